@@ -3,6 +3,9 @@
 #include "Utils.h"
 #include "Core/Logger.h"
 #include "System/System.h"
+#include "Math/TransformBenchmark.h"
+#include "Core/Scene/WorldPartition.h"
+#include "Core/Scene/StaticBatcher.h"
 
 #if defined(LOGGING_USE_SPDLOG)
 	#include <spdlog/spdlog.h>
@@ -24,7 +27,7 @@ Core* g_core = nullptr;
 
 void SetupExceptionHandler();
 
-int main() {
+int main(int argc, char** argv) {
 	g_core = Core::GetInstance();
 
 #if defined(LOGGING_USE_SPDLOG)
@@ -36,6 +39,24 @@ int main() {
 	Logger::Info("Version: {0}.{1}.{2}", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH);
 	Logger::Info("Dravix Studios. All rights reserved");
 
+	CoreLaunchOptions options = CoreLaunchOptions::FromArgs(argc, argv);
+
+	/* Standalone, no window or renderer needed */
+	if (options.bBenchTransforms) {
+		return TransformBenchmark::Run() ? 0 : 1;
+	}
+
+	if (options.fStaticClusterSize > 0.f) {
+		StaticBatchSettings bakeSettings = { };
+		bakeSettings.fClusterSize = options.fStaticClusterSize;
+
+		return StaticBatcher::BakeFile(options.scenePath, bakeSettings) ? 0 : 1;
+	}
+
+	if (options.fPartitionCellSize > 0.f) {
+		return WorldPartition::PartitionFile(options.scenePath, options.fPartitionCellSize) ? 0 : 1;
+	}
+
 	SetupExceptionHandler();
 
 	if (g_core == nullptr) {
@@ -43,6 +64,8 @@ int main() {
 		return 1;
 	}
 
+	g_core->SetLaunchOptions(options);
+
 	g_core->Init();
 	g_core->Update();
 
@@ -18,6 +18,48 @@ Camera::Update() {
 
 }
 
+/**
+* Recalculates the view matrix
+* from the camera transform
+*/
+void
+Camera::UpdateView() {
+	this->m_view = glm::mat4(1.f);
+	this->m_view = glm::rotate(this->m_view, glm::radians(this->transform.rotation.x), glm::vec3(1.f, 0.f, 0.f));
+	this->m_view = glm::rotate(this->m_view, glm::radians(this->transform.rotation.y), glm::vec3(0.f, 1.f, 0.f));
+	this->m_view = glm::translate(this->m_view, {
+		-this->transform.location.x,
+		-this->transform.location.y,
+		this->transform.location.z
+	});
+}
+
+/**
+* Builds a world space ray through a point
+* of the viewport, for picking
+*
+* @param fX Pixels from the left edge
+* @param fY Pixels from the top edge
+*
+* @returns Ray from the near plane, normalized direction
+*/
+Ray
+Camera::ScreenPointToRay(float fX, float fY) const {
+	glm::mat4 invViewProj = glm::inverse(this->m_projection * this->m_view);
+
+	/* Vulkan clip space, y points down like the screen */
+	float fNdcX = 2.f * fX / static_cast<float>(this->m_nWidth) - 1.f;
+	float fNdcY = 2.f * fY / static_cast<float>(this->m_nHeight) - 1.f;
+
+	glm::vec4 nearPoint = invViewProj * glm::vec4(fNdcX, fNdcY, 0.f, 1.f);
+	glm::vec4 farPoint = invViewProj * glm::vec4(fNdcX, fNdcY, 1.f, 1.f);
+
+	glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+	glm::vec3 target = glm::vec3(farPoint) / farPoint.w;
+
+	return Ray(origin, glm::normalize(target - origin));
+}
+
 /**
 * Resizes the camera 
 * 
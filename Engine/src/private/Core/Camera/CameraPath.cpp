@@ -0,0 +1,109 @@
+#include "Core/Camera/CameraPath.h"
+#include "Core/Camera/Camera.h"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+/**
+* Loads a camera path from a text file
+*
+* @param path Camera path file
+*
+* @returns True if at least one keyframe was loaded
+*/
+bool
+CameraPath::LoadFromFile(const String& path) {
+	std::ifstream file(path);
+
+	if (!file.is_open()) {
+		Logger::Error("CameraPath::LoadFromFile: Couldn't open {}", path);
+		return false;
+	}
+
+	this->m_keyframes.clear();
+
+	String line;
+	uint32_t nLine = 0;
+	while (std::getline(file, line)) {
+		nLine++;
+
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		std::istringstream stream(line);
+
+		Keyframe keyframe = { };
+		stream >> keyframe.nFrame
+			>> keyframe.location.x >> keyframe.location.y >> keyframe.location.z
+			>> keyframe.rotation.x >> keyframe.rotation.y >> keyframe.rotation.z;
+
+		if (stream.fail()) {
+			Logger::Warn("CameraPath::LoadFromFile: Skipping malformed line {} in {}", nLine, path);
+			continue;
+		}
+
+		this->m_keyframes.push_back(keyframe);
+	}
+
+	std::sort(
+		this->m_keyframes.begin(),
+		this->m_keyframes.end(),
+		[](const Keyframe& a, const Keyframe& b) { return a.nFrame < b.nFrame; }
+	);
+
+	Logger::Info("CameraPath::LoadFromFile: Loaded {} keyframes from {}", this->m_keyframes.size(), path);
+
+	return !this->m_keyframes.empty();
+}
+
+/**
+* Moves a camera to its position on the path
+*
+* @param pCamera Camera to drive
+* @param nFrame Frame number
+*/
+void
+CameraPath::Apply(Camera* pCamera, uint32_t nFrame) const {
+	if (pCamera == nullptr || this->m_keyframes.empty()) {
+		return;
+	}
+
+	const Keyframe& first = this->m_keyframes.front();
+	const Keyframe& last = this->m_keyframes.back();
+
+	Vector3 location = first.location;
+	Vector3 rotation = first.rotation;
+
+	if (nFrame >= last.nFrame) {
+		location = last.location;
+		rotation = last.rotation;
+	}
+	else if (nFrame > first.nFrame) {
+		/* Find the segment containing nFrame */
+		auto it = std::upper_bound(
+			this->m_keyframes.begin(),
+			this->m_keyframes.end(),
+			nFrame,
+			[](uint32_t nValue, const Keyframe& keyframe) { return nValue < keyframe.nFrame; }
+		);
+
+		const Keyframe& b = *it;
+		const Keyframe& a = *(it - 1);
+
+		float t = static_cast<float>(nFrame - a.nFrame) / static_cast<float>(b.nFrame - a.nFrame);
+
+		location.x = a.location.x + (b.location.x - a.location.x) * t;
+		location.y = a.location.y + (b.location.y - a.location.y) * t;
+		location.z = a.location.z + (b.location.z - a.location.z) * t;
+
+		rotation.x = a.rotation.x + (b.rotation.x - a.rotation.x) * t;
+		rotation.y = a.rotation.y + (b.rotation.y - a.rotation.y) * t;
+		rotation.z = a.rotation.z + (b.rotation.z - a.rotation.z) * t;
+	}
+
+	pCamera->transform.location = location;
+	pCamera->transform.rotation = rotation;
+	pCamera->UpdateView();
+}
@@ -62,23 +62,7 @@ void EditorCamera::Update() {
 
 		this->transform.Rotate(deltaY * -this->m_sensY, deltaX * -this->m_sensX, 0.f);
 
-		glm::vec3 pos(this->transform.location.x, this->transform.location.y, this->transform.location.z);
-		glm::vec3 forward = glm::normalize(
-			glm::vec3(
-				this->transform.Forward().x, 
-				this->transform.Forward().y,
-				this->transform.Forward().z
-			)
-		);
-
-		this->m_view = glm::mat4(1.f);
-		this->m_view = glm::rotate(this->m_view, glm::radians(this->transform.rotation.x), glm::vec3(1.f, 0.f, 0.f));
-		this->m_view = glm::rotate(this->m_view, glm::radians(this->transform.rotation.y), glm::vec3(0.f, 1.f, 0.f));
-		this->m_view = glm::translate(this->m_view, {
-			-this->transform.location.x,
-			-this->transform.location.y,
-			this->transform.location.z
-		});
+		this->UpdateView();
 	}
 	else {
 		this->m_input->ShowCursor(true);
@@ -2,8 +2,14 @@
 #include "Core/Scene/SceneManager.h"
 #include "Core/Renderer/ResourceManager.h"
 #include "Core/Project/ProjectManager.h"
+#include "Core/Renderer/Null/NullDevice.h"
+#include "Core/Renderer/MeshUploadQueue.h"
+#include "Core/Renderer/MeshRegistry.h"
+#include "Core/Utils/Profiler.h"
+#include "Core/FrameStats.h"
 
 #include <nfd.h>
+#include <algorithm>
 
 #ifndef GIT_COMMIT
 #define GIT_COMMIT "Unknown commit"
@@ -28,39 +34,242 @@ DropCallback(GLFWwindow* window, int nCount, const char** paths) {
     }
 }
 
+/**
+* Parses launch options from the command line
+* 
+* Supported arguments:
+*   --backend <name>       vulkan (default) or null. null implies --headless
+*   --headless             Render offscreen, no window
+*   --scene <path>         Project (.aethproj) or scene (.aeth) to load
+*   --camera-path <path>   Camera path file
+*   --frames <N>           Exit after N frames
+*   --width <N>            Render width
+*   --height <N>           Render height
+*   --no-pipeline          Update and collect the next frame on the
+*                          main thread after presenting
+*   --profile <path>       Capture CPU zones and write a Chrome trace
+*   --stats <path>         Write frame time statistics (JSON) and
+*                          frame time histograms (CSV) at exit
+*   --hitch-ms <ms>        Frame time reported as a hitch (default 33.3)
+*   --present-mode <mode>  mailbox (default), fifo, fifo-relaxed or immediate
+*   --swapchain-images <N> Swapchain image count (default 3)
+*   --frames-in-flight <N> Frames recorded ahead of the GPU (default 2,
+*                          1 with --low-latency)
+*   --fps-limit <N>        Cap the frame rate
+*   --low-latency          Sample input and collect the frame right
+*                          before recording it. Implies --no-pipeline
+*   --bench-transforms     Benchmark transform matrix composition and exit
+*   --partition <size>     Split the --scene asset into world partition
+*                          cells of that size and exit
+*   --stream-radius <m>    World partition load radius
+*   --stream-budget <MB>   World partition memory budget
+*   --bake-statics <size>  Merge the static objects of the --scene asset
+*                          into batches, clustered by that size, and exit
+*   --keep-mesh-geometry   Keep mesh vertices and indices in CPU memory
+*                          after upload
+*   --keep-mesh-assets     Keep decoded mesh assets in the asset cache
+* 
+* @param argc Argument count
+* @param argv Arguments
+* 
+* @returns Parsed launch options
+*/
+CoreLaunchOptions
+CoreLaunchOptions::FromArgs(int argc, char** argv) {
+    CoreLaunchOptions options = { };
+
+    for (int i = 1; i < argc; i++) {
+        String arg(argv[i]);
+        bool bHasValue = i + 1 < argc;
+
+        if (arg == "--headless") {
+            options.bHeadless = true;
+        }
+        else if (arg == "--backend" && bHasValue) {
+            String backend(argv[++i]);
+
+            if (backend == "vulkan") {
+                options.renderBackend = ERenderBackend::VULKAN;
+            }
+            else if (backend == "null") {
+                options.renderBackend = ERenderBackend::NULL_RENDERER;
+            }
+            else {
+                Logger::Warn("CoreLaunchOptions::FromArgs: Unknown backend {}, using vulkan", backend);
+            }
+        }
+        else if (arg == "--profile" && bHasValue) {
+            options.profilePath = argv[++i];
+        }
+        else if (arg == "--stats" && bHasValue) {
+            options.statsPath = argv[++i];
+        }
+        else if (arg == "--hitch-ms" && bHasValue) {
+            options.fHitchThreshold = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--present-mode" && bHasValue) {
+            String mode(argv[++i]);
+
+            if (mode == "mailbox") {
+                options.presentMode = EPresentMode::MAILBOX;
+            }
+            else if (mode == "fifo") {
+                options.presentMode = EPresentMode::FIFO;
+            }
+            else if (mode == "fifo-relaxed") {
+                options.presentMode = EPresentMode::FIFO_RELAXED;
+            }
+            else if (mode == "immediate") {
+                options.presentMode = EPresentMode::IMMEDIATE;
+            }
+            else {
+                Logger::Warn("CoreLaunchOptions::FromArgs: Unknown present mode {}, using mailbox", mode);
+            }
+        }
+        else if (arg == "--swapchain-images" && bHasValue) {
+            options.nSwapchainImages = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--frames-in-flight" && bHasValue) {
+            options.nFramesInFlight = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--fps-limit" && bHasValue) {
+            options.fTargetFPS = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--low-latency") {
+            options.bLowLatency = true;
+        }
+        else if (arg == "--bench-transforms") {
+            options.bBenchTransforms = true;
+        }
+        else if (arg == "--partition" && bHasValue) {
+            options.fPartitionCellSize = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--stream-radius" && bHasValue) {
+            options.fStreamingRadius = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--stream-budget" && bHasValue) {
+            options.nStreamingBudgetMB = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--bake-statics" && bHasValue) {
+            options.fStaticClusterSize = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--keep-mesh-geometry") {
+            options.bKeepMeshGeometry = true;
+        }
+        else if (arg == "--keep-mesh-assets") {
+            options.bKeepMeshAssets = true;
+        }
+        else if (arg == "--no-pipeline") {
+            options.bPipelined = false;
+        }
+        else if (arg == "--scene" && bHasValue) {
+            options.scenePath = argv[++i];
+        }
+        else if (arg == "--camera-path" && bHasValue) {
+            options.cameraPath = argv[++i];
+        }
+        else if (arg == "--frames" && bHasValue) {
+            options.nFrameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--width" && bHasValue) {
+            options.nWidth = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--height" && bHasValue) {
+            options.nHeight = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else {
+            Logger::Warn("CoreLaunchOptions::FromArgs: Unknown or incomplete argument {}", arg);
+        }
+    }
+
+    if (options.nWidth == 0 || options.nHeight == 0) {
+        Logger::Warn("CoreLaunchOptions::FromArgs: Invalid dimensions, using {}x{}", WIDTH, HEIGHT);
+        options.nWidth = WIDTH;
+        options.nHeight = HEIGHT;
+    }
+
+    if (options.nFramesInFlight == 0) {
+        options.nFramesInFlight = options.bLowLatency ? 1 : 2;
+    }
+
+    /* The pipelined update runs on input polled a frame earlier */
+    if (options.bLowLatency) {
+        options.bPipelined = false;
+    }
+
+    /* The null backend has nothing to present */
+    if (options.renderBackend == ERenderBackend::NULL_RENDERER) {
+        options.bHeadless = true;
+    }
+
+    return options;
+}
+
 /* Core constructor */
 Core::Core()
     : m_renderBackend(ERenderBackend::VULKAN), 
     m_resMgr(ResourceManager::GetInstance()), m_input(Input::GetInstance()),
-    m_sampleCount(ESampleCount::SAMPLE_8), m_nImageCount(3), m_sceneMgr(SceneManager::GetInstance()) {}
+    m_sampleCount(ESampleCount::SAMPLE_8), m_nFramesInFlight(2), m_sceneMgr(SceneManager::GetInstance()) {}
 
 /* Core init method */
 void 
 Core::Init() {
-    /* Initialize GLFW */
-    if (!glfwInit()) {
-        spdlog::error("Error initializing GLFW");
-        return;
+    PROFILE_THREAD("Main");
+
+    if (!this->m_options.profilePath.empty()) {
+#if defined(PROFILER_ENABLED)
+        Profiler::GetInstance()->BeginCapture();
+#else
+        Logger::Warn("Core::Init: Profiler compiled out (release build without USE_PROFILER), {} won't be written", this->m_options.profilePath);
+#endif
     }
 
-    /* 
-        GLFW Window hints:
-            We don't want OpenGL. WE WANT VULKAN!!!!
-    */
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+    PROFILE_SCOPE("Core::Init");
 
-   
-    this->m_pWindow = glfwCreateWindow(WIDTH, HEIGHT, "Aetherion Engine", nullptr, nullptr); // GLFW Window creation
-    glfwSetWindowUserPointer(this->m_pWindow, this);
+    FrameStats::GetInstance()->SetHitchThreshold(this->m_options.fHitchThreshold);
 
-    glfwSetFramebufferSizeCallback(this->m_pWindow, FramebufferSizeCallback);
+    this->m_renderBackend = this->m_options.renderBackend;
+    this->m_nFramesInFlight = this->m_options.nFramesInFlight;
 
-    /* Assert window is not null */
-    if (this->m_pWindow == nullptr) {
-        spdlog::error("Window not initialized");
-        throw std::runtime_error("Window not initialized");
-        return;
+    if (!this->m_options.bHeadless) {
+        /* Initialize GLFW */
+        if (!glfwInit()) {
+            spdlog::error("Error initializing GLFW");
+            return;
+        }
+
+        /* 
+            GLFW Window hints:
+                We don't want OpenGL. WE WANT VULKAN!!!!
+        */
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+       
+        this->m_pWindow = glfwCreateWindow(
+            this->m_options.nWidth, 
+            this->m_options.nHeight, 
+            "Aetherion Engine", 
+            nullptr, 
+            nullptr
+        ); // GLFW Window creation
+
+        /* Assert window is not null */
+        if (this->m_pWindow == nullptr) {
+            spdlog::error("Window not initialized");
+            throw std::runtime_error("Window not initialized");
+            return;
+        }
+
+        glfwSetWindowUserPointer(this->m_pWindow, this);
+        glfwSetFramebufferSizeCallback(this->m_pWindow, FramebufferSizeCallback);
+    }
+    else {
+        Logger::Info(
+            "Core::Init: Headless mode. {}x{} offscreen",
+            this->m_options.nWidth,
+            this->m_options.nHeight
+        );
     }
 
     /* 
@@ -77,7 +286,11 @@ Core::Init() {
             break;
 #else
             Logger::Error("Core::Init: Vulkan not available in this build");
+            return;
 #endif
+        case ERenderBackend::NULL_RENDERER:
+            this->m_renderer = NullRenderer::CreateShared().As<Renderer>();
+            break;
         case ERenderBackend::D3D11:
         case ERenderBackend::D3D12:
         case ERenderBackend::METAL:
@@ -101,8 +314,8 @@ Core::Init() {
     this->m_pool = this->m_device->CreateCommandPool(poolInfo, EQueueType::GRAPHICS);
 
     /* Create graphics context */
-    this->m_contexts.resize(this->m_nImageCount);
-    for (uint32_t i = 0; i < this->m_nImageCount; i++) {
+    this->m_contexts.resize(this->m_nFramesInFlight);
+    for (uint32_t i = 0; i < this->m_nFramesInFlight; i++) {
         this->m_contexts[i] = this->m_device->CreateContext(this->m_pool);
     }
     
@@ -110,31 +323,76 @@ Core::Init() {
     this->CreateSyncObjects();
 
     this->m_input->SetWindow(this->m_pWindow);
-    glfwSetKeyCallback(this->m_pWindow, Input::KeyCallback);
-    glfwSetDropCallback(this->m_pWindow, DropCallback);
-    glfwSetMouseButtonCallback(this->m_pWindow, Input::MouseButtonCallback);
+    if (this->m_pWindow != nullptr) {
+        glfwSetKeyCallback(this->m_pWindow, Input::KeyCallback);
+        glfwSetDropCallback(this->m_pWindow, DropCallback);
+        glfwSetMouseButtonCallback(this->m_pWindow, Input::MouseButtonCallback);
+    }
 
-    this->m_deferredRenderer.Init(this->m_device, this->m_swapchain, this->m_nImageCount, this->m_pWindow);
+    this->m_deferredRenderer.Init(this->m_device, this->m_swapchain, this->m_nFramesInFlight, this->m_pWindow);
 
     this->m_time = Time::GetInstance();
 
     this->m_sceneMgr = SceneManager::GetInstance();
     this->m_sceneMgr->Start();
-    this->m_sceneMgr->SetDimensions(WIDTH, HEIGHT);
+    this->m_sceneMgr->SetDimensions(this->m_options.nWidth, this->m_options.nHeight);
 
     /* Set window title with build commit */
-    String buildCommit(GIT_COMMIT);
-    glfwSetWindowTitle(this->m_pWindow, String("No active project - Aetherion [" + buildCommit + "]").c_str());
+    if (this->m_pWindow != nullptr) {
+        String buildCommit(GIT_COMMIT);
+        glfwSetWindowTitle(this->m_pWindow, String("No active project - Aetherion [" + buildCommit + "]").c_str());
+    }
 
     this->SetupCallbacks();
+
+    /* CPU copies of uploaded meshes, set before anything is decoded */
+    MeshResidencyPolicy residency = { };
+    residency.bKeepGeometry = this->m_options.bKeepMeshGeometry;
+    residency.bKeepAssets = this->m_options.bKeepMeshAssets;
+    MeshRegistry::GetInstance()->SetResidencyPolicy(residency);
+
+    /* Startup scene and camera path from the command line */
+    if (!this->m_options.scenePath.empty()) {
+        this->LoadScene(this->m_options.scenePath);
+    }
+
+    if (!this->m_options.cameraPath.empty()) {
+        this->m_cameraPath.LoadFromFile(this->m_options.cameraPath);
+    }
+
+    /* A headless run always terminates. Default to the camera path length */
+    if (this->m_options.bHeadless && this->m_options.nFrameCount == 0) {
+        this->m_options.nFrameCount = this->m_cameraPath.IsLoaded()
+            ? this->m_cameraPath.GetKeyframes().back().nFrame + 1
+            : 1;
+
+        Logger::Info("Core::Init: No frame count given, rendering {} frames", this->m_options.nFrameCount);
+    }
+
+    /* One worker runs the game update and collection of the next frame */
+    if (this->m_options.bPipelined) {
+        this->m_simulationPool = ThreadPool::CreateShared(1);
+    }
+
+    this->m_frameLimiter.SetTargetFPS(this->m_options.fTargetFPS);
+
+    Logger::Info(
+        "Core::Init: {} frames in flight, {} swapchain images{}",
+        this->m_nFramesInFlight,
+        this->m_swapchain->GetImageCount(),
+        this->m_options.bLowLatency ? ", low latency" : ""
+    );
 }
 
 /* Our core update method */
 void 
 Core::Update() {
-    /* While window should not close */
-    while (!glfwWindowShouldClose(this->m_pWindow)) {
+    /* While window should not close (or frame count not reached) */
+    while (!this->ShouldClose()) {
+        PROFILE_SCOPE("Core::Frame");
+
         this->m_time->PreUpdate();
+        FrameStats::GetInstance()->BeginFrame(this->m_nFrameNumber);
 
         /* Manage window resizing */
         if (this->m_bWindowResized) {
@@ -154,70 +412,340 @@ Core::Update() {
             this->m_deferredRenderer.Invalidate();
             this->m_swapchain->Rebuild(static_cast<uint32_t>(nWidth), static_cast<uint32_t>(nHeight));
             this->m_deferredRenderer.Resize(nWidth, nHeight);
+            this->CreatePresentSemaphores();
 
             SceneManager::GetInstance()->SetDimensions(nWidth, nHeight);
 
+            /* The next frame was collected with the old projection */
+            this->m_bDrawDataValid = false;
             this->m_bWindowResized = false;
         }
 
-        this->m_device->WaitForFence(this->m_inFlightFences[this->m_nImageIndex]);
-        this->m_inFlightFences[this->m_nImageIndex]->Reset();
+        {
+            PROFILE_SCOPE("Core::WaitForFence");
+            this->m_device->WaitForFence(this->m_inFlightFences[this->m_nFrameIndex]);
+            this->m_inFlightFences[this->m_nFrameIndex]->Reset();
+        }
+
+        /* The GPU caught up. Input sampled from here on is shown by this frame */
+        if (this->m_options.bLowLatency) {
+            this->m_frameLimiter.Wait();
+            this->PollEvents();
+        }
 
-        uint32_t nImgIdx = this->m_swapchain->AcquireNextImage(
-            UINT64_MAX, 
-            this->m_imageAvailableSemaphores[this->m_nImageIndex],
-            Ref<Fence>()
-        );
+        uint32_t nImgIdx = 0;
+        {
+            PROFILE_SCOPE("Core::AcquireNextImage");
+            nImgIdx = this->m_swapchain->AcquireNextImage(
+                UINT64_MAX, 
+                this->m_imageAvailableSemaphores[this->m_nFrameIndex],
+                Ref<Fence>()
+            );
+        }
 
-        Ref<GraphicsContext> context = this->m_contexts[this->m_nImageIndex];
+        Ref<GraphicsContext> context = this->m_contexts[this->m_nFrameIndex];
         Ref<CommandBuffer> commandBuffer = context->GetCommandBuffer();
         commandBuffer->Reset();
         commandBuffer->Begin();
 
-        Scene* currentScene = this->m_sceneMgr->GetCurrentScene();
+        {
+            PROFILE_SCOPE("Core::UploadMeshes");
 
-        for (auto& [name, gameObject] : currentScene->GetObjects()) {
-            auto components = gameObject->GetComponents();
-            auto it = components.find("MeshComponent");
-            if (it != components.end()) {
-                Mesh* mesh = dynamic_cast<Mesh*>(it->second);
-                if (mesh && mesh->IsLoaded()) {
-                    this->m_deferredRenderer.UploadMesh(mesh->GetMeshData());
+            MeshUploadQueue* pUploadQueue = MeshUploadQueue::GetInstance();
+            MeshRegistry* pMeshRegistry = MeshRegistry::GetInstance();
 
-                    mesh->ClearTextureData();
-                }
+            /* Streamed out meshes. The last frame drawing them is still in flight */
+            for (String& name : pUploadQueue->DrainReleases()) {
+                this->m_meshReleases.push_back({ std::move(name), this->m_nFrameNumber + this->m_nFramesInFlight });
+            }
+
+            /* Only meshes loaded since the last frame */
+            for (Ref<MeshData>& meshData : pUploadQueue->Drain()) {
+                if (!meshData->bLoaded) continue;
+
+                /* Streamed back in before it was freed, the GPU copy is kept */
+                this->m_meshReleases.erase(
+                    std::remove_if(
+                        this->m_meshReleases.begin(),
+                        this->m_meshReleases.end(),
+                        [&meshData](const MeshRelease& release) { return release.name == meshData->name; }
+                    ),
+                    this->m_meshReleases.end()
+                );
+
+                /* Its CPU copy was dropped and the GPU copy freed meanwhile, read it back */
+                bool bUploaded = this->m_deferredRenderer.GetUploadedMeshes().contains(meshData->name);
+                if (!bUploaded && !pMeshRegistry->Reload(*meshData)) continue;
+
+                this->m_deferredRenderer.UploadMesh(*meshData);
+                pMeshRegistry->OnUploaded(*meshData);
             }
-        }
 
-        this->m_deferredRenderer.FinalizeMeshUploads();
+            while (!this->m_meshReleases.empty() && this->m_meshReleases.front().nFrame <= this->m_nFrameNumber) {
+                this->m_deferredRenderer.UnloadMesh(this->m_meshReleases.front().name);
+                this->m_meshReleases.pop_front();
+            }
+
+            this->m_deferredRenderer.FinalizeMeshUploads();
+        }
 
         const auto& meshCache = this->m_deferredRenderer.GetUploadedMeshes();
-        this->m_sceneCollector.SetUploadedMeshes(&meshCache);
-        CollectedDrawData drawData = this->m_sceneCollector.Collect(currentScene);
+        this->m_sceneCollector.SetUploadedMeshes(&meshCache, this->m_deferredRenderer.GetMeshCacheGeneration());
 
-        this->m_deferredRenderer.Render(context, this->m_swapchain, drawData, nImgIdx);
+        /* Update and collect as late as possible, right before recording */
+        if (this->m_options.bLowLatency) {
+            this->SimulateFrame(this->m_nFrameNumber, this->m_drawData[this->m_nDrawDataIndex]);
+            this->m_input->Close();
+            this->m_bDrawDataValid = true;
+        }
 
-        commandBuffer->End();
+        /* 
+            First frame, or the snapshot went stale (resize, 
+            meshes unloaded or scene changed by the editor).
+            Meshes uploaded above show up on the next frame
+        */
+        if (!this->m_bDrawDataValid) {
+            this->CollectFrame(this->m_nFrameNumber, this->m_drawData[this->m_nDrawDataIndex]);
+            this->m_bDrawDataValid = true;
+        }
 
-        SubmitInfo submitInfo = { };
-        submitInfo.commandBuffers = { commandBuffer };
-        submitInfo.signalSemaphores = { this->m_renderFinishedSemaphores[this->m_nImageIndex] };
-        submitInfo.waitSemaphores = { this->m_imageAvailableSemaphores[this->m_nImageIndex] };
-        submitInfo.waitStages = { EPipelineStage::COLOR_ATTACHMENT_OUTPUT };
+        const CollectedDrawData& drawData = this->m_drawData[this->m_nDrawDataIndex];
+        CollectedDrawData& nextDrawData = this->m_drawData[this->m_nDrawDataIndex ^ 1];
+        uint32_t nNextFrame = this->m_nFrameNumber + 1;
 
-        this->m_device->Submit(submitInfo, this->m_inFlightFences[this->m_nImageIndex]);
+        /* Update and collect the next frame while this one is recorded */
+        if (this->m_simulationPool) {
+            this->m_simulationJob = this->m_simulationPool->Submit([this, nNextFrame, &nextDrawData]() {
+                this->SimulateFrame(nNextFrame, nextDrawData);
+            });
+        }
 
-        this->m_swapchain->Present(nImgIdx, Vector{ this->m_renderFinishedSemaphores[this->m_nImageIndex] });
+        {
+            PROFILE_SCOPE("Core::Render");
+            this->m_deferredRenderer.Render(context, this->m_swapchain, drawData, this->m_nFrameIndex, nImgIdx);
+            commandBuffer->End();
 
-        glfwPollEvents(); // Poll GLFW events
-        this->m_sceneMgr->Update();
-        this->m_input->Close();
+            /* Its slot updates are recorded, later snapshots can leave them out */
+            this->m_sceneCollector.Acknowledge(drawData.nSequence);
+        }
+
+        {
+            PROFILE_SCOPE("Core::Submit");
+
+            SubmitInfo submitInfo = { };
+            submitInfo.commandBuffers = { commandBuffer };
+            submitInfo.signalSemaphores = { this->m_renderFinishedSemaphores[nImgIdx] };
+            submitInfo.waitSemaphores = { this->m_imageAvailableSemaphores[this->m_nFrameIndex] };
+            submitInfo.waitStages = { EPipelineStage::COLOR_ATTACHMENT_OUTPUT };
+
+            this->m_device->Submit(submitInfo, this->m_inFlightFences[this->m_nFrameIndex]);
+        }
+
+        {
+            PROFILE_SCOPE("Core::Present");
+            this->m_swapchain->Present(nImgIdx, Vector{ this->m_renderFinishedSemaphores[nImgIdx] });
+        }
+
+        /* The update consumed this frame's input, clear it before polling */
+        if (this->m_simulationJob.valid()) {
+            PROFILE_SCOPE("Core::WaitSimulation");
+            this->m_simulationJob.get();
+            this->m_input->Close();
+        }
+
+        if (!this->m_options.bLowLatency) {
+            this->m_frameLimiter.Wait();
+            this->PollEvents();
+        }
+
+        if (!this->m_simulationPool && !this->m_options.bLowLatency) {
+            this->SimulateFrame(nNextFrame, nextDrawData);
+            this->m_input->Close();
+        }
+
+        this->m_nDrawDataIndex ^= 1;
         this->m_time->PostUpdate();
 
-        this->m_nImageIndex = (this->m_nImageIndex + 1) % this->m_nImageCount;
+        /* A GPU time only counts on the frame it was read back */
+        float fGPUFrameTime = this->m_deferredRenderer.HasNewGPUTimings() ? this->m_deferredRenderer.GetGPUFrameTime() : 0.f;
+        FrameStats::GetInstance()->EndFrame(this->m_time->frameTime * 1000.f, fGPUFrameTime);
+
+        this->m_nFrameIndex = (this->m_nFrameIndex + 1) % this->m_nFramesInFlight;
+        this->m_nFrameNumber++;
     }
 
     this->m_device->WaitIdle();
+
+    if (this->m_options.bHeadless) {
+        Logger::Info("Core::Update: Headless run finished. {} frames rendered", this->m_nFrameNumber);
+    }
+
+    if (this->m_renderBackend == ERenderBackend::NULL_RENDERER) {
+        this->LogNullDeviceStats();
+    }
+
+    FrameStats* pFrameStats = FrameStats::GetInstance();
+    pFrameStats->LogSummary();
+
+    if (!this->m_options.statsPath.empty()) {
+        pFrameStats->WriteSummary(this->m_options.statsPath);
+    }
+
+    Profiler* pProfiler = Profiler::GetInstance();
+    if (pProfiler->IsCapturing()) {
+        pProfiler->EndCapture();
+        pProfiler->WriteChromeTrace(this->m_options.profilePath);
+    }
+}
+
+/**
+* Checks if the main loop should stop
+* 
+* @returns True when the window was closed or
+* the requested frame count was reached
+*/
+bool
+Core::ShouldClose() {
+    if (this->m_options.nFrameCount > 0 && this->m_nFrameNumber >= this->m_options.nFrameCount) {
+        return true;
+    }
+
+    if (this->m_pWindow == nullptr) {
+        return false;
+    }
+
+    return glfwWindowShouldClose(this->m_pWindow);
+}
+
+/**
+* Collects the draw data of a frame. The caller makes
+* sure nothing else touches the scene meanwhile
+* 
+* @param nFrameNumber Frame the data is collected for
+* @param drawData Output draw data
+*/
+void
+Core::CollectFrame(uint32_t nFrameNumber, CollectedDrawData& drawData) {
+    Scene* currentScene = this->m_sceneMgr->GetCurrentScene();
+
+    if (this->m_cameraPath.IsLoaded()) {
+        this->m_cameraPath.Apply(currentScene->GetCurrentCamera(), nFrameNumber);
+    }
+
+    currentScene->UpdateTransforms();
+
+    this->m_sceneCollector.Collect(currentScene, drawData);
+}
+
+/**
+* Runs the game update and collects the draw data
+* of the next frame. Runs on the simulation worker
+* while the previous frame is recorded, or on the
+* main thread when pipelining is disabled
+* 
+* @param nFrameNumber Frame being simulated
+* @param drawData Output draw data
+*/
+void
+Core::SimulateFrame(uint32_t nFrameNumber, CollectedDrawData& drawData) {
+    PROFILE_SCOPE("Core::SimulateFrame");
+
+    std::lock_guard<std::mutex> sceneLock(this->m_sceneMgr->GetSceneMutex());
+
+    {
+        PROFILE_SCOPE("SceneManager::Update");
+        this->m_sceneMgr->Update();
+    }
+
+    this->CollectFrame(nFrameNumber, drawData);
+}
+
+/**
+* Logs the command stream recorded by the null device
+*/
+void
+Core::LogNullDeviceStats() {
+    NullDeviceStats stats = this->m_device.As<NullDevice>()->GetStats();
+    uint64_t nFrames = std::max<uint64_t>(this->m_nFrameNumber, 1);
+
+    Logger::Info("Core::LogNullDeviceStats: {} submits, {} command buffers", stats.nSubmits, stats.nCommandBuffersSubmitted);
+    Logger::Info(
+        "  - Draws: {} ({} direct, {} indexed, {} indirect up to {} draws), {} per frame",
+        stats.commands.GetDrawCount(),
+        stats.commands.nDraws,
+        stats.commands.nIndexedDraws,
+        stats.commands.nIndirectDraws,
+        stats.commands.nMaxIndirectDrawCount,
+        stats.commands.GetDrawCount() / nFrames
+    );
+    Logger::Info("  - Dispatches: {} ({} groups)", stats.commands.nDispatches, stats.commands.nDispatchGroups);
+    Logger::Info(
+        "  - Barriers: {} ({} buffer, {} image, {} global)",
+        stats.commands.GetBarrierCount(),
+        stats.commands.nBufferBarriers,
+        stats.commands.nImageBarriers,
+        stats.commands.nGlobalBarriers
+    );
+    Logger::Info("  - Render passes: {}, pipeline binds: {}", stats.commands.nRenderPasses, stats.commands.nPipelineBinds);
+    Logger::Info("  - Uploaded: {} KB, {} KB per frame", stats.nBytesUploaded / 1024, stats.nBytesUploaded / nFrames / 1024);
+    Logger::Info("  - Buffers: {} ({} KB), textures: {}", stats.nBuffersCreated, stats.nBufferBytes / 1024, stats.nTexturesCreated);
+}
+
+/**
+* Loads a scene and makes it current
+* 
+* A .aethproj path opens the whole project (its editor
+* scene is loaded by the project opened callback).
+* Any other path is read as a scene asset
+* 
+* @param scenePath Project or scene path
+* 
+* @returns True if the scene was loaded
+*/
+bool
+Core::LoadScene(const String& scenePath) {
+    PROFILE_SCOPE("Core::LoadScene");
+
+    if (fs::path(scenePath).extension() == ".aethproj") {
+        return ProjectManager::GetInstance()->OpenProject(scenePath);
+    }
+
+    AssetManager* assetMgr = AssetManager::GetInstance();
+    AssetHandle sceneHandle = assetMgr->RegisterAsset(scenePath, EAssetType::SCENE);
+
+    AssetVariant sceneAssetVariant = assetMgr->GetAsset(sceneHandle);
+
+    /* Check if asset variant holds SceneAsset */
+    SceneAsset* pSceneAsset = std::get_if<SceneAsset>(&sceneAssetVariant);
+    if (pSceneAsset == nullptr) {
+        Logger::Error("Core::LoadScene: Not a SceneAsset {}", scenePath);
+        return false;
+    }
+
+    /* Create scene from asset */
+    String sceneName(pSceneAsset->header.displayName);
+    Scene* pScene = new Scene(sceneName);
+
+    WorldPartitionSettings streaming = { };
+    if (this->m_options.fStreamingRadius > 0.f) {
+        streaming.fLoadRadius = this->m_options.fStreamingRadius;
+    }
+    if (this->m_options.nStreamingBudgetMB > 0) {
+        streaming.nMemoryBudget = static_cast<uint64_t>(this->m_options.nStreamingBudgetMB) << 20;
+    }
+
+    pScene->GetPartition().SetSettings(streaming);
+    pScene->SetupFromAsset(*pSceneAsset);
+
+    /* Add scene to the scene manager and set it as current */
+    this->m_sceneMgr->AddScene(pScene);
+    this->m_sceneMgr->SetCurrentScene(sceneName);
+    this->m_sceneMgr->SetDimensions(this->m_options.nWidth, this->m_options.nHeight);
+
+    this->SetupSceneCallbacks();
+    this->m_bDrawDataValid = false;
+
+    return true;
 }
 
 Core* 
@@ -232,13 +760,14 @@ Core::GetInstance() {
 */
 void
 Core::CreateSwapchain() {
-    /* TODO: Image count user-selectable */
     SwapchainCreateInfo scInfo = { };
-    scInfo.nImageCount = this->m_nImageCount;
+    scInfo.nImageCount = this->m_options.nSwapchainImages;
+    scInfo.presentMode = this->m_options.presentMode;
     scInfo.pWindow = this->m_pWindow;
-    scInfo.width = WIDTH;
-    scInfo.height = HEIGHT;
+    scInfo.width = this->m_options.nWidth;
+    scInfo.height = this->m_options.nHeight;
     scInfo.bEnableDepthStencil = true;
+    scInfo.bOffscreen = this->m_options.bHeadless;
 
     this->m_swapchain = this->m_device->CreateSwapchain(scInfo);
 }
@@ -248,24 +777,53 @@ Core::CreateSwapchain() {
 */
 void 
 Core::CreateSyncObjects() {
-    this->m_imageAvailableSemaphores.resize(this->m_nImageCount);
-    this->m_renderFinishedSemaphores.resize(this->m_nImageCount);
-    this->m_inFlightFences.resize(this->m_nImageCount);
+    this->m_imageAvailableSemaphores.resize(this->m_nFramesInFlight);
+    this->m_inFlightFences.resize(this->m_nFramesInFlight);
 
     FenceCreateInfo fenceInfo = { };
     fenceInfo.flags = EFenceFlags::SIGNALED;
 
-    for (uint32_t i = 0; i < this->m_nImageCount; i++) {
-        Ref<Semaphore> renderSemaphore = this->m_device->CreateSemaphore();
+    for (uint32_t i = 0; i < this->m_nFramesInFlight; i++) {
         Ref<Semaphore> imageAvailableSemaphore = this->m_device->CreateSemaphore();
         Ref<Fence> inFlightFence = this->m_device->CreateFence(fenceInfo);
 
         this->m_imageAvailableSemaphores[i] = imageAvailableSemaphore;
-        this->m_renderFinishedSemaphores[i] = renderSemaphore;
         this->m_inFlightFences[i] = inFlightFence;
     }
 
+    this->CreatePresentSemaphores();
+}
+
+/**
+* Creates one render finished semaphore per swapchain
+* image. Called again after a rebuild, the image
+* count may change
+*/
+void
+Core::CreatePresentSemaphores() {
+    uint32_t nImageCount = this->m_swapchain->GetImageCount();
+    if (this->m_renderFinishedSemaphores.size() == nImageCount) {
+        return;
+    }
+
+    this->m_renderFinishedSemaphores.resize(nImageCount);
+    for (uint32_t i = 0; i < nImageCount; i++) {
+        this->m_renderFinishedSemaphores[i] = this->m_device->CreateSemaphore();
+    }
+}
+
+/**
+* Polls window events and samples input
+*/
+void
+Core::PollEvents() {
+    PROFILE_SCOPE("Core::PollEvents");
 
+    if (this->m_pWindow != nullptr) {
+        glfwPollEvents(); // Poll GLFW events
+    }
+
+    this->m_input->Poll();
 }
 
 void
@@ -274,8 +832,10 @@ Core::SetupCallbacks() {
     ProjectManager* pProjManager = ProjectManager::GetInstance();
     pProjManager->SetOnProjectOpenedCallback(
         [this, pProjManager](const Project::Asset& projectAsset) {
-            String title = projectAsset.name + " - Aetherion Engine";
-            glfwSetWindowTitle(this->m_pWindow, title.c_str());
+            if (this->m_pWindow != nullptr) {
+                String title = projectAsset.name + " - Aetherion Engine";
+                glfwSetWindowTitle(this->m_pWindow, title.c_str());
+            }
 
             String editorScene = projectAsset.editorScene;
             String runtimeScene = projectAsset.runtimeScene;
@@ -295,27 +855,8 @@ Core::SetupCallbacks() {
 #endif
 
             /* TODO: Switch between editor and runtime scenes */
-            AssetHandle sceneHandle = AssetHandle::FromPath(fullScenePath, EAssetType::SCENE);
-
-            AssetVariant sceneAssetVariant = AssetManager::GetInstance()->GetAsset(sceneHandle);
-
-            /* Check if asset variant holds SceneAsset */
-            if (SceneAsset* pSceneAsset = std::get_if<SceneAsset>(&sceneAssetVariant)) {
-                const SceneAsset sceneAsset = *pSceneAsset;
-
-                /* Create scene from asset */
-                String sceneName(sceneAsset.header.displayName);
-                Scene* pScene = new Scene(sceneName);
-                pScene->SetupFromAsset(sceneAsset);
-                
-                /* Add scene to the scene manager and set it as current */
-                this->m_sceneMgr->AddScene(pScene);
-                this->m_sceneMgr->SetCurrentScene(sceneName);
-
-                this->SetupSceneCallbacks();
-            }
-            else {
-                Logger::Error("Core::SetupCallbacks:[OnProjectOpenedCallback]: Not a SceneAsset");
+            if (!this->LoadScene(fullScenePath)) {
+                Logger::Error("Core::SetupCallbacks:[OnProjectOpenedCallback]: Failed loading {}", fullScenePath);
                 return;
             }
         }
@@ -411,17 +952,16 @@ Core::SetupCallbacks() {
             * create a new gameobject with a MeshComponent
             */
             const Name& assetName = ProjectManagerHelpers::GetAssetName(handle);
-            GameObject* pObj = new GameObject(String(assetName));
-            Mesh* pMesh = new Mesh("MeshComponent");
-            pMesh->LoadAsset(handle);
+            Scene* currentScene = sceneMgr->GetCurrentScene();
 
-            pObj->AddComponent("MeshComponent", pMesh);
+            /* Several objects may use the asset, they share its mesh */
+            GameObject* pObj = currentScene->CreateObject(String(assetName));
 
-            Scene* currentScene = sceneMgr->GetCurrentScene();
+            Mesh& mesh = pObj->AddComponent<Mesh>("MeshComponent");
+            mesh.LoadAsset(handle);
 
-            pObj->transform.scale = Vector3(.05f, .05f, .05f);
-            //pObj->transform.Rotate(90.f, 0.f, 0.f);
-            currentScene->AddObject(pObj);
+            pObj->GetTransform().scale = Vector3(.05f, .05f, .05f);
+            //pObj->GetTransform().Rotate(90.f, 0.f, 0.f);
 
             break;
         }
@@ -439,18 +979,10 @@ Core::SetupSceneCallbacks() {
 
     if (pCurrentScene == nullptr) return;
 
-    pCurrentScene->GetHierarchy().SetOnNodeDeleted([this, pCurrentScene](GameObject* pObj) {
+    /* The mesh registry frees GPU meshes once their last user is gone and no frame draws them */
+    pCurrentScene->GetHierarchy().SetOnNodeDeleted([pCurrentScene](GameObject* pObj) {
         if (pObj == nullptr) return;
 
-        Map<String, Component*> components = pObj->GetComponents();
-        if (components.count("MeshComponent") > 0) {
-            Mesh* pMeshComponent = dynamic_cast<Mesh*>(components.at("MeshComponent"));
-            if (pMeshComponent && pMeshComponent->IsLoaded()) {
-                String meshName = pMeshComponent->GetMeshData().name;
-
-                this->m_deferredRenderer.UnloadMesh(meshName);
-            }
-        }
         pCurrentScene->DeleteObject(pObj);
     });
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "Core/ECS/ComponentType.h"
+#include "Core/Logger.h"
+
+#include <atomic>
+#include <stdexcept>
+
+/**
+* Hands out the next dynamic component type ID
+*
+* @returns Component type ID
+*/
+ComponentTypeID
+ComponentTypes::NextDynamicID() {
+	static std::atomic<ComponentTypeID> nNextID{ FIRST_DYNAMIC_COMPONENT_TYPE };
+
+	ComponentTypeID id = nNextID.fetch_add(1, std::memory_order_relaxed);
+	if (id >= MAX_COMPONENT_TYPES) {
+		Logger::Error("ComponentTypes::NextDynamicID: More than {} component types", MAX_COMPONENT_TYPES);
+		throw std::runtime_error("ComponentTypes::NextDynamicID: Too many component types");
+	}
+
+	return id;
+}
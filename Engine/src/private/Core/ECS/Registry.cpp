@@ -0,0 +1,131 @@
+#include "Core/ECS/Registry.h"
+
+/**
+* Creates an entity without components
+*
+* @returns Entity handle
+*/
+EntityHandle
+Registry::CreateEntity() {
+	EntityID entity;
+
+	if (!this->m_freeEntities.empty()) {
+		entity = this->m_freeEntities.back();
+		this->m_freeEntities.pop_back();
+	}
+	else {
+		entity = static_cast<EntityID>(this->m_alive.size());
+		this->m_alive.push_back(false);
+		this->m_generations.push_back(0);
+		this->m_masks.push_back(0);
+	}
+
+	this->m_alive[entity] = true;
+	this->m_nAliveCount++;
+
+	return this->GetHandle(entity);
+}
+
+/**
+* Destroys an entity and all its components.
+* Stale handles are ignored
+*
+* @param handle Entity handle
+*/
+void
+Registry::DestroyEntity(EntityHandle handle) {
+	if (!this->IsAlive(handle)) return;
+
+	EntityID entity = handle.nIndex;
+
+	/* Only the pools the entity is in */
+	ComponentMask mask = this->m_masks[entity];
+	for (ComponentTypeID type = 0; mask != 0; type++, mask >>= 1) {
+		if ((mask & 1) != 0) {
+			this->m_pools[type]->Remove(entity);
+		}
+	}
+
+	this->m_masks[entity] = 0;
+
+	this->m_alive[entity] = false;
+	this->m_generations[entity]++;
+	this->m_freeEntities.push_back(entity);
+	this->m_nAliveCount--;
+}
+
+/**
+* Checks if a handle still points to
+* its entity
+*
+* @param handle Entity handle
+*
+* @returns True if the entity wasn't destroyed
+*/
+bool
+Registry::IsAlive(EntityHandle handle) const {
+	EntityID entity = handle.nIndex;
+
+	return entity < this->m_alive.size() &&
+		this->m_alive[entity] &&
+		this->m_generations[entity] == handle.nGeneration;
+}
+
+/**
+* Gets the current handle of an entity index
+*
+* @param entity Entity index
+*
+* @returns Entity handle, invalid if no entity lives there
+*/
+EntityHandle
+Registry::GetHandle(EntityID entity) const {
+	if (entity >= this->m_alive.size() || !this->m_alive[entity]) {
+		return EntityHandle{ };
+	}
+
+	EntityHandle handle = { };
+	handle.nIndex = entity;
+	handle.nGeneration = this->m_generations[entity];
+
+	return handle;
+}
+
+/**
+* Gets every entity whose mask contains
+* the required bits
+*
+* @param required Required component mask
+* @param outEntities Output entities, in index order
+*/
+void
+Registry::QueryMask(ComponentMask required, Vector<EntityID>& outEntities) const {
+	outEntities.clear();
+
+	for (EntityID entity = 0; entity < this->m_masks.size(); entity++) {
+		/* Dead entities have an empty mask */
+		if ((this->m_masks[entity] & required) == required && this->m_alive[entity]) {
+			outEntities.push_back(entity);
+		}
+	}
+}
+
+/**
+* Starts every behaviour component, pool by pool
+*/
+void
+Registry::StartComponents() {
+	for (UniquePtr<IComponentPool>& pool : this->m_pools) {
+		if (pool) pool->Start();
+	}
+}
+
+/**
+* Updates every behaviour component, pool by pool
+*/
+void
+Registry::UpdateComponents() {
+	for (UniquePtr<IComponentPool>& pool : this->m_pools) {
+		if (pool) pool->Update();
+	}
+}
@@ -0,0 +1,136 @@
+#include "Core/ECS/SystemScheduler.h"
+#include "Core/Utils/Profiler.h"
+
+#include <algorithm>
+
+ThreadPool::Ptr SystemScheduler::m_workerPool;
+
+/**
+* Checks if two systems can't run at the same time
+*
+* @param other Other system access
+*
+* @returns True if one writes a type the other uses
+*/
+bool
+SystemAccess::ConflictsWith(const SystemAccess& other) const {
+	if (this->bExclusive || other.bExclusive) return true;
+
+	return (this->writes & (other.reads | other.writes)) != 0 || (other.writes & this->reads) != 0;
+}
+
+/**
+* Adds a system and places it in its stage
+*
+* @param system System
+*
+* @returns Added system
+*/
+ISystem&
+SystemScheduler::AddSystem(UniquePtr<ISystem> system) {
+	SystemEntry entry = { };
+	entry.system = std::move(system);
+	entry.system->DeclareAccess(entry.access);
+
+	/* After every earlier system it conflicts with */
+	for (const SystemEntry& other : this->m_systems) {
+		if (entry.access.ConflictsWith(other.access)) {
+			entry.nStage = std::max(entry.nStage, other.nStage + 1);
+		}
+	}
+
+	if (entry.nStage >= this->m_stages.size()) {
+		this->m_stages.resize(static_cast<size_t>(entry.nStage) + 1);
+	}
+
+	this->m_stages[entry.nStage].push_back(static_cast<uint32_t>(this->m_systems.size()));
+	this->m_systems.push_back(std::move(entry));
+
+	return *this->m_systems.back().system;
+}
+
+/**
+* Runs every system, stage by stage. Returns once
+* all of them finished
+*
+* @param registry Scene registry
+* @param fDeltaTime Frame delta time
+*/
+void
+SystemScheduler::Run(Registry& registry, float fDeltaTime) {
+	PROFILE_SCOPE("SystemScheduler::Run");
+
+	ThreadPool* pPool = SystemScheduler::GetWorkerPool();
+
+	for (const Vector<uint32_t>& stage : this->m_stages) {
+		this->m_chunks.clear();
+
+		/* Serial, systems may still change the registry here */
+		for (uint32_t nSystem : stage) {
+			ISystem* pSystem = this->m_systems[nSystem].system.get();
+			uint32_t nCount = pSystem->Prepare(registry);
+
+			for (uint32_t nBegin = 0; nBegin < nCount; nBegin += this->m_nChunkSize) {
+				Chunk chunk = { };
+				chunk.pSystem = pSystem;
+				chunk.nBegin = nBegin;
+				chunk.nEnd = std::min(nCount, nBegin + this->m_nChunkSize);
+
+				this->m_chunks.push_back(chunk);
+			}
+		}
+
+		if (this->m_chunks.empty()) continue;
+
+		auto runChunk = [fDeltaTime](const Chunk& chunk) {
+			PROFILE_SCOPE(chunk.pSystem->GetName());
+			chunk.pSystem->Run(chunk.nBegin, chunk.nEnd, fDeltaTime);
+		};
+
+		/* Hand all chunks but the last to the workers, this thread takes the last one */
+		this->m_pending.clear();
+		for (size_t i = 0; i + 1 < this->m_chunks.size(); i++) {
+			const Chunk& chunk = this->m_chunks[i];
+			this->m_pending.push_back(pPool->Submit([&runChunk, &chunk]() { runChunk(chunk); }));
+		}
+
+		/* Wait for every chunk before rethrowing, they reference m_chunks */
+		std::exception_ptr exception = nullptr;
+
+		try {
+			runChunk(this->m_chunks.back());
+		}
+		catch (...) {
+			exception = std::current_exception();
+		}
+
+		for (std::future<void>& pending : this->m_pending) {
+			try {
+				pending.get();
+			}
+			catch (...) {
+				if (!exception) exception = std::current_exception();
+			}
+		}
+
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+}
+
+/**
+* Gets the pool shared by every scheduler,
+* one worker per core besides the caller
+*
+* @returns Worker pool
+*/
+ThreadPool*
+SystemScheduler::GetWorkerPool() {
+	if (!SystemScheduler::m_workerPool) {
+		uint32_t nCores = std::thread::hardware_concurrency();
+		SystemScheduler::m_workerPool = ThreadPool::CreateShared(nCores > 1 ? nCores - 1 : 1);
+	}
+
+	return SystemScheduler::m_workerPool.Get().get();
+}
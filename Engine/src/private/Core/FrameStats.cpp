@@ -0,0 +1,340 @@
+#include "Core/FrameStats.h"
+#include "Core/Logger.h"
+#include "Core/Utils/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+FrameStats* FrameStats::m_instance;
+
+/**
+* Marks the start of a frame
+*
+* @param nFrame Frame number
+*/
+void
+FrameStats::BeginFrame(uint32_t nFrame) {
+	this->m_nFrame = nFrame;
+	this->m_nFrameStart = Profiler::GetInstance()->Now();
+}
+
+/**
+* Records the frame started by BeginFrame
+*
+* @param fCPUMilliseconds CPU frame time
+* @param fGPUMilliseconds GPU frame time read back this
+* frame, 0 if there was no new reading
+*/
+void
+FrameStats::EndFrame(float fCPUMilliseconds, float fGPUMilliseconds) {
+	this->m_cpuWindow[this->m_nWindowNext] = fCPUMilliseconds;
+	this->m_gpuWindow[this->m_nWindowNext] = fGPUMilliseconds;
+
+	this->m_nWindowNext = (this->m_nWindowNext + 1) % WINDOW_SIZE;
+	this->m_nWindowCount = std::min(this->m_nWindowCount + 1, WINDOW_SIZE);
+
+	this->m_cpuRun.Add(fCPUMilliseconds);
+	this->m_gpuRun.Add(fGPUMilliseconds);
+
+	if (fCPUMilliseconds > this->m_fHitchThreshold) {
+		this->ReportHitch(fCPUMilliseconds, Profiler::GetInstance()->Now());
+	}
+}
+
+/**
+* Gets CPU frame time statistics
+*
+* @param bWholeRun True for every frame, false for the rolling window.
+* Whole run percentiles are rounded up to their histogram bin, 1% at most
+*
+* @returns CPU frame time statistics
+*/
+FrameTimeStats
+FrameStats::GetCPUStats(bool bWholeRun) const {
+	if (bWholeRun) return this->m_cpuRun.ComputeStats();
+	return FrameStats::ComputeStats(this->m_cpuWindow, this->m_nWindowCount);
+}
+
+/**
+* Gets GPU frame time statistics
+*
+* @param bWholeRun True for every frame, false for the rolling window.
+* Whole run percentiles are rounded up to their histogram bin, 1% at most
+*
+* @returns GPU frame time statistics
+*/
+FrameTimeStats
+FrameStats::GetGPUStats(bool bWholeRun) const {
+	if (bWholeRun) return this->m_gpuRun.ComputeStats();
+	return FrameStats::ComputeStats(this->m_gpuWindow, this->m_nWindowCount);
+}
+
+/**
+* Logs whole run statistics
+*/
+void
+FrameStats::LogSummary() const {
+	FrameTimeStats cpu = this->GetCPUStats(true);
+	FrameTimeStats gpu = this->GetGPUStats(true);
+
+	Logger::Info(
+		"FrameStats::LogSummary: CPU {} frames, avg {:.2f} ms, p50 {:.2f}, p95 {:.2f}, p99 {:.2f}, max {:.2f} (1% low {:.1f} FPS)",
+		cpu.nSamples, cpu.fAverage, cpu.fP50, cpu.fP95, cpu.fP99, cpu.fMax, cpu.GetLowFPS()
+	);
+
+	if (gpu.nSamples > 0) {
+		Logger::Info(
+			"FrameStats::LogSummary: GPU {} frames, avg {:.2f} ms, p50 {:.2f}, p95 {:.2f}, p99 {:.2f}, max {:.2f}",
+			gpu.nSamples, gpu.fAverage, gpu.fP50, gpu.fP95, gpu.fP99, gpu.fMax
+		);
+	}
+
+	Logger::Info("FrameStats::LogSummary: {} hitches above {:.1f} ms", this->m_nHitchCount, this->m_fHitchThreshold);
+}
+
+/**
+* Writes the whole run summary as JSON and
+* the frame time histograms as CSV next to it
+*
+* @param path JSON output path. The CSV uses the
+* same path with a .csv extension
+*
+* @returns True if both files were written
+*/
+bool
+FrameStats::WriteSummary(const String& path) const {
+	std::ofstream json(path, std::ios::trunc);
+	if (!json.is_open()) {
+		Logger::Error("FrameStats::WriteSummary: Couldn't open {}", path);
+		return false;
+	}
+
+	auto writeStats = [&json](const char* name, const FrameTimeStats& stats) {
+		json << "\"" << name << "\":{\"frames\":" << stats.nSamples
+			<< ",\"avg\":" << stats.fAverage
+			<< ",\"p50\":" << stats.fP50
+			<< ",\"p95\":" << stats.fP95
+			<< ",\"p99\":" << stats.fP99
+			<< ",\"max\":" << stats.fMax
+			<< ",\"low1Fps\":" << stats.GetLowFPS() << "}";
+	};
+
+	json << "{\"hitchThresholdMs\":" << this->m_fHitchThreshold << ",";
+	writeStats("cpu", this->GetCPUStats(true));
+	json << ",";
+	writeStats("gpu", this->GetGPUStats(true));
+	json << ",\"hitchCount\":" << this->m_nHitchCount << ",\"hitches\":[";
+
+	for (size_t i = 0; i < this->m_hitches.size(); i++) {
+		const HitchReport& hitch = this->m_hitches[i];
+
+		if (i > 0) json << ",";
+		json << "\n{\"frame\":" << hitch.nFrame << ",\"cpuMs\":" << hitch.fCPUMilliseconds << ",\"zones\":[";
+
+		for (size_t j = 0; j < hitch.zones.size(); j++) {
+			if (j > 0) json << ",";
+			json << "{\"name\":\"";
+			Profiler::WriteEscaped(json, hitch.zones[j].name);
+			json << "\",\"ms\":" << hitch.zones[j].fMilliseconds << "}";
+		}
+
+		json << "]}";
+	}
+
+	json << "\n]}\n";
+
+	/* Frames per histogram bin, empty bins left out */
+	String csvPath = std::filesystem::path(path).replace_extension(".csv").string();
+
+	std::ofstream csv(csvPath, std::ios::trunc);
+	if (!csv.is_open()) {
+		Logger::Error("FrameStats::WriteSummary: Couldn't open {}", csvPath);
+		return false;
+	}
+
+	csv << "bin_ms,cpu_frames,gpu_frames\n";
+	for (uint32_t i = 0; i < Histogram::BIN_COUNT; i++) {
+		uint32_t nCPUFrames = this->m_cpuRun.bins[i];
+		uint32_t nGPUFrames = this->m_gpuRun.bins[i];
+		if (nCPUFrames == 0 && nGPUFrames == 0) continue;
+
+		csv << Histogram::GetBinStart(i) << "," << nCPUFrames << "," << nGPUFrames << "\n";
+	}
+
+	Logger::Info("FrameStats::WriteSummary: Frame stats written to {} and {}", path, csvPath);
+	return true;
+}
+
+/**
+* Computes statistics over the rolling window
+*
+* @param times Window ring buffer, 0 entries are skipped
+* @param nCount Number of filled entries
+*
+* @returns Frame time statistics
+*/
+FrameTimeStats
+FrameStats::ComputeStats(const std::array<float, WINDOW_SIZE>& times, uint32_t nCount) {
+	FrameTimeStats stats = { };
+
+	/* Order doesn't matter, the filled entries are sorted anyway */
+	Vector<float> sorted;
+	sorted.reserve(nCount);
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		if (times[i] > 0.f) sorted.push_back(times[i]);
+	}
+
+	if (sorted.empty()) return stats;
+
+	std::sort(sorted.begin(), sorted.end());
+
+	/* Nearest rank percentile */
+	auto percentile = [&sorted](float fPercent) {
+		size_t nRank = static_cast<size_t>(fPercent / 100.f * static_cast<float>(sorted.size()) + .5f);
+		nRank = std::clamp<size_t>(nRank, 1, sorted.size());
+		return sorted[nRank - 1];
+	};
+
+	double fSum = 0.0;
+	for (float fTime : sorted) fSum += fTime;
+
+	stats.nSamples = static_cast<uint32_t>(sorted.size());
+	stats.fAverage = static_cast<float>(fSum / sorted.size());
+	stats.fP50 = percentile(50.f);
+	stats.fP95 = percentile(95.f);
+	stats.fP99 = percentile(99.f);
+	stats.fMax = sorted.back();
+
+	return stats;
+}
+
+/**
+* Adds a frame time to the histogram
+*
+* @param fMilliseconds Frame time, 0 is skipped
+*/
+void
+FrameStats::Histogram::Add(float fMilliseconds) {
+	if (fMilliseconds <= 0.f) return;
+
+	double fBin = std::log(static_cast<double>(fMilliseconds) / BIN_MIN) / std::log(BIN_GROWTH);
+	uint32_t nBin = static_cast<uint32_t>(std::clamp(fBin, 0.0, static_cast<double>(BIN_COUNT - 1)));
+	this->bins[nBin]++;
+
+	this->nSamples++;
+	this->fSum += fMilliseconds;
+	this->fMax = std::max(this->fMax, fMilliseconds);
+}
+
+/**
+* Gets the shortest frame time of a bin
+*
+* @param nBin Bin index
+*
+* @returns Bin start in milliseconds
+*/
+float
+FrameStats::Histogram::GetBinStart(uint32_t nBin) {
+	return static_cast<float>(BIN_MIN * std::pow(BIN_GROWTH, static_cast<double>(nBin)));
+}
+
+/**
+* Computes statistics over the histogram. Percentiles
+* are the upper edge of the bin holding the nearest
+* rank, capped at the longest frame. The last bin
+* has no upper edge, its percentiles are the
+* longest frame
+*
+* @returns Frame time statistics
+*/
+FrameTimeStats
+FrameStats::Histogram::ComputeStats() const {
+	FrameTimeStats stats = { };
+	if (this->nSamples == 0) return stats;
+
+	auto percentile = [this](float fPercent) {
+		uint32_t nRank = static_cast<uint32_t>(fPercent / 100.f * static_cast<float>(this->nSamples) + .5f);
+		nRank = std::clamp<uint32_t>(nRank, 1, this->nSamples);
+
+		uint32_t nSeen = 0;
+		for (uint32_t i = 0; i < BIN_COUNT; i++) {
+			nSeen += this->bins[i];
+			if (nSeen >= nRank) {
+				if (i + 1 == BIN_COUNT) return this->fMax;
+				return std::min(GetBinStart(i + 1), this->fMax);
+			}
+		}
+
+		return this->fMax;
+	};
+
+	stats.nSamples = this->nSamples;
+	stats.fAverage = static_cast<float>(this->fSum / this->nSamples);
+	stats.fP50 = percentile(50.f);
+	stats.fP95 = percentile(95.f);
+	stats.fP99 = percentile(99.f);
+	stats.fMax = this->fMax;
+
+	return stats;
+}
+
+/**
+* Records a hitch with the longest profiler
+* zones that ran during the frame
+*
+* @param fCPUMilliseconds Frame time
+* @param nFrameEnd Frame end (profiler time)
+*/
+void
+FrameStats::ReportHitch(float fCPUMilliseconds, uint64_t nFrameEnd) {
+	this->m_nHitchCount++;
+
+	Logger::Warn("FrameStats::ReportHitch: Frame {} took {:.2f} ms", this->m_nFrame, fCPUMilliseconds);
+
+	if (this->m_hitches.size() >= MAX_HITCH_REPORTS) return;
+
+	HitchReport report = { };
+	report.nFrame = this->m_nFrame;
+	report.fCPUMilliseconds = fCPUMilliseconds;
+
+	Profiler* pProfiler = Profiler::GetInstance();
+	if (pProfiler->IsCapturing()) {
+		Vector<ProfileZone> zones;
+		pProfiler->GetZones(this->m_nFrameStart, nFrameEnd, zones);
+
+		/* Time of each zone name inside the frame */
+		HashMap<const char*, uint64_t> zoneTimes;
+		for (const ProfileZone& zone : zones) {
+			uint64_t nStart = std::max(zone.nStart, this->m_nFrameStart);
+			uint64_t nEnd = std::min(zone.nEnd, nFrameEnd);
+
+			if (nEnd > nStart) zoneTimes[zone.name] += nEnd - nStart;
+		}
+
+		for (auto& [name, nTime] : zoneTimes) {
+			report.zones.push_back({ name, static_cast<float>(nTime) / 1000000.f });
+		}
+
+		std::sort(report.zones.begin(), report.zones.end(), [](const HitchZone& a, const HitchZone& b) {
+			return a.fMilliseconds > b.fMilliseconds;
+		});
+
+		if (report.zones.size() > MAX_HITCH_ZONES) {
+			report.zones.resize(MAX_HITCH_ZONES);
+		}
+	}
+
+	this->m_hitches.push_back(std::move(report));
+}
+
+FrameStats*
+FrameStats::GetInstance() {
+	if (FrameStats::m_instance == nullptr) {
+		FrameStats::m_instance = new FrameStats();
+	}
+
+	return FrameStats::m_instance;
+}
@@ -3,10 +3,57 @@
 #include "Core/Renderer/Vulkan/VulkanRenderer.h"
 
 #include "Core/Resources/AssetManager.h"
+#include "Core/Renderer/MeshUploadQueue.h"
+#include "Core/Renderer/MeshRegistry.h"
 
 #include <stb/stb_image.h>
 
-Mesh::Mesh(String name) : Component::Component(name) { }
+Mesh::Mesh(String name) : Component::Component(name), m_meshData(CreateRef<MeshData>()) { }
+
+Mesh::~Mesh() {
+	this->ReleaseMeshData();
+}
+
+/**
+* Takes over the mesh data and registry
+* user of another component
+* 
+* @param other Component moved from, left without data
+*/
+Mesh::Mesh(Mesh&& other) noexcept
+	: Component::Component(std::move(other)),
+	m_meshData(std::move(other.m_meshData)),
+	m_meshHandle(other.m_meshHandle),
+	m_bShared(other.m_bShared) {
+	other.m_meshData = nullptr;
+	other.m_bShared = false;
+}
+
+/**
+* Lets go of the current mesh data and takes
+* over the data and registry user of another
+* component
+* 
+* @param other Component moved from, left without data
+* 
+* @returns This component
+*/
+Mesh&
+Mesh::operator=(Mesh&& other) {
+	if (this == &other) return *this;
+
+	this->ReleaseMeshData();
+
+	Component::operator=(std::move(other));
+	this->m_meshData = std::move(other.m_meshData);
+	this->m_meshHandle = other.m_meshHandle;
+	this->m_bShared = other.m_bShared;
+
+	other.m_meshData = nullptr;
+	other.m_bShared = false;
+
+	return *this;
+}
 
 void 
 Mesh::Start() {
@@ -19,28 +66,130 @@ Mesh::Update() {
 }
 
 /**
-* Load mesh asset
+* Load mesh asset. The data comes from the mesh
+* registry, decoded once and shared with every
+* other component using the asset
 * 
 * @param handle Mesh asset handle
+* @param bQueueUpload False when the caller queues shared data once itself
 * 
 * @returns True if success
 */
 bool 
-Mesh::LoadAsset(const AssetHandle& handle) {
-	if (this->m_meshData.bLoaded) {
+Mesh::LoadAsset(const AssetHandle& handle, bool bQueueUpload) {
+	if (this->m_meshData->bLoaded) {
 		Logger::Error("Mesh::LoadAsset: Mesh already loaded");
 		return false;
 	}
 
 	this->m_meshHandle = handle;
 
+	MeshRegistry* pRegistry = MeshRegistry::GetInstance();
+
+	Ref<MeshData> meshData = pRegistry->Acquire(handle);
+	if (meshData == nullptr) return false;
+
+	if (!this->SetMeshData(handle, meshData, bQueueUpload)) {
+		pRegistry->Release(handle);
+		return false;
+	}
+
+	this->m_bShared = true;
+	return true;
+}
+
+/**
+* Lets go of the mesh data. Shared data is freed,
+* GPU copy included, once its last user let go.
+* Data set directly is only owned by this
+* component and goes right away. Destroying
+* the component does the same, and unlike
+* unloading in place also takes the object
+* out of its scene's BVH
+*/
+void
+Mesh::Unload() {
+	if (!this->m_meshData || !this->m_meshData->bLoaded) return;
+
+	this->ReleaseMeshData();
+
+	this->m_meshData = CreateRef<MeshData>();
+	this->m_bShared = false;
+}
+
+/**
+* Releases the registry user, or the upload
+* and GPU copy of data owned by this component.
+* The data itself stays referenced
+*/
+void
+Mesh::ReleaseMeshData() {
+	if (!this->m_meshData || !this->m_meshData->bLoaded) return;
+
+	if (this->m_bShared) {
+		MeshRegistry::GetInstance()->Release(this->m_meshHandle);
+	}
+	else {
+		MeshUploadQueue* pUploadQueue = MeshUploadQueue::GetInstance();
+		pUploadQueue->Remove(this->m_meshData.Get().get());
+		pUploadQueue->Release(this->m_meshData->name);
+	}
+}
+
+/**
+* Sets mesh data loaded elsewhere and queues its
+* upload. The component owns it, shared data
+* goes through LoadAsset()
+* 
+* @param handle Mesh asset handle the data came from
+* @param meshData Loaded mesh data
+* @param bQueueUpload False when the caller queues shared data once itself
+* 
+* @returns True if success
+*/
+bool
+Mesh::SetMeshData(const AssetHandle& handle, const Ref<MeshData>& meshData, bool bQueueUpload) {
+	if (this->m_meshData->bLoaded) {
+		Logger::Error("Mesh::SetMeshData: Mesh already loaded");
+		return false;
+	}
+
+	if (meshData == nullptr || !meshData->bLoaded) {
+		Logger::Error("Mesh::SetMeshData: Mesh data not loaded");
+		return false;
+	}
+
+	this->m_meshHandle = handle;
+	this->m_meshData = meshData;
+
+	/* Let the renderer pick it up on the next frame */
+	if (bQueueUpload) {
+		MeshUploadQueue::GetInstance()->Push(this->m_meshData);
+	}
+
+	return true;
+}
+
+/**
+* Decodes a mesh asset and its textures. Doesn't
+* touch any component, safe to call from worker
+* threads
+* 
+* @param handle Mesh asset handle
+* 
+* @returns Loaded mesh data, nullptr on failure
+*/
+Ref<MeshData>
+Mesh::LoadMeshData(const AssetHandle& handle) {
 	AssetManager* assetMgr = AssetManager::GetInstance();
 	const AssetVariant& assetVariant = assetMgr->GetAsset(handle);
 	if (assetVariant.valueless_by_exception()) {
-		Logger::Error("Mesh::LoadAsset: Invalid asset given");
-		return false;
+		Logger::Error("Mesh::LoadMeshData: Invalid asset given");
+		return nullptr;
 	}
 
+	Ref<MeshData> meshData = CreateRef<MeshData>();
+
 
 	const MeshAsset& meshAsset = std::get<MeshAsset>(assetVariant);
 
@@ -63,18 +212,18 @@ Mesh::LoadAsset(const AssetHandle& handle) {
 
 		/* Check if there's any mismatch with the size */
 		if ((nVertexSize + nIndexSize) != nTotalByteSize) {
-			Logger::Error("Mesh::LoadAsset: Size mismatch. Expected {} got {}", 
+			Logger::Error("Mesh::LoadMeshData: Size mismatch. Expected {} got {}", 
 				nTotalByteSize, nVertexSize + nIndexSize
 			);
 
-			return false;
+			return nullptr;
 		}
 
 		/* Check Vertex size is the same as in vertex stride */
 		if (sizeof(Vertex) != nVertexStride) {
-			Logger::Error("Mesh::LoadAsset: Stride mismatch. Expected {} got {}", sizeof(Vertex), nVertexStride);
+			Logger::Error("Mesh::LoadMeshData: Stride mismatch. Expected {} got {}", sizeof(Vertex), nVertexStride);
 			/* TODO: Handle asset update */
-			return false;
+			return nullptr;
 		}
 
 		Vector<Vertex> vertices(nVertexCount);
@@ -95,13 +244,13 @@ Mesh::LoadAsset(const AssetHandle& handle) {
 			const AssetVariant& materialVariant = assetMgr->GetAsset(materialHandle);
 
 			if (materialVariant.valueless_by_exception()) {
-				Logger::Error("Mesh::LoadAsset: Invalid material");
+				Logger::Error("Mesh::LoadMeshData: Invalid material");
 				continue;
 			}
 
 			const MaterialAsset& materialAsset = std::get<MaterialAsset>(materialVariant);
 
-			material = this->ProcessMaterial(materialAsset);
+			material = Mesh::ProcessMaterial(materialAsset);
 		}
 
 		/* Get material asset handles */
@@ -140,6 +289,12 @@ Mesh::LoadAsset(const AssetHandle& handle) {
 		
 		/* Prepare SubMesh data */
 		SubMeshData subData = { };
+
+		for (const Vertex& vertex : vertices) {
+			subData.bounds.Expand(vertex.position);
+		}
+		meshData->bounds.Expand(subData.bounds);
+
 		subData.vertices = std::move(vertices);
 		subData.indices = std::move(indices);
 
@@ -155,31 +310,15 @@ Mesh::LoadAsset(const AssetHandle& handle) {
 		subData.emissive = emissiveData;
 		subData.normal = normalData;
 
-		this->m_meshData.subMeshes[i] = std::move(subData);
+		meshData->subMeshes[i] = std::move(subData);
 	}
 
-	this->m_meshData.name = meshAsset.header.displayName;
-
-	this->m_meshData.bLoaded = true;
+	meshData->name = meshAsset.header.displayName;
+	meshData->assetHandle = handle;
 
-	return true;
-}
+	meshData->bLoaded = true;
 
-/**
-* Clear mesh texture data
-*/
-void 
-Mesh::ClearTextureData() {
-	for (auto& [idx, sub] : this->m_meshData.subMeshes) {
-		sub.albedo.data.clear();
-		sub.albedo.data.shrink_to_fit();
-		sub.orm.data.clear();
-		sub.orm.data.shrink_to_fit();
-		sub.emissive.data.clear();
-		sub.emissive.data.shrink_to_fit();
-		sub.normal.data.clear();
-		sub.normal.data.shrink_to_fit();
-	}
+	return meshData;
 }
 
 /**
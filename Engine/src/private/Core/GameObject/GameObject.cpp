@@ -1,53 +1,70 @@
 #include "Core/GameObject/GameObject.h"
 #include "Core/Resources/AssetManager.h"
 
-GameObject::GameObject(String name) {
-	this->m_name = name;
+GameObject::GameObject(String name, Registry* pRegistry) 
+	: m_name(name), m_pRegistry(pRegistry) {
+	this->m_handle = this->m_pRegistry->CreateEntity();
 
-	this->transform = { };
-	this->transform.location = { 0.f, 0.f, 0.f };
-	this->transform.rotation = { 0.f, 0.f, 0.f };
-	this->transform.scale = { 1.f, 1.f, 1.f };
+	Transform& transform = this->m_pRegistry->Add<Transform>(this->m_handle.nIndex);
+	transform.location = { 0.f, 0.f, 0.f };
+	transform.rotation = { 0.f, 0.f, 0.f };
+	transform.scale = { 1.f, 1.f, 1.f };
+
+	this->m_pRegistry->Add<WorldTransform>(this->m_handle.nIndex);
 }
 
-String 
-GameObject::GetName() {
-	return this->m_name;
+GameObject::~GameObject() {
+	this->m_pRegistry->DestroyEntity(this->m_handle);
 }
 
-void 
-GameObject::Start() {
-	for (std::pair<String, Component*> component : this->m_components) {
-		component.second->Start();
-	}
+String 
+GameObject::GetName() {
+	return this->m_name.string();
 }
 
-void 
-GameObject::Update() {
-	for (std::pair<String, Component*> component : this->m_components) {
-		component.second->Update();
-	}
+/**
+* Gets the object transform for writing. Marks
+* it dirty, so its world matrix is recomputed
+* 
+* @returns Transform, valid until another transform is added or removed
+*/
+Transform&
+GameObject::GetTransform() {
+	this->MarkTransformDirty();
+	return *this->m_pRegistry->Get<Transform>(this->m_handle.nIndex);
 }
 
-Map<String, Component*> 
-GameObject::GetComponents() {
-	return this->m_components;
+/**
+* Gets the object transform
+* 
+* @returns Transform, valid until another transform is added or removed
+*/
+const Transform&
+GameObject::GetTransform() const {
+	return *this->m_pRegistry->Get<Transform>(this->m_handle.nIndex);
 }
 
-void 
-GameObject::AddComponent(String name, Component* component) {
-	this->m_components[name] = component;
+/**
+* Flags the cached matrices for recomputation.
+* Children follow on the next transform update
+*/
+void
+GameObject::MarkTransformDirty() {
+	WorldTransform* pWorldTransform = this->m_pRegistry->Get<WorldTransform>(this->m_handle.nIndex);
+	if (pWorldTransform != nullptr) {
+		pWorldTransform->bDirty = true;
+	}
 }
 
 void 
 GameObject::SetupFromAsset(const GameObjectAsset& asset) {
 	AssetManager* assetManager = AssetManager::GetInstance();
 
+	this->GetTransform() = asset.transform;
+
 	/* Handle mesh component */
 	if (asset.HasComponent(EAssetComponent::MESH)) {
-		Mesh* pMeshComponent = new Mesh("MeshComponent");
-		pMeshComponent->LoadAsset(asset.meshHandle);
-
-		this->AddComponent("MeshComponent", pMeshComponent);
+		Mesh& meshComponent = this->AddComponent<Mesh>("MeshComponent");
+		meshComponent.LoadAsset(asset.meshHandle);
 	}
-}
\ No newline at end of file
+}
@@ -10,35 +10,63 @@ Input::Input() {
 	this->m_pWindow = nullptr;
 }
 
+/**
+* Requests the cursor visibility. GLFW may only be
+* called from the main thread, so the request is
+* applied by the next Poll
+* 
+* @param bShow True to show the cursor
+*/
 void 
 Input::ShowCursor(bool bShow) {
-	if (!bShow) {
-		/* Disable cursor */
+	this->m_bCursorVisible = bShow;
+}
+
+/**
+* Applies the cursor visibility and samples the
+* mouse delta while the cursor is captured.
+* Called from the main thread after polling events
+*/
+void
+Input::Poll() {
+	/* Nothing to do without a window (headless) */
+	if (this->m_pWindow == nullptr) {
+		return;
+	}
+
+	if (this->m_bCursorVisible) {
+		if (!this->m_bCursorShown) {
+			glfwSetInputMode(this->m_pWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+			this->m_bCursorShown = true;
+		}
+		return;
+	}
+
+	/* Disable cursor */
+	if (this->m_bCursorShown) {
 		glfwSetInputMode(this->m_pWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		this->m_bCursorShown = false;
+	}
 
-		/* Get window size */
-		int nWidth = 0; 
-		int nHeight = 0;;
-		glfwGetWindowSize(this->m_pWindow, &nWidth, &nHeight);
+	/* Get window size */
+	int nWidth = 0; 
+	int nHeight = 0;
+	glfwGetWindowSize(this->m_pWindow, &nWidth, &nHeight);
 
-		/* Calculate center position */
-		this->centerX = static_cast<float>(nWidth / 2);
-		this->centerY = static_cast<float>(nHeight / 2);
+	/* Calculate center position */
+	this->centerX = static_cast<float>(nWidth / 2);
+	this->centerY = static_cast<float>(nHeight / 2);
 
-		/* Get actual cursor position */
-		double posX, posY = 0.f;
-		glfwGetCursorPos(this->m_pWindow, &posX, &posY);
+	/* Get actual cursor position */
+	double posX, posY = 0.f;
+	glfwGetCursorPos(this->m_pWindow, &posX, &posY);
 
-		/* Calculate delta */
-		this->deltaX = this->centerX - static_cast<float>(posX);
-		this->deltaY = this->centerY - static_cast<float>(posY);
+	/* Calculate delta */
+	this->deltaX = this->centerX - static_cast<float>(posX);
+	this->deltaY = this->centerY - static_cast<float>(posY);
 
-		/* Move cursor to the center */
-		glfwSetCursorPos(this->m_pWindow, this->centerX, this->centerY);
-	}
-	else {
-		glfwSetInputMode(this->m_pWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-	}
+	/* Move cursor to the center */
+	glfwSetCursorPos(this->m_pWindow, this->centerX, this->centerY);
 }
 
 void 
@@ -0,0 +1,68 @@
+#include "Core/Renderer/DrawSortKey.h"
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+/**
+* Buckets a view depth logarithmically, near
+* draws get finer buckets than far ones. The
+* coarse buckets keep the order stable while
+* the camera moves a little
+*
+* @param fDepth View space depth, negative is behind
+*
+* @returns Depth bucket, 0 is nearest
+*/
+uint32_t
+DrawSortKey::QuantizeDepth(float fDepth) {
+	if (!(fDepth > 0.f)) return 0;
+
+	float fBucket = std::log2(1.f + fDepth) * 64.f;
+	return static_cast<uint32_t>(std::min(fBucket, static_cast<float>(DEPTH_MASK)));
+}
+
+/**
+* Stable LSD radix sort by key, 8 bits a pass.
+* Passes where every key has the same digit are
+* skipped, most keys only differ in a few bytes
+*
+* @param items Draws to sort, sorted on return
+* @param scratch Scratch buffer, reused between calls
+*/
+void
+RadixSortDraws(Vector<DrawSortItem>& items, Vector<DrawSortItem>& scratch) {
+	size_t nCount = items.size();
+	if (nCount < 2) return;
+
+	scratch.resize(nCount);
+
+	/* Every digit's histogram in one read */
+	std::array<std::array<uint32_t, 256>, 8> histograms = { };
+	for (const DrawSortItem& item : items) {
+		for (uint32_t nPass = 0; nPass < 8; nPass++) {
+			histograms[nPass][(item.nKey >> (nPass * 8)) & 0xFF]++;
+		}
+	}
+
+	for (uint32_t nPass = 0; nPass < 8; nPass++) {
+		std::array<uint32_t, 256>& histogram = histograms[nPass];
+
+		uint32_t nShift = nPass * 8;
+		uint32_t nDigit = (items[0].nKey >> nShift) & 0xFF;
+		if (histogram[nDigit] == nCount) continue;
+
+		uint32_t nOffset = 0;
+		for (uint32_t& nBucket : histogram) {
+			uint32_t nSize = nBucket;
+			nBucket = nOffset;
+			nOffset += nSize;
+		}
+
+		for (const DrawSortItem& item : items) {
+			scratch[histogram[(item.nKey >> nShift) & 0xFF]++] = item;
+		}
+
+		items.swap(scratch);
+	}
+}
@@ -0,0 +1,267 @@
+#include "Core/Renderer/MeshRegistry.h"
+#include "Core/Renderer/MeshData.h"
+#include "Core/Renderer/MeshUploadQueue.h"
+#include "Core/GameObject/Components/Mesh.h"
+#include "Core/Resources/AssetManager.h"
+#include "Core/Logger.h"
+
+MeshRegistry* MeshRegistry::m_instance;
+
+/**
+* Gets the shared data of a mesh asset and adds
+* a user to it. The first user decodes it, out
+* of the lock so streaming threads decode in
+* parallel. When two race for the same mesh,
+* the first one registered wins
+*
+* @param handle Mesh asset handle
+* @param pnResidentBytes Set to the memory the mesh keeps once uploaded, 0 on
+* failure. Its GPU copy, plus the CPU geometry the residency policy keeps
+*
+* @returns Shared mesh data, nullptr on failure
+*/
+Ref<MeshData>
+MeshRegistry::Acquire(const AssetHandle& handle, uint64_t* pnResidentBytes) {
+	if (pnResidentBytes != nullptr) {
+		*pnResidentBytes = 0;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		auto it = this->m_meshes.find(handle.uuid);
+		if (it != this->m_meshes.end()) {
+			it->second.nUsers++;
+
+			if (pnResidentBytes != nullptr) {
+				*pnResidentBytes = it->second.nResidentBytes;
+			}
+
+			return it->second.meshData;
+		}
+	}
+
+	Ref<MeshData> meshData = this->Decode(handle);
+	if (meshData == nullptr) return nullptr;
+
+	/* Measured before it's shared, the frame loop frees CPU copies once uploaded */
+	uint64_t nGPUBytes = meshData->GetByteSize();
+	uint64_t nGeometryBytes = meshData->GetGeometryByteSize();
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	/* Charged once per mesh, refunded when its last user lets go */
+	Entry& entry = this->m_meshes[handle.uuid];
+	if (entry.meshData == nullptr) {
+		entry.meshData = meshData;
+		entry.nResidentBytes = nGPUBytes + (this->m_policy.bKeepGeometry ? nGeometryBytes : 0);
+
+		this->m_nResidentBytes += entry.nResidentBytes;
+	}
+	entry.nUsers++;
+
+	if (pnResidentBytes != nullptr) {
+		*pnResidentBytes = entry.nResidentBytes;
+	}
+
+	return entry.meshData;
+}
+
+/**
+* Removes a user of a mesh. The last one drops
+* the CPU copy and queues the GPU copy for
+* release, a pending upload is cancelled
+*
+* @param handle Mesh asset handle
+*/
+void
+MeshRegistry::Release(const AssetHandle& handle) {
+	Ref<MeshData> meshData;
+
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		auto it = this->m_meshes.find(handle.uuid);
+		if (it == this->m_meshes.end()) {
+			Logger::Warn("MeshRegistry::Release: Mesh {} has no users", handle.uuid);
+			return;
+		}
+
+		if (--it->second.nUsers > 0) return;
+
+		meshData = it->second.meshData;
+		this->m_nResidentBytes -= it->second.nResidentBytes;
+		this->m_meshes.erase(it);
+	}
+
+	MeshUploadQueue* pUploadQueue = MeshUploadQueue::GetInstance();
+	pUploadQueue->Remove(meshData.Get().get());
+	pUploadQueue->Release(meshData->name);
+}
+
+/**
+* Gets the number of users of a mesh
+*
+* @param handle Mesh asset handle
+*
+* @returns User count, 0 if not resident
+*/
+uint32_t
+MeshRegistry::GetUserCount(const AssetHandle& handle) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	auto it = this->m_meshes.find(handle.uuid);
+	return it != this->m_meshes.end() ? it->second.nUsers : 0;
+}
+
+/**
+* Gets the number of resident meshes
+*
+* @returns Mesh count
+*/
+uint32_t
+MeshRegistry::GetMeshCount() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	return static_cast<uint32_t>(this->m_meshes.size());
+}
+
+/**
+* Gets the memory every resident mesh keeps once
+* uploaded, each counted once however many
+* users share it
+*
+* @returns Size in bytes
+*/
+uint64_t
+MeshRegistry::GetResidentBytes() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_nResidentBytes;
+}
+
+/**
+* Sets what stays in CPU memory after upload,
+* for meshes uploaded from now on
+*
+* @param policy Residency policy
+*/
+void
+MeshRegistry::SetResidencyPolicy(const MeshResidencyPolicy& policy) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_policy = policy;
+}
+
+MeshResidencyPolicy
+MeshRegistry::GetResidencyPolicy() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_policy;
+}
+
+/**
+* Drops the CPU copies of a mesh now on the GPU.
+* Textures always go, geometry unless the policy
+* keeps it
+*
+* @param meshData Uploaded mesh data
+*/
+void
+MeshRegistry::OnUploaded(MeshData& meshData) {
+	bool bKeepGeometry = this->GetResidencyPolicy().bKeepGeometry;
+
+	meshData.ClearTextureData();
+
+	if (!bKeepGeometry) {
+		meshData.ClearGeometryData();
+	}
+}
+
+/**
+* Reads the CPU copies of a mesh back from its
+* asset, the ones the residency policy dropped.
+* Bounds and materials don't change
+*
+* @param meshData Mesh data, refilled in place
+*
+* @returns True if geometry and textures are resident
+*/
+bool
+MeshRegistry::Reload(MeshData& meshData) {
+	if (meshData.bGeometryResident && meshData.bTexturesResident) return true;
+
+	if (!meshData.assetHandle.IsValid()) {
+		Logger::Error("MeshRegistry::Reload: {} wasn't decoded from an asset", meshData.name);
+		return false;
+	}
+
+	Ref<MeshData> reloaded = this->Decode(meshData.assetHandle);
+	if (reloaded == nullptr) {
+		Logger::Error("MeshRegistry::Reload: Failed reading {} back", meshData.name);
+		return false;
+	}
+
+	for (auto& [idx, sub] : reloaded->subMeshes) {
+		auto it = meshData.subMeshes.find(idx);
+		if (it == meshData.subMeshes.end()) continue;
+
+		SubMeshData& resident = it->second;
+
+		if (!meshData.bGeometryResident) {
+			resident.vertices = std::move(sub.vertices);
+			resident.indices = std::move(sub.indices);
+		}
+
+		if (!meshData.bTexturesResident) {
+			resident.albedo = std::move(sub.albedo);
+			resident.orm = std::move(sub.orm);
+			resident.emissive = std::move(sub.emissive);
+			resident.normal = std::move(sub.normal);
+		}
+	}
+
+	meshData.bGeometryResident = true;
+	meshData.bTexturesResident = true;
+
+	Logger::Debug("MeshRegistry::Reload: {} read back", meshData.name);
+	return true;
+}
+
+/**
+* Decodes a mesh asset. Unless the policy keeps
+* them, the source asset leaves the asset cache
+* once no other decode of it is running, under
+* the lock so no decode holds a reference to it
+*
+* @param handle Mesh asset handle
+*
+* @returns Decoded mesh data, nullptr on failure
+*/
+Ref<MeshData>
+MeshRegistry::Decode(const AssetHandle& handle) {
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_decoding[handle.uuid]++;
+	}
+
+	Ref<MeshData> meshData = Mesh::LoadMeshData(handle);
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	auto it = this->m_decoding.find(handle.uuid);
+	if (--it->second == 0) {
+		this->m_decoding.erase(it);
+
+		if (!this->m_policy.bKeepAssets) {
+			AssetManager::GetInstance()->UnloadAsset(handle);
+		}
+	}
+
+	return meshData;
+}
+
+MeshRegistry*
+MeshRegistry::GetInstance() {
+	if (MeshRegistry::m_instance == nullptr) {
+		MeshRegistry::m_instance = new MeshRegistry();
+	}
+
+	return MeshRegistry::m_instance;
+}
@@ -0,0 +1,109 @@
+#include "Core/Renderer/MeshUploadQueue.h"
+#include "Core/Renderer/MeshData.h"
+
+#include <algorithm>
+
+MeshUploadQueue* MeshUploadQueue::m_instance;
+
+/**
+* Queues a mesh for upload. A mesh already
+* in the queue is not added twice
+*
+* @param meshData Loaded mesh data
+*/
+void
+MeshUploadQueue::Push(const Ref<MeshData>& meshData) {
+	if (!meshData) return;
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	if (!this->m_queued.insert(meshData.Get().get()).second) return;
+
+	this->m_pending.push_back(meshData);
+}
+
+/**
+* Removes a mesh from the queue, used
+* when its owner is destroyed before
+* the upload happened
+*
+* @param pMeshData Mesh data
+*/
+void
+MeshUploadQueue::Remove(const MeshData* pMeshData) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	if (this->m_queued.erase(pMeshData) == 0) return;
+
+	this->m_pending.erase(
+		std::remove_if(
+			this->m_pending.begin(),
+			this->m_pending.end(),
+			[pMeshData](const Ref<MeshData>& meshData) { return meshData.Get().get() == pMeshData; }
+		),
+		this->m_pending.end()
+	);
+}
+
+/**
+* Takes every queued mesh
+*
+* @returns Queued meshes in push order
+*/
+Vector<Ref<MeshData>>
+MeshUploadQueue::Drain() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	Vector<Ref<MeshData>> pending;
+	pending.swap(this->m_pending);
+	this->m_queued.clear();
+
+	return pending;
+}
+
+/**
+* Queues the GPU mesh of that name
+* for release
+*
+* @param name Mesh name
+*/
+void
+MeshUploadQueue::Release(const String& name) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_releases.push_back(name);
+}
+
+/**
+* Takes every queued release
+*
+* @returns Mesh names in release order
+*/
+Vector<String>
+MeshUploadQueue::DrainReleases() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	Vector<String> releases;
+	releases.swap(this->m_releases);
+
+	return releases;
+}
+
+/**
+* Checks if there are meshes waiting
+*
+* @returns True if the queue is empty
+*/
+bool
+MeshUploadQueue::IsEmpty() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_pending.empty();
+}
+
+MeshUploadQueue*
+MeshUploadQueue::GetInstance() {
+	if (MeshUploadQueue::m_instance == nullptr) {
+		MeshUploadQueue::m_instance = new MeshUploadQueue();
+	}
+
+	return MeshUploadQueue::m_instance;
+}
@@ -1,4 +1,5 @@
 #include "Core/Renderer/MeshUploader.h"
+#include "Core/Utils/Profiler.h"
 #include <stb/stb_image.h>
 #include <xxhash.h>
 
@@ -24,6 +25,8 @@ MeshUploader::Init(
 
 UploadedMesh
 MeshUploader::Upload(const MeshData& meshData) {
+	PROFILE_SCOPE("MeshUploader::Upload");
+
 	UploadedMesh result = { };
 
 	for (auto& [idx, subData] : meshData.subMeshes) {
@@ -74,6 +77,8 @@ MeshUploader::Upload(const MeshData& meshData) {
 */
 uint32_t 
 MeshUploader::QueueTextureUpload(const TextureData& textureData) {
+	PROFILE_SCOPE("MeshUploader::QueueTextureUpload");
+
 	/* Check if texture has name and data */
 	if (textureData.name.empty() || textureData.data.empty()) {
 		return UINT32_MAX;
@@ -161,6 +166,8 @@ MeshUploader::QueueTextureUpload(const TextureData& textureData) {
 */
 void
 MeshUploader::FinalizeUploads() {
+	PROFILE_SCOPE("MeshUploader::FinalizeUploads");
+
 	for (PendingTextureUpload& pendingTexture : this->m_pendingTextureUploads) {
 		if (pendingTexture.future.valid()) {
 			Ref<GPUTexture> texture = pendingTexture.future.get();
@@ -0,0 +1,62 @@
+#include "Core/Renderer/Null/NullBuffer.h"
+#include "Core/Renderer/Null/NullDevice.h"
+
+NullBuffer::NullBuffer(Ref<NullDevice> device) : m_device(device) {}
+
+/**
+* Creates a null buffer
+*
+* @param createInfo Buffer create info
+* @param debugName Unused
+*/
+void
+NullBuffer::Create(const BufferCreateInfo& createInfo, const String& debugName) {
+	this->m_nSize = createInfo.nSize;
+	this->m_bufferType = createInfo.type;
+	this->m_bufferUsage = createInfo.usage;
+
+	this->m_device->RecordBufferCreated(this->m_nSize);
+
+	/* Initial data goes through a staging copy on a real device */
+	if (createInfo.pcData != nullptr && createInfo.nSize > 0) {
+		this->m_device->RecordUpload(this->m_nSize);
+	}
+}
+
+/**
+* Maps the buffer into host memory
+*
+* @returns Pointer to the buffer contents
+*/
+void*
+NullBuffer::Map() {
+	if (this->m_data.size() != this->m_nSize) {
+		this->m_data.resize(this->m_nSize);
+	}
+
+	return this->m_data.data();
+}
+
+/**
+* Unmaps the buffer. Memory stays allocated
+* so persistent mappings remain valid
+*/
+void
+NullBuffer::Unmap() {}
+
+/**
+* Copies a buffer into this one
+*
+* @param srcBuff Source buffer
+* @param nSize Size of the copy
+* @param nOffset Destination offset
+*/
+void
+NullBuffer::CopyBuffer(Ref<GPUBuffer> srcBuff, uint32_t nSize, uint32_t nOffset) {
+	if (static_cast<uint64_t>(nOffset) + nSize > this->m_nSize) {
+		Logger::Error("NullBuffer::CopyBuffer: Copy of {} bytes at offset {} overflows buffer of {} bytes", nSize, nOffset, this->m_nSize);
+		throw std::runtime_error("NullBuffer::CopyBuffer: Copy out of bounds");
+	}
+
+	this->m_device->RecordUpload(nSize);
+}
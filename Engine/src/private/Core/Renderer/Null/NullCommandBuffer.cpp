@@ -0,0 +1,67 @@
+#include "Core/Renderer/Null/NullCommandBuffer.h"
+
+/**
+* Adds another command stream to this one
+*
+* @param other Stats to add
+*/
+void
+NullCommandStats::Accumulate(const NullCommandStats& other) {
+	this->nDraws += other.nDraws;
+	this->nIndexedDraws += other.nIndexedDraws;
+	this->nIndirectDraws += other.nIndirectDraws;
+	this->nMaxIndirectDrawCount += other.nMaxIndirectDrawCount;
+	this->nVertices += other.nVertices;
+
+	this->nDispatches += other.nDispatches;
+	this->nDispatchGroups += other.nDispatchGroups;
+
+	this->nBufferBarriers += other.nBufferBarriers;
+	this->nImageBarriers += other.nImageBarriers;
+	this->nGlobalBarriers += other.nGlobalBarriers;
+
+	this->nRenderPasses += other.nRenderPasses;
+	this->nSubpasses += other.nSubpasses;
+
+	this->nPipelineBinds += other.nPipelineBinds;
+	this->nDescriptorSetBinds += other.nDescriptorSetBinds;
+	this->nVertexBufferBinds += other.nVertexBufferBinds;
+	this->nIndexBufferBinds += other.nIndexBufferBinds;
+
+	this->nPushConstantBytes += other.nPushConstantBytes;
+	this->nFilledBytes += other.nFilledBytes;
+}
+
+/**
+* Begins recording. Like a Vulkan command buffer
+* allocated from a resettable pool, beginning
+* implicitly resets it
+*
+* @param bSingleTime Unused
+*/
+void
+NullCommandBuffer::Begin(bool bSingleTime) {
+	this->m_stats = { };
+	this->m_bRecording = true;
+}
+
+/**
+* Ends recording
+*/
+void
+NullCommandBuffer::End() {
+	if (!this->m_bRecording) {
+		Logger::Warn("NullCommandBuffer::End: Command buffer was not recording");
+	}
+
+	this->m_bRecording = false;
+}
+
+/**
+* Resets the recorded commands
+*/
+void
+NullCommandBuffer::Reset() {
+	this->m_stats = { };
+	this->m_bRecording = false;
+}
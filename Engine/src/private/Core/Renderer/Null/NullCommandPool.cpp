@@ -0,0 +1,82 @@
+#include "Core/Renderer/Null/NullCommandPool.h"
+
+#include <algorithm>
+
+/**
+* Creates the command pool
+*
+* @param createInfo Command pool create info
+*/
+void
+NullCommandPool::Create(const CommandPoolCreateInfo& createInfo) {}
+
+/**
+* Allocates a command buffer
+*
+* @returns Allocated command buffer
+*/
+Ref<CommandBuffer>
+NullCommandPool::AllocateCommandBuffer() {
+	Ref<NullCommandBuffer> commandBuffer = NullCommandBuffer::CreateShared();
+	this->m_commandBuffers.push_back(commandBuffer);
+
+	return commandBuffer.As<CommandBuffer>();
+}
+
+/**
+* Allocates many command buffers
+*
+* @param nCount Number of command buffers
+*
+* @returns Allocated command buffers
+*/
+Vector<Ref<CommandBuffer>>
+NullCommandPool::AllocateCommandBuffers(uint32_t nCount) {
+	Vector<Ref<CommandBuffer>> commandBuffers;
+	commandBuffers.reserve(nCount);
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		commandBuffers.push_back(this->AllocateCommandBuffer());
+	}
+
+	return commandBuffers;
+}
+
+/**
+* Frees a command buffer
+*
+* @param commandBuffer Command buffer to free
+*/
+void
+NullCommandPool::FreeCommandBuffer(Ref<CommandBuffer> commandBuffer) {
+	Ref<NullCommandBuffer> nullCommandBuffer = commandBuffer.As<NullCommandBuffer>();
+
+	auto it = std::find(this->m_commandBuffers.begin(), this->m_commandBuffers.end(), nullCommandBuffer);
+	if (it != this->m_commandBuffers.end()) {
+		this->m_commandBuffers.erase(it);
+	}
+}
+
+/**
+* Frees many command buffers
+*
+* @param commandBuffers Command buffers to free
+*/
+void
+NullCommandPool::FreeCommandBuffers(const Vector<Ref<CommandBuffer>>& commandBuffers) {
+	for (const Ref<CommandBuffer>& commandBuffer : commandBuffers) {
+		this->FreeCommandBuffer(commandBuffer);
+	}
+}
+
+/**
+* Resets every command buffer allocated from the pool
+*
+* @param bReleaseResources Unused
+*/
+void
+NullCommandPool::Reset(bool bReleaseResources) {
+	for (Ref<NullCommandBuffer>& commandBuffer : this->m_commandBuffers) {
+		commandBuffer->Reset();
+	}
+}
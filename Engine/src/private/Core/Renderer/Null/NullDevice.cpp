@@ -0,0 +1,472 @@
+#include "Core/Renderer/Null/NullDevice.h"
+
+/**
+* Creates the null device
+*
+* @param createInfo Unused
+*/
+void
+NullDevice::Create(const DeviceCreateInfo& createInfo) {
+	Logger::Info("NullDevice::Create: Null device created, no GPU work will be executed");
+}
+
+/**
+* Creates a command pool
+*
+* @param createInfo Command pool create info
+* @param queueType Unused
+*
+* @returns Created command pool
+*/
+Ref<CommandPool>
+NullDevice::CreateCommandPool(const CommandPoolCreateInfo& createInfo, EQueueType queueType) {
+	Ref<NullCommandPool> pool = NullCommandPool::CreateShared();
+	pool->Create(createInfo);
+
+	return pool.As<CommandPool>();
+}
+
+/**
+* Creates a graphics context
+*
+* @param commandPool The command pool where the command buffer will live
+*
+* @returns A graphics context
+*/
+Ref<GraphicsContext>
+NullDevice::CreateContext(Ref<CommandPool>& commandPool) {
+	Ref<CommandBuffer> commandBuff = commandPool->AllocateCommandBuffer();
+
+	Ref<NullGraphicsContext> context = NullGraphicsContext::CreateShared(commandBuff.As<NullCommandBuffer>());
+	return context.As<GraphicsContext>();
+}
+
+/**
+* Creates a pipeline layout
+*
+* @param createInfo Pipeline layout create info
+*
+* @returns Created pipeline layout
+*/
+Ref<PipelineLayout>
+NullDevice::CreatePipelineLayout(const PipelineLayoutCreateInfo& createInfo) {
+	Ref<NullPipelineLayout> layout = NullPipelineLayout::CreateShared();
+	layout->Create(createInfo);
+
+	return layout.As<PipelineLayout>();
+}
+
+/**
+* Creates a graphics pipeline
+*
+* @param createInfo Graphics pipeline create info
+*
+* @returns Created graphics pipeline
+*/
+Ref<Pipeline>
+NullDevice::CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) {
+	Ref<NullPipeline> pipeline = NullPipeline::CreateShared();
+	pipeline->CreateGraphics(createInfo);
+
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nPipelinesCreated++;
+
+	return pipeline.As<Pipeline>();
+}
+
+/**
+* Creates a compute pipeline
+*
+* @param createInfo Compute pipeline create info
+*
+* @returns Created compute pipeline
+*/
+Ref<Pipeline>
+NullDevice::CreateComputePipeline(const ComputePipelineCreateInfo& createInfo) {
+	Ref<NullPipeline> pipeline = NullPipeline::CreateShared();
+	pipeline->CreateCompute(createInfo);
+
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nPipelinesCreated++;
+
+	return pipeline.As<Pipeline>();
+}
+
+/**
+* Begins a single time command buffer
+*
+* @returns Command buffer in recording state
+*/
+Ref<CommandBuffer>
+NullDevice::BeginSingleTimeCommandBuffer() {
+	Ref<NullCommandBuffer> commandBuff = NullCommandBuffer::CreateShared();
+	commandBuff->Begin(true);
+
+	return commandBuff.As<CommandBuffer>();
+}
+
+/**
+* Ends and submits a single time command buffer
+*
+* @param commandBuffer The command buffer to end
+*/
+void
+NullDevice::EndSingleTimeCommandBuffer(Ref<CommandBuffer> commandBuffer) {
+	commandBuffer->End();
+
+	SubmitInfo submitInfo = { };
+	submitInfo.commandBuffers = { commandBuffer };
+
+	this->Submit(submitInfo, Ref<Fence>());
+}
+
+/**
+* Gets device limits. Values are the
+* common desktop ones
+*/
+void
+NullDevice::GetLimits(
+	uint32_t& nMaxUniformBufferRange,
+	uint32_t& nMaxStorageBufferRange,
+	uint32_t& nMaxPushConstantSize,
+	uint32_t& nMaxBoundDescriptorSets
+) const {
+	nMaxUniformBufferRange = 65536;
+	nMaxStorageBufferRange = UINT32_MAX;
+	nMaxPushConstantSize = 256;
+	nMaxBoundDescriptorSets = 32;
+}
+
+/**
+* Checks if the format has stencil component
+*
+* @param format Format
+*
+* @returns True if has stencil component
+*/
+bool
+NullDevice::HasStencilComponent(GPUFormat format) {
+	return format == GPUFormat::D32_FLOAT_S8_UINT || format == GPUFormat::D24_UNORM_S8_UINT;
+}
+
+/**
+* Creates a swapchain
+*
+* @param createInfo Swapchain create info
+*
+* @returns Created swapchain
+*/
+Ref<Swapchain>
+NullDevice::CreateSwapchain(const SwapchainCreateInfo& createInfo) {
+	Ref<NullDevice> deviceRef = std::static_pointer_cast<NullDevice>(this->shared_from_this());
+
+	Ref<NullSwapchain> swapchain = NullSwapchain::CreateShared(deviceRef);
+	swapchain->Create(createInfo);
+
+	return swapchain.As<Swapchain>();
+}
+
+/**
+* Creates a render pass
+*
+* @param createInfo Render pass create info
+*
+* @returns Created render pass
+*/
+Ref<RenderPass>
+NullDevice::CreateRenderPass(const RenderPassCreateInfo& createInfo) {
+	Ref<NullRenderPass> renderPass = NullRenderPass::CreateShared();
+	renderPass->Create(createInfo);
+
+	return renderPass.As<RenderPass>();
+}
+
+/**
+* Creates a buffer
+*
+* @param createInfo Buffer create info
+*
+* @returns Created buffer
+*/
+Ref<GPUBuffer>
+NullDevice::CreateBuffer(const BufferCreateInfo& createInfo) {
+	Ref<NullDevice> deviceRef = std::static_pointer_cast<NullDevice>(this->shared_from_this());
+
+	Ref<NullBuffer> buffer = NullBuffer::CreateShared(deviceRef);
+	buffer->Create(createInfo);
+
+	return buffer.As<GPUBuffer>();
+}
+
+/**
+* Creates a ring buffer
+*
+* @param createInfo Ring buffer create info
+*
+* @returns Created ring buffer
+*/
+Ref<GPURingBuffer>
+NullDevice::CreateRingBuffer(const RingBufferCreateInfo& createInfo) {
+	Ref<NullDevice> deviceRef = std::static_pointer_cast<NullDevice>(this->shared_from_this());
+
+	Ref<NullRingBuffer> ringBuffer = NullRingBuffer::CreateShared(deviceRef);
+	ringBuffer->Create(createInfo);
+
+	return ringBuffer.As<GPURingBuffer>();
+}
+
+/**
+* Creates a texture
+*
+* @param createInfo Texture create info
+*
+* @returns Created texture
+*/
+Ref<GPUTexture>
+NullDevice::CreateTexture(const TextureCreateInfo& createInfo) {
+	Ref<NullDevice> deviceRef = std::static_pointer_cast<NullDevice>(this->shared_from_this());
+
+	Ref<NullTexture> texture = NullTexture::CreateShared(deviceRef);
+	texture->Create(createInfo);
+
+	return texture.As<GPUTexture>();
+}
+
+/**
+* Creates a image view
+*
+* @param createInfo Image view create info
+*
+* @returns Created image view
+*/
+Ref<ImageView>
+NullDevice::CreateImageView(const ImageViewCreateInfo& createInfo) {
+	Ref<NullImageView> imageView = NullImageView::CreateShared();
+	imageView->Create(createInfo);
+
+	return imageView.As<ImageView>();
+}
+
+/**
+* Creates a framebuffer
+*
+* @param createInfo Framebuffer create info
+*
+* @returns Created framebuffer
+*/
+Ref<Framebuffer>
+NullDevice::CreateFramebuffer(const FramebufferCreateInfo& createInfo) {
+	Ref<NullFramebuffer> framebuffer = NullFramebuffer::CreateShared();
+	framebuffer->Create(createInfo);
+
+	return framebuffer.As<Framebuffer>();
+}
+
+/**
+* Creates a sampler
+*
+* @param createInfo Sampler create info
+*
+* @returns Created sampler
+*/
+Ref<Sampler>
+NullDevice::CreateSampler(const SamplerCreateInfo& createInfo) {
+	Ref<NullSampler> sampler = NullSampler::CreateShared();
+	sampler->Create(createInfo);
+
+	return sampler.As<Sampler>();
+}
+
+/**
+* Creates a descriptor pool
+*
+* @param createInfo Descriptor pool create info
+*
+* @returns Created descriptor pool
+*/
+Ref<DescriptorPool>
+NullDevice::CreateDescriptorPool(const DescriptorPoolCreateInfo& createInfo) {
+	Ref<NullDescriptorPool> pool = NullDescriptorPool::CreateShared();
+	pool->Create(createInfo);
+
+	return pool.As<DescriptorPool>();
+}
+
+/**
+* Creates a descriptor set layout
+*
+* @param createInfo Descriptor set layout create info
+*
+* @returns Created descriptor set layout
+*/
+Ref<DescriptorSetLayout>
+NullDevice::CreateDescriptorSetLayout(const DescriptorSetLayoutCreateInfo& createInfo) {
+	Ref<NullDescriptorSetLayout> layout = NullDescriptorSetLayout::CreateShared();
+	layout->Create(createInfo);
+
+	return layout.As<DescriptorSetLayout>();
+}
+
+/**
+* Creates a descriptor set
+*
+* @param pool Descriptor pool to allocate from
+* @param layout Descriptor set layout
+*
+* @returns Created descriptor set
+*/
+Ref<DescriptorSet>
+NullDevice::CreateDescriptorSet(Ref<DescriptorPool> pool, Ref<DescriptorSetLayout> layout) {
+	Ref<NullDescriptorSet> set = NullDescriptorSet::CreateShared();
+	set->Allocate(pool, layout);
+
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nDescriptorSetsCreated++;
+
+	return set.As<DescriptorSet>();
+}
+
+/**
+* Creates a semaphore
+*
+* @returns Created semaphore
+*/
+Ref<Semaphore>
+NullDevice::CreateSemaphore() {
+	Ref<NullSemaphore> semaphore = NullSemaphore::CreateShared();
+	semaphore->Create();
+
+	return semaphore.As<Semaphore>();
+}
+
+/**
+* Creates a fence
+*
+* @param createInfo Fence create info
+*
+* @returns Created fence
+*/
+Ref<Fence>
+NullDevice::CreateFence(const FenceCreateInfo& createInfo) {
+	Ref<NullFence> fence = NullFence::CreateShared();
+	fence->Create(createInfo);
+
+	return fence.As<Fence>();
+}
+
+/**
+* Creates a query pool whose results are never available
+*
+* @param createInfo Query pool create info
+*
+* @returns Created query pool
+*/
+Ref<QueryPool>
+NullDevice::CreateQueryPool(const QueryPoolCreateInfo& createInfo) {
+	Ref<NullQueryPool> queryPool = NullQueryPool::CreateShared();
+	queryPool->Create(createInfo);
+
+	return queryPool.As<QueryPool>();
+}
+
+/**
+* Creates a ImGui implementation that draws nothing
+*
+* @param createInfo ImGui create info
+*
+* @returns Created ImGui implementation
+*/
+Ref<ImGuiImpl>
+NullDevice::CreateImGui(const ImGuiImplCreateInfo& createInfo) {
+	Ref<NullImGuiImpl> imgui = NullImGuiImpl::CreateShared();
+	imgui->Create(createInfo);
+
+	return imgui.As<ImGuiImpl>();
+}
+
+/**
+* Get texture uploader
+*
+* @returns Texture uploader
+*/
+Ref<TextureUploader>
+NullDevice::GetTextureUploader() {
+	if (!this->m_textureUploader) {
+		Ref<Device> deviceRef = std::static_pointer_cast<Device>(this->shared_from_this());
+		this->m_textureUploader = TextureUploader::CreateShared(deviceRef);
+		this->m_textureUploader->Init();
+	}
+
+	return this->m_textureUploader;
+}
+
+/**
+* "Submits" command buffers. Their recorded
+* commands are added to the device totals
+*
+* @param submitInfo Submit info
+* @param fence Unused, fences are always signaled
+*/
+void
+NullDevice::Submit(const SubmitInfo& submitInfo, Ref<Fence> fence) {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+
+	this->m_stats.nSubmits++;
+	this->m_stats.nCommandBuffersSubmitted += submitInfo.commandBuffers.size();
+
+	for (const Ref<CommandBuffer>& commandBuffer : submitInfo.commandBuffers) {
+		this->m_stats.commands.Accumulate(commandBuffer.As<NullCommandBuffer>()->GetStats());
+	}
+}
+
+/**
+* Counts bytes sent from the host to the device
+*
+* @param nBytes Uploaded bytes
+*/
+void
+NullDevice::RecordUpload(uint64_t nBytes) {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nBytesUploaded += nBytes;
+}
+
+/**
+* Counts a buffer creation
+*
+* @param nBytes Buffer size
+*/
+void
+NullDevice::RecordBufferCreated(uint64_t nBytes) {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nBuffersCreated++;
+	this->m_stats.nBufferBytes += nBytes;
+}
+
+/**
+* Counts a texture creation
+*/
+void
+NullDevice::RecordTextureCreated() {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats.nTexturesCreated++;
+}
+
+/**
+* Gets a snapshot of the recorded totals
+*
+* @returns Device stats
+*/
+NullDeviceStats
+NullDevice::GetStats() {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	return this->m_stats;
+}
+
+/**
+* Clears the recorded totals
+*/
+void
+NullDevice::ResetStats() {
+	std::lock_guard<std::mutex> lock(this->m_statsMutex);
+	this->m_stats = { };
+}
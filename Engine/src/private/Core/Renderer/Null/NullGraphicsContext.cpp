@@ -0,0 +1,263 @@
+#include "Core/Renderer/Null/NullGraphicsContext.h"
+#include "Core/Renderer/Null/NullBuffer.h"
+
+NullGraphicsContext::NullGraphicsContext(Ref<NullCommandBuffer> commandBuffer)
+	: m_commandBuffer(commandBuffer) {}
+
+/**
+* Binds a pipeline
+*
+* @param pipeline Binded pipeline
+*/
+void
+NullGraphicsContext::BindPipeline(Ref<Pipeline> pipeline) {
+	this->m_commandBuffer->GetStats().nPipelineBinds++;
+}
+
+/**
+* Binds descriptor sets
+*
+* @param nFirstSet First set
+* @param sets DescriptorSet vector
+* @param dynamicOffsets Dynamic offsets (optional)
+*/
+void
+NullGraphicsContext::BindDescriptorSets(
+	uint32_t nFirstSet,
+	const Vector<Ref<DescriptorSet>>& sets,
+	const Vector<uint32_t>& dynamicOffsets
+) {
+	this->m_commandBuffer->GetStats().nDescriptorSetBinds += sets.size();
+}
+
+/**
+* Binds vertex buffers
+*
+* @param buffers Vertex buffer vector
+* @param offsets Offsets
+*/
+void
+NullGraphicsContext::BindVertexBuffers(const Vector<Ref<GPUBuffer>>& buffers, const Vector<size_t>& offsets) {
+	this->m_commandBuffer->GetStats().nVertexBufferBinds += buffers.size();
+}
+
+/**
+* Binds a index buffer
+*
+* @param buffer Index buffer
+* @param indexType Index type
+*/
+void
+NullGraphicsContext::BindIndexBuffer(Ref<GPUBuffer> buffer, EIndexType indexType) {
+	this->m_commandBuffer->GetStats().nIndexBufferBinds++;
+}
+
+/**
+* Records a draw call
+*
+* @param nVertexCount Number of vertices
+* @param nInstanceCount Number of instances
+* @param nFirstVertex First vertex
+* @param nFirstInstance First instance
+*/
+void
+NullGraphicsContext::Draw(
+	uint32_t nVertexCount,
+	uint32_t nInstanceCount,
+	uint32_t nFirstVertex,
+	uint32_t nFirstInstance
+) {
+	NullCommandStats& stats = this->m_commandBuffer->GetStats();
+	stats.nDraws++;
+	stats.nVertices += static_cast<uint64_t>(nVertexCount) * nInstanceCount;
+}
+
+/**
+* Records a indexed draw call
+*
+* @param nIndexCount Number of indices
+* @param nInstanceCount Number of instances
+* @param nFirstIndex First index
+* @param nVertexOffset Vertex offset
+* @param nFirstInstance First instance
+*/
+void
+NullGraphicsContext::DrawIndexed(
+	uint32_t nIndexCount,
+	uint32_t nInstanceCount,
+	uint32_t nFirstIndex,
+	uint32_t nVertexOffset,
+	uint32_t nFirstInstance
+) {
+	NullCommandStats& stats = this->m_commandBuffer->GetStats();
+	stats.nIndexedDraws++;
+	stats.nVertices += static_cast<uint64_t>(nIndexCount) * nInstanceCount;
+}
+
+/**
+* Records an indirect indexed draw call. The real
+* draw count lives in GPU memory, so only the
+* upper bound is known
+*
+* @param buffer Buffer containing draw parameters
+* @param nOffset Byte offset into buffer
+* @param countBuffer Buffer containing draw count
+* @param nCountBufferOffset Byte offset into countBuffer
+* @param nMaxDrawCount Maximum number of draws
+* @param nStride Byte stride between draw parameters
+*/
+void
+NullGraphicsContext::DrawIndexedIndirect(
+	Ref<GPUBuffer> buffer,
+	uint32_t nOffset,
+	Ref<GPUBuffer> countBuffer,
+	uint32_t nCountBufferOffset,
+	uint32_t nMaxDrawCount,
+	uint32_t nStride
+) {
+	NullCommandStats& stats = this->m_commandBuffer->GetStats();
+	stats.nIndirectDraws++;
+	stats.nMaxIndirectDrawCount += nMaxDrawCount;
+}
+
+/**
+* Records a push constant update
+*
+* @param layout Pipeline layout
+* @param stages Shader stage
+* @param nOffset Push constant offset
+* @param nSize Size of push constant data
+* @param pcData Push constant data
+*/
+void
+NullGraphicsContext::PushConstants(
+	Ref<PipelineLayout> layout,
+	EShaderStage stages,
+	uint32_t nOffset,
+	uint32_t nSize,
+	const void* pcData
+) {
+	this->m_commandBuffer->GetStats().nPushConstantBytes += nSize;
+}
+
+/**
+* Begins a render pass
+*
+* @param beginInfo Render pass begin info
+*/
+void
+NullGraphicsContext::BeginRenderPass(const RenderPassBeginInfo& beginInfo) {
+	if (this->m_bInsideRenderPass) {
+		Logger::Error("NullGraphicsContext::BeginRenderPass: A render pass is already active");
+		throw std::runtime_error("NullGraphicsContext::BeginRenderPass: A render pass is already active");
+	}
+
+	this->m_bInsideRenderPass = true;
+	this->m_commandBuffer->GetStats().nRenderPasses++;
+}
+
+/**
+* Ends the current render pass
+*/
+void
+NullGraphicsContext::EndRenderPass() {
+	if (!this->m_bInsideRenderPass) {
+		Logger::Error("NullGraphicsContext::EndRenderPass: No active render pass");
+		throw std::runtime_error("NullGraphicsContext::EndRenderPass: No active render pass");
+	}
+
+	this->m_bInsideRenderPass = false;
+}
+
+/**
+* Advances to the next subpass
+*/
+void
+NullGraphicsContext::NextSubpass() {
+	this->m_commandBuffer->GetStats().nSubpasses++;
+}
+
+/**
+* Records a buffer fill
+*
+* @param buffer Buffer to fill
+* @param nOffset Offset
+* @param nSize Size of the fill (~0U = rest of the buffer)
+* @param nData Fill data
+*/
+void
+NullGraphicsContext::FillBuffer(Ref<GPUBuffer> buffer, uint32_t nOffset, uint32_t nSize, uint32_t nData) {
+	if (nSize == ~0U) {
+		nSize = buffer.As<NullBuffer>()->GetSize() - nOffset;
+	}
+
+	this->m_commandBuffer->GetStats().nFilledBytes += nSize;
+}
+
+/**
+* Records a compute dispatch
+*
+* @param x X dimension
+* @param y Y dimension
+* @param z Z dimension
+*/
+void
+NullGraphicsContext::Dispatch(uint32_t x, uint32_t y, uint32_t z) {
+	NullCommandStats& stats = this->m_commandBuffer->GetStats();
+	stats.nDispatches++;
+	stats.nDispatchGroups += static_cast<uint64_t>(x) * y * z;
+}
+
+/**
+* Records a buffer memory barrier
+*
+* @param buffer Buffer
+* @param srcAccess Source access mask
+* @param dstAccess Destination access mask
+*/
+void
+NullGraphicsContext::BufferMemoryBarrier(Ref<GPUBuffer> buffer, EAccess srcAccess, EAccess dstAccess) {
+	this->m_commandBuffer->GetStats().nBufferBarriers++;
+}
+
+/**
+* Records an image layout transition
+*
+* @param image Image to transition
+* @param oldLayout Old layout
+* @param newLayout New layout
+*/
+void
+NullGraphicsContext::ImageBarrier(Ref<GPUTexture> image, EImageLayout oldLayout, EImageLayout newLayout) {
+	this->m_commandBuffer->GetStats().nImageBarriers++;
+}
+
+/**
+* Records an image layout transition (extended)
+*
+* @param image Image to transition
+* @param oldLayout Old layout
+* @param newLayout New layout
+* @param nLayerCount Number of array layers
+* @param nBaseMipLevel Base mip level
+* @param nBaseArrayLayer Base array layer
+*/
+void
+NullGraphicsContext::ImageBarrier(
+	Ref<GPUTexture> image,
+	EImageLayout oldLayout,
+	EImageLayout newLayout,
+	uint32_t nLayerCount,
+	uint32_t nBaseMipLevel,
+	uint32_t nBaseArrayLayer
+) {
+	this->m_commandBuffer->GetStats().nImageBarriers++;
+}
+
+/**
+* Records a global memory barrier
+*/
+void
+NullGraphicsContext::GlobalBarrier() {
+	this->m_commandBuffer->GetStats().nGlobalBarriers++;
+}
@@ -0,0 +1,29 @@
+#include "Core/Renderer/Null/NullRenderer.h"
+#include "Core/Renderer/Null/NullDevice.h"
+
+/**
+* Creates the null renderer
+*
+* @param pWindow Ignored, nothing is ever presented
+*/
+void
+NullRenderer::Create(GLFWwindow* pWindow) {
+	if (pWindow != nullptr) {
+		Logger::Warn("NullRenderer::Create: The null backend never presents to the window");
+	}
+}
+
+/**
+* Creates a null device
+*
+* @returns Created device
+*/
+Ref<Device>
+NullRenderer::CreateDevice() {
+	DeviceCreateInfo deviceInfo = { };
+
+	Ref<NullDevice> device = NullDevice::CreateShared();
+	device->Create(deviceInfo);
+
+	return device.As<Device>();
+}
@@ -0,0 +1,77 @@
+#include "Core/Renderer/Null/NullRingBuffer.h"
+#include "Core/Renderer/Null/NullDevice.h"
+
+NullRingBuffer::NullRingBuffer(Ref<NullDevice> device) : m_device(device) {}
+
+/**
+* Creates a ring buffer backed by host memory
+*
+* Sizing follows VulkanRingBuffer so allocation
+* patterns (and wraps) match the real backend
+*
+* @param createInfo Ring buffer create info
+*/
+void
+NullRingBuffer::Create(const RingBufferCreateInfo& createInfo) {
+	this->m_usage = createInfo.usage;
+	this->m_nFramesInFlight = createInfo.nFramesInFlight;
+
+	/* Same offset alignment rules as VulkanRingBuffer */
+	this->m_nAlignment = createInfo.nAlignment;
+	if (this->m_usage == EBufferUsage::UNIFORM_BUFFER || this->m_usage == EBufferUsage::STORAGE_BUFFER) {
+		this->m_nAlignment = std::max(createInfo.nAlignment, NullDevice::MIN_BUFFER_OFFSET_ALIGNMENT);
+	}
+	this->m_nPerFrameSize = this->Align(createInfo.nBufferSize / createInfo.nFramesInFlight, this->m_nAlignment);
+
+	this->m_nBufferSize = this->m_nPerFrameSize * this->m_nFramesInFlight;
+
+	BufferCreateInfo bufferInfo = { };
+	bufferInfo.nSize = this->m_nBufferSize;
+	bufferInfo.usage = createInfo.usage;
+	bufferInfo.sharingMode = ESharingMode::EXCLUSIVE;
+
+	this->m_buffer = this->m_device->CreateBuffer(bufferInfo);
+
+	/* Map the memory persistently */
+	this->m_pMap = this->m_buffer->Map();
+}
+
+/**
+* Allocates a chunk of the current frame region.
+* Every byte handed out is counted as uploaded
+*
+* @param nDataSize Size of the allocation
+* @param outOffset Offset of the allocation inside the buffer
+*
+* @returns Pointer to the allocated memory
+*/
+void*
+NullRingBuffer::Allocate(uint32_t nDataSize, uint32_t& outOffset) {
+	uint32_t nAlignedSize = this->Align(nDataSize, this->m_nAlignment);
+
+	uint32_t nFrameBaseOffset = (this->m_nOffset / this->m_nPerFrameSize) * this->m_nPerFrameSize;
+	uint32_t nFrameEnd = nFrameBaseOffset + this->m_nPerFrameSize;
+
+	if (this->m_nOffset + nAlignedSize > nFrameEnd) {
+		Logger::Warn("NullRingBuffer::Allocate: Overflow inside frame region, wrapping to frame base");
+		this->m_nOffset = nFrameBaseOffset;
+	}
+
+	outOffset = this->m_nOffset;
+	void* pPtr = static_cast<uint8_t*>(this->m_pMap) + this->m_nOffset;
+	this->m_nOffset += nAlignedSize;
+
+	this->m_device->RecordUpload(nDataSize);
+
+	return pPtr;
+}
+
+uint32_t
+NullRingBuffer::Align(uint32_t nValue, uint32_t nAlignment) {
+	return (nValue + nAlignment - 1) & ~(nAlignment - 1);
+}
+
+void
+NullRingBuffer::Reset(uint32_t nImageIndex) {
+	this->m_nOffset = this->Align(this->m_nPerFrameSize * nImageIndex, this->m_nAlignment);
+}
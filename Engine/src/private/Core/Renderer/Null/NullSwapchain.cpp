@@ -0,0 +1,126 @@
+#include "Core/Renderer/Null/NullSwapchain.h"
+#include "Core/Renderer/Null/NullDevice.h"
+
+NullSwapchain::NullSwapchain(Ref<NullDevice> device) : m_device(device) {}
+
+/**
+* Creates the null image chain
+*
+* @param createInfo Swap chain create info
+*/
+void
+NullSwapchain::Create(const SwapchainCreateInfo& createInfo) {
+	this->m_nImageCount = createInfo.nImageCount > 0 ? createInfo.nImageCount : 1;
+	this->m_extent = Extent2D { createInfo.width, createInfo.height };
+
+	if (this->m_extent.width == 0 || this->m_extent.height == 0) {
+		Logger::Error("NullSwapchain::Create: Extent can't be 0");
+		throw std::runtime_error("NullSwapchain::Create: Extent can't be 0");
+	}
+
+	this->CreateImages();
+}
+
+/**
+* Acquires the next image
+*
+* @param nTimeout Unused
+* @param signalSemaphore Unused
+* @param signalFence Unused
+*
+* @returns Acquired image index
+*/
+uint32_t
+NullSwapchain::AcquireNextImage(
+	uint64_t nTimeout,
+	Ref<Semaphore> signalSemaphore,
+	Ref<Fence> signalFence
+) {
+	uint32_t nImageIndex = this->m_nNextImage;
+	this->m_nNextImage = (this->m_nNextImage + 1) % this->m_nImageCount;
+
+	return nImageIndex;
+}
+
+/**
+* Presents an image
+*
+* @param nImageIndex Image index
+* @param pWaitSemaphores Unused
+*
+* @returns Always true
+*/
+bool
+NullSwapchain::Present(uint32_t nImageIndex, const Vector<Ref<Semaphore>>& pWaitSemaphores) {
+	this->m_nPresentCount++;
+	return true;
+}
+
+/**
+* Recreates the image chain with new dimensions
+*
+* @param nNewWidth New width
+* @param nNewHeight New height
+*/
+void
+NullSwapchain::Rebuild(uint32_t nNewWidth, uint32_t nNewHeight) {
+	if (nNewWidth == 0 || nNewHeight == 0) {
+		return;
+	}
+
+	this->m_extent = Extent2D { nNewWidth, nNewHeight };
+	this->m_nNextImage = 0;
+
+	this->CreateImages();
+}
+
+/**
+* Creates color and depth images
+*/
+void
+NullSwapchain::CreateImages() {
+	Extent3D extent = { };
+	extent.width = this->m_extent.width;
+	extent.height = this->m_extent.height;
+	extent.depth = 1;
+
+	TextureCreateInfo textureInfo = { };
+	textureInfo.extent = extent;
+	textureInfo.imageType = ETextureDimensions::TYPE_2D;
+	textureInfo.usage = ETextureUsage::COLOR_ATTACHMENT | ETextureUsage::TRANSFER_SRC;
+	textureInfo.format = COLOR_FORMAT;
+
+	this->m_images.resize(this->m_nImageCount);
+	this->m_imageViews.resize(this->m_nImageCount);
+
+	for (uint32_t i = 0; i < this->m_nImageCount; i++) {
+		this->m_images[i] = this->m_device->CreateTexture(textureInfo);
+		this->m_imageViews[i] = this->CreateView(this->m_images[i], COLOR_FORMAT, EImageAspect::COLOR);
+	}
+
+	textureInfo.usage = ETextureUsage::DEPTH_STENCIL_ATTACHMENT | ETextureUsage::SAMPLED;
+	textureInfo.format = DEPTH_FORMAT;
+
+	this->m_depthImage = this->m_device->CreateTexture(textureInfo);
+	this->m_depthImageView = this->CreateView(this->m_depthImage, DEPTH_FORMAT, EImageAspect::DEPTH);
+}
+
+/**
+* Creates a 2D view for a chain image
+*
+* @param image Image
+* @param format View format
+* @param aspect View aspect
+*
+* @returns Created image view
+*/
+Ref<ImageView>
+NullSwapchain::CreateView(Ref<GPUTexture> image, GPUFormat format, EImageAspect aspect) {
+	ImageViewCreateInfo viewInfo = { };
+	viewInfo.image = image;
+	viewInfo.viewType = EImageViewType::TYPE_2D;
+	viewInfo.format = format;
+	viewInfo.subresourceRange.aspectMask = aspect;
+
+	return this->m_device->CreateImageView(viewInfo);
+}
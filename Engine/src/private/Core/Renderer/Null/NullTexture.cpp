@@ -0,0 +1,38 @@
+#include "Core/Renderer/Null/NullTexture.h"
+#include "Core/Renderer/Null/NullDevice.h"
+#include "Core/Renderer/Null/NullBuffer.h"
+
+NullTexture::NullTexture(Ref<NullDevice> device) : m_device(device) {}
+
+/**
+* Creates a null texture. If a staging buffer
+* is given its size is counted as uploaded
+*
+* @param createInfo Texture create info
+* @param debugName Unused
+*/
+void
+NullTexture::Create(const TextureCreateInfo& createInfo, const String& debugName) {
+	if (createInfo.extent.width == 0 || createInfo.extent.height == 0) {
+		Logger::Error("NullTexture::Create: Texture extent can't be 0 ({})", debugName);
+		throw std::runtime_error("NullTexture::Create: Texture extent can't be 0");
+	}
+
+	this->m_extent = createInfo.extent;
+	this->m_format = createInfo.format;
+
+	if (createInfo.buffer) {
+		this->m_nSize = createInfo.buffer.As<NullBuffer>()->GetSize();
+		this->m_device->RecordUpload(this->m_nSize);
+	}
+
+	this->m_device->RecordTextureCreated();
+}
+
+/**
+* Resets the texture
+*/
+void
+NullTexture::Reset() {
+	this->m_nSize = 0;
+}
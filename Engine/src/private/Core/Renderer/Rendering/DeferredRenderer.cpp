@@ -17,6 +17,7 @@ DeferredRenderer::Init(Ref<Device> device, Ref<Swapchain> swapchain, uint32_t nF
     this->m_device = device;
     this->m_nFramesInFlight = nFramesInFlight;
     this->m_pWindow = pWindow;
+    this->m_bHeadless = pWindow == nullptr;
     
     Extent2D ext = swapchain->GetExtent();
     if (ext.width == 0 || ext.height == 0) {
@@ -125,29 +126,38 @@ DeferredRenderer::Invalidate() {
 * @param context Graphics context
 * @param swapchain Swapchain
 * @param drawData Collected scene data for drawing
-* @param nImgIdx Current image index for frames-in-flight
+* @param nFrameIndex Frame in flight index, selects per-frame resources
+* @param nImageIndex Acquired swapchain image index
 */
 void
 DeferredRenderer::Render(
 	Ref<GraphicsContext> context,
 	Ref<Swapchain> swapchain,
 	const CollectedDrawData& drawData,
-	uint32_t nImgIdx
+	uint32_t nFrameIndex,
+	uint32_t nImageIndex
 ) {
     if (this->m_imguiPass.HasPendingResize()) {
         ImVec2 sz = this->m_imguiPass.GetPendingSize();
         uint32_t nNewWidth = static_cast<uint32_t>(sz.x);
         uint32_t nNewHeight = static_cast<uint32_t>(sz.y);
         this->Resize(nNewWidth, nNewHeight, true);
-        SceneManager::GetInstance()->SetDimensions(nNewWidth, nNewHeight);
+
+        {
+            /* The camera may be updated by the simulation worker */
+            SceneManager* sceneMgr = SceneManager::GetInstance();
+            std::lock_guard<std::mutex> sceneLock(sceneMgr->GetSceneMutex());
+            sceneMgr->SetDimensions(nNewWidth, nNewHeight);
+        }
+
         this->m_imguiPass.ClearPendingResize();
     }
 
-    this->m_graph.Reset(nImgIdx);
+    this->m_graph.Reset(nFrameIndex);
 
     TextureHandle backBuffer = this->m_graph.ImportBackbuffer(
-        swapchain->GetImage(nImgIdx),
-        swapchain->GetImageView(nImgIdx)
+        swapchain->GetImage(nImageIndex),
+        swapchain->GetImageView(nImageIndex)
     );
 
     if (this->m_imguiPass.SunChanged()) {
@@ -159,10 +169,10 @@ DeferredRenderer::Render(
 
         this->m_skyAtmosphere.SetSunDirection(sunDir);
         this->m_skyAtmosphere.SetViewProjection(drawData.view, drawData.proj);
-        this->m_skyAtmosphere.Update(context, nImgIdx);
+        this->m_skyAtmosphere.Update(context, nFrameIndex);
         this->m_shadowPass.SetSunDirection(sunDir);
 
-        this->m_iblGen.Generate(context, nImgIdx);
+        this->m_iblGen.Generate(context, nFrameIndex);
         this->m_bIBLGenerated = true;
 
         this->m_sunDirection = sunDir;
@@ -170,43 +180,30 @@ DeferredRenderer::Render(
         this->m_imguiPass.NotifySunUpdated();
     }
 
-    this->UploadSceneData(drawData, nImgIdx);
+    this->UploadSceneData(drawData, nFrameIndex);
 
     this->m_cullingPass.SetViewProj(drawData.viewProj);
 
-    this->UpdateSceneDescriptors(nImgIdx);
-
     /* Import G-Buffer resources */
     this->m_gbuffPass.ImportResources(this->m_graph);
    
     const Vector<MegaBuffer::Block>& blocks = this->m_megaBuffer.GetBlocks();
     uint32_t nBlockCount = this->m_megaBuffer.GetBlockCount();
 
-    Vector<uint32_t> batchesPerBlock(nBlockCount, 0);
-    for (const DrawBatch& batch : drawData.batches) {
-        if (batch.nBlockIdx < nBlockCount) {
-            batchesPerBlock[batch.nBlockIdx]++;
-        }
-    }
-
-    uint32_t nMaxBatchesPerBlock = 0;
-    for (uint32_t nCount : batchesPerBlock) {
-        nMaxBatchesPerBlock = std::max(nMaxBatchesPerBlock, nCount);
-    }
-    nMaxBatchesPerBlock = std::max(nMaxBatchesPerBlock, 1u);
+    uint32_t nMaxDrawsPerBlock = std::max(drawData.nMaxDrawsPerBlock, 1u);
 
     this->m_cullingPass.SetTotalBlocks(nBlockCount);
-    this->m_cullingPass.SetBatchesPerBlock(nMaxBatchesPerBlock);
+    this->m_cullingPass.SetDrawsPerBlock(nMaxDrawsPerBlock);
 
     this->m_graph.AddNode("Culling",
         [&](RenderGraphBuilder& builder) { this->m_cullingPass.SetupNode(builder); },
         [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
-            this->m_cullingPass.Execute(context, graphCtx, nImgIdx);
+            this->m_cullingPass.Execute(context, graphCtx, nFrameIndex);
         }
     );
     
     this->m_gbuffPass.SetSceneData(
-        this->m_sceneSets[nImgIdx],
+        this->m_sceneSets[nFrameIndex],
         this->m_sceneSetLayout,
         this->m_bindlessSet,
         this->m_bindlessLayout,
@@ -214,11 +211,10 @@ DeferredRenderer::Render(
         nBlockCount,
         this->m_cullingPass.GetCountBuffer(),
         this->m_cullingPass.GetIndirectBuffer(),
-        this->m_cullingPass.GetIndirectBuffer()->GetPerFrameSize() * nImgIdx,
+        this->m_cullingPass.GetIndirectBuffer()->GetPerFrameSize() * nFrameIndex,
         drawData.nTotalBatches,
-        nMaxBatchesPerBlock,
-        this->m_cullingPass.GetWVPBuffer()->GetAlignment(),
-        this->m_cullingPass.GetMaterialBuffer()->GetAlignment()
+        nMaxDrawsPerBlock,
+        drawData.viewProj
     );
 
     /* 1. G-Buffer pass (Indirect) */
@@ -236,13 +232,13 @@ DeferredRenderer::Render(
     this->m_graph.AddNode("BentNormalPass", 
         [&](RenderGraphBuilder& builder) { this->m_bentNormalPass.SetupNode(builder); },
         [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
-            this->m_bentNormalPass.Execute(context, graphCtx, nImgIdx);
+            this->m_bentNormalPass.Execute(context, graphCtx, nFrameIndex);
         }
     );
 
     /* 2. Shadow pass (Cascade shadow map) */
     this->m_shadowPass.SetSceneData(
-        this->m_sceneSets[nImgIdx],
+        this->m_sceneSets[nFrameIndex],
         this->m_sceneSetLayout,
         blocks,
         nBlockCount
@@ -257,7 +253,7 @@ DeferredRenderer::Render(
     this->m_graph.AddNode("ShadowPass",
         [&](RenderGraphBuilder& builder) { this->m_shadowPass.SetupNode(builder); },
         [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
-            this->m_shadowPass.Execute(context, graphCtx, nImgIdx);
+            this->m_shadowPass.Execute(context, graphCtx, nFrameIndex);
         }
     );
 
@@ -288,7 +284,7 @@ DeferredRenderer::Render(
     this->m_graph.AddNode("Lighting",
         [&](RenderGraphBuilder& builder) { this->m_lightingPass.SetupNode(builder); },
         [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) { 
-            this->m_lightingPass.Execute(context, graphCtx, nImgIdx); 
+            this->m_lightingPass.Execute(context, graphCtx, nFrameIndex); 
         }
     );
 
@@ -316,82 +312,97 @@ DeferredRenderer::Render(
 
     /* 5. Tonemap pass */
     this->m_tonemapPass.SetInput(this->m_lightingPass.GetOutput().hdrOutput);
+
+    /* Headless: no editor UI, tonemap straight into the offscreen image */
+    if (this->m_bHeadless) {
+        this->m_tonemapPass.SetOutput(backBuffer, EImageLayout::TRANSFER_SRC);
+    }
     
     this->m_graph.AddNode("Tonemap",
         [&](RenderGraphBuilder& builder) { this->m_tonemapPass.SetupNode(builder); },
         [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
-            this->m_tonemapPass.Execute(context, graphCtx, nImgIdx);
+            this->m_tonemapPass.Execute(context, graphCtx, nFrameIndex);
         }
     );
 
     /* 6. ImGui Pass */
-    this->m_imguiPass.SetInput(this->m_tonemapPass.GetOutput(), this->m_graph.GetPool(), nImgIdx);
-    this->m_imguiPass.SetOutput(backBuffer);
-    this->m_graph.AddNode("ImGui",
-        [&](RenderGraphBuilder& builder) { this->m_imguiPass.SetupNode(builder); },
-        [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
-            this->m_imguiPass.Execute(context, graphCtx, nImgIdx);
-        }
-    );
+    if (!this->m_bHeadless) {
+        this->m_imguiPass.SetInput(this->m_tonemapPass.GetOutput(), this->m_graph.GetPool(), nFrameIndex);
+        this->m_imguiPass.SetOutput(backBuffer);
+        this->m_imguiPass.SetGPUTimings(this->m_graph.GetGPUTimings(), this->m_graph.GetGPUFrameTime());
+        this->m_graph.AddNode("ImGui",
+            [&](RenderGraphBuilder& builder) { this->m_imguiPass.SetupNode(builder); },
+            [&](Ref<GraphicsContext> context, RenderGraphContext& graphCtx) {
+                this->m_imguiPass.Execute(context, graphCtx, nFrameIndex);
+            }
+        );
+    }
 
     this->m_graph.Compile();
     this->m_graph.Execute(context);
 }
 
 /**
-* Uploads scene transformation and instance data to GPU buffers
+* Uploads the frame's sparse scene and draw group
+* updates and the visible instance list. The persistent tables
+* are written on the GPU by the culling pass
 * 
 * @param data Draw data
 * @param nFrameIdx Current frame index
 */
 void 
 DeferredRenderer::UploadSceneData(const CollectedDrawData& data, uint32_t nFrameIdx) {
+    Ref<GPURingBuffer> transformUpdateBuffer = this->m_cullingPass.GetTransformUpdateBuffer();
+    Ref<GPURingBuffer> instanceUpdateBuffer = this->m_cullingPass.GetInstanceUpdateBuffer();
+    Ref<GPURingBuffer> groupUpdateBuffer = this->m_cullingPass.GetGroupUpdateBuffer();
+    Ref<GPURingBuffer> visibleBuffer = this->m_cullingPass.GetVisibleBuffer();
+
     /* Reset ring buffers */
-    this->m_cullingPass.GetInstanceBuffer()->Reset(nFrameIdx);
-    this->m_cullingPass.GetMaterialBuffer()->Reset(nFrameIdx);
-    this->m_cullingPass.GetBatchBuffer()->Reset(nFrameIdx);
-    this->m_cullingPass.GetWVPBuffer()->Reset(nFrameIdx);
+    transformUpdateBuffer->Reset(nFrameIdx);
+    instanceUpdateBuffer->Reset(nFrameIdx);
+    groupUpdateBuffer->Reset(nFrameIdx);
+    visibleBuffer->Reset(nFrameIdx);
+
+    uint32_t nTransformUpdates = static_cast<uint32_t>(data.transformUpdates.size());
+    uint32_t nInstanceUpdates = static_cast<uint32_t>(data.instanceUpdates.size());
+    uint32_t nGroupUpdates = static_cast<uint32_t>(data.groupUpdates.size());
+
+    /* This snapshot's updates already reached the tables */
+    if (data.nSequence <= this->m_nAppliedSceneSequence) {
+        nTransformUpdates = 0;
+        nInstanceUpdates = 0;
+        nGroupUpdates = 0;
+    }
 
+    this->m_cullingPass.SetUpdateCounts(nTransformUpdates, nInstanceUpdates, nGroupUpdates);
     this->m_cullingPass.SetTotalBatches(data.nTotalBatches);
+    this->m_cullingPass.SetBatchSlotCount(data.nBatchSlotCount);
+    this->m_cullingPass.SetGroupSlotCount(data.nGroupSlotCount);
 
-    if (data.batches.empty()) return;
+    this->m_nAppliedSceneSequence = std::max(this->m_nAppliedSceneSequence, data.nSequence);
 
     /* Copy data to ring buffers */
     uint32_t nOffset = 0;
 
-    /* Object instance data */
-    void* ptr = this->m_cullingPass.GetInstanceBuffer()->Allocate(
-        static_cast<uint32_t>(data.instances.size() * sizeof(ObjectInstanceData)),
-        nOffset
-    );
-
-    memcpy(ptr, data.instances.data(), data.instances.size() * sizeof(ObjectInstanceData));
-
-    /* Material instance data */
-    ptr = this->m_cullingPass.GetMaterialBuffer()->Allocate(
-        static_cast<uint32_t>(data.materials.size() * sizeof(MaterialInstanceData)),
-        nOffset
-    );
-
-    memcpy(ptr, data.materials.data(), data.materials.size() * sizeof(MaterialInstanceData));
-
-    /* Draw batches */
-    ptr = this->m_cullingPass.GetBatchBuffer()->Allocate(
-        static_cast<uint32_t>(data.batches.size() * sizeof(DrawBatch)),
-        nOffset
-    );
-
-    memcpy(ptr, data.batches.data(), data.batches.size() * sizeof(DrawBatch));
+    if (nTransformUpdates > 0) {
+        void* ptr = transformUpdateBuffer->Allocate(nTransformUpdates * sizeof(TransformUpdate), nOffset);
+        memcpy(ptr, data.transformUpdates.data(), nTransformUpdates * sizeof(TransformUpdate));
+    }
 
-    /* WVP */
-    ptr = this->m_cullingPass.GetWVPBuffer()->Allocate(
-        static_cast<uint32_t>(data.wvps.size() * sizeof(WVP)),
-        nOffset
-    );
+    if (nInstanceUpdates > 0) {
+        void* ptr = instanceUpdateBuffer->Allocate(nInstanceUpdates * sizeof(InstanceUpdate), nOffset);
+        memcpy(ptr, data.instanceUpdates.data(), nInstanceUpdates * sizeof(InstanceUpdate));
+    }
 
-    memcpy(ptr, data.wvps.data(), data.wvps.size() * sizeof(WVP));
+    if (nGroupUpdates > 0) {
+        void* ptr = groupUpdateBuffer->Allocate(nGroupUpdates * sizeof(GroupUpdate), nOffset);
+        memcpy(ptr, data.groupUpdates.data(), nGroupUpdates * sizeof(GroupUpdate));
+    }
 
-    this->m_cullingPass.SetTotalBatches(data.nTotalBatches);
+    if (data.nTotalBatches > 0) {
+        void* ptr = visibleBuffer->Allocate(data.nTotalBatches * sizeof(uint32_t), nOffset);
+        memcpy(ptr, data.visibleBatches.data(), data.nTotalBatches * sizeof(uint32_t));
+    }
 }
 
 /**
@@ -490,6 +501,8 @@ DeferredRenderer::UploadMesh(const MeshData& meshData) {
     if (this->m_uploadedMeshes.count(name) > 0) return;
 
     UploadedMesh uploaded = this->m_meshUploader.Upload(meshData);
+    uploaded.nUploadId = ++this->m_nMeshCacheGeneration;
+
     this->m_uploadedMeshes[name] = uploaded;
 }
 
@@ -508,6 +521,7 @@ DeferredRenderer::UnloadMesh(const String& name) {
         }
 
         this->m_uploadedMeshes.erase(name);
+        this->m_nMeshCacheGeneration++;
     }
 }
 
@@ -520,12 +534,14 @@ DeferredRenderer::CreateSceneDescriptors() {
         Scene Descriptor layout (Set 0)
         Binding 0: Instance Data (Storage Buffer)
         Binding 1: Material Data (Storage Buffer)
-        Binding 5: WVP Data (Storage buffer)
+        Binding 5: World matrices (Storage buffer)
+        Binding 6: Group instance lists (Storage buffer)
     */
     Vector<DescriptorSetLayoutBinding> bindings = {
         { 0, EDescriptorType::STORAGE_BUFFER, 1, EShaderStage::VERTEX | EShaderStage::FRAGMENT, false },
         { 1, EDescriptorType::STORAGE_BUFFER, 1, EShaderStage::VERTEX | EShaderStage::FRAGMENT, false },
-        { 5, EDescriptorType::STORAGE_BUFFER, 1, EShaderStage::VERTEX, false }
+        { 5, EDescriptorType::STORAGE_BUFFER, 1, EShaderStage::VERTEX, false },
+        { 6, EDescriptorType::STORAGE_BUFFER, 1, EShaderStage::VERTEX, false }
     };
 
     /* Create descriptor set layout */
@@ -538,7 +554,7 @@ DeferredRenderer::CreateSceneDescriptors() {
     DescriptorPoolCreateInfo poolInfo = { };
     poolInfo.nMaxSets = this->m_nFramesInFlight;
     poolInfo.poolSizes = {
-        { EDescriptorType::STORAGE_BUFFER, 3 * this->m_nFramesInFlight }
+        { EDescriptorType::STORAGE_BUFFER, 4 * this->m_nFramesInFlight }
     };
 
     this->m_scenePool = this->m_device->CreateDescriptorPool(poolInfo);
@@ -547,11 +563,14 @@ DeferredRenderer::CreateSceneDescriptors() {
     this->m_sceneSets.resize(this->m_nFramesInFlight);
     for (uint32_t i = 0; i < this->m_nFramesInFlight; i++) {
         this->m_sceneSets[i] = this->m_device->CreateDescriptorSet(this->m_scenePool, this->m_sceneSetLayout);
+        this->UpdateSceneDescriptors(i);
     }
 }
 
 /**
-* Updates scene descriptor sets for a specific frame index
+* Points a scene descriptor set at the culling
+* pass' persistent tables and the frame's
+* group instance lists
 * 
 * @param nImgIdx Frame/Image index
 */
@@ -559,27 +578,36 @@ void
 DeferredRenderer::UpdateSceneDescriptors(uint32_t nImgIdx) {
     Ref<DescriptorSet> currentSceneSet = this->m_sceneSets[nImgIdx];
 
-    /* Binding 0: Instance data (from CullingPass) */
+    /* Binding 0: Instance table (from CullingPass) */
     DescriptorBufferInfo instanceInfo = { };
-    instanceInfo.buffer = this->m_cullingPass.GetInstanceBuffer()->GetBuffer();
-    instanceInfo.nOffset = this->m_cullingPass.GetInstanceBuffer()->GetPerFrameSize() * nImgIdx;
-    instanceInfo.nRange = this->m_cullingPass.GetInstanceBuffer()->GetPerFrameSize();
+    instanceInfo.buffer = this->m_cullingPass.GetInstanceTable();
+    instanceInfo.nOffset = 0;
+    instanceInfo.nRange = MAX_SCENE_INSTANCES * sizeof(ObjectInstanceData);
 
-    /* Binding 1: Material data (from CullingPass) */
+    /* Binding 1: Material table (from CullingPass) */
     DescriptorBufferInfo materialInfo = { };
-    materialInfo.buffer = this->m_cullingPass.GetMaterialBuffer()->GetBuffer();
-    materialInfo.nOffset = this->m_cullingPass.GetMaterialBuffer()->GetPerFrameSize() * nImgIdx;
-    materialInfo.nRange = this->m_cullingPass.GetMaterialBuffer()->GetPerFrameSize();
-
-    /* Binding 5: WVP Data (from CullingPass) */
-    DescriptorBufferInfo wvpInfo = { };
-    wvpInfo.buffer = this->m_cullingPass.GetWVPBuffer()->GetBuffer();
-    wvpInfo.nOffset = this->m_cullingPass.GetWVPBuffer()->GetPerFrameSize() * nImgIdx;
-    wvpInfo.nRange = this->m_cullingPass.GetWVPBuffer()->GetPerFrameSize();
+    materialInfo.buffer = this->m_cullingPass.GetMaterialTable();
+    materialInfo.nOffset = 0;
+    materialInfo.nRange = MAX_SCENE_INSTANCES * sizeof(MaterialInstanceData);
+
+    /* Binding 5: World matrix table (from CullingPass) */
+    DescriptorBufferInfo worldInfo = { };
+    worldInfo.buffer = this->m_cullingPass.GetWorldTable();
+    worldInfo.nOffset = 0;
+    worldInfo.nRange = MAX_SCENE_TRANSFORMS * sizeof(glm::mat4);
+
+    /* Binding 6: This frame's group instance lists, every view (from CullingPass) */
+    Ref<GPURingBuffer> groupInstanceBuffer = this->m_cullingPass.GetGroupInstanceBuffer();
+
+    DescriptorBufferInfo groupInstanceInfo = { };
+    groupInstanceInfo.buffer = groupInstanceBuffer->GetBuffer();
+    groupInstanceInfo.nOffset = groupInstanceBuffer->GetPerFrameSize() * nImgIdx;
+    groupInstanceInfo.nRange = groupInstanceBuffer->GetPerFrameSize();
     
     currentSceneSet->WriteBuffer(0, 0, instanceInfo);
     currentSceneSet->WriteBuffer(1, 0, materialInfo);
-    currentSceneSet->WriteBuffer(5, 0, wvpInfo);
+    currentSceneSet->WriteBuffer(5, 0, worldInfo);
+    currentSceneSet->WriteBuffer(6, 0, groupInstanceInfo);
     currentSceneSet->UpdateWrites();
 }
 
@@ -2,6 +2,7 @@
 #include "Core/Renderer/Rendering/RenderGraphBuilder.h"
 
 #include <array>
+#include <algorithm>
 
 /**
 * Culling pass initialization
@@ -54,20 +55,10 @@ CullingPass::Execute(
 ) {
 	this->m_frustumBuffer->Reset(nFrameIndex);
 
-	Ref<DescriptorSet> cullingSet = this->m_cullingSets[nFrameIndex];
-
-	context->FillBuffer(this->m_countBuffer, 0, 64 * sizeof(uint32_t), 0);
-	context->BufferMemoryBarrier(this->m_countBuffer, EAccess::TRANSFER_WRITE, EAccess::SHADER_WRITE);
-
-	if (this->m_nTotalBatches == 0) {
-		return;
+	if (this->m_nTransformUpdates > 0 || this->m_nInstanceUpdates > 0 || this->m_nGroupUpdates > 0) {
+		this->ApplySceneUpdates(context, nFrameIndex);
 	}
 
-	context->BindPipeline(this->m_computePipeline);
-	context->BindDescriptorSets(0, { this->m_cullingSets[nFrameIndex]});
-	
-	uint32_t nGroups = (this->m_nTotalBatches + 255) / 256;
-
 	glm::mat4 viewProj = this->m_viewProj;
 	glm::vec4 frustumPlanes[6];
 	this->ExtractFrustumPlanes(viewProj, frustumPlanes);
@@ -82,33 +73,139 @@ CullingPass::Execute(
 	void* pFrustumData = this->m_frustumBuffer->Allocate(sizeof(frustumData), nFrustumDataOffset);
 	memcpy(pFrustumData, &frustumData, sizeof(frustumData));
 
-	/* Push constants */
+	/* The camera is view 0, shadow cascades follow */
+	CullViewInfo viewInfo = { };
+	viewInfo.nViewIdx = 0;
+	viewInfo.nBatchCount = this->m_nTotalBatches;
+	viewInfo.bUseVisibleList = true;
+	viewInfo.nFrustumOffset = nFrustumDataOffset;
+	viewInfo.nFrustumAlignment = this->m_frustumBuffer->GetAlignment();
+	viewInfo.indirectBuffer = this->m_indirectBuffer->GetBuffer();
+	viewInfo.countBuffer = this->m_countBuffer;
+
+	this->CullView(context, this->m_cullingSets[nFrameIndex], viewInfo);
+}
+
+/**
+* Culls a view in two steps. The first one
+* compacts the visible instance slots of every
+* draw group into the view's instance list, the
+* second one emits one instanced draw per live
+* group, in the collector's sort order
+* 
+* @param context Graphics context
+* @param set Culling set with the view's outputs
+* @param info View to cull
+*/
+void
+CullingPass::CullView(Ref<GraphicsContext> context, Ref<DescriptorSet> set, const CullViewInfo& info) {
+	if (info.nViewIdx >= MAX_CULL_VIEWS) {
+		Logger::Error("CullingPass::CullView: View index {} out of range ({})", info.nViewIdx, MAX_CULL_VIEWS);
+		return;
+	}
+
+	uint32_t nGroupCountOffset = info.nViewIdx * MAX_DRAW_GROUPS;
+
+	context->FillBuffer(info.countBuffer, 0, 64 * sizeof(uint32_t), 0);
+	context->BufferMemoryBarrier(info.countBuffer, EAccess::TRANSFER_WRITE, EAccess::SHADER_WRITE);
+
+	if (info.nBatchCount == 0 || this->m_nGroupSlotCount == 0) {
+		return;
+	}
+
+	context->FillBuffer(
+		this->m_groupCountBuffer,
+		nGroupCountOffset * sizeof(uint32_t),
+		this->m_nGroupSlotCount * sizeof(uint32_t),
+		0
+	);
+	context->BufferMemoryBarrier(this->m_groupCountBuffer, EAccess::TRANSFER_WRITE, EAccess::SHADER_WRITE);
+
+	/* Push constants, shared by both steps */
 	struct {
 		uint32_t nTotalBatches;
-		uint32_t nWvpAlignment;
-		uint32_t nMaterialAlignment;
 		uint32_t nFrustumOffset;
 		uint32_t nFrustumAlignment;
 		uint32_t nMaxDrawsPerBlock;
+		uint32_t nUseVisibleList;
+		uint32_t nGroupCountOffset;
+		uint32_t nInstanceListOffset;
+		uint32_t nGroupSlotCount;
 	} pushData;
 
-	pushData.nTotalBatches = this->m_nTotalBatches;
-	pushData.nWvpAlignment = this->m_wvpBuffer->GetAlignment();
-	pushData.nMaterialAlignment = this->m_materialBuffer->GetAlignment();
-	pushData.nFrustumOffset = nFrustumDataOffset;
-	pushData.nFrustumAlignment = this->m_frustumBuffer->GetAlignment();
-	pushData.nMaxDrawsPerBlock = this->m_nMaxBatchesPerBlock;
+	pushData.nTotalBatches = info.nBatchCount;
+	pushData.nFrustumOffset = info.nFrustumOffset;
+	pushData.nFrustumAlignment = info.nFrustumAlignment;
+	pushData.nMaxDrawsPerBlock = this->m_nMaxDrawsPerBlock;
+	pushData.nUseVisibleList = info.bUseVisibleList ? 1 : 0;
+	pushData.nGroupCountOffset = nGroupCountOffset;
+	pushData.nInstanceListOffset = info.nViewIdx * MAX_SCENE_INSTANCES;
+	pushData.nGroupSlotCount = this->m_nGroupSlotCount;
 
+	/* 1. Compact visible instances per group */
+	context->BindPipeline(this->m_computePipeline);
+	context->BindDescriptorSets(0, { set });
 	context->PushConstants(this->m_pipelineLayout, EShaderStage::COMPUTE, 0, sizeof(pushData), &pushData);
 
-	context->Dispatch(nGroups, 1, 1);
+	context->Dispatch((info.nBatchCount + 255) / 256, 1, 1);
 
-	context->BufferMemoryBarrier(
-		this->m_indirectBuffer->GetBuffer(),
-		EAccess::SHADER_WRITE, 
-		EAccess::INDIRECT_COMMAND_READ
-	);
-	context->BufferMemoryBarrier(this->m_countBuffer, EAccess::SHADER_WRITE, EAccess::INDIRECT_COMMAND_READ);
+	context->BufferMemoryBarrier(this->m_groupCountBuffer, EAccess::SHADER_WRITE, EAccess::SHADER_READ);
+
+	/* 2. One draw per group */
+	context->BindPipeline(this->m_drawGroupsPipeline);
+	context->BindDescriptorSets(0, { set });
+	context->PushConstants(this->m_drawGroupsPipelineLayout, EShaderStage::COMPUTE, 0, sizeof(pushData), &pushData);
+
+	context->Dispatch((this->m_nGroupSlotCount + 63) / 64, 1, 1);
+
+	context->BufferMemoryBarrier(info.indirectBuffer, EAccess::SHADER_WRITE, EAccess::INDIRECT_COMMAND_READ);
+	context->BufferMemoryBarrier(info.countBuffer, EAccess::SHADER_WRITE, EAccess::INDIRECT_COMMAND_READ);
+	context->BufferMemoryBarrier(this->m_groupInstanceBuffer->GetBuffer(), EAccess::SHADER_WRITE, EAccess::SHADER_READ);
+}
+
+/**
+* Writes the frame's transform, instance and
+* group updates into the persistent tables
+* 
+* @param context Graphics context
+* @param nFrameIndex Current frame index
+*/
+void
+CullingPass::ApplySceneUpdates(Ref<GraphicsContext> context, uint32_t nFrameIndex) {
+	std::array<Ref<GPUBuffer>, 5> tables = {
+		this->m_instanceTable,
+		this->m_materialTable,
+		this->m_batchTable,
+		this->m_worldTable,
+		this->m_groupTable
+	};
+
+	/* Earlier frames may still be reading the slots */
+	for (Ref<GPUBuffer>& table : tables) {
+		context->BufferMemoryBarrier(table, EAccess::SHADER_READ, EAccess::SHADER_WRITE);
+	}
+
+	context->BindPipeline(this->m_updatePipeline);
+	context->BindDescriptorSets(0, { this->m_updateSets[nFrameIndex] });
+
+	struct {
+		uint32_t nTransformUpdates;
+		uint32_t nInstanceUpdates;
+		uint32_t nGroupUpdates;
+	} pushData;
+
+	pushData.nTransformUpdates = this->m_nTransformUpdates;
+	pushData.nInstanceUpdates = this->m_nInstanceUpdates;
+	pushData.nGroupUpdates = this->m_nGroupUpdates;
+
+	context->PushConstants(this->m_updatePipelineLayout, EShaderStage::COMPUTE, 0, sizeof(pushData), &pushData);
+
+	uint32_t nUpdates = std::max({ this->m_nTransformUpdates, this->m_nInstanceUpdates, this->m_nGroupUpdates });
+	context->Dispatch((nUpdates + 63) / 64, 1, 1);
+
+	for (Ref<GPUBuffer>& table : tables) {
+		context->BufferMemoryBarrier(table, EAccess::SHADER_WRITE, EAccess::SHADER_READ);
+	}
 }
 
 void
@@ -121,7 +218,7 @@ CullingPass::CreatePipeline() {
 	PushConstantRange pushRange = { };
 	pushRange.stage = EShaderStage::COMPUTE;
 	pushRange.nOffset = 0;
-	pushRange.nSize = 6 * sizeof(uint32_t);
+	pushRange.nSize = 8 * sizeof(uint32_t);
 
 	ComputePipelineCreateInfo pipelineInfo = { };
 	pipelineInfo.shader = computeShader;
@@ -130,6 +227,33 @@ CullingPass::CreatePipeline() {
 
 	this->m_computePipeline = this->m_device->CreateComputePipeline(pipelineInfo);
 	this->m_pipelineLayout = this->m_computePipeline->GetLayout();
+
+	/* Draw emission, same set and push constants */
+	Ref<Shader> drawGroupsShader = Shader::CreateShared();
+	drawGroupsShader->LoadFromGLSL("shaders/GPUDrawGroups.comp", EShaderStage::COMPUTE);
+
+	ComputePipelineCreateInfo drawGroupsPipelineInfo = pipelineInfo;
+	drawGroupsPipelineInfo.shader = drawGroupsShader;
+
+	this->m_drawGroupsPipeline = this->m_device->CreateComputePipeline(drawGroupsPipelineInfo);
+	this->m_drawGroupsPipelineLayout = this->m_drawGroupsPipeline->GetLayout();
+
+	/* Scene update scatter */
+	Ref<Shader> updateShader = Shader::CreateShared();
+	updateShader->LoadFromGLSL("shaders/SceneUpdate.comp", EShaderStage::COMPUTE);
+
+	PushConstantRange updatePushRange = { };
+	updatePushRange.stage = EShaderStage::COMPUTE;
+	updatePushRange.nOffset = 0;
+	updatePushRange.nSize = 3 * sizeof(uint32_t);
+
+	ComputePipelineCreateInfo updatePipelineInfo = { };
+	updatePipelineInfo.shader = updateShader;
+	updatePipelineInfo.descriptorSetLayouts = { this->m_updateSetLayout };
+	updatePipelineInfo.pushConstantRanges = { updatePushRange };
+
+	this->m_updatePipeline = this->m_device->CreateComputePipeline(updatePipelineInfo);
+	this->m_updatePipelineLayout = this->m_updatePipeline->GetLayout();
 }
 
 /**
@@ -137,32 +261,64 @@ CullingPass::CreatePipeline() {
 */
 void 
 CullingPass::CreateResources() {
-	constexpr uint32_t MAX_OBJECT = 131072; // Max objects (2^17)
-	constexpr uint32_t MAX_MATERIALS = 131072; // Max objects (2^17)
-	constexpr uint32_t MAX_BATCHES = 131072; // Max objects (2^17)
 	constexpr uint32_t MAX_DRAWS = 131072; // Max objects (2^17)
 
 	/* 
-		ObjectInstanceData ring buffer 
-		
-		Alignment: 8 (2 uint32_t)
+		Persistent tables, one entry per collector slot.
+		Written only by the scene update pass
+	*/
+	auto createTable = [this](uint32_t nSize) {
+		BufferCreateInfo tableInfo = { };
+		tableInfo.nSize = nSize;
+		tableInfo.sharingMode = ESharingMode::EXCLUSIVE;
+		tableInfo.usage = EBufferUsage::STORAGE_BUFFER;
+		tableInfo.type = EBufferType::STORAGE_BUFFER;
+
+		return this->m_device->CreateBuffer(tableInfo);
+	};
+
+	this->m_instanceTable = createTable(MAX_SCENE_INSTANCES * sizeof(ObjectInstanceData));
+	this->m_materialTable = createTable(MAX_SCENE_INSTANCES * sizeof(MaterialInstanceData));
+	this->m_batchTable = createTable(MAX_SCENE_INSTANCES * sizeof(DrawBatch));
+	this->m_worldTable = createTable(MAX_SCENE_TRANSFORMS * sizeof(glm::mat4));
+	this->m_groupTable = createTable(MAX_DRAW_GROUPS * sizeof(DrawGroup));
+
+	/* 
+		Update lists ring buffers. A frame may rewrite
+		every slot (first frame, scene change)
 	*/
-	RingBufferCreateInfo instanceInfo = { };
-	instanceInfo.nAlignment = 8;
-	instanceInfo.nFramesInFlight = this->m_nFramesInFlight;
-	instanceInfo.nBufferSize = MAX_OBJECT * sizeof(ObjectInstanceData);
-	instanceInfo.usage = EBufferUsage::STORAGE_BUFFER;
+	RingBufferCreateInfo transformUpdateInfo = { };
+	transformUpdateInfo.nAlignment = 16;
+	transformUpdateInfo.nFramesInFlight = this->m_nFramesInFlight;
+	transformUpdateInfo.nBufferSize = MAX_SCENE_TRANSFORMS * sizeof(TransformUpdate) * this->m_nFramesInFlight;
+	transformUpdateInfo.usage = EBufferUsage::STORAGE_BUFFER;
+
+	this->m_transformUpdateBuffer = this->m_device->CreateRingBuffer(transformUpdateInfo);
+
+	RingBufferCreateInfo instanceUpdateInfo = { };
+	instanceUpdateInfo.nAlignment = 16;
+	instanceUpdateInfo.nFramesInFlight = this->m_nFramesInFlight;
+	instanceUpdateInfo.nBufferSize = MAX_SCENE_INSTANCES * sizeof(InstanceUpdate) * this->m_nFramesInFlight;
+	instanceUpdateInfo.usage = EBufferUsage::STORAGE_BUFFER;
 
-	this->m_instanceBuffer = this->m_device->CreateRingBuffer(instanceInfo);
+	this->m_instanceUpdateBuffer = this->m_device->CreateRingBuffer(instanceUpdateInfo);
 
-	/* MaterialInstanceData ring buffer */
-	RingBufferCreateInfo materialInfo = { };
-	materialInfo.nAlignment = 64;
-	materialInfo.nFramesInFlight = this->m_nFramesInFlight;
-	materialInfo.nBufferSize = MAX_MATERIALS * sizeof(MaterialInstanceData);
-	materialInfo.usage = EBufferUsage::STORAGE_BUFFER;
+	RingBufferCreateInfo groupUpdateInfo = { };
+	groupUpdateInfo.nAlignment = 16;
+	groupUpdateInfo.nFramesInFlight = this->m_nFramesInFlight;
+	groupUpdateInfo.nBufferSize = MAX_DRAW_GROUPS * sizeof(GroupUpdate) * this->m_nFramesInFlight;
+	groupUpdateInfo.usage = EBufferUsage::STORAGE_BUFFER;
 
-	this->m_materialBuffer = this->m_device->CreateRingBuffer(materialInfo);
+	this->m_groupUpdateBuffer = this->m_device->CreateRingBuffer(groupUpdateInfo);
+
+	/* Visible instance slots ring buffer */
+	RingBufferCreateInfo visibleInfo = { };
+	visibleInfo.nAlignment = 16;
+	visibleInfo.nFramesInFlight = this->m_nFramesInFlight;
+	visibleInfo.nBufferSize = MAX_SCENE_INSTANCES * sizeof(uint32_t) * this->m_nFramesInFlight;
+	visibleInfo.usage = EBufferUsage::STORAGE_BUFFER;
+
+	this->m_visibleBuffer = this->m_device->CreateRingBuffer(visibleInfo);
 
 	/* DrawIndexedIndirectCommand ring buffer */
 	RingBufferCreateInfo indirectInfo = { };
@@ -173,24 +329,6 @@ CullingPass::CreateResources() {
 
 	this->m_indirectBuffer = this->m_device->CreateRingBuffer(indirectInfo);
 
-	/* WVP Ring buffer */
-	RingBufferCreateInfo wvpInfo = { };
-	wvpInfo.nAlignment = 256;
-	wvpInfo.nBufferSize = 2 * 1024 * 1024;
-	wvpInfo.nFramesInFlight = this->m_nFramesInFlight;
-	wvpInfo.usage = EBufferUsage::STORAGE_BUFFER;
-
-	this->m_wvpBuffer = this->m_device->CreateRingBuffer(wvpInfo);
-
-	/* DrawBatch ring buffer */
-	RingBufferCreateInfo batchInfo = { };
-	batchInfo.nAlignment = 16;
-	batchInfo.nBufferSize = sizeof(DrawBatch) * MAX_BATCHES;
-	batchInfo.nFramesInFlight = this->m_nFramesInFlight;
-	batchInfo.usage = EBufferUsage::STORAGE_BUFFER;
-
-	this->m_batchBuffer = this->m_device->CreateRingBuffer(batchInfo);
-
 	/* Draw count buffer (4 bytes, max 64 blocks) */
 	BufferCreateInfo countInfo = { };
 	countInfo.sharingMode = ESharingMode::EXCLUSIVE;
@@ -200,6 +338,27 @@ CullingPass::CreateResources() {
 
 	this->m_countBuffer = this->m_device->CreateBuffer(countInfo);
 
+	/* Visible instance count per draw group, a range per view */
+	BufferCreateInfo groupCountInfo = { };
+	groupCountInfo.sharingMode = ESharingMode::EXCLUSIVE;
+	groupCountInfo.nSize = MAX_DRAW_GROUPS * MAX_CULL_VIEWS * sizeof(uint32_t);
+	groupCountInfo.usage = EBufferUsage::STORAGE_BUFFER | EBufferUsage::TRANSFER_DST;
+	groupCountInfo.type = EBufferType::STORAGE_BUFFER;
+
+	this->m_groupCountBuffer = this->m_device->CreateBuffer(groupCountInfo);
+
+	/* 
+		Compacted instance lists, read through gl_InstanceIndex.
+		Every view gets room for all the instance slots
+	*/
+	RingBufferCreateInfo groupInstanceInfo = { };
+	groupInstanceInfo.nAlignment = 16;
+	groupInstanceInfo.nFramesInFlight = this->m_nFramesInFlight;
+	groupInstanceInfo.nBufferSize = MAX_SCENE_INSTANCES * MAX_CULL_VIEWS * sizeof(uint32_t) * this->m_nFramesInFlight;
+	groupInstanceInfo.usage = EBufferUsage::STORAGE_BUFFER;
+
+	this->m_groupInstanceBuffer = this->m_device->CreateRingBuffer(groupInstanceInfo);
+
 	/* Frustum data ring buffer */
 	uint32_t nFrustumDataSize = sizeof(FrustumData);
 	uint32_t nAlignedFrustumSize = NextPowerOf2(nFrustumDataSize);
@@ -230,21 +389,21 @@ CullingPass::CreateResources() {
 */
 void
 CullingPass::CreateDescriptors() {
-	Vector<DescriptorSetLayoutBinding> bindings(7);
+	Vector<DescriptorSetLayoutBinding> bindings(11);
 	
-	/* Binding 0: Instance data (ObjectInstanceData) */
+	/* Binding 0: Instance table (ObjectInstanceData) */
 	bindings[0].nBinding = 0;
 	bindings[0].nDescriptorCount = 1;
 	bindings[0].stageFlags = EShaderStage::COMPUTE | EShaderStage::VERTEX;
 	bindings[0].descriptorType = EDescriptorType::STORAGE_BUFFER;
 
-	/* Binding 1: Material data (MaterialInstanceData) */
+	/* Binding 1: Material table (MaterialInstanceData) */
 	bindings[1].nBinding = 1;
 	bindings[1].nDescriptorCount = 1;
 	bindings[1].stageFlags = EShaderStage::COMPUTE | EShaderStage::VERTEX | EShaderStage::FRAGMENT;
 	bindings[1].descriptorType = EDescriptorType::STORAGE_BUFFER;
 
-	/* Binding 2: Draw batches (DrawBatch) */
+	/* Binding 2: Batch table (DrawBatch) */
 	bindings[2].nBinding = 2;
 	bindings[2].nDescriptorCount = 1;
 	bindings[2].stageFlags = EShaderStage::COMPUTE;
@@ -262,7 +421,7 @@ CullingPass::CreateDescriptors() {
 	bindings[4].stageFlags = EShaderStage::COMPUTE;
 	bindings[4].descriptorType = EDescriptorType::STORAGE_BUFFER;
 
-	/* Binding 5: WVP Ring buffer (read only) */
+	/* Binding 5: World matrix table (read only) */
 	bindings[5].nBinding = 5;
 	bindings[5].nDescriptorCount = 1;
 	bindings[5].stageFlags = EShaderStage::COMPUTE | EShaderStage::VERTEX;
@@ -274,89 +433,124 @@ CullingPass::CreateDescriptors() {
 	bindings[6].stageFlags = EShaderStage::COMPUTE;
 	bindings[6].descriptorType = EDescriptorType::STORAGE_BUFFER;
 
+	/* Binding 7: Visible instance slots ring buffer */
+	bindings[7].nBinding = 7;
+	bindings[7].nDescriptorCount = 1;
+	bindings[7].stageFlags = EShaderStage::COMPUTE;
+	bindings[7].descriptorType = EDescriptorType::STORAGE_BUFFER;
+
+	/* Binding 8: Draw group table (DrawGroup) */
+	bindings[8].nBinding = 8;
+	bindings[8].nDescriptorCount = 1;
+	bindings[8].stageFlags = EShaderStage::COMPUTE;
+	bindings[8].descriptorType = EDescriptorType::STORAGE_BUFFER;
+
+	/* Binding 9: Visible instances per group, every view */
+	bindings[9].nBinding = 9;
+	bindings[9].nDescriptorCount = 1;
+	bindings[9].stageFlags = EShaderStage::COMPUTE;
+	bindings[9].descriptorType = EDescriptorType::STORAGE_BUFFER;
+
+	/* Binding 10: Compacted instance lists ring buffer */
+	bindings[10].nBinding = 10;
+	bindings[10].nDescriptorCount = 1;
+	bindings[10].stageFlags = EShaderStage::COMPUTE;
+	bindings[10].descriptorType = EDescriptorType::STORAGE_BUFFER;
+
 	/* Create descriptor set layout */
 	DescriptorSetLayoutCreateInfo layoutInfo = { };
 	layoutInfo.bindings = bindings;
 	
 	this->m_setLayout = this->m_device->CreateDescriptorSetLayout(layoutInfo);
 
-	Logger::Debug("CullingPass::CreateDescriptors: Culling pass descriptor set layout created");
+	/* 
+		Scene update layout
+
+		Binding 0-3: Instance, material, batch and world tables
+		Binding 4: Transform updates
+		Binding 5: Instance updates
+		Binding 6: Draw group table
+		Binding 7: Group updates
+	*/
+	Vector<DescriptorSetLayoutBinding> updateBindings(8);
+	for (uint32_t i = 0; i < 8; i++) {
+		updateBindings[i].nBinding = i;
+		updateBindings[i].nDescriptorCount = 1;
+		updateBindings[i].stageFlags = EShaderStage::COMPUTE;
+		updateBindings[i].descriptorType = EDescriptorType::STORAGE_BUFFER;
+	}
+
+	DescriptorSetLayoutCreateInfo updateLayoutInfo = { };
+	updateLayoutInfo.bindings = updateBindings;
+
+	this->m_updateSetLayout = this->m_device->CreateDescriptorSetLayout(updateLayoutInfo);
+
+	Logger::Debug("CullingPass::CreateDescriptors: Culling pass descriptor set layouts created");
 
 	/* Create descriptor pool */
 	DescriptorPoolSize poolSize = { };
 	poolSize.type = EDescriptorType::STORAGE_BUFFER;
-	poolSize.nDescriptorCount = 7 * this->m_nFramesInFlight;
+	poolSize.nDescriptorCount = (11 + 8) * this->m_nFramesInFlight;
 
 	DescriptorPoolCreateInfo poolInfo = { };
-	poolInfo.nMaxSets = this->m_nFramesInFlight;
+	poolInfo.nMaxSets = 2 * this->m_nFramesInFlight;
 	poolInfo.poolSizes = { poolSize };
 
 	this->m_pool = this->m_device->CreateDescriptorPool(poolInfo);
 
 	/* Allocate descriptor sets */
 	this->m_cullingSets.resize(this->m_nFramesInFlight);
+	this->m_updateSets.resize(this->m_nFramesInFlight);
 
 	for (uint32_t i = 0; i < this->m_nFramesInFlight; i++) {
 		this->m_cullingSets[i] = this->m_device->CreateDescriptorSet(this->m_pool, this->m_setLayout);
+		this->m_updateSets[i] = this->m_device->CreateDescriptorSet(this->m_pool, this->m_updateSetLayout);
 	}
 
-	/* Writes descriptor sets */
-	Vector<DescriptorBufferInfo> bufferInfos(7);
-	
-	std::array<uint32_t, 7> frameSizes = {
-		this->m_instanceBuffer->GetPerFrameSize(), // 0
-		this->m_materialBuffer->GetPerFrameSize(), // 1
-		this->m_batchBuffer->GetPerFrameSize(), // 2
-		this->m_indirectBuffer->GetPerFrameSize(), // 3
-		0, // 4 (Is not per frame)
-		this->m_wvpBuffer->GetPerFrameSize(), // 5
-		this->m_frustumBuffer->GetPerFrameSize(), // 6
-	};
-
-	/* Binding 0: Instance data */
-	bufferInfos[0].buffer = this->m_instanceBuffer->GetBuffer();
-	bufferInfos[0].nOffset = 0;
-	bufferInfos[0].nRange = this->m_instanceBuffer->GetPerFrameSize();
-
-	/* Binding 1: Material data */
-	bufferInfos[1].buffer = this->m_materialBuffer->GetBuffer();
-	bufferInfos[1].nOffset = 0;
-	bufferInfos[1].nRange = this->m_materialBuffer->GetPerFrameSize();
-
-	/* Binding 2: Batch data */
-	bufferInfos[2].buffer = this->m_batchBuffer->GetBuffer();
-	bufferInfos[2].nOffset = 0;
-	bufferInfos[2].nRange = this->m_batchBuffer->GetPerFrameSize();
-	
-	/* Binding 3: Output commands */
-	bufferInfos[3].buffer = this->m_indirectBuffer->GetBuffer();
-	bufferInfos[3].nOffset = 0;
-	bufferInfos[3].nRange = this->m_indirectBuffer->GetPerFrameSize();
-
-	/* Binding 4: Draw count */
-	bufferInfos[4].buffer = this->m_countBuffer;
-	bufferInfos[4].nOffset = 0;
-	bufferInfos[4].nRange = 64 * sizeof(uint32_t);
-
-	/* Binding 5: WVP Buffer */
-	bufferInfos[5].buffer = this->m_wvpBuffer->GetBuffer();
-	bufferInfos[5].nOffset = 0;
-	bufferInfos[5].nRange = this->m_wvpBuffer->GetPerFrameSize();
-
-	/* Binding 6: Frustum buffer */
-	bufferInfos[6].buffer = this->m_frustumBuffer->GetBuffer();
-	bufferInfos[6].nOffset = 0;
-	bufferInfos[6].nRange = this->m_frustumBuffer->GetPerFrameSize();
+	/* Persistent tables, the same for every frame */
+	DescriptorBufferInfo instanceInfo = { this->m_instanceTable, 0, MAX_SCENE_INSTANCES * sizeof(ObjectInstanceData) };
+	DescriptorBufferInfo materialInfo = { this->m_materialTable, 0, MAX_SCENE_INSTANCES * sizeof(MaterialInstanceData) };
+	DescriptorBufferInfo batchInfo = { this->m_batchTable, 0, MAX_SCENE_INSTANCES * sizeof(DrawBatch) };
+	DescriptorBufferInfo worldInfo = { this->m_worldTable, 0, MAX_SCENE_TRANSFORMS * sizeof(glm::mat4) };
+	DescriptorBufferInfo groupInfo = { this->m_groupTable, 0, MAX_DRAW_GROUPS * sizeof(DrawGroup) };
+	DescriptorBufferInfo groupCountInfo = { this->m_groupCountBuffer, 0, MAX_DRAW_GROUPS * MAX_CULL_VIEWS * sizeof(uint32_t) };
+
+	/* Per frame regions of the ring buffers */
+	uint32_t nIndirectSize = this->m_indirectBuffer->GetPerFrameSize();
+	uint32_t nFrustumSize = this->m_frustumBuffer->GetPerFrameSize();
+	uint32_t nVisibleSize = this->m_visibleBuffer->GetPerFrameSize();
+	uint32_t nTransformUpdateSize = this->m_transformUpdateBuffer->GetPerFrameSize();
+	uint32_t nInstanceUpdateSize = this->m_instanceUpdateBuffer->GetPerFrameSize();
+	uint32_t nGroupUpdateSize = this->m_groupUpdateBuffer->GetPerFrameSize();
+	uint32_t nGroupInstanceSize = this->m_groupInstanceBuffer->GetPerFrameSize();
 
 	for (uint32_t i = 0; i < this->m_nFramesInFlight; i++) {
 		Ref<DescriptorSet> set = this->m_cullingSets[i];
-		
-		for (uint32_t j = 0; j < 7; j++) {
-			DescriptorBufferInfo& bufferInfo = bufferInfos[j];
-			bufferInfo.nOffset = frameSizes[j] * i;
-			set->WriteBuffer(j, 0, bufferInfo);
-		}
+
+		set->WriteBuffer(0, 0, instanceInfo);
+		set->WriteBuffer(1, 0, materialInfo);
+		set->WriteBuffer(2, 0, batchInfo);
+		set->WriteBuffer(3, 0, { this->m_indirectBuffer->GetBuffer(), nIndirectSize * i, nIndirectSize });
+		set->WriteBuffer(4, 0, { this->m_countBuffer, 0, 64 * sizeof(uint32_t) });
+		set->WriteBuffer(5, 0, worldInfo);
+		set->WriteBuffer(6, 0, { this->m_frustumBuffer->GetBuffer(), nFrustumSize * i, nFrustumSize });
+		set->WriteBuffer(7, 0, { this->m_visibleBuffer->GetBuffer(), nVisibleSize * i, nVisibleSize });
+		set->WriteBuffer(8, 0, groupInfo);
+		set->WriteBuffer(9, 0, groupCountInfo);
+		set->WriteBuffer(10, 0, { this->m_groupInstanceBuffer->GetBuffer(), nGroupInstanceSize * i, nGroupInstanceSize });
 		set->UpdateWrites();
+
+		Ref<DescriptorSet> updateSet = this->m_updateSets[i];
+
+		updateSet->WriteBuffer(0, 0, instanceInfo);
+		updateSet->WriteBuffer(1, 0, materialInfo);
+		updateSet->WriteBuffer(2, 0, batchInfo);
+		updateSet->WriteBuffer(3, 0, worldInfo);
+		updateSet->WriteBuffer(4, 0, { this->m_transformUpdateBuffer->GetBuffer(), nTransformUpdateSize * i, nTransformUpdateSize });
+		updateSet->WriteBuffer(5, 0, { this->m_instanceUpdateBuffer->GetBuffer(), nInstanceUpdateSize * i, nInstanceUpdateSize });
+		updateSet->WriteBuffer(6, 0, groupInfo);
+		updateSet->WriteBuffer(7, 0, { this->m_groupUpdateBuffer->GetBuffer(), nGroupUpdateSize * i, nGroupUpdateSize });
+		updateSet->UpdateWrites();
 	}
 }
 
@@ -75,17 +75,9 @@ GBufferPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx,
 
 	context->BindDescriptorSets(0, { this->m_sceneSet, this->m_bindlessSet });
 
-	uint32_t nCurrentOffset = 0;
+	uint32_t nCurrentOffset = this->m_nIndirectOffset;
 
-	struct {
-		uint32_t nWvpAlignment;
-		uint32_t nMaterialAlignment;
-	} pcData;
-
-	pcData.nWvpAlignment = this->m_nWvpAlignment;
-	pcData.nMaterialAlignment = this->m_nMaterialAlignment;
-
-	context->PushConstants(this->m_pipelineLayout, EShaderStage::VERTEX, 0, sizeof(pcData), &pcData);
+	context->PushConstants(this->m_pipelineLayout, EShaderStage::VERTEX, 0, sizeof(glm::mat4), &this->m_viewProj);
 
 	for (uint32_t i = 0; i < this->m_nBlockCount; i++) {
 		Ref<GPUBuffer> VBO = this->m_blocks[i].vertexBuffer;
@@ -99,11 +91,11 @@ GBufferPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx,
 			nCurrentOffset,
 			this->m_countBuffer,
 			i * sizeof(uint32_t),
-			this->m_nMaxBatchesPerBlock,
+			this->m_nMaxDrawsPerBlock,
 			sizeof(DrawIndexedIndirectCommand)
 		);
 
-		nCurrentOffset += this->m_nMaxBatchesPerBlock * sizeof(DrawIndexedIndirectCommand);
+		nCurrentOffset += this->m_nMaxDrawsPerBlock * sizeof(DrawIndexedIndirectCommand);
 	}
 
 }
@@ -131,9 +123,8 @@ GBufferPass::SetSceneData(
 	Ref<GPURingBuffer> indirectBuffer,
 	uint32_t nIndirectOffset,
 	uint32_t nTotalBatches,
-	uint32_t nMaxBatchesPerBlock,
-	uint32_t nWvpAlignment,
-	uint32_t nMaterialAlignment
+	uint32_t nMaxDrawsPerBlock,
+	const glm::mat4& viewProj
 ) {
 	this->m_sceneSet = sceneSet;
 	this->m_sceneSetLayout = sceneSetLayout;
@@ -151,10 +142,9 @@ GBufferPass::SetSceneData(
 
 	this->m_nTotalBatches = nTotalBatches;
 
-	this->m_nMaxBatchesPerBlock = nMaxBatchesPerBlock;
+	this->m_nMaxDrawsPerBlock = nMaxDrawsPerBlock;
 
-	this->m_nWvpAlignment = nWvpAlignment;
-	this->m_nMaterialAlignment = nMaterialAlignment;
+	this->m_viewProj = viewProj;
 
 	if (this->m_device && !this->m_pipeline) {
 		this->CreatePipeline();
@@ -166,7 +156,7 @@ GBufferPass::CreatePipeline() {
 	PipelineLayoutCreateInfo plInfo = { };
 	plInfo.setLayouts = { this->m_sceneSetLayout, this->m_bindlessSetLayout };
 	plInfo.pushConstantRanges = {
-		{ EShaderStage::VERTEX, 0, 2 * sizeof(uint32_t)} // wvpAlignment
+		{ EShaderStage::VERTEX, 0, sizeof(glm::mat4) } // viewProj
 	};
 
 	this->m_pipelineLayout = this->m_device->CreatePipelineLayout(plInfo);
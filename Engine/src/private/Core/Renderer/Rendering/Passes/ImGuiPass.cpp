@@ -1,5 +1,6 @@
 #include "Core/Renderer/Rendering/Passes/ImGuiPass.h"
 #include "Core/Renderer/Rendering/RenderGraphContext.h"
+#include "Core/FrameStats.h"
 #include "Fonts/RobotoRegular.h"
 
 #include "Icons/Folder.h"
@@ -105,6 +106,12 @@ void
 ImGuiPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx, uint32_t nImgIdx) {
 	this->m_imgui->NewFrame();
 
+    /* 
+        The editor UI reads and edits the scene, wait for
+        the simulation worker to finish the next frame
+    */
+    std::unique_lock<std::mutex> sceneLock(SceneManager::GetInstance()->GetSceneMutex());
+
     float hierarchyPadding = 50.f;
     float hierarchyHeight = static_cast<float>(this->m_nHeight) - (hierarchyPadding * 2);
 
@@ -182,10 +189,15 @@ ImGuiPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx, u
             ImGuiTreeNodeFlags treeFlags = ImGuiTreeNodeFlags_DefaultOpen;
 
             Hierarchy& hierarchy = pCurrentScene->GetHierarchy();
-            Ref<Hierarchy::HierarchyNode> rootNode = hierarchy.root;
 
-            if (rootNode) {
-                this->DrawHierarchyNode(hierarchy, rootNode);
+            if (hierarchy.GetSize() > 0) {
+                uint32_t nDeleteNode = Hierarchy::INVALID_NODE;
+                this->DrawHierarchyNode(hierarchy, Hierarchy::ROOT, nDeleteNode);
+
+                /* Deleting shifts node indices, wait until the tree is drawn */
+                if (nDeleteNode != Hierarchy::INVALID_NODE) {
+                    hierarchy.DeleteNode(nDeleteNode);
+                }
             }
         }
     }
@@ -209,6 +221,39 @@ ImGuiPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx, u
     }
     ImGui::End();
 
+    /* GPU time per render graph node */
+    ImGui::Begin("GPU Timings");
+    if (this->m_gpuTimings.empty()) {
+        ImGui::Text("No GPU timestamps available");
+    }
+    else {
+        for (const GPUNodeTiming& timing : this->m_gpuTimings) {
+            ImGui::Text("%-16s %7.3f ms", timing.name, timing.fMilliseconds);
+        }
+
+        ImGui::Separator();
+        ImGui::Text("%-16s %7.3f ms", "Total", this->m_fGPUFrameTime);
+    }
+    ImGui::End();
+
+    /* Percentiles over the last FrameStats::WINDOW_SIZE frames */
+    ImGui::Begin("Frame Times");
+    {
+        FrameStats* pFrameStats = FrameStats::GetInstance();
+        FrameTimeStats cpu = pFrameStats->GetCPUStats();
+        FrameTimeStats gpu = pFrameStats->GetGPUStats();
+
+        ImGui::Text("%-4s %7s %7s %7s %7s", "", "p50", "p95", "p99", "max");
+        ImGui::Text("%-4s %7.2f %7.2f %7.2f %7.2f", "CPU", cpu.fP50, cpu.fP95, cpu.fP99, cpu.fMax);
+        if (gpu.nSamples > 0) {
+            ImGui::Text("%-4s %7.2f %7.2f %7.2f %7.2f", "GPU", gpu.fP50, gpu.fP95, gpu.fP99, gpu.fMax);
+        }
+
+        ImGui::Separator();
+        ImGui::Text("1%% low %.1f FPS, %u hitches", cpu.GetLowFPS(), pFrameStats->GetHitchCount());
+    }
+    ImGui::End();
+
     /* Main menu bar */
     if (ImGui::BeginMainMenuBar()) {
 	    if (ImGui::BeginMenu("File")) {
@@ -258,6 +303,8 @@ ImGuiPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx, u
 	    ImGui::EndMainMenuBar();
     }
 
+
+    sceneLock.unlock();
 	
 	this->m_imgui->Render(context);
 }
@@ -469,20 +516,24 @@ ImGuiPass::ShowAssetBrowser() {
 /**
 * Draw a hierarchy node
 * 
-* @param node Hierarchy node to draw
+* @param hierarchy Scene hierarchy
+* @param nNode Index of the node to draw
+* @param nDeleteNode Set to the node picked for deletion
 */
 void 
-ImGuiPass::DrawHierarchyNode(Hierarchy& hierarchy, const Ref<Hierarchy::HierarchyNode>& node) {
+ImGuiPass::DrawHierarchyNode(const Hierarchy& hierarchy, uint32_t nNode, uint32_t& nDeleteNode) {
     ImGuiTreeNodeFlags flags = 0;
 
-    const char* nodeID = node->name.data;
+    const Hierarchy::HierarchyNode& node = hierarchy.nodes[nNode];
+    const char* nodeID = node.name.data;
 
-    if (!node->HasChildren()) {
+    if (!node.HasChildren()) {
         flags |= ImGuiTreeNodeFlags_Leaf;
     }
 
+    /* IDs survive index changes, tree state stays with the node */
     bool bOpen = ImGui::TreeNodeEx(
-        static_cast<void*>(node.Get().get()),
+        reinterpret_cast<void*>(static_cast<uintptr_t>(node.id)),
         flags,
         "%s",
         nodeID
@@ -490,14 +541,14 @@ ImGuiPass::DrawHierarchyNode(Hierarchy& hierarchy, const Ref<Hierarchy::Hierarch
 
     if (ImGui::BeginPopupContextItem()) {
         if (ImGui::MenuItem("Delete")) {
-            hierarchy.DeleteNode(node);
+            nDeleteNode = nNode;
         }
         ImGui::EndPopup();
     }
 
     if (bOpen) {
-        for (const Ref<Hierarchy::HierarchyNode>& child : node->children) {
-            DrawHierarchyNode(hierarchy, child);
+        for (uint32_t nChild = node.nFirstChild; nChild != Hierarchy::INVALID_NODE; nChild = hierarchy.nodes[nChild].nNextSibling) {
+            this->DrawHierarchyNode(hierarchy, nChild, nDeleteNode);
         }
 
         ImGui::TreePop();
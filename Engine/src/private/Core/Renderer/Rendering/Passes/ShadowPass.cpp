@@ -88,7 +88,6 @@ ShadowPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx,
 
 	struct ShadowPushConstants {
 		glm::mat4 lightViewProj;
-		uint32_t nWvpAlignment;
 	};
 
 	Viewport vp = {
@@ -119,7 +118,6 @@ ShadowPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx,
 
 		ShadowPushConstants pc = { };
 		pc.lightViewProj = this->m_cascades[i].viewProj;
-		pc.nWvpAlignment = this->m_pCullingPass->GetWVPBuffer()->GetAlignment();
 
 		context->PushConstants(
 			this->m_pipelineLayout,
@@ -149,11 +147,11 @@ ShadowPass::Execute(Ref<GraphicsContext> context, RenderGraphContext& graphCtx,
 				nCurrentOffset,
 				this->m_shadowCountBuffers[i],
 				j * sizeof(uint32_t),
-				this->m_pCullingPass->GetMaxBatchesPerBlock(),
+				this->m_pCullingPass->GetMaxDrawsPerBlock(),
 				sizeof(DrawIndexedIndirectCommand)
 			);
 
-			nCurrentOffset += this->m_pCullingPass->GetMaxBatchesPerBlock() * sizeof(DrawIndexedIndirectCommand);
+			nCurrentOffset += this->m_pCullingPass->GetMaxDrawsPerBlock() * sizeof(DrawIndexedIndirectCommand);
 		}
 
 		context->EndRenderPass();
@@ -509,7 +507,7 @@ ShadowPass::CreateCullingResources() {
 
 	/* Create descriptor pool */
 	DescriptorPoolSize poolSize = { };
-	poolSize.nDescriptorCount = 6 * CSM_CASCADE_COUNT * this->m_nFramesInFlight;
+	poolSize.nDescriptorCount = 11 * CSM_CASCADE_COUNT * this->m_nFramesInFlight;
 	poolSize.type = EDescriptorType::STORAGE_BUFFER;
 
 	DescriptorPoolCreateInfo poolInfo = { };
@@ -531,25 +529,38 @@ ShadowPass::CreateCullingResources() {
 		Allocate descriptor sets
 
 		Bindings:
-		 0. Instance data (Reused)
-		 1. Batch data (Reused)
-		 2. Output commands (One per cascade)
-		 3. Draw count (One per cascade)
-		 4. WVP Data (Reused)
-		 5. Frustum data (From the Shader pass)
+		 0. Instance table (Reused)
+		 1. Material table (Reused, unused)
+		 2. Batch table (Reused)
+		 3. Output commands (One per cascade)
+		 4. Draw count (One per cascade)
+		 5. World matrix table (Reused)
+		 6. Frustum data (From the Shader pass)
+		 7. Visible slots (Reused, unused, cascades walk every slot)
+		 8. Draw group table (Reused)
+		 9. Group counts (Reused, each cascade is its own view)
+		 10. Group instance lists (Reused, same)
 	*/
+	DescriptorBufferInfo instanceInfo = { this->m_pCullingPass->GetInstanceTable(), 0, MAX_SCENE_INSTANCES * sizeof(ObjectInstanceData) };
+	DescriptorBufferInfo materialInfo = { this->m_pCullingPass->GetMaterialTable(), 0, MAX_SCENE_INSTANCES * sizeof(MaterialInstanceData) };
+	DescriptorBufferInfo batchInfo = { this->m_pCullingPass->GetBatchTable(), 0, MAX_SCENE_INSTANCES * sizeof(DrawBatch) };
+	DescriptorBufferInfo worldInfo = { this->m_pCullingPass->GetWorldTable(), 0, MAX_SCENE_TRANSFORMS * sizeof(glm::mat4) };
+
+	DescriptorBufferInfo groupInfo = { this->m_pCullingPass->GetGroupTable(), 0, MAX_DRAW_GROUPS * sizeof(DrawGroup) };
+	DescriptorBufferInfo groupCountInfo = { 
+		this->m_pCullingPass->GetGroupCountBuffer(), 
+		0, 
+		MAX_DRAW_GROUPS * CullingPass::MAX_CULL_VIEWS * sizeof(uint32_t) 
+	};
+
+	Ref<GPURingBuffer> visibleBuffer = this->m_pCullingPass->GetVisibleBuffer();
+	Ref<GPURingBuffer> groupInstanceBuffer = this->m_pCullingPass->GetGroupInstanceBuffer();
 
 	for (uint32_t i = 0; i < CSM_CASCADE_COUNT; i++) {
-		/* Define per frame sizes */
-		std::array<uint32_t, 7> frameSizes = {
-			this->m_pCullingPass->GetInstanceBuffer()->GetPerFrameSize(), // 0
-			this->m_pCullingPass->GetMaterialBuffer()->GetPerFrameSize(), // 1
-			this->m_pCullingPass->GetBatchBuffer()->GetPerFrameSize(), // 2
-			this->m_shadowIndirectBuffers[i]->GetPerFrameSize(), // 3
-			0, // 4 (Is not per frame)
-			this->m_pCullingPass->GetWVPBuffer()->GetPerFrameSize(), // 5
-			this->m_shadowFrustumBuffer->GetPerFrameSize(), // 6
-		};
+		uint32_t nIndirectSize = this->m_shadowIndirectBuffers[i]->GetPerFrameSize();
+		uint32_t nFrustumSize = this->m_shadowFrustumBuffer->GetPerFrameSize();
+		uint32_t nVisibleSize = visibleBuffer->GetPerFrameSize();
+		uint32_t nGroupInstanceSize = groupInstanceBuffer->GetPerFrameSize();
 
 		/* Create a descriptor set per frame in flight */
 		Vector<Ref<DescriptorSet>>& sets = this->m_shadowCullingSets[i];
@@ -557,40 +568,17 @@ ShadowPass::CreateCullingResources() {
 			sets[j] = this->m_device->CreateDescriptorSet(this->m_shadowCullingPool, cullingLayout);
 
 			Ref<DescriptorSet>& set = sets[j];
-			/* Binding 0: Instance data */
-			set->WriteBuffer(0, 0, {
-				this->m_pCullingPass->GetInstanceBuffer()->GetBuffer(), frameSizes[0] * j, frameSizes[0]
-				});
-
-			/* Binding 1: Material data (Unused) */
-			set->WriteBuffer(1, 0, {
-				this->m_pCullingPass->GetMaterialBuffer()->GetBuffer(), frameSizes[1] * j, frameSizes[2]
-			});
-
-			/* Binding 1: Batch data */
-			set->WriteBuffer(2, 0, {
-				this->m_pCullingPass->GetBatchBuffer()->GetBuffer(), frameSizes[2] * j, frameSizes[2]
-				});
-
-			/* Binding 2: Output commands */
-			set->WriteBuffer(3, 0, {
-				this->m_shadowIndirectBuffers[i]->GetBuffer(), frameSizes[3] * j, frameSizes[3]
-				});
-
-			/* Binding 3: Draw count */
-			set->WriteBuffer(4, 0, {
-				this->m_shadowCountBuffers[i], frameSizes[4] * j, 64 * sizeof(uint32_t)
-			});
-
-			/* Binding 4: WVP Data */
-			set->WriteBuffer(5, 0, {
-				this->m_pCullingPass->GetWVPBuffer()->GetBuffer(), frameSizes[5] * j, frameSizes[5]
-			});
-
-			/* Binding 5: Frustum data */
-			set->WriteBuffer(6, 0, {
-				this->m_shadowFrustumBuffer->GetBuffer(), frameSizes[6] * j, frameSizes[6]
-			});
+			set->WriteBuffer(0, 0, instanceInfo);
+			set->WriteBuffer(1, 0, materialInfo);
+			set->WriteBuffer(2, 0, batchInfo);
+			set->WriteBuffer(3, 0, { this->m_shadowIndirectBuffers[i]->GetBuffer(), nIndirectSize * j, nIndirectSize });
+			set->WriteBuffer(4, 0, { this->m_shadowCountBuffers[i], 0, 64 * sizeof(uint32_t) });
+			set->WriteBuffer(5, 0, worldInfo);
+			set->WriteBuffer(6, 0, { this->m_shadowFrustumBuffer->GetBuffer(), nFrustumSize * j, nFrustumSize });
+			set->WriteBuffer(7, 0, { visibleBuffer->GetBuffer(), nVisibleSize * j, nVisibleSize });
+			set->WriteBuffer(8, 0, groupInfo);
+			set->WriteBuffer(9, 0, groupCountInfo);
+			set->WriteBuffer(10, 0, { groupInstanceBuffer->GetBuffer(), nGroupInstanceSize * j, nGroupInstanceSize });
 
 			set->UpdateWrites();
 		}
@@ -607,15 +595,6 @@ ShadowPass::CreateCullingResources() {
 */
 void 
 ShadowPass::DispatchShadowCulling(Ref<GraphicsContext> context, uint32_t nCascadeIdx, uint32_t nFrameIdx) {
-	/* Reset count buffer to 0 */
-	Ref<GPUBuffer> countBuffer = this->m_shadowCountBuffers[nCascadeIdx];
-	context->FillBuffer(countBuffer, 0, sizeof(uint32_t) * 64, 0);
-	context->BufferMemoryBarrier(countBuffer, EAccess::TRANSFER_WRITE, EAccess::SHADER_WRITE);
-
-	if (this->m_pCullingPass->GetTotalBatches() == 0) {
-		return;
-	}
-
 	CascadeData cascade = this->m_cascades[nCascadeIdx];
 
 	/* Calculate frustum planes for this cascade */
@@ -632,48 +611,17 @@ ShadowPass::DispatchShadowCulling(Ref<GraphicsContext> context, uint32_t nCascad
 
 	memcpy(pFrustumData, &frustumData, sizeof(frustumData));
 
-	context->BindPipeline(this->m_pCullingPass->GetPipeline());
-	context->BindDescriptorSets(0, { this->m_shadowCullingSets[nCascadeIdx][nFrameIdx]});
-
-	/* Push constants */
-	struct {
-		uint32_t nTotalBatches;
-		uint32_t nWvpAlignment;
-		uint32_t nMaterialAlignment;
-		uint32_t nFrustumOffset;
-		uint32_t nFrustumAlignment;
-		uint32_t nMaxDrawsPerBlock;
-	} pushData;
-
-
-	pushData.nTotalBatches = this->m_pCullingPass->GetTotalBatches();
-	pushData.nWvpAlignment = this->m_pCullingPass->GetWVPBuffer()->GetAlignment();
-	pushData.nMaterialAlignment = this->m_pCullingPass->GetMaterialBuffer()->GetAlignment();
-	pushData.nFrustumOffset = nFrustumOffset;
-	pushData.nFrustumAlignment = this->m_shadowFrustumBuffer->GetAlignment();
-	pushData.nMaxDrawsPerBlock = this->m_pCullingPass->GetMaxBatchesPerBlock();
-
-	context->PushConstants(
-		this->m_pCullingPass->GetPipelineLayout(),
-		EShaderStage::COMPUTE,
-		0,
-		sizeof(pushData), &pushData
-	);
-
-	uint32_t nGroups = (pushData.nTotalBatches + 255) / 256;
-	context->Dispatch(nGroups, 1, 1);
-
-	context->BufferMemoryBarrier(
-		this->m_shadowIndirectBuffers[nCascadeIdx]->GetBuffer(),
-		EAccess::SHADER_WRITE, 
-		EAccess::INDIRECT_COMMAND_READ
-	);
-
-	context->BufferMemoryBarrier(
-		this->m_shadowCountBuffers[nCascadeIdx],
-		EAccess::SHADER_WRITE,
-		EAccess::INDIRECT_COMMAND_READ
-	);
+	/* Casters outside the camera frustum still cast, so every slot is tested */
+	CullViewInfo viewInfo = { };
+	viewInfo.nViewIdx = 1 + nCascadeIdx;
+	viewInfo.nBatchCount = this->m_pCullingPass->GetBatchSlotCount();
+	viewInfo.bUseVisibleList = false;
+	viewInfo.nFrustumOffset = nFrustumOffset;
+	viewInfo.nFrustumAlignment = this->m_shadowFrustumBuffer->GetAlignment();
+	viewInfo.indirectBuffer = this->m_shadowIndirectBuffers[nCascadeIdx]->GetBuffer();
+	viewInfo.countBuffer = this->m_shadowCountBuffers[nCascadeIdx];
+
+	this->m_pCullingPass->CullView(context, this->m_shadowCullingSets[nCascadeIdx][nFrameIdx], viewInfo);
 }
 
 /**
@@ -687,7 +635,7 @@ ShadowPass::CreatePipeline() {
 
 	/* Create pipeline layout */
 	PushConstantRange pushRange = { };
-	pushRange.nSize = sizeof(glm::mat4) + sizeof(uint32_t);
+	pushRange.nSize = sizeof(glm::mat4);
 	pushRange.stage = EShaderStage::VERTEX;
 	
 	PipelineLayoutCreateInfo layoutInfo = { };
@@ -40,6 +40,14 @@ void
 TonemapPass::SetupNode(RenderGraphBuilder& builder) {
 	builder.ReadTexture(this->m_input);
 
+	if (this->m_externalOutput.IsValid()) {
+		builder.UseColorOutput(this->m_externalOutput, this->m_externalFinalLayout);
+		this->m_output = this->m_externalOutput;
+
+		builder.SetDimensions(this->m_nWidth, this->m_nHeight);
+		return;
+	}
+
 	TextureDesc sceneDesc = { };
 	sceneDesc.format = GPUFormat::BGRA8_UNORM;
 	sceneDesc.nWidth = this->m_nWidth;
@@ -80,6 +88,12 @@ TonemapPass::SetInput(TextureHandle input) {
 	this->m_input = input;
 }
 
+void
+TonemapPass::SetOutput(TextureHandle output, EImageLayout finalLayout) {
+	this->m_externalOutput = output;
+	this->m_externalFinalLayout = finalLayout;
+}
+
 void 
 TonemapPass::SetScreenQuad(Ref<GPUBuffer> vertexBuffer, Ref<GPUBuffer> indexBuffer, uint32_t nIndexCount) {
 	this->m_vertexBuffer = vertexBuffer;
@@ -1,4 +1,5 @@
 #include "Core/Renderer/Rendering/RenderGraph.h"
+#include "Core/Utils/Profiler.h"
 
 /**
 * Setups the render graph
@@ -9,6 +10,61 @@ RenderGraph::Setup(Ref<Device> device, uint32_t nFramesInFlight){
     this->m_device = device;
     this->m_pool.Init(device);
     this->m_nFramesInFlight = nFramesInFlight;
+
+    this->CreateTimestampQueries();
+}
+
+/**
+* Creates one timestamp query pool per frame in 
+* flight, two queries (begin, end) per node
+*/
+void
+RenderGraph::CreateTimestampQueries() {
+    this->m_fTimestampPeriod = this->m_device->GetTimestampPeriod();
+
+    if (this->m_fTimestampPeriod <= 0.f) {
+        Logger::Warn("RenderGraph::CreateTimestampQueries: Device can't write timestamps, GPU timings disabled");
+        return;
+    }
+
+    QueryPoolCreateInfo queryInfo = { };
+    queryInfo.type = EQueryType::TIMESTAMP;
+    queryInfo.nQueryCount = MAX_TIMED_NODES * 2;
+
+    this->m_timestampFrames.resize(this->m_nFramesInFlight);
+    for (TimestampFrame& frame : this->m_timestampFrames) {
+        frame.queryPool = this->m_device->CreateQueryPool(queryInfo);
+    }
+}
+
+/**
+* Reads the timestamps a frame wrote the last time
+* it was recorded. Its fence was already waited, so
+* this doesn't stall. Unavailable results keep the
+* previous timings
+* 
+* @param frame Timestamp frame
+*/
+void
+RenderGraph::ReadTimestamps(TimestampFrame& frame) {
+    if (frame.nodeNames.empty()) return;
+
+    uint32_t nQueryCount = static_cast<uint32_t>(frame.nodeNames.size()) * 2;
+
+    Vector<uint64_t> timestamps;
+    if (!frame.queryPool->GetResults(0, nQueryCount, timestamps)) return;
+
+    float fTicksToMs = this->m_fTimestampPeriod / 1000000.f;
+
+    this->m_gpuTimings.resize(frame.nodeNames.size());
+    for (uint32_t i = 0; i < frame.nodeNames.size(); i++) {
+        GPUNodeTiming& timing = this->m_gpuTimings[i];
+        timing.name = frame.nodeNames[i];
+        timing.fMilliseconds = static_cast<float>(timestamps[i * 2 + 1] - timestamps[i * 2]) * fTicksToMs;
+    }
+
+    this->m_fGPUFrameTime = static_cast<float>(timestamps[nQueryCount - 1] - timestamps[0]) * fTicksToMs;
+    this->m_bNewGPUTimings = true;
 }
 
 /**
@@ -195,13 +251,41 @@ RenderGraph::CreateFramebuffers() {
 */
 void 
 RenderGraph::Execute(Ref<GraphicsContext> context) {
+    PROFILE_SCOPE("RenderGraph::Execute");
+
     RenderGraphContext graphCtx;
     graphCtx.m_pool = &this->m_pool;
 
-    for(GraphNode& node : this->m_nodes) {
+    /* Read what this frame slot wrote last time, then reuse its queries */
+    this->m_bNewGPUTimings = false;
+
+    TimestampFrame* pTimestamps = nullptr;
+    if (!this->m_timestampFrames.empty()) {
+        pTimestamps = &this->m_timestampFrames[this->m_nFrameIndex % this->m_timestampFrames.size()];
+
+        this->ReadTimestamps(*pTimestamps);
+        pTimestamps->nodeNames.clear();
+
+        context->ResetQueries(pTimestamps->queryPool, 0, pTimestamps->queryPool->GetQueryCount());
+    }
+
+    for(uint32_t i = 0; i < this->m_nodes.size(); i++) {
+        GraphNode& node = this->m_nodes[i];
+        PROFILE_SCOPE(node.name);
+
+        bool bTimed = pTimestamps != nullptr && i < MAX_TIMED_NODES;
+        if (bTimed) {
+            context->WriteTimestamp(pTimestamps->queryPool, i * 2, EPipelineStage::TOP_OF_PIPE);
+            pTimestamps->nodeNames.push_back(node.name);
+        }
+
         if (node.bIsComputeOnly) {
             node.execute(context, graphCtx);
             context->GlobalBarrier();
+
+            if (bTimed) {
+                context->WriteTimestamp(pTimestamps->queryPool, i * 2 + 1, EPipelineStage::BOTTOM_OF_PIPE);
+            }
             continue;
         }
 
@@ -211,7 +295,8 @@ RenderGraph::Execute(Ref<GraphicsContext> context) {
         beginInfo.framebuffer = node.framebuffer;
         beginInfo.renderArea = { { 0, 0 }, { node.nWidth, node.nHeight } };
 
-        for(uint32_t i = 0; i < node.colorOutputs.size(); ++i) {
+        /* Own index, i is the node's timestamp query slot */
+        for(uint32_t nOutput = 0; nOutput < node.colorOutputs.size(); ++nOutput) {
             beginInfo.clearValues.push_back(ClearValue { ClearColor {0.f, 0.f, 0.f, 1.f} });
         }
 
@@ -227,6 +312,10 @@ RenderGraph::Execute(Ref<GraphicsContext> context) {
 
         /* End the render pass */
         context->EndRenderPass();
+
+        if (bTimed) {
+            context->WriteTimestamp(pTimestamps->queryPool, i * 2 + 1, EPipelineStage::BOTTOM_OF_PIPE);
+        }
     }
 
     this->m_pool.EndFrame();
@@ -1,108 +1,630 @@
 #include "Core/Renderer/SceneCollector.h"
+#include "Core/Utils/Profiler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <xxhash.h>
 
 /**
 * Collects scene draw data
-* 
+*
 * @param scene Scene
-* 
-* @returns Collected draw data from scene
+* @param outData Collected draw data, its buffers are reused
 */
-CollectedDrawData
-SceneCollector::Collect(Scene* scene) {
-	CollectedDrawData result = { };
+void
+SceneCollector::Collect(Scene* scene, CollectedDrawData& outData) {
+	PROFILE_SCOPE("SceneCollector::Collect");
+
+	outData.transformUpdates.clear();
+	outData.instanceUpdates.clear();
+	outData.groupUpdates.clear();
+	outData.visibleBatches.clear();
+	outData.nSequence = 0;
+	outData.nTotalBatches = 0;
+	outData.nBatchSlotCount = 0;
+	outData.nGroupSlotCount = 0;
+	outData.nMaxDrawsPerBlock = 1;
+
+	if (!scene || !this->m_uploadedMeshes) return;
 
-	if (!scene || !this->m_uploadedMeshes) return result;
+	/* Slots of another scene mean nothing here */
+	if (scene != this->m_pScene) {
+		this->Reset(scene);
+	}
+
+	outData.nSequence = ++this->m_nSequence;
 
 	/* Get the current camera's View and Projection */
 	Camera* cam = scene->GetCurrentCamera();
 	glm::mat4 view = cam->GetView();
 	glm::mat4 proj = cam->GetProjection();
 
-	result.viewProj = view * proj;
-	result.view = view;
-	result.proj = proj;
-	result.cameraPosition = glm::vec3(cam->transform.location.x, cam->transform.location.y, cam->transform.location.z);
+	outData.viewProj = proj * view;
+	outData.view = view;
+	outData.proj = proj;
+	outData.cameraPosition = glm::vec3(cam->transform.location.x, cam->transform.location.y, cam->transform.location.z);
+
+	this->SyncObjects(scene);
+	this->SyncTransforms(scene);
+	this->LayoutGroups();
+
+	this->CollectVisible(scene, Frustum::FromMatrix(outData.viewProj), view, outData);
+	this->SortGroups();
+
+	this->EmitUpdates(outData);
+
+	outData.nTotalBatches = static_cast<uint32_t>(outData.visibleBatches.size());
+	outData.nBatchSlotCount = this->m_nInstanceSlotCount;
+	outData.nGroupSlotCount = static_cast<uint32_t>(this->m_groups.size());
+
+	for (uint32_t nCount : this->m_blockGroupCounts) {
+		outData.nMaxDrawsPerBlock = std::max(outData.nMaxDrawsPerBlock, nCount);
+	}
+}
+
+/**
+* Drops every slot, the next frame uploads
+* the whole scene again
+*
+* @param scene Scene the slots are for
+*/
+void
+SceneCollector::Reset(Scene* scene) {
+	this->m_pScene = scene;
+
+	this->m_records.clear();
+
+	this->m_worlds.clear();
+	this->m_instances.clear();
+	this->m_groups.clear();
+
+	this->m_freeTransformSlots.clear();
+	this->m_freeInstanceSlots.clear();
+	this->m_freeGroupSlots.clear();
+	this->m_nTransformSlotCount = 0;
+	this->m_nInstanceSlotCount = 0;
+
+	this->m_groupSlots.clear();
+	this->m_bGroupLayoutDirty = false;
+	this->m_bGroupOrderDirty = false;
+
+	this->m_blockGroupCounts.clear();
+
+	this->m_transformLog.Clear();
+	this->m_instanceLog.Clear();
+	this->m_groupLog.Clear();
+}
+
+/**
+* Gives slots to new mesh objects, frees the slots
+* of deleted ones and rebuilds objects whose mesh
+* was uploaded or unloaded since the last frame
+*
+* @param scene Scene
+*/
+void
+SceneCollector::SyncObjects(Scene* scene) {
+	Registry& registry = scene->GetRegistry();
+	ComponentPool<Mesh>& meshPool = registry.GetPool<Mesh>();
+	ComponentPool<WorldTransform>& worldPool = registry.GetPool<WorldTransform>();
+
+	const Vector<EntityID>& entities = meshPool.GetEntities();
+	const Vector<Mesh>& meshes = meshPool.GetComponents();
+
+	this->m_nSweep++;
+
+	for (uint32_t i = 0; i < meshes.size(); i++) {
+		const Mesh& mesh = meshes[i];
+		if (!mesh.IsLoaded()) continue;
 
-	Map<String, GameObject*> gameObjects;
-	Ref<Hierarchy::HierarchyNode> rootNode = scene->GetHierarchy().root;
-	this->CollectGameObjects(rootNode, gameObjects);
+		EntityID entity = entities[i];
 
-	for (auto& [name, gameObject] : gameObjects) {
-		/* Find a mesh component on the current GameObject */
-		Map<String, Component*> components = gameObject->GetComponents();
-		Map<String, Component*>::iterator it = components.find("MeshComponent");
-		if (it == components.end()) continue;
+		const WorldTransform* pWorldTransform = worldPool.Get(entity);
+		if (pWorldTransform == nullptr) continue;
 
-		Mesh* mesh = dynamic_cast<Mesh*>(it->second);
-		if (!mesh || !mesh->IsLoaded()) continue;
+		if (entity >= this->m_records.size()) {
+			this->m_records.resize(static_cast<size_t>(entity) + 1);
+		}
+
+		ObjectRecord& record = this->m_records[entity];
+		record.nSweep = this->m_nSweep;
+
+		uint32_t nGeneration = registry.GetHandle(entity).nGeneration;
+
+		bool bSameObject = record.bTracked && record.nGeneration == nGeneration;
+		if (bSameObject && record.nUploadGeneration == this->m_nUploadGeneration) continue;
 
 		/* Check if the mesh is on the uploaded meshes cache */
-		const String& meshName = mesh->GetMeshData().name;
-		Map<String, UploadedMesh>::const_iterator uploadIt = this->m_uploadedMeshes->find(meshName);
+		const UploadedMesh* pUpload = nullptr;
 
-		if (uploadIt == this->m_uploadedMeshes->end()) continue;
+		Map<String, UploadedMesh>::const_iterator uploadIt = this->m_uploadedMeshes->find(mesh.GetMeshData().name);
+		if (uploadIt != this->m_uploadedMeshes->end()) {
+			pUpload = &uploadIt->second;
+		}
 
-		const UploadedMesh& uploadedMesh = uploadIt->second;
-		glm::mat4 world = gameObject->transform.GetWorldMatrix();
+		record.nUploadGeneration = this->m_nUploadGeneration;
 
-		for (auto& [idx, subMesh] : uploadedMesh.subMeshes) {
-			uint32_t nWvpIdx = static_cast<uint32_t>(result.wvps.size());
-			uint32_t nMaterialIdx = static_cast<uint32_t>(result.materials.size());
+		/* Cache changed, but not for this mesh */
+		if (bSameObject && record.pUpload == pUpload && (pUpload == nullptr || pUpload->nUploadId == record.nUploadId)) continue;
 
-			WVP wvp = { };
-			wvp.World = world;
-			wvp.View = view;
-			wvp.Projection = proj;
+		this->ReleaseObject(record);
+		this->TrackObject(record, pUpload, pWorldTransform->world);
 
-			result.wvps.push_back(wvp);
+		record.nGeneration = nGeneration;
+	}
 
-			UploadedSubMeshMaterial uploadedMaterial = subMesh.material;
+	/* Deleted objects and meshes that got unloaded */
+	for (ObjectRecord& record : this->m_records) {
+		if (record.bTracked && record.nSweep != this->m_nSweep) {
+			this->ReleaseObject(record);
+		}
+	}
+}
 
-			MaterialInstanceData material = { };
-			material.albedoIndex = uploadedMaterial.nAlbedoIndex;
-			material.ormIndex = uploadedMaterial.nORMIndex;
-			material.emissiveIndex = uploadedMaterial.nEmissiveIndex;
-			material.normalIndex = uploadedMaterial.nNormalIndex;
+/**
+* Copies the world matrices that changed in the
+* last transform update
+*
+* @param scene Scene
+*/
+void
+SceneCollector::SyncTransforms(Scene* scene) {
+	ComponentPool<WorldTransform>& worldPool = scene->GetRegistry().GetPool<WorldTransform>();
 
-			material.albedoColor = uploadedMaterial.albedoColor;
-			material.emissiveColor = uploadedMaterial.emissiveColor;
-			material.ao = uploadedMaterial.ao;
-			material.roughness = uploadedMaterial.roughness;
-			material.metallic = uploadedMaterial.metallic;
-			material.materialFlags = uploadedMaterial.materialFlags;
+	for (EntityID entity : scene->GetChangedEntities()) {
+		if (entity >= this->m_records.size()) continue;
 
-			result.materials.push_back(material);
+		uint32_t nSlot = this->m_records[entity].nTransformSlot;
+		if (nSlot == INVALID_SLOT) continue;
 
-			ObjectInstanceData instance = { };
-			instance.wvpOffset = nWvpIdx * sizeof(WVP);
-			instance.materialOffset = nMaterialIdx * sizeof(MaterialInstanceData);
+		const WorldTransform* pWorldTransform = worldPool.Get(entity);
+		if (pWorldTransform == nullptr) continue;
 
-			result.instances.push_back(instance);
+		this->m_worlds[nSlot] = pWorldTransform->world;
+		this->m_transformLog.Mark(this->m_nSequence, nSlot);
+	}
+}
+
+/**
+* Packs the instance lists of the live draw groups
+* back to back, in slot order. Only runs when a
+* group gained or lost instances
+*/
+void
+SceneCollector::LayoutGroups() {
+	if (!this->m_bGroupLayoutDirty) return;
+	this->m_bGroupLayoutDirty = false;
 
-			DrawBatch batch = { };
-			batch.indexCount = subMesh.geometry.nIndexCount;
-			batch.firstIndex = subMesh.geometry.nFirstIndex;
-			batch.vertexOffset = subMesh.geometry.nVertexOffset;
-			batch.instanceDataIndex = static_cast<uint32_t>(result.instances.size() - 1);
-			batch.nBlockIdx = subMesh.nBlockIdx;
+	uint32_t nBase = 0;
 
-			result.batches.push_back(batch);
+	for (uint32_t i = 0; i < this->m_groups.size(); i++) {
+		DrawGroupRecord& record = this->m_groups[i];
+		if (record.nLiveCount == 0) continue;
+
+		if (record.group.instanceBase != nBase) {
+			record.group.instanceBase = nBase;
+			this->m_groupLog.Mark(this->m_nSequence, i);
 		}
+
+		nBase += record.nLiveCount;
 	}
+}
+
+/**
+* Lists the instance slots inside the frustum.
+* Off screen subtrees of the scene BVH are
+* skipped as a whole. Also finds the depth of
+* each group's nearest visible instance
+*
+* @param scene Scene
+* @param frustum Camera frustum
+* @param view Camera view matrix
+* @param outData Draw data, gets the visible slots
+*/
+void
+SceneCollector::CollectVisible(Scene* scene, const Frustum& frustum, const glm::mat4& view, CollectedDrawData& outData) {
+	this->m_groupDepths.assign(this->m_groups.size(), FLT_MAX);
+
+	auto addVisible = [&](uint32_t nSlot, float fDepth) {
+		outData.visibleBatches.push_back(nSlot);
+
+		float& fGroupDepth = this->m_groupDepths[this->m_instances[nSlot].batch.groupIndex];
+		fGroupDepth = std::min(fGroupDepth, fDepth);
+	};
+
+	this->m_visibleEntities.clear();
+	scene->GetBVH().QueryFrustum(frustum, this->m_visibleEntities);
+
+	ComponentPool<Mesh>& meshPool = scene->GetRegistry().GetPool<Mesh>();
+
+	for (EntityID entity : this->m_visibleEntities) {
+		if (entity >= this->m_records.size()) continue;
 
-	result.nTotalBatches = static_cast<uint32_t>(result.batches.size());
+		const ObjectRecord& record = this->m_records[entity];
+		if (record.instances.empty()) continue;
 
-	return result;
+		const glm::mat4& world = this->m_worlds[record.nTransformSlot];
+		float fDepth = -(view * world[3]).z;
+
+		if (record.instances.size() == 1) {
+			addVisible(record.instances[0].nSlot, fDepth);
+			continue;
+		}
+
+		/* The object is visible, some of its parts may not be */
+		const MeshData& meshData = meshPool.Get(entity)->GetMeshData();
+
+		for (const InstanceSlot& instance : record.instances) {
+			auto subDataIt = meshData.subMeshes.find(instance.nSubMeshIdx);
+
+			if (subDataIt != meshData.subMeshes.end() && !frustum.Intersects(subDataIt->second.bounds.Transform(world))) {
+				continue;
+			}
+
+			addVisible(instance.nSlot, fDepth);
+		}
+	}
 }
 
-void 
-SceneCollector::CollectGameObjects(Ref<Hierarchy::HierarchyNode> node, Map<String, GameObject*>& outObjects) {
-	if (node->pObj != nullptr)
-		outObjects[String(node->name)] = node->pObj;
+/**
+* Ranks the live draw groups of each block by
+* sort key, the rank is where the group's command
+* goes. Keys only change when a group comes or
+* goes or its nearest instance changes depth
+* bucket, the sort is skipped otherwise and only
+* groups whose rank moved are sent again
+*/
+void
+SceneCollector::SortGroups() {
+	bool bChanged = this->m_bGroupOrderDirty;
+	this->m_bGroupOrderDirty = false;
+
+	for (uint32_t i = 0; i < this->m_groups.size(); i++) {
+		DrawGroupRecord& record = this->m_groups[i];
+		if (record.nLiveCount == 0) continue;
 
-	if (!node->HasChildren())
-		return;
+		/* Off screen groups keep their last depth, the camera doesn't draw them */
+		uint32_t nDepth = DrawSortKey::GetDepth(record.nSortKey);
+		if (this->m_groupDepths[i] != FLT_MAX) {
+			nDepth = DrawSortKey::QuantizeDepth(this->m_groupDepths[i]);
+		}
+
+		uint64_t nKey = DrawSortKey::Make(
+			DrawSortKey::PASS_OPAQUE,
+			record.nPipeline,
+			record.group.nBlockIdx,
+			nDepth,
+			record.nMaterialId
+		);
+
+		if (nKey != record.nSortKey) {
+			record.nSortKey = nKey;
+			bChanged = true;
+		}
+	}
+
+	if (!bChanged) return;
+
+	PROFILE_SCOPE("SceneCollector::SortGroups");
+
+	this->m_sortItems.clear();
+	for (uint32_t i = 0; i < this->m_groups.size(); i++) {
+		if (this->m_groups[i].nLiveCount == 0) continue;
+		this->m_sortItems.push_back({ this->m_groups[i].nSortKey, i });
+	}
+
+	RadixSortDraws(this->m_sortItems, this->m_sortScratch);
+
+	/* The block is above the depth in the key, each block's groups are contiguous */
+	uint32_t nBlock = UINT32_MAX;
+	uint32_t nRank = 0;
+
+	for (const DrawSortItem& item : this->m_sortItems) {
+		DrawGroupRecord& record = this->m_groups[item.nIndex];
+
+		if (record.group.nBlockIdx != nBlock) {
+			nBlock = record.group.nBlockIdx;
+			nRank = 0;
+		}
+
+		if (record.group.drawOrder != nRank) {
+			record.group.drawOrder = nRank;
+			this->m_groupLog.Mark(this->m_nSequence, item.nIndex);
+		}
+
+		nRank++;
+	}
+}
+
+/**
+* Writes every slot changed after the last applied
+* sequence, once each and with its current value.
+* A frame that never made it to the GPU is covered
+* by the next one
+*
+* @param outData Draw data, gets the update lists
+*/
+void
+SceneCollector::EmitUpdates(CollectedDrawData& outData) {
+	uint64_t nApplied = this->m_nAppliedSequence.load(std::memory_order_acquire);
 
-	for(Ref<Hierarchy::HierarchyNode> children : node->children)
-		this->CollectGameObjects(children, outObjects);
-}
\ No newline at end of file
+	this->m_transformLog.DropApplied(nApplied);
+	this->m_instanceLog.DropApplied(nApplied);
+	this->m_groupLog.DropApplied(nApplied);
+
+	this->m_transformLog.ForEachPending(this->m_nSequence, [&](uint32_t nSlot) {
+		TransformUpdate update = { };
+		update.nSlot = nSlot;
+		update.world = this->m_worlds[nSlot];
+
+		outData.transformUpdates.push_back(update);
+	});
+
+	this->m_instanceLog.ForEachPending(this->m_nSequence, [&](uint32_t nSlot) {
+		outData.instanceUpdates.push_back(this->m_instances[nSlot]);
+	});
+
+	this->m_groupLog.ForEachPending(this->m_nSequence, [&](uint32_t nSlot) {
+		GroupUpdate update = { };
+		update.group = this->m_groups[nSlot].group;
+		update.nSlot = nSlot;
+
+		outData.groupUpdates.push_back(update);
+	});
+}
+
+/**
+* Gives an object a transform slot and an
+* instance slot per uploaded submesh. Each
+* instance joins the draw group of its submesh
+*
+* @param record Object record, without slots
+* @param pUpload Uploaded mesh, null if not uploaded yet
+* @param world World matrix
+*/
+void
+SceneCollector::TrackObject(ObjectRecord& record, const UploadedMesh* pUpload, const glm::mat4& world) {
+	record.bTracked = true;
+	record.pUpload = pUpload;
+	record.nUploadId = pUpload ? pUpload->nUploadId : 0;
+
+	if (pUpload == nullptr) return;
+
+	record.nTransformSlot = this->AllocateTransformSlot();
+	if (record.nTransformSlot == INVALID_SLOT) return;
+
+	this->m_worlds[record.nTransformSlot] = world;
+	this->m_transformLog.Mark(this->m_nSequence, record.nTransformSlot);
+
+	for (auto& [idx, subMesh] : pUpload->subMeshes) {
+		uint32_t nGroup = this->AcquireGroup(pUpload->nUploadId, idx, subMesh);
+		if (nGroup == INVALID_DRAW_GROUP) break;
+
+		uint32_t nSlot = this->AllocateInstanceSlot();
+		if (nSlot == INVALID_SLOT) {
+			this->ReleaseGroup(nGroup);
+			break;
+		}
+
+		const UploadedSubMeshMaterial& uploadedMaterial = subMesh.material;
+
+		InstanceUpdate& update = this->m_instances[nSlot];
+		update = { };
+
+		update.material.albedoIndex = uploadedMaterial.nAlbedoIndex;
+		update.material.ormIndex = uploadedMaterial.nORMIndex;
+		update.material.emissiveIndex = uploadedMaterial.nEmissiveIndex;
+		update.material.normalIndex = uploadedMaterial.nNormalIndex;
+
+		update.material.albedoColor = uploadedMaterial.albedoColor;
+		update.material.emissiveColor = uploadedMaterial.emissiveColor;
+		update.material.ao = uploadedMaterial.ao;
+		update.material.roughness = uploadedMaterial.roughness;
+		update.material.metallic = uploadedMaterial.metallic;
+		update.material.materialFlags = uploadedMaterial.materialFlags;
+
+		update.batch.groupIndex = nGroup;
+		update.batch.instanceDataIndex = nSlot;
+
+		update.instance.transformIndex = record.nTransformSlot;
+		update.instance.materialIndex = nSlot;
+
+		update.nSlot = nSlot;
+
+		record.instances.push_back({ nSlot, idx });
+		this->m_instanceLog.Mark(this->m_nSequence, nSlot);
+	}
+}
+
+/**
+* Frees the slots of an object. Its instances
+* are sent without a group, culling skips them
+*
+* @param record Object record
+*/
+void
+SceneCollector::ReleaseObject(ObjectRecord& record) {
+	for (const InstanceSlot& instance : record.instances) {
+		InstanceUpdate& update = this->m_instances[instance.nSlot];
+		this->ReleaseGroup(update.batch.groupIndex);
+
+		update = { };
+		update.batch.groupIndex = INVALID_DRAW_GROUP;
+		update.nSlot = instance.nSlot;
+
+		this->m_instanceLog.Mark(this->m_nSequence, instance.nSlot);
+		this->m_freeInstanceSlots.push_back(instance.nSlot);
+	}
+	record.instances.clear();
+
+	if (record.nTransformSlot != INVALID_SLOT) {
+		this->m_freeTransformSlots.push_back(record.nTransformSlot);
+		record.nTransformSlot = INVALID_SLOT;
+	}
+
+	record.bTracked = false;
+	record.pUpload = nullptr;
+	record.nUploadId = 0;
+}
+
+/**
+* Adds an instance to the draw group of an
+* uploaded submesh, creating the group if it's
+* the first one. Instances of a group share
+* the mesh allocation and the material
+*
+* @param nUploadId UploadedMesh::nUploadId
+* @param nSubMeshIdx Submesh index
+* @param subMesh Uploaded submesh
+*
+* @returns Group slot, INVALID_DRAW_GROUP if out of slots
+*/
+uint32_t
+SceneCollector::AcquireGroup(uint32_t nUploadId, uint32_t nSubMeshIdx, const UploadedSubMesh& subMesh) {
+	uint64_t nKey = (static_cast<uint64_t>(nUploadId) << 32) | nSubMeshIdx;
+
+	auto groupIt = this->m_groupSlots.find(nKey);
+	if (groupIt != this->m_groupSlots.end()) {
+		this->m_groups[groupIt->second].nLiveCount++;
+		this->m_bGroupLayoutDirty = true;
+
+		return groupIt->second;
+	}
+
+	uint32_t nGroup = INVALID_DRAW_GROUP;
+
+	if (!this->m_freeGroupSlots.empty()) {
+		nGroup = this->m_freeGroupSlots.back();
+		this->m_freeGroupSlots.pop_back();
+	}
+	else if (this->m_groups.size() < MAX_DRAW_GROUPS) {
+		nGroup = static_cast<uint32_t>(this->m_groups.size());
+		this->m_groups.emplace_back();
+	}
+	else {
+		Logger::Error("SceneCollector::AcquireGroup: Out of draw group slots ({})", MAX_DRAW_GROUPS);
+		return INVALID_DRAW_GROUP;
+	}
+
+	DrawGroupRecord& record = this->m_groups[nGroup];
+	record.nKey = nKey;
+	record.nLiveCount = 1;
+
+	record.group = { };
+	record.group.indexCount = subMesh.geometry.nIndexCount;
+	record.group.firstIndex = subMesh.geometry.nFirstIndex;
+	record.group.vertexOffset = subMesh.geometry.nVertexOffset;
+	record.group.nBlockIdx = subMesh.nBlockIdx;
+
+	/* Bindless textures, the material only decides what gets sampled */
+	const UploadedSubMeshMaterial& material = subMesh.material;
+	uint32_t textures[4] = { material.nAlbedoIndex, material.nORMIndex, material.nEmissiveIndex, material.nNormalIndex };
+
+	record.nSortKey = 0;
+	record.nMaterialId = XXH64(textures, sizeof(textures), 0);
+	record.nPipeline = material.materialFlags;
+
+	this->m_groupSlots[nKey] = nGroup;
+
+	if (subMesh.nBlockIdx >= this->m_blockGroupCounts.size()) {
+		this->m_blockGroupCounts.resize(static_cast<size_t>(subMesh.nBlockIdx) + 1, 0);
+	}
+	this->m_blockGroupCounts[subMesh.nBlockIdx]++;
+
+	this->m_bGroupLayoutDirty = true;
+	this->m_bGroupOrderDirty = true;
+	this->m_groupLog.Mark(this->m_nSequence, nGroup);
+
+	return nGroup;
+}
+
+/**
+* Removes an instance from its draw group. The
+* last one out sends the group as dead
+*
+* @param nGroup Group slot
+*/
+void
+SceneCollector::ReleaseGroup(uint32_t nGroup) {
+	if (nGroup == INVALID_DRAW_GROUP) return;
+
+	DrawGroupRecord& record = this->m_groups[nGroup];
+	this->m_bGroupLayoutDirty = true;
+
+	if (--record.nLiveCount > 0) return;
+
+	this->m_groupSlots.erase(record.nKey);
+	this->m_blockGroupCounts[record.group.nBlockIdx]--;
+
+	record.nKey = 0;
+	record.group = { };
+	this->m_bGroupOrderDirty = true;
+
+	this->m_groupLog.Mark(this->m_nSequence, nGroup);
+	this->m_freeGroupSlots.push_back(nGroup);
+}
+
+uint32_t
+SceneCollector::AllocateTransformSlot() {
+	if (!this->m_freeTransformSlots.empty()) {
+		uint32_t nSlot = this->m_freeTransformSlots.back();
+		this->m_freeTransformSlots.pop_back();
+		return nSlot;
+	}
+
+	if (this->m_nTransformSlotCount >= MAX_SCENE_TRANSFORMS) {
+		Logger::Error("SceneCollector::AllocateTransformSlot: Out of transform slots ({})", MAX_SCENE_TRANSFORMS);
+		return INVALID_SLOT;
+	}
+
+	this->m_worlds.emplace_back(1.f);
+
+	return this->m_nTransformSlotCount++;
+}
+
+uint32_t
+SceneCollector::AllocateInstanceSlot() {
+	if (!this->m_freeInstanceSlots.empty()) {
+		uint32_t nSlot = this->m_freeInstanceSlots.back();
+		this->m_freeInstanceSlots.pop_back();
+		return nSlot;
+	}
+
+	if (this->m_nInstanceSlotCount >= MAX_SCENE_INSTANCES) {
+		Logger::Error("SceneCollector::AllocateInstanceSlot: Out of instance slots ({})", MAX_SCENE_INSTANCES);
+		return INVALID_SLOT;
+	}
+
+	this->m_instances.emplace_back();
+
+	return this->m_nInstanceSlotCount++;
+}
+
+void
+SceneCollector::ChangeLog::Mark(uint64_t nSequence, uint32_t nSlot) {
+	if (nSlot >= this->emitted.size()) {
+		this->emitted.resize(static_cast<size_t>(nSlot) + 1, 0);
+	}
+
+	this->changes.push_back({ nSequence, nSlot });
+}
+
+/**
+* Forgets the changes the renderer already applied
+*
+* @param nApplied Last applied sequence
+*/
+void
+SceneCollector::ChangeLog::DropApplied(uint64_t nApplied) {
+	auto firstPending = std::find_if(this->changes.begin(), this->changes.end(), [nApplied](const SlotChange& change) {
+		return change.nSequence > nApplied;
+	});
+
+	this->changes.erase(this->changes.begin(), firstPending);
+}
+
+void
+SceneCollector::ChangeLog::Clear() {
+	this->changes.clear();
+	this->emitted.clear();
+}
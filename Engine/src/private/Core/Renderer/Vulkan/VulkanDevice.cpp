@@ -525,6 +525,16 @@ VulkanDevice::TransitionLayout(
 */
 Ref<Swapchain> 
 VulkanDevice::CreateSwapchain(const SwapchainCreateInfo& createInfo) {
+	Ref<VulkanDevice> deviceRef = std::static_pointer_cast<VulkanDevice>(this->shared_from_this());
+
+	/* Offscreen image chain for headless runs */
+	if (createInfo.bOffscreen) {
+		Ref<VulkanOffscreenSwapchain> offscreen = VulkanOffscreenSwapchain::CreateShared(deviceRef);
+		offscreen->Create(createInfo);
+
+		return offscreen.As<Swapchain>();
+	}
+
 	if (!createInfo.pWindow) {
 		Logger::Error("VulkanDevice::CreateSwapchain: createInfo.pWindow is null");
 		throw std::runtime_error("VulkanDevice::CreateSwapchain: createInfo.pWindow is null");
@@ -539,8 +549,6 @@ VulkanDevice::CreateSwapchain(const SwapchainCreateInfo& createInfo) {
 			&surface),
 		"Failed to create window surface");
 
-	Ref<VulkanDevice> deviceRef = std::static_pointer_cast<VulkanDevice>(this->shared_from_this());
-
 	Ref<VulkanSwapchain> swapchain = VulkanSwapchain::CreateShared(deviceRef, surface);
 	swapchain->Create(createInfo);
 
@@ -750,6 +758,39 @@ VulkanDevice::CreateFence(const FenceCreateInfo& createInfo) {
 	return fence.As<Fence>();
 }
 
+/**
+* Creates a Vulkan query pool
+* 
+* @param createInfo Query pool create info
+*
+* @returns Created Vulkan query pool
+*/
+Ref<QueryPool>
+VulkanDevice::CreateQueryPool(const QueryPoolCreateInfo& createInfo) {
+	Ref<VulkanDevice> deviceRef = std::static_pointer_cast<VulkanDevice>(this->shared_from_this());
+	Ref<VulkanQueryPool> queryPool = VulkanQueryPool::CreateShared(deviceRef);
+	queryPool->Create(createInfo);
+
+	return queryPool.As<QueryPool>();
+}
+
+/**
+* Gets the timestamp period of the graphics queue
+* 
+* @returns Nanoseconds per tick, 0 if the graphics 
+* queue family has no valid timestamp bits
+*/
+float
+VulkanDevice::GetTimestampPeriod() {
+	uint32_t nGraphicsFamily = this->GetGraphicsQueueFamily();
+
+	if (this->m_queueFamilyProperties[nGraphicsFamily].timestampValidBits == 0) {
+		return 0.f;
+	}
+
+	return this->m_devProperties.limits.timestampPeriod;
+}
+
 /**
 * Creates a Vulkan ImGui implementation
 *
@@ -948,8 +989,14 @@ VulkanDevice::FindQueueFamilies() {
 			indices.graphicsFamily = i;
 		}
 
+		/* Headless: the graphics queue doubles as the present queue */
 		VkBool32 bPresentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(this->m_physicalDevice, i, this->m_surface, &bPresentSupport);
+		if (this->m_surface == VK_NULL_HANDLE) {
+			bPresentSupport = indices.graphicsFamily.has_value() && indices.graphicsFamily.value() == i;
+		}
+		else {
+			vkGetPhysicalDeviceSurfaceSupportKHR(this->m_physicalDevice, i, this->m_surface, &bPresentSupport);
+		}
 
 		if (bPresentSupport) {
 			indices.presentFamily = i;
@@ -1,5 +1,6 @@
 #include "Core/Renderer/Vulkan/VulkanGraphicsContext.h"
 #include "Core/Renderer/Vulkan/VulkanTexture.h"
+#include "Core/Renderer/Vulkan/VulkanQueryPool.h"
 
 VulkanGraphicsContext::VulkanGraphicsContext(Ref<VulkanCommandBuffer> commandBuffer) 
 	: m_commandBuffer(commandBuffer), m_currentPipeline(VK_NULL_HANDLE), 
@@ -530,3 +531,31 @@ VulkanGraphicsContext::GlobalBarrier() {
 	);
 }
 
+/**
+* Resets queries
+*
+* @param queryPool Query pool
+* @param nFirstQuery First query
+* @param nQueryCount Query count
+*/
+void
+VulkanGraphicsContext::ResetQueries(Ref<QueryPool> queryPool, uint32_t nFirstQuery, uint32_t nQueryCount) {
+	VkQueryPool vkQueryPool = queryPool.As<VulkanQueryPool>()->GetVkQueryPool();
+
+	vkCmdResetQueryPool(this->m_commandBuffer->GetVkCommandBuffer(), vkQueryPool, nFirstQuery, nQueryCount);
+}
+
+/**
+* Writes a timestamp
+*
+* @param queryPool Timestamp query pool
+* @param nQuery Query index
+* @param stage Pipeline stage (single stage)
+*/
+void
+VulkanGraphicsContext::WriteTimestamp(Ref<QueryPool> queryPool, uint32_t nQuery, EPipelineStage stage) {
+	VkQueryPool vkQueryPool = queryPool.As<VulkanQueryPool>()->GetVkQueryPool();
+	VkPipelineStageFlagBits vkStage = static_cast<VkPipelineStageFlagBits>(VulkanHelpers::ConvertPipelineStage(stage));
+
+	vkCmdWriteTimestamp(this->m_commandBuffer->GetVkCommandBuffer(), vkStage, vkQueryPool, nQuery);
+}
@@ -1,5 +1,7 @@
 #include "Core/Renderer/Vulkan/VulkanImGuiImpl.h"
 
+#include <algorithm>
+
 VulkanImGuiImpl::VulkanImGuiImpl(Ref<VulkanDevice> device) 
 	: m_device(device) {}
 
@@ -20,8 +22,9 @@ VulkanImGuiImpl::Create(const ImGuiImplCreateInfo& createInfo) {
 	initInfo.Device = this->m_device->GetVkDevice();
 	initInfo.Queue = this->m_device->GetGraphicsQueue();
 	initInfo.QueueFamily = this->m_device->GetGraphicsQueueFamily();
-	initInfo.MinImageCount = createInfo.nFramesInFlight;
-	initInfo.ImageCount = createInfo.nFramesInFlight;
+	/* ImGui wants at least 2, even with a single frame in flight */
+	initInfo.MinImageCount = std::max(createInfo.nFramesInFlight, 2u);
+	initInfo.ImageCount = initInfo.MinImageCount;
 	initInfo.DescriptorPool = createInfo.descriptorPool.As<VulkanDescriptorPool>()->GetVkPool();
 	initInfo.PipelineInfoMain.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 	initInfo.PipelineInfoMain.Subpass = 0;
@@ -0,0 +1,231 @@
+#include "Core/Renderer/Vulkan/VulkanOffscreenSwapchain.h"
+#include "Core/Renderer/Vulkan/VulkanDevice.h"
+
+VulkanOffscreenSwapchain::VulkanOffscreenSwapchain(Ref<VulkanDevice> device)
+	: m_device(device) {}
+
+/**
+* Creates the offscreen image chain
+*
+* @param createInfo Swap chain create info
+*/
+void
+VulkanOffscreenSwapchain::Create(const SwapchainCreateInfo& createInfo) {
+	this->m_nImageCount = createInfo.nImageCount > 0 ? createInfo.nImageCount : 1;
+	this->m_extent = Extent2D { createInfo.width, createInfo.height };
+
+	if (this->m_extent.width == 0 || this->m_extent.height == 0) {
+		Logger::Error("VulkanOffscreenSwapchain::Create: Extent can't be 0");
+		throw std::runtime_error("VulkanOffscreenSwapchain::Create: Extent can't be 0");
+	}
+
+	this->CreateImages();
+	this->CreateDepthResources();
+
+	Logger::Debug(
+		"VulkanOffscreenSwapchain::Create: Offscreen chain created. {}x{}, image count: {}",
+		this->m_extent.width,
+		this->m_extent.height,
+		this->m_nImageCount
+	);
+}
+
+/**
+* Acquires the next offscreen image
+*
+* There is no presentation engine, so the semaphore
+* is signaled through an empty queue submission
+*
+* @param nTimeout Unused
+* @param signalSemaphore Semaphore for when the image is available
+* @param signalFence Fence for when the image is available (optional)
+*
+* @returns Acquired image index
+*/
+uint32_t
+VulkanOffscreenSwapchain::AcquireNextImage(
+	uint64_t nTimeout,
+	Ref<Semaphore> signalSemaphore,
+	Ref<Fence> signalFence
+) {
+	uint32_t nImageIndex = this->m_nNextImage;
+	this->m_nNextImage = (this->m_nNextImage + 1) % this->m_nImageCount;
+
+	if (signalSemaphore || signalFence) {
+		SubmitInfo submitInfo = { };
+		if (signalSemaphore) {
+			submitInfo.signalSemaphores = { signalSemaphore };
+		}
+
+		this->m_device->Submit(submitInfo, signalFence);
+	}
+
+	return nImageIndex;
+}
+
+/**
+* "Presents" an offscreen image
+*
+* Waits on the given semaphores so they are
+* unsignaled for the next frame
+*
+* @param nImageIndex Image index
+* @param pWaitSemaphores Semaphores to consume (optional)
+*
+* @returns Always true
+*/
+bool
+VulkanOffscreenSwapchain::Present(
+	uint32_t nImageIndex,
+	const Vector<Ref<Semaphore>>& pWaitSemaphores
+) {
+	if (pWaitSemaphores.empty()) {
+		return true;
+	}
+
+	SubmitInfo submitInfo = { };
+	submitInfo.waitSemaphores = pWaitSemaphores;
+	submitInfo.waitStages.resize(pWaitSemaphores.size(), EPipelineStage::ALL_COMMANDS);
+
+	this->m_device->Submit(submitInfo, Ref<Fence>());
+	return true;
+}
+
+/**
+* Recreates the image chain with new dimensions
+*
+* @param nNewWidth New width
+* @param nNewHeight New height
+*/
+void
+VulkanOffscreenSwapchain::Rebuild(uint32_t nNewWidth, uint32_t nNewHeight) {
+	if (nNewWidth == 0 || nNewHeight == 0) {
+		return;
+	}
+
+	this->m_device->WaitIdle();
+
+	this->m_imageViews.clear();
+	this->m_images.clear();
+	this->m_depthImageView = nullptr;
+	this->m_depthImage = nullptr;
+
+	this->m_extent = Extent2D { nNewWidth, nNewHeight };
+	this->m_nNextImage = 0;
+
+	this->CreateImages();
+	this->CreateDepthResources();
+}
+
+/**
+* Creates color images and views
+*/
+void
+VulkanOffscreenSwapchain::CreateImages() {
+	Extent3D extent = { };
+	extent.width = this->m_extent.width;
+	extent.height = this->m_extent.height;
+	extent.depth = 1;
+
+	this->m_images.resize(this->m_nImageCount);
+	this->m_imageViews.resize(this->m_nImageCount);
+
+	for (uint32_t i = 0; i < this->m_nImageCount; i++) {
+		TextureCreateInfo textureInfo = { };
+		textureInfo.usage = ETextureUsage::COLOR_ATTACHMENT | ETextureUsage::TRANSFER_SRC | ETextureUsage::SAMPLED;
+		textureInfo.extent = extent;
+		textureInfo.tiling = ETextureTiling::OPTIMAL;
+		textureInfo.sharingMode = ESharingMode::EXCLUSIVE;
+		textureInfo.format = COLOR_FORMAT;
+		textureInfo.samples = ESampleCount::SAMPLE_1;
+		textureInfo.imageType = ETextureDimensions::TYPE_2D;
+		textureInfo.initialLayout = ETextureLayout::UNDEFINED;
+
+		Ref<VulkanTexture> image = VulkanTexture::CreateShared(this->m_device);
+		image->Create(textureInfo, "OffscreenImage" + std::to_string(i));
+
+		ImageViewCreateInfo viewInfo = { };
+		viewInfo.image = image.As<GPUTexture>();
+		viewInfo.viewType = EImageViewType::TYPE_2D;
+		viewInfo.format = COLOR_FORMAT;
+
+		viewInfo.subresourceRange.aspectMask = EImageAspect::COLOR;
+		viewInfo.subresourceRange.nBaseArrayLayer = 0;
+		viewInfo.subresourceRange.nLayerCount = 1;
+		viewInfo.subresourceRange.nBaseMipLevel = 0;
+		viewInfo.subresourceRange.nLevelCount = 1;
+
+		viewInfo.components.r = ComponentMapping::ESwizzle::IDENTITY;
+		viewInfo.components.g = ComponentMapping::ESwizzle::IDENTITY;
+		viewInfo.components.b = ComponentMapping::ESwizzle::IDENTITY;
+		viewInfo.components.a = ComponentMapping::ESwizzle::IDENTITY;
+
+		Ref<VulkanImageView> imageView = VulkanImageView::CreateShared(this->m_device->GetVkDevice());
+		imageView->Create(viewInfo);
+
+		this->m_images[i] = image.As<GPUTexture>();
+		this->m_imageViews[i] = imageView.As<ImageView>();
+	}
+}
+
+/**
+* Creates depth resources
+*/
+void
+VulkanOffscreenSwapchain::CreateDepthResources() {
+	Vector<VkFormat> candidates = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT };
+
+	VkFormat depthFormat = this->m_device->FindSupportedFormat(
+		candidates,
+		VK_IMAGE_TILING_OPTIMAL,
+		VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+	);
+
+	Extent3D extent = { };
+	extent.width = this->m_extent.width;
+	extent.height = this->m_extent.height;
+	extent.depth = 1;
+
+	TextureCreateInfo textureInfo = { };
+	textureInfo.usage = ETextureUsage::DEPTH_STENCIL_ATTACHMENT | ETextureUsage::SAMPLED;
+	textureInfo.extent = extent;
+	textureInfo.tiling = ETextureTiling::OPTIMAL;
+	textureInfo.sharingMode = ESharingMode::EXCLUSIVE;
+	textureInfo.format = VulkanHelpers::RevertFormat(depthFormat);
+	textureInfo.samples = ESampleCount::SAMPLE_1;
+	textureInfo.imageType = ETextureDimensions::TYPE_2D;
+	textureInfo.initialLayout = ETextureLayout::UNDEFINED;
+
+	Ref<VulkanTexture> depthImage = VulkanTexture::CreateShared(this->m_device);
+	depthImage->Create(textureInfo, "OffscreenDepth");
+
+	ImageViewCreateInfo viewInfo = { };
+	viewInfo.image = depthImage.As<GPUTexture>();
+	viewInfo.viewType = EImageViewType::TYPE_2D;
+	viewInfo.format = VulkanHelpers::RevertFormat(depthFormat);
+
+	viewInfo.subresourceRange.aspectMask = EImageAspect::DEPTH;
+	viewInfo.subresourceRange.nBaseArrayLayer = 0;
+	viewInfo.subresourceRange.nLayerCount = 1;
+	viewInfo.subresourceRange.nBaseMipLevel = 0;
+	viewInfo.subresourceRange.nLevelCount = 1;
+
+	viewInfo.components.r = ComponentMapping::ESwizzle::IDENTITY;
+	viewInfo.components.g = ComponentMapping::ESwizzle::IDENTITY;
+	viewInfo.components.b = ComponentMapping::ESwizzle::IDENTITY;
+	viewInfo.components.a = ComponentMapping::ESwizzle::IDENTITY;
+
+	Ref<VulkanImageView> depthImageView = VulkanImageView::CreateShared(this->m_device->GetVkDevice());
+	depthImageView->Create(viewInfo);
+
+	this->m_depthImage = depthImage.As<GPUTexture>();
+	this->m_depthImageView = depthImageView.As<ImageView>();
+	this->m_depthFormat = VulkanHelpers::RevertFormat(depthFormat);
+
+	this->m_device->TransitionLayout(
+		this->m_depthImage,
+		this->m_depthFormat,
+		EImageLayout::UNDEFINED,
+		EImageLayout::DEPTH_STENCIL_ATTACHMENT
+	);
+}
@@ -0,0 +1,85 @@
+#include "Core/Renderer/Vulkan/VulkanQueryPool.h"
+
+VkQueryType
+ConvertQueryType(EQueryType type) {
+	switch (type) {
+	case EQueryType::TIMESTAMP:
+		return VK_QUERY_TYPE_TIMESTAMP;
+	}
+
+	return VK_QUERY_TYPE_TIMESTAMP;
+}
+
+VulkanQueryPool::VulkanQueryPool(Ref<VulkanDevice> device)
+	: m_device(device), m_queryPool(VK_NULL_HANDLE), m_nQueryCount(0) { }
+
+VulkanQueryPool::~VulkanQueryPool() {
+	VkDevice vkDevice = this->m_device->GetVkDevice();
+
+	if (this->m_queryPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(vkDevice, this->m_queryPool, nullptr);
+	}
+}
+
+/**
+* Creates a Vulkan query pool
+* 
+* Queries start unavailable, they must be reset
+* from a command buffer before their first write
+* 
+* @param createInfo Query pool create info
+*/
+void
+VulkanQueryPool::Create(const QueryPoolCreateInfo& createInfo) {
+	VkDevice vkDevice = this->m_device->GetVkDevice();
+
+	VkQueryPoolCreateInfo poolInfo = { };
+	poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType = ConvertQueryType(createInfo.type);
+	poolInfo.queryCount = createInfo.nQueryCount;
+
+	VK_CHECK(
+		vkCreateQueryPool(
+			vkDevice,
+			&poolInfo,
+			nullptr,
+			&this->m_queryPool
+		),
+		"Failed to create query pool");
+
+	this->m_nQueryCount = createInfo.nQueryCount;
+}
+
+/**
+* Reads query results without waiting
+* 
+* @param nFirstQuery First query
+* @param nQueryCount Query count
+* @param results Output results, one per query
+* 
+* @returns True if every query was available
+*/
+bool
+VulkanQueryPool::GetResults(uint32_t nFirstQuery, uint32_t nQueryCount, Vector<uint64_t>& results) {
+	if (nFirstQuery + nQueryCount > this->m_nQueryCount) {
+		Logger::Error("VulkanQueryPool::GetResults: Range {}+{} out of bounds ({} queries)", nFirstQuery, nQueryCount, this->m_nQueryCount);
+		return false;
+	}
+
+	VkDevice vkDevice = this->m_device->GetVkDevice();
+
+	results.resize(nQueryCount);
+
+	VkResult result = vkGetQueryPoolResults(
+		vkDevice,
+		this->m_queryPool,
+		nFirstQuery,
+		nQueryCount,
+		results.size() * sizeof(uint64_t),
+		results.data(),
+		sizeof(uint64_t),
+		VK_QUERY_RESULT_64_BIT
+	);
+
+	return result == VK_SUCCESS;
+}
@@ -108,14 +108,19 @@ void VulkanRenderer::Create(GLFWwindow* pWindow) {
 		);
 	}
 
-	/* Create window surface */
-	VK_CHECK(
-		glfwCreateWindowSurface(
-			this->m_instance, 
-			this->m_pWindow, 
-			nullptr, 
-			&this->m_surface
-		), "Couldn't create window surface");
+	/* Create window surface (headless runs have no window and no surface) */
+	if (this->m_pWindow != nullptr) {
+		VK_CHECK(
+			glfwCreateWindowSurface(
+				this->m_instance, 
+				this->m_pWindow, 
+				nullptr, 
+				&this->m_surface
+			), "Couldn't create window surface");
+	}
+	else {
+		Logger::Info("VulkanRenderer::Create: No window provided, running headless");
+	}
 
 	this->PickPhysicalDevice();
 	this->CheckDescirptorIndexingSupport();
@@ -136,7 +141,7 @@ VulkanRenderer::CreateDevice() {
 	if (this->m_bEnableValidationLayers) {
 		deviceInfo.validationLayers = validationLayers;
 	}
-	deviceInfo.requiredExtensions = deviceExtensions;
+	deviceInfo.requiredExtensions = this->GetDeviceExtensions();
 
 	Ref<VulkanDevice> device = VulkanDevice::CreateShared(this->m_physicalDevice, this->m_instance, this->m_surface);
 	device->Create(deviceInfo);
@@ -198,13 +203,14 @@ VulkanRenderer::IsDeviceSuitable(const VkPhysicalDevice& physicalDevice) {
 
 	bool bExtensionsSupported = this->CheckDeviceExtensionSupport(physicalDevice);
 
-	bool bSwapChainAdequate = false;
-	if (bExtensionsSupported) {
+	/* Without a surface there is nothing to present to */
+	bool bSwapChainAdequate = this->m_surface == VK_NULL_HANDLE;
+	if (bExtensionsSupported && !bSwapChainAdequate) {
 		SwapChainSupportDetails swapChainSupport = this->QuerySwapChainSupport(physicalDevice);
 		bSwapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
 	}
 
-	return indices.IsComplete() && bSwapChainAdequate;
+	return indices.IsComplete() && bExtensionsSupported && bSwapChainAdequate;
 }
 
 /**
@@ -233,8 +239,14 @@ VulkanRenderer::FindQueueFamilies(const VkPhysicalDevice& physicalDevice) {
 			indices.graphicsFamily = i;
 		}
 
+		/* Headless: the graphics queue doubles as the present queue */
 		VkBool32 bPresentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, this->m_surface, &bPresentSupport);
+		if (this->m_surface == VK_NULL_HANDLE) {
+			bPresentSupport = indices.graphicsFamily.has_value() && indices.graphicsFamily.value() == i;
+		}
+		else {
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, this->m_surface, &bPresentSupport);
+		}
 
 		if (bPresentSupport) {
 			indices.presentFamily = i;
@@ -304,7 +316,8 @@ VulkanRenderer::CheckDeviceExtensionSupport(const VkPhysicalDevice& physicalDevi
 	Vector<VkExtensionProperties> extensions(nExtensionCount);
 	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &nExtensionCount, extensions.data());
 
-	std::set<String> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+	Vector<const char*> required = this->GetDeviceExtensions();
+	std::set<String> requiredExtensions(required.begin(), required.end());
 
 	for (const VkExtensionProperties& extension : extensions) {
 		requiredExtensions.erase(extension.extensionName);
@@ -384,10 +397,15 @@ VulkanRenderer::CheckValidationLayersSupport() {
 */
 Vector<const char*>
 VulkanRenderer::GetRequiredExtensions() {
-	uint32_t nGlfwExtensions;
-	const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&nGlfwExtensions);
+	Vector<const char*> extensions;
 
-	Vector<const char*> extensions(glfwExtensions, glfwExtensions + nGlfwExtensions);
+	/* Surface extensions are only needed when rendering to a window */
+	if (this->m_pWindow != nullptr) {
+		uint32_t nGlfwExtensions;
+		const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&nGlfwExtensions);
+
+		extensions.assign(glfwExtensions, glfwExtensions + nGlfwExtensions);
+	}
 
 	if (this->m_bEnableValidationLayers) {
 		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -396,6 +414,27 @@ VulkanRenderer::GetRequiredExtensions() {
 	return extensions;
 }
 
+/**
+* Gets the required device extensions.
+* VK_KHR_swapchain is skipped when there is no surface
+* 
+* @returns A vector of device extension names
+*/
+Vector<const char*>
+VulkanRenderer::GetDeviceExtensions() const {
+	Vector<const char*> extensions;
+
+	for (const char* extension : deviceExtensions) {
+		if (this->m_surface == VK_NULL_HANDLE && strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) {
+			continue;
+		}
+
+		extensions.push_back(extension);
+	}
+
+	return extensions;
+}
+
 /**
 * Populates debug messenger create info
 * 
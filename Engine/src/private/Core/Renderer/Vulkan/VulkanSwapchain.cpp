@@ -24,6 +24,7 @@ VulkanSwapchain::~VulkanSwapchain() {
 */
 void 
 VulkanSwapchain::Create(const SwapchainCreateInfo& createInfo) {
+	this->m_createInfo = createInfo;
 	this->m_nImageCount = createInfo.nImageCount;
 	this->m_pWindow = createInfo.pWindow;
 
@@ -36,6 +37,15 @@ VulkanSwapchain::Create(const SwapchainCreateInfo& createInfo) {
 	VkExtent2D extent = this->ChooseSwapExtent(details.capabilities);
 	this->m_extent = extent;
 
+	/* Determine image count */
+	if (details.capabilities.maxImageCount > 0 && this->m_nImageCount > details.capabilities.maxImageCount) {
+		this->m_nImageCount = details.capabilities.maxImageCount;
+	} 
+
+	if (this->m_nImageCount < details.capabilities.minImageCount) {
+		this->m_nImageCount = details.capabilities.minImageCount;
+	}
+
 	VkSwapchainCreateInfoKHR scInfo = { };
 	scInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
 	scInfo.imageFormat = format.format;
@@ -385,20 +395,30 @@ VulkanSwapchain::ChooseSurfaceFormat(const Vector<VkSurfaceFormatKHR>& available
 }
 
 /**
-* Choose the best swap present mode
+* Choose the requested present mode, FIFO
+* if the surface doesn't support it
 * 
 * @param presentModes Present modes
 * 
-* @returns The best swap present mode
+* @returns The swap present mode
 */
 VkPresentModeKHR 
 VulkanSwapchain::ChooseSwapPresentMode(const Vector<VkPresentModeKHR>& presentModes) {
+	VkPresentModeKHR requested = VulkanHelpers::ConvertPresentMode(this->m_createInfo.presentMode);
+
 	for (const VkPresentModeKHR& presentMode : presentModes) {
-		if (presentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+		if (presentMode == requested) {
+			this->m_presentMode = this->m_createInfo.presentMode;
 			return presentMode;
 		}
 	}
 
+	/* FIFO is always supported */
+	if (requested != VK_PRESENT_MODE_FIFO_KHR) {
+		Logger::Warn("VulkanSwapchain::ChooseSwapPresentMode: Present mode {} not supported, using FIFO", static_cast<int>(requested));
+	}
+
+	this->m_presentMode = EPresentMode::FIFO;
 	return VK_PRESENT_MODE_FIFO_KHR;
 }
 
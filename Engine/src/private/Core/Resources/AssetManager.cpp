@@ -10,6 +10,7 @@
 #include <assimp/postprocess.h>
 
 #include "Core/Renderer/GPUTexture.h"
+#include "Core/Utils/Profiler.h"
 
 namespace fs = std::filesystem;
 
@@ -185,6 +186,24 @@ AssetManager::SaveScene(const String& filename, const SceneAsset& asset) {
 
 	file.write(reinterpret_cast<const char*>(objects.data()), asset.header.nObjectCount * sizeof(GameObjectAsset));
 
+	/* World partition cells, older readers stop before them */
+	static_assert(std::is_trivially_copyable_v<SceneCellAsset>);
+
+	uint32_t nCellCount = static_cast<uint32_t>(asset.cells.size());
+	file.write(reinterpret_cast<const char*>(&nCellCount), sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(asset.cells.data()), nCellCount * sizeof(SceneCellAsset));
+
+	/* Static objects and baked batches */
+	static_assert(std::is_trivially_copyable_v<SceneStaticBatchAsset>);
+
+	uint32_t nStaticCount = static_cast<uint32_t>(asset.staticObjects.size());
+	file.write(reinterpret_cast<const char*>(&nStaticCount), sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(asset.staticObjects.data()), nStaticCount * sizeof(uint32_t));
+
+	uint32_t nBatchCount = static_cast<uint32_t>(asset.staticBatches.size());
+	file.write(reinterpret_cast<const char*>(&nBatchCount), sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(asset.staticBatches.data()), nBatchCount * sizeof(SceneStaticBatchAsset));
+
 	if (!file) return false;
 
 	file.close();
@@ -333,6 +352,8 @@ AssetManager::SaveTexture(const String& filename, const TextureAsset& asset) {
 template<typename TAsset, typename THeader>
 AssetHandle 
 AssetManager::ReadAsset(const String& filename, EAssetType expectedType) {
+	PROFILE_SCOPE("AssetManager::ReadAsset");
+
 	AssetHandle handle = { };
 
 	std::ifstream file(filename, std::ios::binary);
@@ -479,10 +500,68 @@ AssetManager::ReadAssetData<SceneAsset, SceneAssetHeader>(
 		objects.resize(header.nObjectCount);
 		file.read(reinterpret_cast<char*>(objects.data()), header.nObjectCount * sizeof(GameObjectAsset));
 	}
+
+	/* Cell table, missing on scenes saved before world partition */
+	Vector<SceneCellAsset> cells;
+	uint32_t nCellCount = 0;
+
+	if (file.read(reinterpret_cast<char*>(&nCellCount), sizeof(uint32_t)) && nCellCount > 0) {
+		cells.resize(nCellCount);
+		file.read(reinterpret_cast<char*>(cells.data()), nCellCount * sizeof(SceneCellAsset));
+
+		if (!file) {
+			Logger::Error("AssetManager::ReadAssetData[SceneAsset]: Failed reading {} cells", nCellCount);
+			cells.clear();
+		}
+	}
+
+	/* Static objects and baked batches, missing on scenes saved before 1.2 */
+	Vector<uint32_t> staticObjects;
+	Vector<SceneStaticBatchAsset> staticBatches;
+	uint32_t nStaticCount = 0;
+	uint32_t nBatchCount = 0;
+
+	if (file.read(reinterpret_cast<char*>(&nStaticCount), sizeof(uint32_t)) && nStaticCount > 0) {
+		staticObjects.resize(nStaticCount);
+		file.read(reinterpret_cast<char*>(staticObjects.data()), nStaticCount * sizeof(uint32_t));
+	}
+
+	if (file.read(reinterpret_cast<char*>(&nBatchCount), sizeof(uint32_t)) && nBatchCount > 0) {
+		staticBatches.resize(nBatchCount);
+		file.read(reinterpret_cast<char*>(staticBatches.data()), nBatchCount * sizeof(SceneStaticBatchAsset));
+	}
+
+	if (!file && (nStaticCount > 0 || nBatchCount > 0)) {
+		Logger::Error("AssetManager::ReadAssetData[SceneAsset]: Failed reading static objects of {}", filename);
+		staticObjects.clear();
+		staticBatches.clear();
+	}
+
+	std::erase_if(staticObjects, [&](uint32_t nIndex) { return nIndex >= objects.size(); });
+
+	/* Cell and batch assets sit next to the scene file */
+	fs::path sceneDir = fs::path(filename).parent_path();
+
+	for (SceneCellAsset& cell : cells) {
+		String cellPath = (sceneDir / cell.path.string()).string();
+		cell.handle = this->RegisterAsset(cellPath, EAssetType::SCENE);
+	}
+
+	for (SceneStaticBatchAsset& batch : staticBatches) {
+		String batchPath = (sceneDir / batch.path.string()).string();
+		batch.handle = this->RegisterAsset(batchPath, EAssetType::MESH);
+
+		if (batch.nObjectIndex < objects.size()) {
+			objects[batch.nObjectIndex].meshHandle = batch.handle;
+		}
+	}
 	
 	SceneAsset asset = { };
 	asset.header = std::move(header);
 	asset.objects = std::move(objects);
+	asset.cells = std::move(cells);
+	asset.staticObjects = std::move(staticObjects);
+	asset.staticBatches = std::move(staticBatches);
 
 	handle = AssetHandle::FromPath(filename, EAssetType::SCENE);
 
@@ -629,6 +708,20 @@ AssetManager::GetAsset(const AssetHandle& handle) {
 	return emptyAsset;
 }
 
+/**
+* Drops an asset from the cache. It stays
+* registered, the next GetAsset reads it
+* from disk again. References previously
+* returned by GetAsset become invalid
+* 
+* @param handle Asset handle
+*/
+void
+AssetManager::UnloadAsset(const AssetHandle& handle) {
+	std::lock_guard<std::mutex> lock(this->m_cacheMutex);
+	this->m_assetCache.erase(handle);
+}
+
 /**
 * Imports an external asset
 * and translates it to 
@@ -641,6 +734,8 @@ AssetManager::GetAsset(const AssetHandle& handle) {
 */
 bool 
 AssetManager::ImportAsset(const String& path, const String& projectAssets) {
+	PROFILE_SCOPE("AssetManager::ImportAsset");
+
 	fs::path assetPath = path;
 
 	if (!fs::exists(assetPath) || !fs::is_regular_file(assetPath)) {
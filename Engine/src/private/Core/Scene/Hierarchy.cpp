@@ -0,0 +1,511 @@
+#include "Core/Scene/Hierarchy.h"
+#include "Core/GameObject/GameObject.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+
+Hierarchy
+Hierarchy::Create(const Name& rootName) {
+	Hierarchy hierarchy = { };
+	hierarchy.CreateNode(rootName);
+	return hierarchy;
+}
+
+/**
+* Gets the current index of a node
+*
+* @param nId Node ID
+*
+* @returns Node index or INVALID_NODE
+*/
+uint32_t
+Hierarchy::FindNode(uint32_t nId) const {
+	auto it = this->nodeIndices.find(nId);
+	if (it == this->nodeIndices.end()) return INVALID_NODE;
+
+	return it->second;
+}
+
+/**
+* Creates a node as the last child of its parent.
+* The first node created is the root
+*
+* @param name Node name
+* @param nParent Parent index, the root if invalid
+* @param pObj Node GameObject
+*
+* @returns Created node index
+*/
+uint32_t
+Hierarchy::CreateNode(const Name& name, uint32_t nParent, GameObject* pObj) {
+	HierarchyNode node = { };
+	node.name = name;
+	node.id = this->GenerateID();
+	node.pObj = pObj;
+
+	this->nameIndices[name.string()].push_back(node.id);
+
+	if (this->nodes.empty()) {
+		this->nodes.push_back(node);
+		this->nodeIndices[node.id] = ROOT;
+		return ROOT;
+	}
+
+	if (nParent >= this->nodes.size()) {
+		nParent = ROOT;
+	}
+
+	uint32_t nIndex = nParent + this->nodes[nParent].nSubtreeSize;
+	node.nParent = nParent;
+
+	/* Parent subtree ends the array (always true for the root), link in place */
+	if (nIndex == this->nodes.size()) {
+		node.nDepth = this->nodes[nParent].nDepth + 1;
+		this->nodes.push_back(node);
+
+		HierarchyNode& parent = this->nodes[nParent];
+		if (parent.nLastChild != INVALID_NODE) {
+			this->nodes[parent.nLastChild].nNextSibling = nIndex;
+		}
+		else {
+			parent.nFirstChild = nIndex;
+		}
+		parent.nLastChild = nIndex;
+
+		for (uint32_t nAncestor = nParent; nAncestor != INVALID_NODE; nAncestor = this->nodes[nAncestor].nParent) {
+			this->nodes[nAncestor].nSubtreeSize++;
+		}
+
+		this->nodeIndices[node.id] = nIndex;
+		return nIndex;
+	}
+
+	/* Insert after the parent subtree and shift the indices behind it */
+	this->nodes.insert(this->nodes.begin() + nIndex, node);
+
+	for (HierarchyNode& other : this->nodes) {
+		if (other.nParent != INVALID_NODE && other.nParent >= nIndex) {
+			other.nParent++;
+		}
+	}
+
+	this->RebuildLinks();
+	return nIndex;
+}
+
+/**
+* Changes node parent (move node). The node and
+* its subtree become the last child of the new parent
+*
+* @param nNode Node index
+* @param nNewParent New parent index
+*/
+void
+Hierarchy::MoveNode(uint32_t nNode, uint32_t nNewParent) {
+	uint32_t nCount = static_cast<uint32_t>(this->nodes.size());
+	if (nNode == ROOT || nNode >= nCount || nNewParent >= nCount) return;
+
+	uint32_t nBegin = nNode;
+	uint32_t nEnd = nNode + this->nodes[nNode].nSubtreeSize;
+
+	if (nNewParent >= nBegin && nNewParent < nEnd) {
+		Logger::Warn("Hierarchy::MoveNode: Can't move {} below itself", this->nodes[nNode].name.data);
+		return;
+	}
+
+	if (this->nodes[nNode].nParent == nNewParent) return;
+
+	this->nodes[nNode].nParent = nNewParent;
+
+	/* The subtree block goes right after the new parent's subtree */
+	uint32_t nInsert = nNewParent + this->nodes[nNewParent].nSubtreeSize;
+
+	Vector<uint32_t> order;
+	order.reserve(nCount);
+
+	for (uint32_t i = 0; i <= nCount; i++) {
+		if (i == nInsert) {
+			for (uint32_t j = nBegin; j < nEnd; j++) {
+				order.push_back(j);
+			}
+		}
+
+		if (i < nCount && (i < nBegin || i >= nEnd)) {
+			order.push_back(i);
+		}
+	}
+
+	GameObject* pObj = this->nodes[nNode].pObj;
+
+	this->Reorder(order);
+
+	/* Same local transform, new world matrix for the whole subtree */
+	if (pObj != nullptr) {
+		pObj->MarkTransformDirty();
+	}
+}
+
+/**
+* Delete a node and its subtree. Deleting the
+* root only deletes its descendants
+*
+* @param nNode Node index
+*/
+void
+Hierarchy::DeleteNode(uint32_t nNode) {
+	uint32_t nCount = static_cast<uint32_t>(this->nodes.size());
+	if (nNode >= nCount) return;
+
+	uint32_t nBegin = nNode == ROOT ? ROOT + 1 : nNode;
+	uint32_t nEnd = nNode + this->nodes[nNode].nSubtreeSize;
+	if (nBegin >= nEnd) return;
+
+	/* Back to front, children go before their parent */
+	for (uint32_t i = nEnd; i-- > nBegin;) {
+		this->ReleaseNode(this->nodes[i]);
+	}
+
+	Vector<uint32_t> order;
+	order.reserve(nCount - (nEnd - nBegin));
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		if (i < nBegin || i >= nEnd) {
+			order.push_back(i);
+		}
+	}
+
+	this->Reorder(order);
+}
+
+/**
+* Creates several nodes as the last children of
+* one parent. The parent's subtree is shifted
+* and relinked once for all of them
+*
+* @param name Name of every node
+* @param nParent Parent index, the root if invalid
+* @param objects Node GameObjects, one node each
+*
+* @returns Index of the first created node or INVALID_NODE
+*/
+uint32_t
+Hierarchy::CreateNodes(const Name& name, uint32_t nParent, const Vector<GameObject*>& objects) {
+	uint32_t nAdded = static_cast<uint32_t>(objects.size());
+	if (nAdded == 0) return INVALID_NODE;
+
+	if (this->nodes.empty()) {
+		Logger::Error("Hierarchy::CreateNodes: Hierarchy has no root");
+		return INVALID_NODE;
+	}
+
+	if (nParent >= this->nodes.size()) {
+		nParent = ROOT;
+	}
+
+	uint32_t nIndex = nParent + this->nodes[nParent].nSubtreeSize;
+	bool bAppend = nIndex == this->nodes.size();
+
+	Vector<HierarchyNode> added(nAdded);
+	Vector<uint32_t>& ids = this->nameIndices[name.string()];
+
+	for (uint32_t i = 0; i < nAdded; i++) {
+		HierarchyNode& node = added[i];
+		node.name = name;
+		node.id = this->GenerateID();
+		node.pObj = objects[i];
+		node.nParent = nParent;
+		node.nDepth = this->nodes[nParent].nDepth + 1;
+
+		ids.push_back(node.id);
+	}
+
+	if (!bAppend) {
+		for (HierarchyNode& other : this->nodes) {
+			if (other.nParent != INVALID_NODE && other.nParent >= nIndex) {
+				other.nParent += nAdded;
+			}
+		}
+	}
+
+	this->nodes.insert(this->nodes.begin() + nIndex, added.begin(), added.end());
+
+	if (!bAppend) {
+		this->RebuildLinks();
+		return nIndex;
+	}
+
+	/* Parent subtree ended the array, link in place */
+	HierarchyNode& parent = this->nodes[nParent];
+
+	for (uint32_t i = nIndex; i < nIndex + nAdded; i++) {
+		if (parent.nLastChild != INVALID_NODE) {
+			this->nodes[parent.nLastChild].nNextSibling = i;
+		}
+		else {
+			parent.nFirstChild = i;
+		}
+		parent.nLastChild = i;
+
+		this->nodeIndices[this->nodes[i].id] = i;
+	}
+
+	for (uint32_t nAncestor = nParent; nAncestor != INVALID_NODE; nAncestor = this->nodes[nAncestor].nParent) {
+		this->nodes[nAncestor].nSubtreeSize += nAdded;
+	}
+
+	return nIndex;
+}
+
+/**
+* Reparents several nodes at once. Each one becomes
+* the last child of its new parent, in move order.
+* Moves that would put a node below itself, given
+* the moves before them, are skipped
+*
+* @param moves Node and new parent indices
+*/
+void
+Hierarchy::MoveNodes(const Vector<NodeMove>& moves) {
+	uint32_t nCount = static_cast<uint32_t>(this->nodes.size());
+
+	Vector<uint8_t> moved(nCount, 0);
+	Vector<uint32_t> movedNodes;
+
+	for (const NodeMove& move : moves) {
+		if (move.nNode == ROOT || move.nNode >= nCount || move.nNewParent >= nCount) continue;
+
+		HierarchyNode& node = this->nodes[move.nNode];
+		if (node.nParent == move.nNewParent && !moved[move.nNode]) continue;
+
+		/* Parent links already hold the earlier moves */
+		bool bCycle = false;
+		for (uint32_t nAncestor = move.nNewParent; nAncestor != INVALID_NODE; nAncestor = this->nodes[nAncestor].nParent) {
+			if (nAncestor == move.nNode) {
+				bCycle = true;
+				break;
+			}
+		}
+
+		if (bCycle) {
+			Logger::Warn("Hierarchy::MoveNodes: Can't move {} below itself", node.name.data);
+			continue;
+		}
+
+		node.nParent = move.nNewParent;
+
+		if (moved[move.nNode]) {
+			movedNodes.erase(std::find(movedNodes.begin(), movedNodes.end(), move.nNode));
+		}
+
+		moved[move.nNode] = 1;
+		movedNodes.push_back(move.nNode);
+	}
+
+	if (movedNodes.empty()) return;
+
+	/* Child lists from the parent links, moved nodes go last */
+	Vector<uint32_t> firstChild(nCount, INVALID_NODE);
+	Vector<uint32_t> lastChild(nCount, INVALID_NODE);
+	Vector<uint32_t> nextSibling(nCount, INVALID_NODE);
+
+	auto link = [&](uint32_t i) {
+		uint32_t nParent = this->nodes[i].nParent;
+
+		if (lastChild[nParent] != INVALID_NODE) {
+			nextSibling[lastChild[nParent]] = i;
+		}
+		else {
+			firstChild[nParent] = i;
+		}
+		lastChild[nParent] = i;
+	};
+
+	for (uint32_t i = ROOT + 1; i < nCount; i++) {
+		if (!moved[i]) link(i);
+	}
+
+	for (uint32_t nNode : movedNodes) {
+		link(nNode);
+	}
+
+	/* Depth first walk over the new links */
+	Vector<uint32_t> order;
+	order.reserve(nCount);
+
+	uint32_t nNode = ROOT;
+	while (nNode != INVALID_NODE) {
+		order.push_back(nNode);
+
+		if (firstChild[nNode] != INVALID_NODE) {
+			nNode = firstChild[nNode];
+			continue;
+		}
+
+		while (nNode != INVALID_NODE && nextSibling[nNode] == INVALID_NODE) {
+			nNode = this->nodes[nNode].nParent;
+		}
+
+		if (nNode != INVALID_NODE) {
+			nNode = nextSibling[nNode];
+		}
+	}
+
+	Vector<GameObject*> movedObjects;
+	movedObjects.reserve(movedNodes.size());
+
+	for (uint32_t nMoved : movedNodes) {
+		if (this->nodes[nMoved].pObj != nullptr) {
+			movedObjects.push_back(this->nodes[nMoved].pObj);
+		}
+	}
+
+	this->Reorder(order);
+
+	/* Same local transforms, new world matrices for the subtrees */
+	for (GameObject* pObj : movedObjects) {
+		pObj->MarkTransformDirty();
+	}
+}
+
+/**
+* Deletes several nodes and their subtrees with
+* one reorder. Deleting the root only deletes
+* its descendants
+*
+* @param nodesToDelete Node indices
+*/
+void
+Hierarchy::DeleteNodes(const Vector<uint32_t>& nodesToDelete) {
+	uint32_t nCount = static_cast<uint32_t>(this->nodes.size());
+
+	Vector<uint8_t> dropped(nCount, 0);
+	uint32_t nDropped = 0;
+
+	for (uint32_t nNode : nodesToDelete) {
+		if (nNode >= nCount) continue;
+
+		uint32_t nBegin = nNode == ROOT ? ROOT + 1 : nNode;
+		uint32_t nEnd = nNode + this->nodes[nNode].nSubtreeSize;
+
+		for (uint32_t i = nBegin; i < nEnd; i++) {
+			nDropped += dropped[i] == 0;
+			dropped[i] = 1;
+		}
+	}
+
+	if (nDropped == 0) return;
+
+	/* Back to front, children go before their parent */
+	for (uint32_t i = nCount; i-- > ROOT + 1;) {
+		if (dropped[i]) {
+			this->ReleaseNode(this->nodes[i]);
+		}
+	}
+
+	Vector<uint32_t> order;
+	order.reserve(nCount - nDropped);
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		if (!dropped[i]) {
+			order.push_back(i);
+		}
+	}
+
+	this->Reorder(order);
+}
+
+/**
+* Runs the deleted callback of a node about
+* to be dropped and forgets its name
+*
+* @param node Node
+*/
+void
+Hierarchy::ReleaseNode(HierarchyNode& node) {
+	if (node.pObj != nullptr && this->nodeDeletedCb) {
+		this->nodeDeletedCb(node.pObj);
+	}
+	node.pObj = nullptr;
+
+	auto it = this->nameIndices.find(node.name.string());
+	if (it != this->nameIndices.end()) {
+		Vector<uint32_t>& ids = it->second;
+		ids.erase(std::remove(ids.begin(), ids.end(), node.id), ids.end());
+
+		if (ids.empty()) {
+			this->nameIndices.erase(it);
+		}
+	}
+}
+
+/**
+* Rearranges the nodes. Nodes left out are dropped,
+* their children must be left out too
+*
+* @param order Old node indices in their new order
+*/
+void
+Hierarchy::Reorder(const Vector<uint32_t>& order) {
+	Vector<uint32_t> remap(this->nodes.size(), INVALID_NODE);
+	for (uint32_t i = 0; i < order.size(); i++) {
+		remap[order[i]] = i;
+	}
+
+	Vector<HierarchyNode> reordered;
+	reordered.reserve(order.size());
+
+	for (uint32_t nOld : order) {
+		HierarchyNode& node = reordered.emplace_back(this->nodes[nOld]);
+
+		if (node.nParent != INVALID_NODE) {
+			node.nParent = remap[node.nParent];
+		}
+	}
+
+	this->nodes.swap(reordered);
+	this->RebuildLinks();
+}
+
+/**
+* Recomputes child, sibling, subtree size, depth and
+* ID links from the parent indices, in one pass each
+*/
+void
+Hierarchy::RebuildLinks() {
+	uint32_t nCount = static_cast<uint32_t>(this->nodes.size());
+
+	this->nodeIndices.clear();
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		HierarchyNode& node = this->nodes[i];
+		node.nFirstChild = INVALID_NODE;
+		node.nLastChild = INVALID_NODE;
+		node.nNextSibling = INVALID_NODE;
+		node.nSubtreeSize = 1;
+		node.nDepth = 0;
+
+		this->nodeIndices[node.id] = i;
+
+		if (node.nParent == INVALID_NODE) continue;
+
+		/* Depth first order, the parent was already visited */
+		HierarchyNode& parent = this->nodes[node.nParent];
+		node.nDepth = parent.nDepth + 1;
+
+		if (parent.nLastChild != INVALID_NODE) {
+			this->nodes[parent.nLastChild].nNextSibling = i;
+		}
+		else {
+			parent.nFirstChild = i;
+		}
+		parent.nLastChild = i;
+	}
+
+	for (uint32_t i = nCount; i-- > 0;) {
+		uint32_t nParent = this->nodes[i].nParent;
+
+		if (nParent != INVALID_NODE) {
+			this->nodes[nParent].nSubtreeSize += this->nodes[i].nSubtreeSize;
+		}
+	}
+}
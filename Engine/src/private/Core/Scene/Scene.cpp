@@ -1,155 +1,434 @@
 #include "Core/Scene/Scene.h"
 #include "Core/Resources/SceneAsset.h"
 #include "Core/Resources/GameObjectAsset.h"
+#include "Core/Utils/Profiler.h"
+#include "Core/Time.h"
 
-Scene::Scene(const String& name) : m_name(name) {
+#include <algorithm>
+
+Scene::Scene(const String& name) : m_name(name), m_objectPool(&this->m_arena) {
 	this->m_currentCamera = new EditorCamera("EditorCamera");
 
 	/* Setup scene hierarchy */
 	this->m_hierarchy = Hierarchy::Create(name);
+
+	/* Component::Update behaviours, other systems are added by gameplay code */
+	this->m_systems.AddSystem<BehaviourSystem>();
+
+	/* Meshes added, replaced or removed get their BVH leaf updated */
+	this->m_registry.GetPool<Mesh>().TrackChanges(true);
 }
 
-void 
-Scene::AddObject(GameObject* object) {
-	String objName = object->GetName();
+Scene::~Scene() {
+	/* 
+		Objects only hold a fixed name and their entity, 
+		which dies with the registry. Their pool chunks 
+		go with the arena, no destructor runs per object.
+		Mesh components release their registry users with
+		the registry, meshes no other scene uses are freed
+	*/
+	this->m_objectPool.Abandon();
 
-	if (this->m_gameObjects.count(objName) > 0) {
-		spdlog::error("Scene::AddGameObject: GameObject with name {0} already exists", objName);
-		return;
+	delete this->m_currentCamera;
+}
+
+/**
+* Creates an object with a default transform
+* on the scene's registry
+* 
+* @param name Object name, several objects may share it
+* @param nParentNode Hierarchy node it is created under
+* 
+* @returns Created object
+*/
+GameObject*
+Scene::CreateObject(const String& name, uint32_t nParentNode) {
+	GameObject* pObj = this->AllocateObject(name);
+
+	this->m_hierarchy.CreateNode(name, nParentNode, pObj);
+
+	return pObj;
+}
+
+/**
+* Creates an object without its hierarchy
+* node, bulk spawns add the nodes at once
+* 
+* @param name Object name
+* 
+* @returns Created object
+*/
+GameObject*
+Scene::AllocateObject(const String& name) {
+	GameObject* pObj = this->m_objectPool.Create(name, &this->m_registry);
+	EntityHandle handle = pObj->GetHandle();
+
+	if (handle.nIndex >= this->m_objectSlots.size()) {
+		this->m_objectSlots.resize(static_cast<size_t>(handle.nIndex) + 1, UINT32_MAX);
 	}
 
-	this->m_gameObjects[objName] = object;
-	this->m_hierarchy.CreateNode(objName, this->m_hierarchy.root, object);
+	this->m_objectSlots[handle.nIndex] = static_cast<uint32_t>(this->m_objects.size());
+	this->m_objects.push_back(pObj);
+	this->m_nameIndex[pObj->GetName()].push_back(handle);
+
+	return pObj;
 }
 
-Map<String, GameObject*> 
-Scene::GetObjects() {
-	return this->m_gameObjects;
+/**
+* Gets an object by handle
+* 
+* @param handle Entity handle
+* 
+* @returns Object or nullptr if the handle is stale
+*/
+GameObject*
+Scene::GetGameObject(EntityHandle handle) {
+	if (!this->m_registry.IsAlive(handle)) return nullptr;
+	if (handle.nIndex >= this->m_objectSlots.size()) return nullptr;
+
+	uint32_t nSlot = this->m_objectSlots[handle.nIndex];
+	if (nSlot == UINT32_MAX) return nullptr;
+
+	return this->m_objects[nSlot];
+}
+
+/**
+* Finds an object by name
+* 
+* @param name Object name
+* 
+* @returns First living object with that name or nullptr
+*/
+GameObject*
+Scene::FindObject(const String& name) {
+	auto it = this->m_nameIndex.find(name);
+	if (it == this->m_nameIndex.end()) return nullptr;
+
+	for (const EntityHandle& handle : it->second) {
+		GameObject* pObj = this->GetGameObject(handle);
+		if (pObj != nullptr) return pObj;
+	}
+
+	return nullptr;
 }
 
 void 
 Scene::DeleteObject(GameObject* pObj) {
 	if (pObj == nullptr) return;
 
-	String objName = pObj->GetName();
+	EntityHandle handle = pObj->GetHandle();
+	if (this->GetGameObject(handle) != pObj) {
+		Logger::Error("Scene::DeleteObject: {} doesn't belong to scene {}", pObj->GetName(), this->m_name);
+		return;
+	}
+
+	/* Swap the last object into the hole */
+	uint32_t nSlot = this->m_objectSlots[handle.nIndex];
+	GameObject* pLast = this->m_objects.back();
+
+	this->m_objects[nSlot] = pLast;
+	this->m_objectSlots[pLast->GetEntity()] = nSlot;
+	this->m_objects.pop_back();
+	this->m_objectSlots[handle.nIndex] = UINT32_MAX;
 
-	if (this->m_gameObjects.count(objName) > 0) {
-		this->m_gameObjects.erase(objName);
+	auto it = this->m_nameIndex.find(pObj->GetName());
+	if (it != this->m_nameIndex.end()) {
+		Vector<EntityHandle>& handles = it->second;
+		handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+
+		if (handles.empty()) {
+			this->m_nameIndex.erase(it);
+		}
 	}
 
-	delete pObj;
+	this->m_bvh.Remove(handle.nIndex);
+	this->m_staticBatches.erase(handle.nIndex);
+
+	/* Drops the entity and its components, the slot is reused. Shared meshes go with their last user */
+	this->m_objectPool.Destroy(pObj);
+}
+
+/**
+* Finds the closest object along a ray, by
+* the world bounds of its mesh
+*
+* @param ray World space ray, normalized direction
+* @param fMaxDistance Farthest accepted hit
+*
+* @returns Hit object or nullptr
+*/
+GameObject*
+Scene::PickObject(const Ray& ray, float fMaxDistance) {
+	RayHit hit = this->m_bvh.RayCast(ray, fMaxDistance);
+	if (!hit.IsValid()) return nullptr;
+
+	return this->GetGameObject(this->m_registry.GetHandle(hit.entity));
 }
 
 void
 Scene::Start() {
-	Ref<Hierarchy::HierarchyNode> rootNode = this->m_hierarchy.root;
-	this->StartHierarchy(rootNode);
+	/* Pool by pool, over the dense component arrays */
+	this->m_registry.StartComponents();
 
 	this->m_currentCamera->Start();
 }
 
-void 
-Scene::StartHierarchy(Ref<Hierarchy::HierarchyNode> node) {
-	if (node->pObj != nullptr) {
-		node->pObj->Start();
+void
+Scene::Update() {
+	this->m_systems.Run(this->m_registry, Time::GetInstance()->deltaTime);
+
+	/* Sync point, spawns and despawns recorded so far land in this frame */
+	this->m_commands.Apply(*this);
+
+	this->m_currentCamera->Update();
+
+	const Vector3& viewLocation = this->m_currentCamera->transform.location;
+	this->m_partition.Update(*this, glm::vec3(viewLocation.x, viewLocation.y, viewLocation.z));
+}
+
+/**
+* Brings world matrices and bounds up to date.
+* Only dirty objects rebuild their local matrix,
+* and only their subtrees rebuild world matrices
+*/
+void
+Scene::UpdateTransforms() {
+	PROFILE_SCOPE("Scene::UpdateTransforms");
+
+	ComponentPool<Transform>& transforms = this->m_registry.GetPool<Transform>();
+	ComponentPool<WorldTransform>& worldTransforms = this->m_registry.GetPool<WorldTransform>();
+
+	this->ComposeDirtyLocals(transforms, worldTransforms);
+
+	this->PropagateWorlds(worldTransforms);
+
+	this->UpdateBounds(worldTransforms);
+}
+
+/**
+* Rebuilds the local matrix of every dirty object
+* in one batch. Dirty flags stay set so the
+* hierarchy walk knows which subtrees changed
+*
+* @param transforms Transform pool
+* @param worldTransforms World transform pool
+*/
+void
+Scene::ComposeDirtyLocals(ComponentPool<Transform>& transforms, ComponentPool<WorldTransform>& worldTransforms) {
+	const Vector<EntityID>& entities = worldTransforms.GetEntities();
+	Vector<WorldTransform>& cached = worldTransforms.GetComponents();
+
+	this->m_dirtyIndices.clear();
+	this->m_dirtyTransforms.Clear();
+
+	for (uint32_t i = 0; i < cached.size(); i++) {
+		if (!cached[i].bDirty) continue;
+
+		this->m_dirtyIndices.push_back(i);
+		this->m_dirtyTransforms.Push(*transforms.Get(entities[i]));
 	}
 
-	if (!node->HasChildren())
-		return;
+	if (this->m_dirtyIndices.empty()) return;
 
-	for (Ref<Hierarchy::HierarchyNode> children : node->children) {
-		this->StartHierarchy(children);
+	this->m_dirtyMatrices.resize(this->m_dirtyIndices.size());
+	TransformBatch::ComposeLocalMatrices(this->m_dirtyTransforms, this->m_dirtyMatrices.data());
+
+	for (size_t i = 0; i < this->m_dirtyIndices.size(); i++) {
+		cached[this->m_dirtyIndices[i]].local = this->m_dirtyMatrices[i];
 	}
 }
 
+/**
+* Rebuilds world matrices in one pass over the
+* hierarchy. Parents come before their children,
+* so a parent's world matrix is always final
+*
+* @param worldTransforms World transform pool
+*/
 void
-Scene::Update() {
-	Ref<Hierarchy::HierarchyNode> rootNode = this->m_hierarchy.root;
-	this->UpdateHierarchy(rootNode);
+Scene::PropagateWorlds(ComponentPool<WorldTransform>& worldTransforms) {
+	static const glm::mat4 identity = glm::mat4(1.f);
 
-	this->m_currentCamera->Update();
-}
+	const Vector<Hierarchy::HierarchyNode>& nodes = this->m_hierarchy.nodes;
 
-void 
-Scene::UpdateHierarchy(Ref<Hierarchy::HierarchyNode> node) {
-	if (node->pObj != nullptr) {
-		node->pObj->Update();
+	this->m_nodeWorlds.resize(nodes.size());
+	this->m_nodeChanged.resize(nodes.size());
+	this->m_changedEntities.clear();
+
+	for (size_t i = 0; i < nodes.size(); i++) {
+		const Hierarchy::HierarchyNode& node = nodes[i];
+
+		const glm::mat4* pParentWorld = &identity;
+		bool bChanged = false;
+
+		if (node.nParent != Hierarchy::INVALID_NODE) {
+			pParentWorld = this->m_nodeWorlds[node.nParent];
+			bChanged = this->m_nodeChanged[node.nParent] != 0;
+		}
+
+		/* Nodes without an object pass their parent's matrix through */
+		const glm::mat4* pWorld = pParentWorld;
+
+		WorldTransform* pWorldTransform = nullptr;
+		if (node.pObj != nullptr) {
+			pWorldTransform = worldTransforms.Get(node.pObj->GetEntity());
+		}
+
+		if (pWorldTransform != nullptr) {
+			/* Local matrix already rebuilt by ComposeDirtyLocals */
+			if (pWorldTransform->bDirty) {
+				pWorldTransform->bDirty = false;
+				bChanged = true;
+			}
+
+			if (bChanged) {
+				pWorldTransform->world = *pParentWorld * pWorldTransform->local;
+				this->m_changedEntities.push_back(node.pObj->GetEntity());
+			}
+
+			pWorld = &pWorldTransform->world;
+		}
+
+		this->m_nodeWorlds[i] = pWorld;
+		this->m_nodeChanged[i] = bChanged ? 1 : 0;
 	}
+}
 
-	if (!node->HasChildren())
-		return;
+/**
+* Refits the BVH leaves of moved objects and of
+* objects whose mesh was added, replaced or
+* removed. Objects without a loaded mesh
+* leave the BVH
+*
+* @param worldTransforms World transform pool
+*/
+void
+Scene::UpdateBounds(ComponentPool<WorldTransform>& worldTransforms) {
+	ComponentPool<Mesh>& meshes = this->m_registry.GetPool<Mesh>();
+
+	auto updateBounds = [&](EntityID entity) {
+		Mesh* pMesh = meshes.Get(entity);
+		const WorldTransform* pWorldTransform = worldTransforms.Get(entity);
+
+		if (pMesh == nullptr || !pMesh->IsLoaded() || pWorldTransform == nullptr) {
+			this->m_bvh.Remove(entity);
+			return;
+		}
+
+		this->m_bvh.Update(entity, pMesh->GetMeshData().bounds.Transform(pWorldTransform->world));
+	};
+
+	for (EntityID entity : this->m_changedEntities) {
+		updateBounds(entity);
+	}
 
-	for (Ref<Hierarchy::HierarchyNode> children : node->children) {
-		this->UpdateHierarchy(children);
+	/* Update() skips leaves whose bounds didn't change, repeats cost little */
+	for (EntityID entity : meshes.GetChanged()) {
+		updateBounds(entity);
 	}
+	meshes.ClearChanges();
+
+	this->m_bvh.Optimize();
 }
 
 /**
-* Serialize scene data
+* Serialize scene data. On partitioned scenes only
+* the always loaded objects and the cell table are
+* written, streamed objects stay in their cells
 * 
 * @returns Serialized scene asset
 */
 const SceneAsset 
 Scene::SerializeScene() {
-	/* Get GameObject count */
-	uint32_t nObjectCount = this->m_gameObjects.size();
-	std::vector<GameObjectAsset> assets(nObjectCount);
+	Vector<GameObjectAsset> assets;
+	assets.reserve(this->m_objects.size());
 
 	SceneAsset sceneAsset = { };
 
 	/* Serialize GameObjects */
-	uint32_t i = 0;
-	for (auto& [name, pObj] : this->m_gameObjects) {
+	for (GameObject* pObj : this->m_objects) {
+		if (this->m_partition.IsStreamed(pObj->GetHandle())) continue;
+
+		uint32_t nIndex = static_cast<uint32_t>(assets.size());
+
+		if (pObj->IsStatic()) {
+			sceneAsset.staticObjects.push_back(nIndex);
+		}
+
+		auto batchIt = this->m_staticBatches.find(pObj->GetEntity());
+		if (batchIt != this->m_staticBatches.end() && batchIt->second.handle == pObj->GetHandle()) {
+			SceneStaticBatchAsset batch = batchIt->second.asset;
+			batch.nObjectIndex = nIndex;
+
+			sceneAsset.staticBatches.push_back(batch);
+		}
 
 		/* Create a GameObjectAsset */
 		GameObjectAsset objAsset = { };
-		objAsset.transform = pObj->transform;
+		objAsset.transform = static_cast<const GameObject*>(pObj)->GetTransform(); // Non-const access marks it dirty
 
 		/* Serialize mesh asset */
-		Map<String, Component*> components =  pObj->GetComponents();
-		if (components.contains("MeshComponent")) {
-			Mesh* meshComponent = dynamic_cast<Mesh*>(components["MeshComponent"]);
-
-			if (meshComponent) {
-				objAsset.header.displayName = pObj->GetName();
-				objAsset.components = objAsset.components | EAssetComponent::MESH;
-				objAsset.transform = pObj->transform;
-
-				const AssetHandle meshHandle = meshComponent->GetAssetHandle();
-				objAsset.meshHandle = meshHandle;
-			}	
+		Mesh* meshComponent = pObj->GetComponent<Mesh>();
+		if (meshComponent) {
+			objAsset.header.displayName = pObj->GetName();
+			objAsset.components = objAsset.components | EAssetComponent::MESH;
+
+			const AssetHandle meshHandle = meshComponent->GetAssetHandle();
+			objAsset.meshHandle = meshHandle;
 		}
 		
-		assets[i] = std::move(objAsset);
-		i++;
-	}
-
-	if (i != nObjectCount) {
-		Logger::Error("Scene::SerializeScene: Object count mismatch. Got {} of {}", i, nObjectCount);
-		return SceneAsset{};
+		assets.push_back(std::move(objAsset));
 	}
 
 	sceneAsset.header.displayName = this->GetName();
-	sceneAsset.header.nObjectCount = nObjectCount;
+	sceneAsset.header.nObjectCount = static_cast<uint32_t>(assets.size());
 	sceneAsset.objects = std::move(assets);
+	sceneAsset.cells = this->m_partition.GetCellAssets();
 
 	return sceneAsset;
 }
 
 /**
-* Setup the scene from a serialized scene asset
+* Setup the scene from a serialized scene asset.
+* Cells of a partitioned scene are streamed in
+* by the scene update, around the camera
 * 
 * @param sceneAsset Scene asset
 */
 void 
 Scene::SetupFromAsset(const SceneAsset& sceneAsset) {
 	uint32_t nObjectCount = sceneAsset.header.nObjectCount;
+
+	Vector<GameObject*> created;
+	created.reserve(nObjectCount);
 	
 	for (uint32_t i = 0; i < nObjectCount; i++) {
 		const GameObjectAsset& objAsset = sceneAsset.objects[i];
 		
-		GameObject* pObj = new GameObject(String(objAsset.header.displayName));
+		GameObject* pObj = this->CreateObject(String(objAsset.header.displayName));
 		pObj->SetupFromAsset(objAsset);
-		this->AddObject(pObj);
+
+		created.push_back(pObj);
+	}
+
+	for (uint32_t nIndex : sceneAsset.staticObjects) {
+		if (nIndex < created.size()) {
+			created[nIndex]->SetStatic(true);
+		}
+	}
+
+	for (const SceneStaticBatchAsset& batch : sceneAsset.staticBatches) {
+		if (batch.nObjectIndex >= created.size()) continue;
+
+		GameObject* pObj = created[batch.nObjectIndex];
+		this->m_staticBatches[pObj->GetEntity()] = { pObj->GetHandle(), batch };
+	}
+
+	if (sceneAsset.IsBaked()) {
+		Logger::Info("Scene::SetupFromAsset: {} static batches", sceneAsset.staticBatches.size());
+	}
+
+	if (sceneAsset.IsPartitioned()) {
+		this->m_partition.Init(sceneAsset);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,617 @@
+#include "Core/Scene/SceneBVH.h"
+#include "Core/Utils/Profiler.h"
+
+#include <algorithm>
+
+static constexpr uint32_t SAH_BIN_COUNT = 16;
+
+/* Optimize() only measures the tree after this many changes (or a quarter of the leaves) */
+static constexpr uint32_t MIN_CHANGES_BEFORE_CHECK = 16;
+static constexpr float REBUILD_COST_RATIO = 1.3f;
+
+/**
+* Adds an object, next to the sibling that
+* grows the tree the least
+*
+* @param entity Entity index
+* @param bounds World bounds
+*/
+void
+SceneBVH::Insert(EntityID entity, const AABB& bounds) {
+	if (this->Contains(entity)) {
+		this->Update(entity, bounds);
+		return;
+	}
+
+	uint32_t nLeaf = this->AllocateNode();
+	this->m_nodes[nLeaf].bounds = bounds;
+	this->m_nodes[nLeaf].entity = entity;
+
+	if (entity >= this->m_leaves.size()) {
+		this->m_leaves.resize(static_cast<size_t>(entity) + 1, INVALID_NODE);
+	}
+	this->m_leaves[entity] = nLeaf;
+
+	this->InsertLeaf(nLeaf);
+
+	this->m_nLeafCount++;
+	this->m_nChangesSinceBuild++;
+}
+
+void
+SceneBVH::Remove(EntityID entity) {
+	if (!this->Contains(entity)) return;
+
+	uint32_t nLeaf = this->m_leaves[entity];
+	this->RemoveLeaf(nLeaf);
+	this->FreeNode(nLeaf);
+
+	this->m_leaves[entity] = INVALID_NODE;
+
+	this->m_nLeafCount--;
+	this->m_nChangesSinceBuild++;
+}
+
+/**
+* Changes the bounds of an object in place
+* and refits its ancestors
+*
+* @param entity Entity index
+* @param bounds New world bounds
+*/
+void
+SceneBVH::Update(EntityID entity, const AABB& bounds) {
+	if (!this->Contains(entity)) {
+		this->Insert(entity, bounds);
+		return;
+	}
+
+	uint32_t nLeaf = this->m_leaves[entity];
+	BVHNode& leaf = this->m_nodes[nLeaf];
+
+	if (leaf.bounds.min == bounds.min && leaf.bounds.max == bounds.max) return;
+
+	leaf.bounds = bounds;
+	this->Refit(leaf.nParent);
+
+	this->m_nChangesSinceBuild++;
+}
+
+bool
+SceneBVH::Contains(EntityID entity) const {
+	return entity < this->m_leaves.size() && this->m_leaves[entity] != INVALID_NODE;
+}
+
+/**
+* Rebuilds the whole tree top down, splitting
+* each range where the binned SAH is lowest
+*/
+void
+SceneBVH::Build() {
+	PROFILE_SCOPE("SceneBVH::Build");
+
+	struct Primitive {
+		EntityID entity;
+		AABB bounds;
+		glm::vec3 centroid;
+	};
+
+	struct BuildTask {
+		uint32_t nNode;
+		uint32_t nBegin;
+		uint32_t nEnd;
+	};
+
+	struct Bin {
+		AABB bounds;
+		uint32_t nCount = 0;
+	};
+
+	Vector<Primitive> primitives;
+	primitives.reserve(this->m_nLeafCount);
+
+	for (uint32_t nLeaf : this->m_leaves) {
+		if (nLeaf == INVALID_NODE) continue;
+
+		const BVHNode& leaf = this->m_nodes[nLeaf];
+		primitives.push_back({ leaf.entity, leaf.bounds, leaf.bounds.GetCenter() });
+	}
+
+	this->m_nodes.clear();
+	this->m_freeNodes.clear();
+	this->m_nRoot = INVALID_NODE;
+
+	if (primitives.empty()) {
+		this->m_fBuildCost = 0.f;
+		this->m_nChangesSinceBuild = 0;
+		return;
+	}
+
+	this->m_nodes.reserve(primitives.size() * 2 - 1);
+	this->m_nRoot = this->AllocateNode();
+
+	Vector<BuildTask> tasks;
+	tasks.push_back({ this->m_nRoot, 0, static_cast<uint32_t>(primitives.size()) });
+
+	while (!tasks.empty()) {
+		BuildTask task = tasks.back();
+		tasks.pop_back();
+
+		uint32_t nCount = task.nEnd - task.nBegin;
+
+		if (nCount == 1) {
+			const Primitive& primitive = primitives[task.nBegin];
+
+			BVHNode& leaf = this->m_nodes[task.nNode];
+			leaf.bounds = primitive.bounds;
+			leaf.entity = primitive.entity;
+
+			this->m_leaves[primitive.entity] = task.nNode;
+			continue;
+		}
+
+		AABB bounds;
+		AABB centroidBounds;
+		for (uint32_t i = task.nBegin; i < task.nEnd; i++) {
+			bounds.Expand(primitives[i].bounds);
+			centroidBounds.Expand(primitives[i].centroid);
+		}
+
+		this->m_nodes[task.nNode].bounds = bounds;
+
+		/* Cheapest bin boundary over all three axes */
+		int nBestAxis = -1;
+		uint32_t nBestSplit = 0;
+		float fBestCost = FLT_MAX;
+
+		for (int nAxis = 0; nAxis < 3; nAxis++) {
+			float fMin = centroidBounds.min[nAxis];
+			float fExtent = centroidBounds.max[nAxis] - fMin;
+			if (fExtent <= 1e-6f) continue;
+
+			float fScale = SAH_BIN_COUNT / fExtent;
+
+			Bin bins[SAH_BIN_COUNT];
+			for (uint32_t i = task.nBegin; i < task.nEnd; i++) {
+				uint32_t nBin = std::min(SAH_BIN_COUNT - 1, static_cast<uint32_t>((primitives[i].centroid[nAxis] - fMin) * fScale));
+				bins[nBin].bounds.Expand(primitives[i].bounds);
+				bins[nBin].nCount++;
+			}
+
+			/* Right to left sweep first, then evaluate while sweeping left to right */
+			float rightAreas[SAH_BIN_COUNT];
+			uint32_t rightCounts[SAH_BIN_COUNT];
+
+			AABB rightBounds;
+			uint32_t nRightCount = 0;
+			for (uint32_t nBin = SAH_BIN_COUNT; nBin-- > 1;) {
+				rightBounds.Expand(bins[nBin].bounds);
+				nRightCount += bins[nBin].nCount;
+
+				rightAreas[nBin] = rightBounds.GetSurfaceArea();
+				rightCounts[nBin] = nRightCount;
+			}
+
+			AABB leftBounds;
+			uint32_t nLeftCount = 0;
+			for (uint32_t nSplit = 1; nSplit < SAH_BIN_COUNT; nSplit++) {
+				leftBounds.Expand(bins[nSplit - 1].bounds);
+				nLeftCount += bins[nSplit - 1].nCount;
+
+				if (nLeftCount == 0 || rightCounts[nSplit] == 0) continue;
+
+				float fCost = leftBounds.GetSurfaceArea() * nLeftCount + rightAreas[nSplit] * rightCounts[nSplit];
+				if (fCost < fBestCost) {
+					fBestCost = fCost;
+					nBestAxis = nAxis;
+					nBestSplit = nSplit;
+				}
+			}
+		}
+
+		Primitive* pBegin = primitives.data() + task.nBegin;
+		Primitive* pEnd = primitives.data() + task.nEnd;
+		Primitive* pMiddle = pBegin;
+
+		if (nBestAxis >= 0) {
+			float fMin = centroidBounds.min[nBestAxis];
+			float fScale = SAH_BIN_COUNT / (centroidBounds.max[nBestAxis] - fMin);
+
+			pMiddle = std::partition(pBegin, pEnd, [&](const Primitive& primitive) {
+				uint32_t nBin = std::min(SAH_BIN_COUNT - 1, static_cast<uint32_t>((primitive.centroid[nBestAxis] - fMin) * fScale));
+				return nBin < nBestSplit;
+			});
+		}
+
+		/* Every centroid in the same spot, any split is as good */
+		if (pMiddle == pBegin || pMiddle == pEnd) {
+			pMiddle = pBegin + nCount / 2;
+		}
+
+		uint32_t nMiddle = static_cast<uint32_t>(pMiddle - primitives.data());
+
+		uint32_t nLeft = this->AllocateNode();
+		uint32_t nRight = this->AllocateNode();
+
+		BVHNode& node = this->m_nodes[task.nNode];
+		node.nLeft = nLeft;
+		node.nRight = nRight;
+
+		this->m_nodes[nLeft].nParent = task.nNode;
+		this->m_nodes[nRight].nParent = task.nNode;
+
+		tasks.push_back({ nLeft, task.nBegin, nMiddle });
+		tasks.push_back({ nRight, nMiddle, task.nEnd });
+	}
+
+	this->m_fBuildCost = this->GetCost();
+	this->m_nChangesSinceBuild = 0;
+}
+
+/**
+* Rebuilds the tree if inserts and refits since
+* the last build made it too expensive to walk
+*/
+void
+SceneBVH::Optimize() {
+	uint32_t nThreshold = std::max(MIN_CHANGES_BEFORE_CHECK, this->m_nLeafCount / 4);
+	if (this->m_nChangesSinceBuild < nThreshold) return;
+
+	if (this->GetCost() > this->m_fBuildCost * REBUILD_COST_RATIO) {
+		this->Build();
+		return;
+	}
+
+	this->m_nChangesSinceBuild = 0;
+}
+
+void
+SceneBVH::Clear() {
+	this->m_nodes.clear();
+	this->m_freeNodes.clear();
+	this->m_leaves.clear();
+
+	this->m_nRoot = INVALID_NODE;
+	this->m_nLeafCount = 0;
+	this->m_fBuildCost = 0.f;
+	this->m_nChangesSinceBuild = 0;
+}
+
+/**
+* Gets every object whose bounds touch the frustum.
+* Subtrees fully inside are taken without more tests
+*
+* @param frustum Frustum
+* @param outEntities Visible entities, appended
+*/
+void
+SceneBVH::QueryFrustum(const Frustum& frustum, Vector<EntityID>& outEntities) const {
+	if (this->m_nRoot == INVALID_NODE) return;
+
+	struct StackEntry {
+		uint32_t nNode;
+		uint32_t nPlaneMask; // Planes the parent wasn't fully inside of
+	};
+
+	Vector<StackEntry> stack;
+	stack.reserve(64);
+	stack.push_back({ this->m_nRoot, Frustum::ALL_PLANES });
+
+	while (!stack.empty()) {
+		StackEntry entry = stack.back();
+		stack.pop_back();
+
+		const BVHNode& node = this->m_nodes[entry.nNode];
+
+		EFrustumTest result = frustum.Test(node.bounds, entry.nPlaneMask);
+		if (result == EFrustumTest::OUTSIDE) continue;
+
+		if (result == EFrustumTest::INSIDE) {
+			this->CollectSubtree(entry.nNode, outEntities);
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			outEntities.push_back(node.entity);
+			continue;
+		}
+
+		stack.push_back({ node.nRight, entry.nPlaneMask });
+		stack.push_back({ node.nLeft, entry.nPlaneMask });
+	}
+}
+
+/**
+* Gets every object whose bounds overlap a box
+*
+* @param bounds Box to test
+* @param outEntities Overlapping entities, appended
+*/
+void
+SceneBVH::QueryOverlap(const AABB& bounds, Vector<EntityID>& outEntities) const {
+	if (this->m_nRoot == INVALID_NODE) return;
+
+	Vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(this->m_nRoot);
+
+	while (!stack.empty()) {
+		const BVHNode& node = this->m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (!node.bounds.Overlaps(bounds)) continue;
+
+		if (node.IsLeaf()) {
+			outEntities.push_back(node.entity);
+			continue;
+		}
+
+		stack.push_back(node.nRight);
+		stack.push_back(node.nLeft);
+	}
+}
+
+/**
+* Finds the closest object bounds along a ray,
+* visiting the nearer child first
+*
+* @param ray Ray, normalized direction
+* @param fMaxDistance Farthest accepted hit
+*
+* @returns Closest hit, invalid if nothing was hit
+*/
+RayHit
+SceneBVH::RayCast(const Ray& ray, float fMaxDistance) const {
+	RayHit hit = { };
+	if (this->m_nRoot == INVALID_NODE) return hit;
+
+	float fClosest = fMaxDistance;
+	float fDistance = 0.f;
+
+	if (!ray.Intersects(this->m_nodes[this->m_nRoot].bounds, fClosest, fDistance)) return hit;
+
+	Vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(this->m_nRoot);
+
+	while (!stack.empty()) {
+		const BVHNode& node = this->m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.IsLeaf()) {
+			if (ray.Intersects(node.bounds, fClosest, fDistance)) {
+				fClosest = fDistance;
+				hit.entity = node.entity;
+				hit.fDistance = fDistance;
+			}
+			continue;
+		}
+
+		float fLeftDistance = 0.f;
+		float fRightDistance = 0.f;
+		bool bLeft = ray.Intersects(this->m_nodes[node.nLeft].bounds, fClosest, fLeftDistance);
+		bool bRight = ray.Intersects(this->m_nodes[node.nRight].bounds, fClosest, fRightDistance);
+
+		/* Farther child below the nearer one on the stack */
+		if (bLeft && bRight) {
+			if (fLeftDistance <= fRightDistance) {
+				stack.push_back(node.nRight);
+				stack.push_back(node.nLeft);
+			}
+			else {
+				stack.push_back(node.nLeft);
+				stack.push_back(node.nRight);
+			}
+		}
+		else if (bLeft) {
+			stack.push_back(node.nLeft);
+		}
+		else if (bRight) {
+			stack.push_back(node.nRight);
+		}
+	}
+
+	return hit;
+}
+
+/**
+* SAH cost of the tree, the surface area of
+* every inner node relative to the root's
+*
+* @returns Tree cost, lower is better
+*/
+float
+SceneBVH::GetCost() const {
+	if (this->m_nRoot == INVALID_NODE) return 0.f;
+
+	float fRootArea = this->m_nodes[this->m_nRoot].bounds.GetSurfaceArea();
+	if (fRootArea <= 0.f) return 0.f;
+
+	/* Free nodes look like empty leaves */
+	float fArea = 0.f;
+	for (const BVHNode& node : this->m_nodes) {
+		if (!node.IsLeaf()) {
+			fArea += node.bounds.GetSurfaceArea();
+		}
+	}
+
+	return fArea / fRootArea;
+}
+
+uint32_t
+SceneBVH::AllocateNode() {
+	if (!this->m_freeNodes.empty()) {
+		uint32_t nNode = this->m_freeNodes.back();
+		this->m_freeNodes.pop_back();
+
+		this->m_nodes[nNode] = BVHNode{ };
+		return nNode;
+	}
+
+	this->m_nodes.emplace_back();
+	return static_cast<uint32_t>(this->m_nodes.size() - 1);
+}
+
+void
+SceneBVH::FreeNode(uint32_t nNode) {
+	this->m_nodes[nNode] = BVHNode{ };
+	this->m_freeNodes.push_back(nNode);
+}
+
+/**
+* Links a leaf to the tree. Walks down to the node
+* whose union with the leaf adds the least area
+* (branch and bound, as in Box2D's dynamic tree)
+*
+* @param nLeaf Leaf node
+*/
+void
+SceneBVH::InsertLeaf(uint32_t nLeaf) {
+	if (this->m_nRoot == INVALID_NODE) {
+		this->m_nRoot = nLeaf;
+		this->m_nodes[nLeaf].nParent = INVALID_NODE;
+		return;
+	}
+
+	AABB leafBounds = this->m_nodes[nLeaf].bounds;
+
+	uint32_t nSibling = this->m_nRoot;
+	while (!this->m_nodes[nSibling].IsLeaf()) {
+		const BVHNode& node = this->m_nodes[nSibling];
+
+		float fArea = node.bounds.GetSurfaceArea();
+		float fCombinedArea = AABB::Union(node.bounds, leafBounds).GetSurfaceArea();
+
+		/* Pairing with this node vs. pushing the leaf further down */
+		float fCost = 2.f * fCombinedArea;
+		float fInheritedCost = 2.f * (fCombinedArea - fArea);
+
+		auto childCost = [&](uint32_t nChild) {
+			const BVHNode& child = this->m_nodes[nChild];
+			float fCost = AABB::Union(child.bounds, leafBounds).GetSurfaceArea() + fInheritedCost;
+
+			if (!child.IsLeaf()) {
+				fCost -= child.bounds.GetSurfaceArea();
+			}
+
+			return fCost;
+		};
+
+		float fLeftCost = childCost(node.nLeft);
+		float fRightCost = childCost(node.nRight);
+
+		if (fCost < fLeftCost && fCost < fRightCost) break;
+
+		nSibling = fLeftCost < fRightCost ? node.nLeft : node.nRight;
+	}
+
+	uint32_t nOldParent = this->m_nodes[nSibling].nParent;
+	uint32_t nNewParent = this->AllocateNode();
+
+	BVHNode& newParent = this->m_nodes[nNewParent];
+	newParent.nParent = nOldParent;
+	newParent.nLeft = nSibling;
+	newParent.nRight = nLeaf;
+	newParent.bounds = AABB::Union(this->m_nodes[nSibling].bounds, leafBounds);
+
+	if (nOldParent != INVALID_NODE) {
+		BVHNode& oldParent = this->m_nodes[nOldParent];
+		if (oldParent.nLeft == nSibling) {
+			oldParent.nLeft = nNewParent;
+		}
+		else {
+			oldParent.nRight = nNewParent;
+		}
+	}
+	else {
+		this->m_nRoot = nNewParent;
+	}
+
+	this->m_nodes[nSibling].nParent = nNewParent;
+	this->m_nodes[nLeaf].nParent = nNewParent;
+
+	this->Refit(nOldParent);
+}
+
+/**
+* Unlinks a leaf, its sibling takes the place
+* of their parent
+*
+* @param nLeaf Leaf node
+*/
+void
+SceneBVH::RemoveLeaf(uint32_t nLeaf) {
+	if (nLeaf == this->m_nRoot) {
+		this->m_nRoot = INVALID_NODE;
+		return;
+	}
+
+	uint32_t nParent = this->m_nodes[nLeaf].nParent;
+	uint32_t nGrandParent = this->m_nodes[nParent].nParent;
+	uint32_t nSibling = this->m_nodes[nParent].nLeft == nLeaf
+		? this->m_nodes[nParent].nRight
+		: this->m_nodes[nParent].nLeft;
+
+	this->m_nodes[nSibling].nParent = nGrandParent;
+
+	if (nGrandParent != INVALID_NODE) {
+		BVHNode& grandParent = this->m_nodes[nGrandParent];
+		if (grandParent.nLeft == nParent) {
+			grandParent.nLeft = nSibling;
+		}
+		else {
+			grandParent.nRight = nSibling;
+		}
+	}
+	else {
+		this->m_nRoot = nSibling;
+	}
+
+	this->FreeNode(nParent);
+	this->Refit(nGrandParent);
+}
+
+/**
+* Recomputes the bounds of a node and its
+* ancestors, stopping once one doesn't change
+*
+* @param nNode First inner node to refit
+*/
+void
+SceneBVH::Refit(uint32_t nNode) {
+	while (nNode != INVALID_NODE) {
+		BVHNode& node = this->m_nodes[nNode];
+
+		AABB bounds = AABB::Union(this->m_nodes[node.nLeft].bounds, this->m_nodes[node.nRight].bounds);
+		if (bounds.min == node.bounds.min && bounds.max == node.bounds.max) return;
+
+		node.bounds = bounds;
+		nNode = node.nParent;
+	}
+}
+
+/**
+* Appends every leaf below a node
+*
+* @param nNode Subtree root
+* @param outEntities Entities, appended
+*/
+void
+SceneBVH::CollectSubtree(uint32_t nNode, Vector<EntityID>& outEntities) const {
+	Vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(nNode);
+
+	while (!stack.empty()) {
+		const BVHNode& node = this->m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.IsLeaf()) {
+			outEntities.push_back(node.entity);
+			continue;
+		}
+
+		stack.push_back(node.nRight);
+		stack.push_back(node.nLeft);
+	}
+}
@@ -0,0 +1,353 @@
+#include "Core/Scene/SceneCommandBuffer.h"
+#include "Core/Scene/Scene.h"
+#include "Core/Renderer/MeshUploadQueue.h"
+#include "Core/Logger.h"
+#include "Core/Utils/Profiler.h"
+
+#include <utility>
+
+/**
+* Records a spawn of copies of an object, with
+* the prototype's transform. Copies get the
+* prototype's name and share its mesh data
+*
+* @param prototype Object to copy
+* @param nCount Number of copies
+* @param parent Parent object, the root if invalid
+* @param onSpawned Called with the copies once they exist
+*/
+void
+SceneCommandBuffer::Spawn(EntityHandle prototype, uint32_t nCount, EntityHandle parent, OnSpawned onSpawned) {
+	if (nCount == 0) return;
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_recording.spawns.push_back({ prototype, parent, nCount, UINT32_MAX, std::move(onSpawned) });
+}
+
+/**
+* Records a spawn of copies of an object,
+* one per transform
+*
+* @param prototype Object to copy
+* @param transforms Local transform of each copy
+* @param parent Parent object, the root if invalid
+* @param onSpawned Called with the copies once they exist
+*/
+void
+SceneCommandBuffer::Spawn(EntityHandle prototype, const Vector<Transform>& transforms, EntityHandle parent, OnSpawned onSpawned) {
+	if (transforms.empty()) return;
+
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	Commands& commands = this->m_recording;
+	uint32_t nFirstTransform = static_cast<uint32_t>(commands.transforms.size());
+
+	commands.transforms.insert(commands.transforms.end(), transforms.begin(), transforms.end());
+	commands.spawns.push_back({ prototype, parent, static_cast<uint32_t>(transforms.size()), nFirstTransform, std::move(onSpawned) });
+}
+
+/**
+* Records the removal of an object
+* and its subtree
+*
+* @param handle Object
+*/
+void
+SceneCommandBuffer::Despawn(EntityHandle handle) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_recording.despawns.push_back(handle);
+}
+
+/**
+* Records a parent change, the object becomes
+* the last child of its new parent
+*
+* @param handle Object
+* @param newParent New parent object, the root if invalid
+*/
+void
+SceneCommandBuffer::Reparent(EntityHandle handle, EntityHandle newParent) {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	this->m_recording.reparents.push_back({ handle, newParent });
+}
+
+/**
+* Checks if there are commands waiting
+*
+* @returns True if nothing was recorded
+*/
+bool
+SceneCommandBuffer::IsEmpty() {
+	std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_recording.IsEmpty();
+}
+
+/**
+* Applies everything recorded so far. Commands
+* recorded meanwhile, spawn callbacks included,
+* wait for the next apply
+*
+* @param scene Scene the commands were recorded for
+*/
+void
+SceneCommandBuffer::Apply(Scene& scene) {
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		if (this->m_recording.IsEmpty()) return;
+
+		std::swap(this->m_recording, this->m_applying);
+	}
+
+	PROFILE_SCOPE("SceneCommandBuffer::Apply");
+
+	this->ApplyDespawns(scene);
+
+	/* Node IDs survive the reparents and spawns, one map serves both */
+	bool bNeedsNodes = !this->m_applying.reparents.empty();
+	for (const SpawnCommand& spawn : this->m_applying.spawns) {
+		bNeedsNodes |= spawn.parent.IsValid();
+	}
+
+	if (bNeedsNodes) {
+		this->MapNodes(scene);
+	}
+
+	this->ApplyReparents(scene);
+	this->ApplySpawns(scene);
+
+	this->m_applying.Clear();
+	this->m_nodeIds.clear();
+}
+
+/**
+* Deletes the despawned objects and their
+* subtrees with one hierarchy rebuild. GPU
+* meshes nothing draws anymore are released
+* by the frame loop in its next batch, once
+* no frame in flight draws them
+*
+* @param scene Scene
+*/
+void
+SceneCommandBuffer::ApplyDespawns(Scene& scene) {
+	const Vector<EntityHandle>& despawns = this->m_applying.despawns;
+	if (despawns.empty()) return;
+
+	PROFILE_SCOPE("SceneCommandBuffer::ApplyDespawns");
+
+	/* By entity index, stale and repeated handles drop out */
+	Vector<uint8_t> marked(scene.m_objectSlots.size(), 0);
+	uint32_t nMarked = 0;
+
+	for (const EntityHandle& handle : despawns) {
+		if (scene.GetGameObject(handle) == nullptr || marked[handle.nIndex]) continue;
+
+		marked[handle.nIndex] = 1;
+		nMarked++;
+	}
+
+	if (nMarked == 0) return;
+
+	/*
+		Detach the objects of every despawned subtree from
+		their nodes, they are deleted below instead of one
+		by one through the deleted callback
+	*/
+	Hierarchy& hierarchy = scene.GetHierarchy();
+
+	Vector<uint32_t> roots;
+	Vector<GameObject*> objects;
+	uint32_t nSubtreeEnd = 0;
+
+	for (uint32_t i = 0; i < hierarchy.GetSize(); i++) {
+		Hierarchy::HierarchyNode& node = hierarchy.nodes[i];
+
+		bool bInside = i < nSubtreeEnd;
+		if (!bInside && node.pObj != nullptr && marked[node.pObj->GetEntity()]) {
+			roots.push_back(i);
+			nSubtreeEnd = i + node.nSubtreeSize;
+			bInside = true;
+		}
+
+		if (bInside && node.pObj != nullptr) {
+			objects.push_back(node.pObj);
+			node.pObj = nullptr;
+		}
+	}
+
+	hierarchy.DeleteNodes(roots);
+
+	/* Meshes go through the registry, the last user queues the GPU release */
+	for (GameObject* pObj : objects) {
+		scene.DeleteObject(pObj);
+	}
+
+	Logger::Debug("SceneCommandBuffer::ApplyDespawns: {} objects despawned", objects.size());
+}
+
+/**
+* Moves every reparented object with one
+* hierarchy rebuild
+*
+* @param scene Scene
+*/
+void
+SceneCommandBuffer::ApplyReparents(Scene& scene) {
+	const Vector<ReparentCommand>& reparents = this->m_applying.reparents;
+	if (reparents.empty()) return;
+
+	PROFILE_SCOPE("SceneCommandBuffer::ApplyReparents");
+
+	Vector<Hierarchy::NodeMove> moves;
+	moves.reserve(reparents.size());
+
+	for (const ReparentCommand& reparent : reparents) {
+		uint32_t nNode = this->FindNode(scene, reparent.handle);
+		uint32_t nParent = reparent.parent.IsValid() ? this->FindNode(scene, reparent.parent) : Hierarchy::ROOT;
+
+		if (nNode == Hierarchy::INVALID_NODE || nParent == Hierarchy::INVALID_NODE) {
+			Logger::Warn("SceneCommandBuffer::ApplyReparents: Object or parent of entity {} is gone", reparent.handle.nIndex);
+			continue;
+		}
+
+		moves.push_back({ nNode, nParent });
+	}
+
+	scene.GetHierarchy().MoveNodes(moves);
+}
+
+/**
+* Creates the spawned copies. Each spawn adds its
+* nodes at once and queues the shared mesh data
+* for upload once, the frame loop skips meshes
+* already on the GPU
+*
+* @param scene Scene
+*/
+void
+SceneCommandBuffer::ApplySpawns(Scene& scene) {
+	const Vector<SpawnCommand>& spawns = this->m_applying.spawns;
+	if (spawns.empty()) return;
+
+	PROFILE_SCOPE("SceneCommandBuffer::ApplySpawns");
+
+	Hierarchy& hierarchy = scene.GetHierarchy();
+
+	Vector<GameObject*> objects;
+	Vector<EntityHandle> handles;
+	uint32_t nSpawned = 0;
+
+	for (const SpawnCommand& spawn : spawns) {
+		GameObject* pPrototype = scene.GetGameObject(spawn.prototype);
+		if (pPrototype == nullptr) {
+			Logger::Warn("SceneCommandBuffer::ApplySpawns: Prototype of {} spawns is gone", spawn.nCount);
+			continue;
+		}
+
+		uint32_t nParent = Hierarchy::ROOT;
+		if (spawn.parent.IsValid()) {
+			nParent = this->FindNode(scene, spawn.parent);
+
+			if (nParent == Hierarchy::INVALID_NODE) {
+				Logger::Warn("SceneCommandBuffer::ApplySpawns: Parent of {} spawns is gone", spawn.nCount);
+				continue;
+			}
+		}
+
+		/* Copied up front, adding components moves the pools */
+		String name = pPrototype->GetName();
+		Transform transform = static_cast<const GameObject*>(pPrototype)->GetTransform();
+
+		Ref<MeshData> meshData;
+		AssetHandle meshHandle;
+
+		/*
+			Copies add users to the registry mesh, its data is only
+			shared. A mesh outside the registry has one owner, whose
+			unload releases it from the GPU, so copies go without
+		*/
+		Mesh* pMesh = pPrototype->GetComponent<Mesh>();
+		if (pMesh != nullptr && pMesh->IsLoaded()) {
+			if (pMesh->IsShared()) {
+				meshData = pMesh->GetMeshDataRef();
+				meshHandle = pMesh->GetAssetHandle();
+			}
+			else {
+				Logger::Warn("SceneCommandBuffer::ApplySpawns: Mesh of {} isn't shared, {} copies spawn without it", name, spawn.nCount);
+			}
+		}
+
+		objects.clear();
+		handles.clear();
+		objects.reserve(spawn.nCount);
+		handles.reserve(spawn.nCount);
+
+		for (uint32_t i = 0; i < spawn.nCount; i++) {
+			GameObject* pObj = scene.AllocateObject(name);
+
+			pObj->GetTransform() = spawn.nFirstTransform != UINT32_MAX
+				? this->m_applying.transforms[spawn.nFirstTransform + i]
+				: transform;
+
+			if (meshData) {
+				pObj->AddComponent<Mesh>("MeshComponent").LoadAsset(meshHandle, false);
+			}
+
+			objects.push_back(pObj);
+			handles.push_back(pObj->GetHandle());
+		}
+
+		hierarchy.CreateNodes(name, nParent, objects);
+
+		if (meshData) {
+			MeshUploadQueue::GetInstance()->Push(meshData);
+		}
+
+		nSpawned += spawn.nCount;
+
+		if (spawn.onSpawned) {
+			spawn.onSpawned(handles);
+		}
+	}
+
+	Logger::Debug("SceneCommandBuffer::ApplySpawns: {} objects spawned", nSpawned);
+}
+
+/**
+* Maps every object to its hierarchy node ID
+* in one pass over the tree
+*
+* @param scene Scene
+*/
+void
+SceneCommandBuffer::MapNodes(Scene& scene) {
+	const Hierarchy& hierarchy = scene.GetHierarchy();
+
+	this->m_nodeIds.clear();
+	this->m_nodeIds.reserve(hierarchy.nodes.size());
+
+	for (const Hierarchy::HierarchyNode& node : hierarchy.nodes) {
+		if (node.pObj != nullptr) {
+			this->m_nodeIds[node.pObj->GetEntity()] = node.id;
+		}
+	}
+}
+
+/**
+* Gets the current node index of an object,
+* through the map built by MapNodes()
+*
+* @param scene Scene
+* @param handle Object
+*
+* @returns Node index or INVALID_NODE if the object is gone
+*/
+uint32_t
+SceneCommandBuffer::FindNode(Scene& scene, EntityHandle handle) {
+	if (scene.GetGameObject(handle) == nullptr) return Hierarchy::INVALID_NODE;
+
+	auto it = this->m_nodeIds.find(handle.nIndex);
+	if (it == this->m_nodeIds.end()) return Hierarchy::INVALID_NODE;
+
+	return scene.GetHierarchy().FindNode(it->second);
+}
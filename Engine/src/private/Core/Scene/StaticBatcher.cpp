@@ -0,0 +1,329 @@
+#include "Core/Scene/StaticBatcher.h"
+#include "Core/Resources/AssetManager.h"
+#include "Core/Utils/Profiler.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/**
+* Bakes the static mesh objects of a scene into
+* batches. Other objects are copied as they are,
+* the batch objects are appended after them
+*
+* @param sceneAsset Scene to bake, not partitioned
+* @param settings Cluster size and chunk limits
+* @param batchPrefix Batch mesh file and name prefix
+* @param outScene Baked scene, batch paths set
+* @param outMeshes One mesh per batch, same order as outScene.staticBatches
+*
+* @returns True if success
+*/
+bool
+StaticBatcher::Bake(
+	const SceneAsset& sceneAsset,
+	const StaticBatchSettings& settings,
+	const String& batchPrefix,
+	SceneAsset& outScene,
+	Vector<MeshAsset>& outMeshes
+) {
+	if (settings.fClusterSize <= 0.f) {
+		Logger::Error("StaticBatcher::Bake: Invalid cluster size {}", settings.fClusterSize);
+		return false;
+	}
+
+	/* Cells are baked scenes of their own, partition after baking */
+	if (sceneAsset.IsPartitioned()) {
+		Logger::Error("StaticBatcher::Bake: {} is partitioned, bake it before partitioning", sceneAsset.header.displayName.data);
+		return false;
+	}
+
+	if (sceneAsset.IsBaked()) {
+		Logger::Error("StaticBatcher::Bake: {} is already baked", sceneAsset.header.displayName.data);
+		return false;
+	}
+
+	outScene = { };
+	outScene.header.displayName = sceneAsset.header.displayName;
+	outMeshes.clear();
+
+	Vector<uint8_t> staticFlags(sceneAsset.objects.size(), 0);
+	for (uint32_t nIndex : sceneAsset.staticObjects) {
+		if (nIndex < staticFlags.size()) staticFlags[nIndex] = 1;
+	}
+
+	AssetManager* assetMgr = AssetManager::GetInstance();
+
+	Map<std::pair<int32_t, int32_t>, Cluster> clusters;
+
+	auto keepObject = [&](uint32_t nSource) {
+		if (staticFlags[nSource]) {
+			outScene.staticObjects.push_back(static_cast<uint32_t>(outScene.objects.size()));
+		}
+
+		outScene.objects.push_back(sceneAsset.objects[nSource]);
+	};
+
+	for (uint32_t i = 0; i < sceneAsset.objects.size(); i++) {
+		const GameObjectAsset& objAsset = sceneAsset.objects[i];
+
+		if (!staticFlags[i] || !objAsset.HasComponent(EAssetComponent::MESH)) {
+			keepObject(i);
+			continue;
+		}
+
+		const MeshAsset* pMeshAsset = std::get_if<MeshAsset>(&assetMgr->GetAsset(objAsset.meshHandle));
+		if (pMeshAsset == nullptr) {
+			Logger::Warn("StaticBatcher::Bake: Mesh of {} not found, left unbatched", objAsset.header.displayName.data);
+			keepObject(i);
+			continue;
+		}
+
+		/* Scene assets are flat, the local matrix is the world one */
+		glm::mat4 world = objAsset.transform.GetLocalMatrix();
+
+		const Vector3& location = objAsset.transform.location;
+		int32_t nX = static_cast<int32_t>(std::floor(location.x / settings.fClusterSize));
+		int32_t nZ = static_cast<int32_t>(std::floor(location.z / settings.fClusterSize));
+
+		auto [it, bInserted] = clusters.try_emplace(std::make_pair(nX, nZ));
+		Cluster& cluster = it->second;
+
+		if (bInserted) {
+			cluster.nX = nX;
+			cluster.nZ = nZ;
+			cluster.origin = glm::vec3((nX + .5f) * settings.fClusterSize, 0.f, (nZ + .5f) * settings.fClusterSize);
+		}
+
+		if (!StaticBatcher::MergeMesh(*pMeshAsset, world, settings, cluster)) {
+			Logger::Warn("StaticBatcher::Bake: Couldn't merge {}, left unbatched", objAsset.header.displayName.data);
+			keepObject(i);
+			continue;
+		}
+
+		cluster.nSourceCount++;
+	}
+
+	/* One object and mesh per cluster */
+	for (auto& [coords, cluster] : clusters) {
+		if (cluster.materials.empty()) continue;
+
+		String batchName = batchPrefix + "_static_" + std::to_string(cluster.nX) + "_" + std::to_string(cluster.nZ);
+		uint32_t nObjectIndex = static_cast<uint32_t>(outScene.objects.size());
+
+		GameObjectAsset objAsset = { };
+		objAsset.header.displayName = "StaticBatch " + std::to_string(cluster.nX) + "_" + std::to_string(cluster.nZ);
+		objAsset.transform.location = Vector3{ cluster.origin.x, cluster.origin.y, cluster.origin.z };
+		objAsset.components = EAssetComponent::MESH;
+
+		SceneStaticBatchAsset batch = { };
+		batch.bounds = cluster.bounds;
+		batch.nSourceCount = cluster.nSourceCount;
+		batch.nObjectIndex = nObjectIndex;
+		batch.path = batchName + ".aeth";
+
+		outScene.objects.push_back(objAsset);
+		outScene.staticObjects.push_back(nObjectIndex);
+		outScene.staticBatches.push_back(batch);
+
+		/* GPU meshes are keyed by name, the coordinates go first so a long prefix can't truncate them away */
+		String meshName = "static_" + std::to_string(cluster.nX) + "_" + std::to_string(cluster.nZ) + "_" + batchPrefix;
+		outMeshes.push_back(StaticBatcher::BuildMesh(cluster, meshName));
+	}
+
+	outScene.header.nObjectCount = static_cast<uint32_t>(outScene.objects.size());
+
+	return true;
+}
+
+/**
+* Bakes a scene file. Writes the batch meshes
+* and "<name>_baked.aeth" next to it
+*
+* @param scenePath Scene asset path
+* @param settings Cluster size and chunk limits
+*
+* @returns True if success
+*/
+bool
+StaticBatcher::BakeFile(const String& scenePath, const StaticBatchSettings& settings) {
+	PROFILE_SCOPE("StaticBatcher::BakeFile");
+
+	AssetManager* assetMgr = AssetManager::GetInstance();
+	AssetHandle sceneHandle = assetMgr->RegisterAsset(scenePath, EAssetType::SCENE);
+
+	AssetVariant sceneVariant = assetMgr->GetAsset(sceneHandle);
+	const SceneAsset* pSceneAsset = std::get_if<SceneAsset>(&sceneVariant);
+	if (pSceneAsset == nullptr) {
+		Logger::Error("StaticBatcher::BakeFile: Not a SceneAsset {}", scenePath);
+		return false;
+	}
+
+	fs::path path = fs::absolute(scenePath);
+	fs::path dir = path.parent_path();
+	String stem = path.stem().string();
+
+	SceneAsset baked = { };
+	Vector<MeshAsset> meshes;
+
+	if (!StaticBatcher::Bake(*pSceneAsset, settings, stem, baked, meshes)) return false;
+
+	uint32_t nSourceCount = 0;
+
+	for (size_t i = 0; i < meshes.size(); i++) {
+		String meshPath = (dir / baked.staticBatches[i].path.string()).string();
+
+		if (!assetMgr->SaveMesh(meshPath, meshes[i])) {
+			Logger::Error("StaticBatcher::BakeFile: Failed saving batch {}", meshPath);
+			return false;
+		}
+
+		nSourceCount += baked.staticBatches[i].nSourceCount;
+	}
+
+	String bakedPath = (dir / (stem + "_baked.aeth")).string();
+	if (!assetMgr->SaveScene(bakedPath, baked)) {
+		Logger::Error("StaticBatcher::BakeFile: Failed saving {}", bakedPath);
+		return false;
+	}
+
+	Logger::Info(
+		"StaticBatcher::BakeFile: {} static objects of {} merged into {} batches of {}. Saved at {}",
+		nSourceCount, scenePath, meshes.size(), settings.fClusterSize, bakedPath
+	);
+
+	return true;
+}
+
+/**
+* Appends the submeshes of a mesh to the chunks
+* of their materials, in the cluster's space
+*
+* @param meshAsset Source mesh
+* @param world Source object world matrix
+* @param settings Chunk limits
+* @param cluster Cluster to merge into
+*
+* @returns False if the mesh layout isn't supported, the cluster is left untouched
+*/
+bool
+StaticBatcher::MergeMesh(const MeshAsset& meshAsset, const glm::mat4& world, const StaticBatchSettings& settings, Cluster& cluster) {
+	for (const SubMeshAsset& subMesh : meshAsset.subMeshes) {
+		const SubMeshAssetHeader& header = subMesh.header;
+
+		uint64_t nVertexSize = static_cast<uint64_t>(header.nVertexCount) * header.nVertexStride;
+		uint64_t nIndexSize = static_cast<uint64_t>(header.nIndexCount) * header.nIndexStride;
+
+		if (header.nVertexStride != sizeof(Vertex) || header.nIndexStride != sizeof(uint32_t)) return false;
+		if (nVertexSize + nIndexSize != subMesh.buffer.size()) return false;
+		if (header.nVertexCount > settings.nMaxChunkVertices || header.nIndexCount > settings.nMaxChunkIndices) return false;
+	}
+
+	glm::mat4 toCluster = glm::translate(glm::mat4(1.f), -cluster.origin) * world;
+	glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(world));
+
+	/* Mirroring flips the winding, the triangles are flipped back */
+	bool bMirrored = glm::determinant(glm::mat3(world)) < 0.f;
+
+	for (const SubMeshAsset& subMesh : meshAsset.subMeshes) {
+		const SubMeshAssetHeader& header = subMesh.header;
+
+		Vector<Chunk>& chunks = cluster.materials[header.materialHandle];
+
+		bool bFull = !chunks.empty()
+			&& (chunks.back().vertices.size() + header.nVertexCount > settings.nMaxChunkVertices
+				|| chunks.back().indices.size() + header.nIndexCount > settings.nMaxChunkIndices);
+
+		if (chunks.empty() || bFull) {
+			chunks.emplace_back();
+		}
+
+		Chunk& chunk = chunks.back();
+		uint32_t nBaseVertex = static_cast<uint32_t>(chunk.vertices.size());
+
+		const Byte* pVertices = subMesh.buffer.data();
+		const Byte* pIndices = pVertices + static_cast<size_t>(header.nVertexCount) * sizeof(Vertex);
+
+		chunk.vertices.reserve(chunk.vertices.size() + header.nVertexCount);
+
+		for (uint32_t i = 0; i < header.nVertexCount; i++) {
+			Vertex vertex;
+			memcpy(&vertex, pVertices + static_cast<size_t>(i) * sizeof(Vertex), sizeof(Vertex));
+
+			glm::vec3 worldPosition = glm::vec3(world * glm::vec4(vertex.position, 1.f));
+			cluster.bounds.Expand(worldPosition);
+
+			vertex.position = glm::vec3(toCluster * glm::vec4(vertex.position, 1.f));
+
+			glm::vec3 normal = normalMatrix * vertex.normal;
+			float fLength = glm::length(normal);
+			vertex.normal = fLength > 0.f ? normal / fLength : normal;
+
+			chunk.vertices.push_back(vertex);
+		}
+
+		chunk.indices.reserve(chunk.indices.size() + header.nIndexCount);
+
+		for (uint32_t i = 0; i < header.nIndexCount; i++) {
+			uint32_t nIndex = 0;
+			memcpy(&nIndex, pIndices + static_cast<size_t>(i) * sizeof(uint32_t), sizeof(uint32_t));
+
+			chunk.indices.push_back(nBaseVertex + nIndex);
+		}
+
+		if (bMirrored) {
+			size_t nFirst = chunk.indices.size() - header.nIndexCount;
+
+			for (size_t i = nFirst; i + 2 < chunk.indices.size(); i += 3) {
+				std::swap(chunk.indices[i + 1], chunk.indices[i + 2]);
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+* Builds the mesh asset of a cluster, one submesh
+* per chunk
+*
+* @param cluster Cluster
+* @param name Mesh name, unique among the scene's meshes
+*
+* @returns Mesh asset
+*/
+MeshAsset
+StaticBatcher::BuildMesh(const Cluster& cluster, const String& name) {
+	MeshAsset meshAsset = { };
+	meshAsset.header.displayName = name;
+
+	for (const auto& [materialHandle, chunks] : cluster.materials) {
+		for (const Chunk& chunk : chunks) {
+			size_t nVertexSize = chunk.vertices.size() * sizeof(Vertex);
+			size_t nIndexSize = chunk.indices.size() * sizeof(uint32_t);
+
+			SubMeshAsset subMesh = { };
+			subMesh.header.nVertexCount = static_cast<uint32_t>(chunk.vertices.size());
+			subMesh.header.nVertexOffset = 0;
+			subMesh.header.nVertexStride = sizeof(Vertex);
+			subMesh.header.nIndexCount = static_cast<uint32_t>(chunk.indices.size());
+			subMesh.header.nIndexOffset = 0;
+			subMesh.header.nIndexStride = sizeof(uint32_t);
+			subMesh.header.nTotalByteSize = static_cast<uint32_t>(nVertexSize + nIndexSize);
+			subMesh.header.materialHandle = materialHandle;
+			subMesh.header.displayName = name + "_" + std::to_string(meshAsset.subMeshes.size());
+
+			subMesh.buffer.resize(nVertexSize + nIndexSize);
+			memcpy(subMesh.buffer.data(), chunk.vertices.data(), nVertexSize);
+			memcpy(subMesh.buffer.data() + nVertexSize, chunk.indices.data(), nIndexSize);
+
+			meshAsset.subMeshes.push_back(std::move(subMesh));
+		}
+	}
+
+	meshAsset.header.nSubMeshCount = static_cast<uint32_t>(meshAsset.subMeshes.size());
+
+	return meshAsset;
+}
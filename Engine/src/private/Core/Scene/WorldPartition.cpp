@@ -0,0 +1,638 @@
+#include "Core/Scene/WorldPartition.h"
+#include "Core/Scene/Scene.h"
+#include "Core/Resources/AssetManager.h"
+#include "Core/Renderer/MeshRegistry.h"
+#include "Core/Utils/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+WorldPartition::~WorldPartition() {
+	/* Loads in flight only touch their own payload */
+	if (this->m_streamingPool) {
+		this->m_streamingPool->WaitAll();
+	}
+}
+
+/**
+* Takes the cell table of a partitioned scene.
+* Always loaded objects keep their meshes in
+* the registry, streaming never frees them
+*
+* @param sceneAsset Partitioned scene asset
+*/
+void
+WorldPartition::Init(const SceneAsset& sceneAsset) {
+	this->m_cells.clear();
+	this->m_cells.resize(sceneAsset.cells.size());
+
+	for (size_t i = 0; i < sceneAsset.cells.size(); i++) {
+		this->m_cells[i].asset = sceneAsset.cells[i];
+		this->m_cells[i].nByteSize = sceneAsset.cells[i].nByteSize;
+	}
+
+	Logger::Info("WorldPartition::Init: {} cells, {} always loaded objects", this->m_cells.size(), sceneAsset.objects.size());
+}
+
+/**
+* Streams cells around the view. Instantiates
+* finished loads, unloads cells past the unload
+* radius and starts loading the nearest missing
+* cells within the budget
+*
+* @param scene Scene owning the streamed objects
+* @param viewPosition Camera position
+*/
+void
+WorldPartition::Update(Scene& scene, const glm::vec3& viewPosition) {
+	if (!this->IsEnabled()) return;
+
+	PROFILE_SCOPE("WorldPartition::Update");
+
+	for (Cell& cell : this->m_cells) {
+		cell.fDistance = WorldPartition::DistanceXZ(cell.asset.bounds, viewPosition);
+	}
+
+	this->PollLoads(scene);
+
+	/* Hysteresis, a camera moving along a cell border doesn't thrash it */
+	float fUnloadRadius = this->m_settings.fLoadRadius + this->m_settings.fUnloadMargin;
+
+	for (uint32_t i = 0; i < this->m_cells.size(); i++) {
+		if (this->m_cells[i].state == ECellState::LOADED && this->m_cells[i].fDistance > fUnloadRadius) {
+			this->UnloadCell(scene, i);
+		}
+	}
+
+	this->StartLoads(scene);
+}
+
+/**
+* Checks if an object belongs to a streamed cell
+*
+* @param handle Entity handle
+*
+* @returns True if the object is owned by a cell
+*/
+bool
+WorldPartition::IsStreamed(EntityHandle handle) const {
+	auto it = this->m_streamedObjects.find(handle.nIndex);
+	return it != this->m_streamedObjects.end() && it->second.handle == handle;
+}
+
+/**
+* Gets the cell table for serialization, with
+* the sizes measured by loads so far
+*
+* @returns Cell assets
+*/
+Vector<SceneCellAsset>
+WorldPartition::GetCellAssets() const {
+	Vector<SceneCellAsset> cells;
+	cells.reserve(this->m_cells.size());
+
+	for (const Cell& cell : this->m_cells) {
+		SceneCellAsset asset = cell.asset;
+		asset.nByteSize = cell.nByteSize;
+		cells.push_back(asset);
+	}
+
+	return cells;
+}
+
+/**
+* Instantiates cells whose load finished,
+* a few per update to bound the hitch
+*
+* @param scene Scene
+*/
+void
+WorldPartition::PollLoads(Scene& scene) {
+	float fUnloadRadius = this->m_settings.fLoadRadius + this->m_settings.fUnloadMargin;
+	uint32_t nInstantiated = 0;
+
+	for (uint32_t i = 0; i < this->m_cells.size(); i++) {
+		Cell& cell = this->m_cells[i];
+		if (cell.state != ECellState::LOADING) continue;
+
+		if (cell.load.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+		if (nInstantiated >= this->m_settings.nMaxCellsPerUpdate) break;
+
+		Ref<CellPayload> payload = cell.load.get();
+
+		this->m_nLoadingCells--;
+		this->m_nPendingBytes -= cell.nByteSize;
+
+		if (!payload) {
+			Logger::Error("WorldPartition::PollLoads: Failed loading cell {}", cell.asset.path.data);
+			cell.state = ECellState::FAILED;
+			continue;
+		}
+
+		cell.nByteSize = payload->nByteSize;
+
+		/* The camera moved away while it was loading */
+		if (cell.fDistance > fUnloadRadius) {
+			cell.state = ECellState::UNLOADED;
+			continue;
+		}
+
+		this->InstantiateCell(scene, i, *payload);
+		nInstantiated++;
+	}
+}
+
+/**
+* Starts loading the nearest unloaded cells
+* in the load radius. Farther loaded cells
+* are evicted when the budget is exceeded
+*
+* @param scene Scene
+*/
+void
+WorldPartition::StartLoads(Scene& scene) {
+	Vector<uint32_t> candidates;
+
+	for (uint32_t i = 0; i < this->m_cells.size(); i++) {
+		const Cell& cell = this->m_cells[i];
+
+		if (cell.state == ECellState::UNLOADED && cell.fDistance <= this->m_settings.fLoadRadius) {
+			candidates.push_back(i);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+		return this->m_cells[a].fDistance < this->m_cells[b].fDistance;
+	});
+
+	bool bOverBudget = false;
+
+	for (uint32_t nCell : candidates) {
+		if (this->m_nLoadingCells >= this->m_settings.nMaxConcurrentLoads) break;
+
+		Cell& cell = this->m_cells[nCell];
+
+		if (!this->MakeRoom(scene, cell.nByteSize, cell.fDistance)) {
+			bOverBudget = true;
+			break;
+		}
+
+		if (!this->m_streamingPool) {
+			this->m_streamingPool = ThreadPool::CreateShared(std::max(this->m_settings.nStreamingThreads, 1u));
+		}
+
+		AssetHandle handle = cell.asset.handle;
+		cell.load = this->m_streamingPool->Submit([handle]() {
+			return WorldPartition::LoadCell(handle);
+		});
+
+		cell.state = ECellState::LOADING;
+		this->m_nLoadingCells++;
+		this->m_nPendingBytes += cell.nByteSize;
+	}
+
+	if (bOverBudget && !this->m_bOverBudget) {
+		Logger::Warn(
+			"WorldPartition::StartLoads: Memory budget reached ({} of {} MB), nearer cells wait",
+			(MeshRegistry::GetInstance()->GetResidentBytes() + this->m_nPendingBytes) >> 20,
+			this->m_settings.nMemoryBudget >> 20
+		);
+	}
+
+	this->m_bOverBudget = bOverBudget;
+}
+
+/**
+* Evicts loaded cells farther than the one about
+* to load, farthest first, until it fits the budget.
+* The budget covers every mesh in the registry, each
+* counted once. Meshes a victim shares with other
+* users stay, so evicting it may free less than
+* its size. Loading cells count their full size
+* until instantiated, erring on the safe side
+*
+* @param scene Scene
+* @param nBytes Size of the cell about to load
+* @param fDistance Its distance to the view
+*
+* @returns True if it fits
+*/
+bool
+WorldPartition::MakeRoom(Scene& scene, uint64_t nBytes, float fDistance) {
+	MeshRegistry* pRegistry = MeshRegistry::GetInstance();
+
+	while (pRegistry->GetResidentBytes() + this->m_nPendingBytes + nBytes > this->m_settings.nMemoryBudget) {
+		/* A cell bigger than the whole budget still loads on its own */
+		if (this->m_nLoadedCells == 0 && this->m_nLoadingCells == 0) return true;
+
+		uint32_t nVictim = UINT32_MAX;
+		float fFarthest = fDistance;
+
+		for (uint32_t i = 0; i < this->m_cells.size(); i++) {
+			const Cell& cell = this->m_cells[i];
+
+			if (cell.state == ECellState::LOADED && cell.fDistance > fFarthest) {
+				nVictim = i;
+				fFarthest = cell.fDistance;
+			}
+		}
+
+		if (nVictim == UINT32_MAX) return false;
+
+		this->UnloadCell(scene, nVictim);
+	}
+
+	return true;
+}
+
+/**
+* Creates the objects of a loaded cell under
+* a hierarchy node of their own
+*
+* @param scene Scene
+* @param nCell Cell index
+* @param payload Loaded cell
+*/
+void
+WorldPartition::InstantiateCell(Scene& scene, uint32_t nCell, const CellPayload& payload) {
+	PROFILE_SCOPE("WorldPartition::InstantiateCell");
+
+	Cell& cell = this->m_cells[nCell];
+	Hierarchy& hierarchy = scene.GetHierarchy();
+
+	/* Last child of the root, its objects are appended without moving other nodes */
+	String cellName = "Cell " + std::to_string(cell.asset.nX) + "_" + std::to_string(cell.asset.nZ);
+	uint32_t nCellNode = hierarchy.CreateNode(Name(cellName), Hierarchy::ROOT);
+	cell.nNodeId = hierarchy.nodes[nCellNode].id;
+
+	cell.objects.reserve(payload.objects.size());
+
+	for (uint32_t i = 0; i < payload.objects.size(); i++) {
+		const GameObjectAsset& objAsset = payload.objects[i];
+
+		GameObject* pObj = scene.CreateObject(String(objAsset.header.displayName), nCellNode);
+		pObj->GetTransform() = objAsset.transform;
+
+		if (objAsset.HasComponent(EAssetComponent::MESH)) {
+			/* The payload holds a registry user, no decode happens here */
+			auto it = payload.meshes.find(objAsset.meshHandle.uuid);
+
+			if (it != payload.meshes.end() && it->second) {
+				Mesh& mesh = pObj->AddComponent<Mesh>("MeshComponent");
+				mesh.LoadAsset(objAsset.meshHandle);
+			}
+		}
+
+		EntityHandle handle = pObj->GetHandle();
+		cell.objects.push_back(handle);
+
+		if (std::binary_search(payload.staticObjects.begin(), payload.staticObjects.end(), i)) {
+			pObj->SetStatic(true);
+		}
+
+		this->m_streamedObjects[handle.nIndex] = { handle, nCell };
+	}
+
+	cell.state = ECellState::LOADED;
+	this->m_nLoadedCells++;
+
+	Logger::Debug(
+		"WorldPartition::InstantiateCell: {} loaded, {} objects, {} KB",
+		cellName, cell.objects.size(), cell.nByteSize >> 10
+	);
+}
+
+/**
+* Destroys the objects of a cell. Their meshes
+* are freed by the registry once nothing else
+* uses them
+*
+* @param scene Scene
+* @param nCell Cell index
+*/
+void
+WorldPartition::UnloadCell(Scene& scene, uint32_t nCell) {
+	PROFILE_SCOPE("WorldPartition::UnloadCell");
+
+	Cell& cell = this->m_cells[nCell];
+	Hierarchy& hierarchy = scene.GetHierarchy();
+
+	uint32_t nCellNode = hierarchy.FindNode(cell.nNodeId);
+	uint32_t nCellEnd = nCellNode != Hierarchy::INVALID_NODE ? nCellNode + hierarchy.nodes[nCellNode].nSubtreeSize : 0;
+
+	/*
+		Detach the cell's objects from their nodes, wherever
+		the editor moved them. Nodes moved out of the cell
+		node are deleted with it, their subtrees included.
+		Other objects in those subtrees go through the
+		usual deleted callback
+	*/
+	Vector<uint32_t> nodesToDelete;
+	if (nCellNode != Hierarchy::INVALID_NODE) {
+		nodesToDelete.push_back(nCellNode);
+	}
+
+	for (uint32_t i = 0; i < hierarchy.GetSize(); i++) {
+		Hierarchy::HierarchyNode& node = hierarchy.nodes[i];
+		if (node.pObj == nullptr) continue;
+
+		auto it = this->m_streamedObjects.find(node.pObj->GetEntity());
+		if (it == this->m_streamedObjects.end() || it->second.nCell != nCell || it->second.handle != node.pObj->GetHandle()) continue;
+
+		node.pObj = nullptr;
+
+		bool bInCell = i >= nCellNode && i < nCellEnd;
+		if (!bInCell) {
+			nodesToDelete.push_back(i);
+		}
+	}
+
+	hierarchy.DeleteNodes(nodesToDelete);
+
+	for (const EntityHandle& handle : cell.objects) {
+		auto it = this->m_streamedObjects.find(handle.nIndex);
+		if (it != this->m_streamedObjects.end() && it->second.handle == handle) {
+			this->m_streamedObjects.erase(it);
+		}
+
+		/* Already deleted in the editor */
+		GameObject* pObj = scene.GetGameObject(handle);
+		if (pObj == nullptr) continue;
+
+		scene.DeleteObject(pObj);
+	}
+
+	cell.objects.clear();
+	cell.nNodeId = UINT32_MAX;
+	cell.state = ECellState::UNLOADED;
+
+	this->m_nLoadedCells--;
+
+	Logger::Debug("WorldPartition::UnloadCell: Cell {}_{} unloaded", cell.asset.nX, cell.asset.nZ);
+}
+
+/**
+* Reads a cell asset and acquires its meshes,
+* decoding the ones not resident yet. Runs on
+* a streaming thread, doesn't touch the scene
+*
+* @param handle Cell scene asset handle
+*
+* @returns Cell payload, nullptr on failure
+*/
+Ref<WorldPartition::CellPayload>
+WorldPartition::LoadCell(AssetHandle handle) {
+	PROFILE_SCOPE("WorldPartition::LoadCell");
+
+	AssetManager* assetMgr = AssetManager::GetInstance();
+	Ref<CellPayload> payload = CreateRef<CellPayload>();
+
+	{
+		const SceneAsset* pCellAsset = std::get_if<SceneAsset>(&assetMgr->GetAsset(handle));
+		if (pCellAsset == nullptr) return nullptr;
+
+		payload->objects = pCellAsset->objects;
+		payload->staticObjects = pCellAsset->staticObjects;
+		std::sort(payload->staticObjects.begin(), payload->staticObjects.end());
+	}
+
+	/* The payload has its own copy, the next load reads the file again */
+	assetMgr->UnloadAsset(handle);
+
+	for (const GameObjectAsset& objAsset : payload->objects) {
+		if (!objAsset.HasComponent(EAssetComponent::MESH)) continue;
+		if (payload->meshes.contains(objAsset.meshHandle.uuid)) continue;
+
+		/* Every mesh the cell uses counts, whichever cell decoded it, so the size doesn't depend on load order */
+		uint64_t nResidentBytes = 0;
+		Ref<MeshData> meshData = MeshRegistry::GetInstance()->Acquire(objAsset.meshHandle, &nResidentBytes);
+		payload->nByteSize += nResidentBytes;
+
+		/* Failed meshes are remembered too, they aren't decoded again */
+		payload->meshes[objAsset.meshHandle.uuid] = meshData;
+	}
+
+	return payload;
+}
+
+/* Each mesh acquired by the load holds a registry user until the cell's objects took theirs */
+WorldPartition::CellPayload::~CellPayload() {
+	MeshRegistry* pRegistry = MeshRegistry::GetInstance();
+
+	for (const auto& [uuid, meshData] : this->meshes) {
+		if (meshData == nullptr) continue;
+
+		AssetHandle handle = { };
+		handle.uuid = uuid;
+		handle.type = EAssetType::MESH;
+		pRegistry->Release(handle);
+	}
+}
+
+/**
+* Distance from a point to a box on the
+* horizontal plane
+*
+* @param bounds Box
+* @param point Point
+*
+* @returns Distance, 0 inside the box
+*/
+float
+WorldPartition::DistanceXZ(const AABB& bounds, const glm::vec3& point) {
+	float fDx = std::max({ bounds.min.x - point.x, 0.f, point.x - bounds.max.x });
+	float fDz = std::max({ bounds.min.z - point.z, 0.f, point.z - bounds.max.z });
+
+	return std::sqrt(fDx * fDx + fDz * fDz);
+}
+
+/**
+* Splits a scene into grid cells on the XZ plane.
+* Objects with a mesh go to the cell holding their
+* location, the rest stay always loaded
+*
+* @param sceneAsset Flat scene
+* @param fCellSize Cell side
+* @param cellPrefix File name prefix of the cell assets
+* @param outRoot Always loaded objects and the cell table
+* @param outCells Cell assets, in cell table order
+*
+* @returns True if success
+*/
+bool
+WorldPartition::Partition(
+	const SceneAsset& sceneAsset,
+	float fCellSize,
+	const String& cellPrefix,
+	SceneAsset& outRoot,
+	Vector<SceneAsset>& outCells
+) {
+	if (fCellSize <= 0.f) {
+		Logger::Error("WorldPartition::Partition: Invalid cell size {}", fCellSize);
+		return false;
+	}
+
+	if (sceneAsset.IsPartitioned()) {
+		Logger::Error("WorldPartition::Partition: {} is already partitioned", sceneAsset.header.displayName.data);
+		return false;
+	}
+
+	outRoot = { };
+	outRoot.header.displayName = sceneAsset.header.displayName;
+	outCells.clear();
+
+	/* Ordered, the cell table comes out the same for the same scene */
+	Map<std::pair<int32_t, int32_t>, uint32_t> cellIndices;
+
+	/* Static flags and baked batches follow their objects */
+	Vector<uint8_t> staticFlags(sceneAsset.objects.size(), 0);
+	for (uint32_t nIndex : sceneAsset.staticObjects) {
+		if (nIndex < staticFlags.size()) staticFlags[nIndex] = 1;
+	}
+
+	Vector<const SceneStaticBatchAsset*> sourceBatches(sceneAsset.objects.size(), nullptr);
+	for (const SceneStaticBatchAsset& batch : sceneAsset.staticBatches) {
+		if (batch.nObjectIndex < sourceBatches.size()) sourceBatches[batch.nObjectIndex] = &batch;
+	}
+
+	auto placeObject = [&](SceneAsset& target, uint32_t nSource) {
+		uint32_t nIndex = static_cast<uint32_t>(target.objects.size());
+		target.objects.push_back(sceneAsset.objects[nSource]);
+
+		if (staticFlags[nSource]) {
+			target.staticObjects.push_back(nIndex);
+		}
+
+		if (sourceBatches[nSource] != nullptr) {
+			SceneStaticBatchAsset batch = *sourceBatches[nSource];
+			batch.nObjectIndex = nIndex;
+
+			target.staticBatches.push_back(batch);
+		}
+	};
+
+	for (uint32_t i = 0; i < sceneAsset.objects.size(); i++) {
+		const GameObjectAsset& objAsset = sceneAsset.objects[i];
+
+		if (!objAsset.HasComponent(EAssetComponent::MESH)) {
+			placeObject(outRoot, i);
+			continue;
+		}
+
+		const Vector3& location = objAsset.transform.location;
+		glm::vec3 position(location.x, location.y, location.z);
+
+		int32_t nX = static_cast<int32_t>(std::floor(position.x / fCellSize));
+		int32_t nZ = static_cast<int32_t>(std::floor(position.z / fCellSize));
+
+		auto [it, bInserted] = cellIndices.try_emplace(std::make_pair(nX, nZ), static_cast<uint32_t>(outCells.size()));
+
+		if (bInserted) {
+			String cellFile = cellPrefix + "_cell_" + std::to_string(nX) + "_" + std::to_string(nZ) + ".aeth";
+
+			SceneCellAsset cell = { };
+			cell.nX = nX;
+			cell.nZ = nZ;
+			cell.path = cellFile;
+			cell.bounds.Expand(glm::vec3(nX * fCellSize, position.y, nZ * fCellSize));
+			cell.bounds.Expand(glm::vec3((nX + 1) * fCellSize, position.y, (nZ + 1) * fCellSize));
+
+			SceneAsset cellAsset = { };
+			cellAsset.header.displayName = cellFile;
+
+			outRoot.cells.push_back(cell);
+			outCells.push_back(std::move(cellAsset));
+		}
+
+		uint32_t nCell = it->second;
+		outRoot.cells[nCell].bounds.Expand(position);
+		outRoot.cells[nCell].nObjectCount++;
+		placeObject(outCells[nCell], i);
+	}
+
+	/* Budget estimate, the geometry of each unique mesh */
+	AssetManager* assetMgr = AssetManager::GetInstance();
+
+	for (size_t i = 0; i < outCells.size(); i++) {
+		SceneAsset& cellAsset = outCells[i];
+		cellAsset.header.nObjectCount = static_cast<uint32_t>(cellAsset.objects.size());
+
+		Vector<uint64_t> counted;
+
+		for (const GameObjectAsset& objAsset : cellAsset.objects) {
+			uint64_t nMeshId = objAsset.meshHandle.uuid;
+			if (std::find(counted.begin(), counted.end(), nMeshId) != counted.end()) continue;
+			counted.push_back(nMeshId);
+
+			const MeshAsset* pMeshAsset = std::get_if<MeshAsset>(&assetMgr->GetAsset(objAsset.meshHandle));
+			if (pMeshAsset == nullptr) continue;
+
+			for (const SubMeshAsset& subMesh : pMeshAsset->subMeshes) {
+				outRoot.cells[i].nByteSize += subMesh.buffer.size();
+			}
+		}
+	}
+
+	outRoot.header.nObjectCount = static_cast<uint32_t>(outRoot.objects.size());
+
+	return true;
+}
+
+/**
+* Partitions a scene file. Writes the cells and
+* "<name>_partitioned.aeth" next to it
+*
+* @param scenePath Flat scene asset path
+* @param fCellSize Cell side
+*
+* @returns True if success
+*/
+bool
+WorldPartition::PartitionFile(const String& scenePath, float fCellSize) {
+	PROFILE_SCOPE("WorldPartition::PartitionFile");
+
+	AssetManager* assetMgr = AssetManager::GetInstance();
+	AssetHandle sceneHandle = assetMgr->RegisterAsset(scenePath, EAssetType::SCENE);
+
+	AssetVariant sceneVariant = assetMgr->GetAsset(sceneHandle);
+	const SceneAsset* pSceneAsset = std::get_if<SceneAsset>(&sceneVariant);
+	if (pSceneAsset == nullptr) {
+		Logger::Error("WorldPartition::PartitionFile: Not a SceneAsset {}", scenePath);
+		return false;
+	}
+
+	fs::path path = fs::absolute(scenePath);
+	fs::path dir = path.parent_path();
+	String stem = path.stem().string();
+
+	SceneAsset root = { };
+	Vector<SceneAsset> cells;
+
+	if (!WorldPartition::Partition(*pSceneAsset, fCellSize, stem, root, cells)) return false;
+
+	for (size_t i = 0; i < cells.size(); i++) {
+		String cellPath = (dir / root.cells[i].path.string()).string();
+
+		if (!assetMgr->SaveScene(cellPath, cells[i])) {
+			Logger::Error("WorldPartition::PartitionFile: Failed saving cell {}", cellPath);
+			return false;
+		}
+	}
+
+	String rootPath = (dir / (stem + "_partitioned.aeth")).string();
+	if (!assetMgr->SaveScene(rootPath, root)) {
+		Logger::Error("WorldPartition::PartitionFile: Failed saving {}", rootPath);
+		return false;
+	}
+
+	Logger::Info(
+		"WorldPartition::PartitionFile: {} split into {} cells of {}, {} always loaded objects. Saved at {}",
+		scenePath, cells.size(), fCellSize, root.objects.size(), rootPath
+	);
+
+	return true;
+}
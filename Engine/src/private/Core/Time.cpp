@@ -4,6 +4,7 @@ Time* Time::m_instance;
 
 Time::Time() {
 	this->deltaTime = 0.f;
+	this->frameTime = 0.f;
 	this->m_startTime = std::chrono::high_resolution_clock::now();
 	this->m_currentTime = this->m_startTime;
 	this->m_lastTime = this->m_startTime;
@@ -28,6 +29,9 @@ Time::Update() {
 
 void
 Time::PostUpdate() {
+	std::chrono::duration<float> duration = std::chrono::high_resolution_clock::now() - this->m_currentTime;
+	this->frameTime = duration.count();
+
 	this->m_lastTime = this->m_currentTime;
 }
 
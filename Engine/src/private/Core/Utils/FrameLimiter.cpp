@@ -0,0 +1,88 @@
+#include "Core/Utils/FrameLimiter.h"
+#include "Core/Utils/Profiler.h"
+
+#include <cmath>
+#include <thread>
+
+/**
+* Sets the target frame rate
+*
+* @param fFPS Frames per second (0 = unlimited)
+*/
+void
+FrameLimiter::SetTargetFPS(float fFPS) {
+	this->m_fTargetFPS = fFPS > 0.f ? fFPS : 0.f;
+	this->m_bStarted = false;
+
+	if (this->m_fTargetFPS > 0.f) {
+		std::chrono::duration<double> period(1.0 / static_cast<double>(this->m_fTargetFPS));
+		this->m_period = std::chrono::duration_cast<Clock::duration>(period);
+	}
+	else {
+		this->m_period = Clock::duration::zero();
+	}
+}
+
+/**
+* Blocks until the next frame deadline. Deadlines
+* advance by one period, so short sleeps are made up
+* on the next frame. After falling more than a frame
+* behind the schedule restarts instead of catching up
+*/
+void
+FrameLimiter::Wait() {
+	if (!this->IsEnabled()) return;
+
+	PROFILE_SCOPE("FrameLimiter::Wait");
+
+	Clock::time_point now = Clock::now();
+
+	if (!this->m_bStarted || now > this->m_nextFrame + this->m_period) {
+		this->m_nextFrame = now;
+		this->m_bStarted = true;
+	}
+
+	Clock::time_point deadline = this->m_nextFrame;
+
+	/* Sleep while it's safe */
+	while (true) {
+		std::chrono::duration<double> remaining = deadline - Clock::now();
+		if (remaining.count() <= this->m_fSleepEstimate) break;
+
+		Clock::time_point start = Clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		std::chrono::duration<double> observed = Clock::now() - start;
+		this->UpdateSleepEstimate(observed.count());
+	}
+
+	/* Spin the rest */
+	while (Clock::now() < deadline) {
+		std::this_thread::yield();
+	}
+
+	this->m_nextFrame = deadline + this->m_period;
+}
+
+/**
+* Adds a sleep sample (Welford's running variance)
+*
+* @param fObserved Duration of a 1 ms sleep in seconds
+*/
+void
+FrameLimiter::UpdateSleepEstimate(double fObserved) {
+	/* Keep adapting if the OS timer resolution changes */
+	if (this->m_nSleepCount >= 1000) {
+		this->m_nSleepCount = 1;
+		this->m_fSleepM2 = 0.0;
+	}
+
+	this->m_nSleepCount++;
+
+	double fDelta = fObserved - this->m_fSleepMean;
+	this->m_fSleepMean += fDelta / static_cast<double>(this->m_nSleepCount);
+	this->m_fSleepM2 += fDelta * (fObserved - this->m_fSleepMean);
+
+	double fStdDev = std::sqrt(this->m_fSleepM2 / static_cast<double>(this->m_nSleepCount - 1));
+	this->m_fSleepEstimate = this->m_fSleepMean + fStdDev;
+}
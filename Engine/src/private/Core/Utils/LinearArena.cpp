@@ -0,0 +1,81 @@
+#include "Core/Utils/LinearArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+LinearArena::LinearArena(size_t nBlockSize) : m_nBlockSize(nBlockSize) { }
+
+LinearArena::~LinearArena() {
+	for (Block& block : this->m_blocks) {
+		::operator delete(block.pData);
+	}
+}
+
+/**
+* Allocates from the current block, or from a
+* new one if it doesn't fit
+*
+* @param nSize Size in bytes
+* @param nAlignment Power of two alignment
+*
+* @returns Uninitialized memory, valid until Reset()
+*/
+void*
+LinearArena::Allocate(size_t nSize, size_t nAlignment) {
+	if (!this->m_blocks.empty()) {
+		Block& block = this->m_blocks.back();
+
+		uintptr_t nAddress = reinterpret_cast<uintptr_t>(block.pData) + this->m_nOffset;
+		size_t nPadding = (nAlignment - (nAddress & (nAlignment - 1))) & (nAlignment - 1);
+
+		if (this->m_nOffset + nPadding + nSize <= block.nSize) {
+			void* pMemory = block.pData + this->m_nOffset + nPadding;
+
+			this->m_nOffset += nPadding + nSize;
+			this->m_nUsedBytes += nSize;
+
+			return pMemory;
+		}
+	}
+
+	/* Worst case padding fits too */
+	this->AddBlock(nSize + nAlignment);
+
+	return this->Allocate(nSize, nAlignment);
+}
+
+/**
+* Drops every allocation. The first block is kept
+* for whatever is allocated next, the rest is freed
+*/
+void
+LinearArena::Reset() {
+	for (size_t i = 1; i < this->m_blocks.size(); i++) {
+		::operator delete(this->m_blocks[i].pData);
+		this->m_nReservedBytes -= this->m_blocks[i].nSize;
+	}
+
+	if (this->m_blocks.size() > 1) {
+		this->m_blocks.resize(1);
+	}
+
+	this->m_nOffset = 0;
+	this->m_nUsedBytes = 0;
+}
+
+/**
+* Starts a new block
+*
+* @param nMinSize Smallest size the block must have
+*/
+void
+LinearArena::AddBlock(size_t nMinSize) {
+	Block block = { };
+	block.nSize = std::max(this->m_nBlockSize, nMinSize);
+	block.pData = static_cast<Byte*>(::operator new(block.nSize));
+
+	this->m_blocks.push_back(block);
+	this->m_nOffset = 0;
+	this->m_nReservedBytes += block.nSize;
+}
@@ -0,0 +1,268 @@
+#include "Core/Utils/Profiler.h"
+#include "Core/Logger.h"
+
+#include <fstream>
+
+Profiler* Profiler::m_instance;
+
+/* Buffer of the calling thread, created on its first zone */
+static thread_local ProfilerThreadBuffer* s_pThreadBuffer = nullptr;
+
+ProfilerThreadBuffer::ProfilerThreadBuffer(uint32_t nThreadId)
+	: m_nThreadId(nThreadId), m_pHead(new Chunk()) {
+	this->m_pTail = this->m_pHead;
+	this->name = "Thread " + std::to_string(nThreadId);
+}
+
+ProfilerThreadBuffer::~ProfilerThreadBuffer() {
+	Chunk* pChunk = this->m_pHead;
+	while (pChunk != nullptr) {
+		Chunk* pNext = pChunk->pNext.load(std::memory_order_relaxed);
+		delete pChunk;
+		pChunk = pNext;
+	}
+}
+
+/**
+* Appends a zone. Only called by the owning thread
+*
+* @param zone Recorded zone
+*/
+void
+ProfilerThreadBuffer::Push(const ProfileZone& zone) {
+	Chunk* pChunk = this->m_pTail;
+	uint32_t nCount = pChunk->nCount.load(std::memory_order_relaxed);
+
+	/* Chunk full, link a new one */
+	if (nCount == CHUNK_SIZE) {
+		Chunk* pNewChunk = new Chunk();
+		pChunk->pNext.store(pNewChunk, std::memory_order_release);
+
+		this->m_pTail = pNewChunk;
+		pChunk = pNewChunk;
+		nCount = 0;
+	}
+
+	pChunk->zones[nCount] = zone;
+	pChunk->nCount.store(nCount + 1, std::memory_order_release);
+}
+
+/**
+* Starts recording zones. Zone timestamps
+* are relative to this call
+*/
+void
+Profiler::BeginCapture() {
+	if (this->IsCapturing()) {
+		Logger::Warn("Profiler::BeginCapture: A capture is already running");
+		return;
+	}
+
+	this->m_epoch = std::chrono::steady_clock::now();
+	this->m_bCapturing.store(true, std::memory_order_release);
+}
+
+/**
+* Stops recording zones. Zones already open
+* when this is called are dropped
+*/
+void
+Profiler::EndCapture() {
+	this->m_bCapturing.store(false, std::memory_order_release);
+}
+
+/**
+* Names the calling thread in the trace
+*
+* @param name Thread name
+*/
+void
+Profiler::SetThreadName(const char* name) {
+	ProfilerThreadBuffer* pBuffer = this->GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(this->m_buffersMutex);
+	pBuffer->name = name;
+}
+
+/**
+* Records a zone for the calling thread
+*
+* @param name Zone name
+* @param nStart Start time (see Now)
+* @param nEnd End time (see Now)
+*/
+void
+Profiler::Record(const char* name, uint64_t nStart, uint64_t nEnd) {
+	if (!this->IsCapturing()) return;
+
+	ProfileZone zone = { };
+	zone.name = name;
+	zone.nStart = nStart;
+	zone.nEnd = nEnd;
+
+	this->GetThreadBuffer()->Push(zone);
+}
+
+/**
+* Gets the current capture time
+*
+* @returns Nanoseconds since the capture began
+*/
+uint64_t
+Profiler::Now() const {
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - this->m_epoch;
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+/**
+* Writes every recorded zone as a Chrome trace
+* (chrome://tracing, ui.perfetto.dev)
+*
+* @param path Output JSON path
+*
+* @returns True if the trace was written
+*/
+bool
+Profiler::WriteChromeTrace(const String& path) {
+	std::ofstream file(path, std::ios::trunc);
+
+	if (!file.is_open()) {
+		Logger::Error("Profiler::WriteChromeTrace: Couldn't open {}", path);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(this->m_buffersMutex);
+
+	uint64_t nZoneCount = 0;
+	bool bFirst = true;
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << std::fixed;
+	file.precision(3);
+
+	for (Ref<ProfilerThreadBuffer>& buffer : this->m_buffers) {
+		uint32_t nThreadId = buffer->GetThreadId();
+
+		if (!bFirst) file << ",\n";
+		bFirst = false;
+
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << nThreadId << ",\"args\":{\"name\":\"";
+		Profiler::WriteEscaped(file, buffer->name.c_str());
+		file << "\"}}";
+
+		const ProfilerThreadBuffer::Chunk* pChunk = buffer->GetHead();
+		while (pChunk != nullptr) {
+			uint32_t nCount = pChunk->nCount.load(std::memory_order_acquire);
+
+			for (uint32_t i = 0; i < nCount; i++) {
+				const ProfileZone& zone = pChunk->zones[i];
+
+				/* Timestamps in microseconds */
+				file << ",\n{\"name\":\"";
+				Profiler::WriteEscaped(file, zone.name);
+				file << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << nThreadId
+					<< ",\"ts\":" << static_cast<double>(zone.nStart) / 1000.0
+					<< ",\"dur\":" << static_cast<double>(zone.nEnd - zone.nStart) / 1000.0 << "}";
+			}
+
+			nZoneCount += nCount;
+			pChunk = pChunk->pNext.load(std::memory_order_acquire);
+		}
+	}
+
+	file << "\n]}\n";
+
+	Logger::Info("Profiler::WriteChromeTrace: {} zones from {} threads written to {}", nZoneCount, this->m_buffers.size(), path);
+	return true;
+}
+
+/**
+* Writes a string as the contents of a JSON
+* string, quotes, backslashes and control
+* characters escaped
+*
+* @param out Output stream
+* @param str Null terminated string
+*/
+void
+Profiler::WriteEscaped(std::ostream& out, const char* str) {
+	static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+	for (const char* c = str; *c != '\0'; c++) {
+		unsigned char ch = static_cast<unsigned char>(*c);
+
+		if (ch == '"' || ch == '\\') {
+			out << '\\' << *c;
+		}
+		else if (ch < 0x20) {
+			out << "\\u00" << HEX_DIGITS[ch >> 4] << HEX_DIGITS[ch & 0xf];
+		}
+		else {
+			out << *c;
+		}
+	}
+}
+
+/**
+* Gets every zone, from any thread, that overlaps
+* a time range
+*
+* @param nStart Range start (see Now)
+* @param nEnd Range end (see Now)
+* @param outZones Output zones
+*/
+void
+Profiler::GetZones(uint64_t nStart, uint64_t nEnd, Vector<ProfileZone>& outZones) {
+	std::lock_guard<std::mutex> lock(this->m_buffersMutex);
+
+	for (Ref<ProfilerThreadBuffer>& buffer : this->m_buffers) {
+		const ProfilerThreadBuffer::Chunk* pChunk = buffer->GetHead();
+
+		while (pChunk != nullptr) {
+			uint32_t nCount = pChunk->nCount.load(std::memory_order_acquire);
+
+			/* Zones are pushed when they end, skip chunks that ended before the range */
+			if (nCount > 0 && pChunk->zones[nCount - 1].nEnd >= nStart) {
+				for (uint32_t i = 0; i < nCount; i++) {
+					const ProfileZone& zone = pChunk->zones[i];
+
+					if (zone.nEnd >= nStart && zone.nStart <= nEnd) {
+						outZones.push_back(zone);
+					}
+				}
+			}
+
+			pChunk = pChunk->pNext.load(std::memory_order_acquire);
+		}
+	}
+}
+
+/**
+* Gets the calling thread's buffer, registering
+* it on first use
+*
+* @returns Thread buffer
+*/
+ProfilerThreadBuffer*
+Profiler::GetThreadBuffer() {
+	if (s_pThreadBuffer != nullptr) {
+		return s_pThreadBuffer;
+	}
+
+	std::lock_guard<std::mutex> lock(this->m_buffersMutex);
+
+	Ref<ProfilerThreadBuffer> buffer = CreateRef<ProfilerThreadBuffer>(static_cast<uint32_t>(this->m_buffers.size()));
+	this->m_buffers.push_back(buffer);
+
+	s_pThreadBuffer = buffer.Get().get();
+	return s_pThreadBuffer;
+}
+
+Profiler*
+Profiler::GetInstance() {
+	if (Profiler::m_instance == nullptr) {
+		Profiler::m_instance = new Profiler();
+	}
+
+	return Profiler::m_instance;
+}
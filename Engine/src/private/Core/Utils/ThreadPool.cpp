@@ -1,8 +1,11 @@
 #include "Core/Utils/ThreadPool.h"
+#include "Core/Utils/Profiler.h"
 
 ThreadPool::ThreadPool(uint32_t nNumThreads) {
 	for(uint32_t i = 0; i < nNumThreads; ++i) {
 		this->m_workers.emplace_back([this] {
+			PROFILE_THREAD("ThreadPool worker");
+
 			while (true) {
 				std::function<void()> task;
 
@@ -21,7 +24,10 @@ ThreadPool::ThreadPool(uint32_t nNumThreads) {
 					this->m_tasks.pop();
 				}
 
-				task();
+				{
+					PROFILE_SCOPE("ThreadPool::Task");
+					task();
+				}
 
 				{
 					this->m_activeTasks--;
@@ -0,0 +1,74 @@
+#include "Math/AABB.h"
+
+#include <cmath>
+#include <algorithm>
+
+/**
+* Bounds of this box after a transform. Exact
+* for the rotated box's corners (Arvo's method)
+*
+* @param matrix Affine transform
+*
+* @returns Transformed bounds
+*/
+AABB
+AABB::Transform(const glm::mat4& matrix) const {
+	if (!this->IsValid()) return AABB();
+
+	glm::vec3 center = this->GetCenter();
+	glm::vec3 extent = this->GetExtent();
+
+	glm::vec3 newCenter = glm::vec3(matrix[3]);
+	glm::vec3 newExtent = glm::vec3(0.f);
+
+	for (int nColumn = 0; nColumn < 3; nColumn++) {
+		for (int nRow = 0; nRow < 3; nRow++) {
+			float fValue = matrix[nColumn][nRow];
+
+			newCenter[nRow] += fValue * center[nColumn];
+			newExtent[nRow] += std::abs(fValue) * extent[nColumn];
+		}
+	}
+
+	return AABB(newCenter - newExtent, newCenter + newExtent);
+}
+
+/**
+* Slab test against a box
+*
+* @param box Box to test
+* @param fMaxDistance Farthest accepted hit
+* @param fOutDistance Entry distance, 0 if the origin is inside
+*
+* @returns True if the ray hits the box before fMaxDistance
+*/
+bool
+Ray::Intersects(const AABB& box, float fMaxDistance, float& fOutDistance) const {
+	float fNear = 0.f;
+	float fFar = fMaxDistance;
+
+	for (int i = 0; i < 3; i++) {
+		float fOrigin = this->origin[i];
+		float fDirection = this->direction[i];
+
+		/* Parallel to the slab, inside it or never */
+		if (std::abs(fDirection) < 1e-8f) {
+			if (fOrigin < box.min[i] || fOrigin > box.max[i]) return false;
+			continue;
+		}
+
+		float fInvDirection = 1.f / fDirection;
+		float fT0 = (box.min[i] - fOrigin) * fInvDirection;
+		float fT1 = (box.max[i] - fOrigin) * fInvDirection;
+
+		if (fT0 > fT1) std::swap(fT0, fT1);
+
+		fNear = std::max(fNear, fT0);
+		fFar = std::min(fFar, fT1);
+
+		if (fNear > fFar) return false;
+	}
+
+	fOutDistance = fNear;
+	return true;
+}
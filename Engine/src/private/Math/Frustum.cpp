@@ -0,0 +1,80 @@
+#include "Math/Frustum.h"
+
+#include <cmath>
+
+/**
+* Extracts the planes of a projection * view
+* matrix (Gribb-Hartmann), same layout as the
+* GPU culling pass
+*
+* @param viewProj Projection * View
+*
+* @returns Frustum with normalized planes
+*/
+Frustum
+Frustum::FromMatrix(const glm::mat4& viewProj) {
+	Frustum frustum = { };
+
+	for (int i = 0; i < 3; i++) {
+		/* Left/right, bottom/top, near/far from rows 0, 1 and 2 against row 3 */
+		for (int nSide = 0; nSide < 2; nSide++) {
+			float fSign = nSide == 0 ? 1.f : -1.f;
+
+			glm::vec4& plane = frustum.planes[i * 2 + nSide];
+			plane.x = viewProj[0][3] + fSign * viewProj[0][i];
+			plane.y = viewProj[1][3] + fSign * viewProj[1][i];
+			plane.z = viewProj[2][3] + fSign * viewProj[2][i];
+			plane.w = viewProj[3][3] + fSign * viewProj[3][i];
+
+			float fLength = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (fLength > 0.f) {
+				plane.x /= fLength;
+				plane.y /= fLength;
+				plane.z /= fLength;
+				plane.w /= fLength;
+			}
+		}
+	}
+
+	return frustum;
+}
+
+/**
+* Classifies a box. Planes the box is fully in
+* front of are cleared from the mask, so children
+* of an accepted node skip them
+*
+* @param box Box to test
+* @param nPlaneMask Planes left to test, updated
+*
+* @returns Where the box is
+*/
+EFrustumTest
+Frustum::Test(const AABB& box, uint32_t& nPlaneMask) const {
+	glm::vec3 center = box.GetCenter();
+	glm::vec3 extent = box.GetExtent();
+
+	for (uint32_t i = 0; i < PLANE_COUNT; i++) {
+		uint32_t nBit = 1u << i;
+		if ((nPlaneMask & nBit) == 0) continue;
+
+		const glm::vec4& plane = this->planes[i];
+
+		float fDistance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+		float fRadius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+
+		if (fDistance + fRadius < 0.f) return EFrustumTest::OUTSIDE;
+
+		if (fDistance - fRadius >= 0.f) {
+			nPlaneMask &= ~nBit;
+		}
+	}
+
+	return nPlaneMask == 0 ? EFrustumTest::INSIDE : EFrustumTest::INTERSECTS;
+}
+
+bool
+Frustum::Intersects(const AABB& box) const {
+	uint32_t nPlaneMask = ALL_PLANES;
+	return this->Test(box, nPlaneMask) != EFrustumTest::OUTSIDE;
+}
@@ -0,0 +1,492 @@
+#include "Math/TransformBatch.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define TRANSFORM_BATCH_X86
+	#include <immintrin.h>
+
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#endif
+
+/*
+	MSVC accepts any intrinsic in any function. GCC and Clang
+	only emit SSE4/AVX2 code in functions that ask for it, the
+	rest of the engine keeps the default instruction set
+*/
+#if defined(TRANSFORM_BATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+	#define TARGET_SSE4 __attribute__((target("sse4.1")))
+	#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+	#define TARGET_SSE4
+	#define TARGET_AVX2
+#endif
+
+static constexpr float DEG_TO_RAD = 0.017453292519943295f;
+
+/* sin/cos range reduction (pi / 2 split in three parts) and minimax polynomials on [-pi/4, pi/4] */
+static constexpr float TWO_OVER_PI = 0.63661977236758134f;
+static constexpr float HALF_PI_1 = 1.5703125f;
+static constexpr float HALF_PI_2 = 4.837512969970703125e-4f;
+static constexpr float HALF_PI_3 = 7.54978995489188216e-8f;
+
+static constexpr float SIN_C0 = -1.9515295891e-4f;
+static constexpr float SIN_C1 = 8.3321608736e-3f;
+static constexpr float SIN_C2 = -1.6666654611e-1f;
+
+static constexpr float COS_C0 = 2.443315711809948e-5f;
+static constexpr float COS_C1 = -1.388731625493765e-3f;
+static constexpr float COS_C2 = 4.166664568298827e-2f;
+
+void
+TransformSoA::Clear() {
+	this->locationX.clear();
+	this->locationY.clear();
+	this->locationZ.clear();
+	this->rotationX.clear();
+	this->rotationY.clear();
+	this->rotationZ.clear();
+	this->scaleX.clear();
+	this->scaleY.clear();
+	this->scaleZ.clear();
+}
+
+void
+TransformSoA::Reserve(size_t nCount) {
+	this->locationX.reserve(nCount);
+	this->locationY.reserve(nCount);
+	this->locationZ.reserve(nCount);
+	this->rotationX.reserve(nCount);
+	this->rotationY.reserve(nCount);
+	this->rotationZ.reserve(nCount);
+	this->scaleX.reserve(nCount);
+	this->scaleY.reserve(nCount);
+	this->scaleZ.reserve(nCount);
+}
+
+/**
+* Appends a transform
+*
+* @param transform Transform to copy
+*/
+void
+TransformSoA::Push(const Transform& transform) {
+	this->locationX.push_back(transform.location.x);
+	this->locationY.push_back(transform.location.y);
+	this->locationZ.push_back(transform.location.z);
+	this->rotationX.push_back(transform.rotation.x);
+	this->rotationY.push_back(transform.rotation.y);
+	this->rotationZ.push_back(transform.rotation.z);
+	this->scaleX.push_back(transform.scale.x);
+	this->scaleY.push_back(transform.scale.y);
+	this->scaleZ.push_back(transform.scale.z);
+}
+
+/*
+	All paths build T * Rx * Ry * Rz * S, the product
+	Transform::GetLocalMatrix gets from glm:
+
+	| cy*cz              -cy*sz              sy     |
+	| sx*sy*cz + cx*sz   cx*cz - sx*sy*sz    -sx*cy |
+	| sx*sz - cx*sy*cz   cx*sy*sz + sx*cz    cx*cy  |
+
+	with each column multiplied by its scale
+*/
+
+/**
+* Composes matrices one at a time
+*
+* @param transforms Packed transforms
+* @param nBegin First element
+* @param nEnd One past the last element
+* @param pOutMatrices Output matrices, indexed like transforms
+*/
+static void
+ComposeScalar(const TransformSoA& transforms, size_t nBegin, size_t nEnd, glm::mat4* pOutMatrices) {
+	for (size_t i = nBegin; i < nEnd; i++) {
+		float fRadX = transforms.rotationX[i] * DEG_TO_RAD;
+		float fRadY = transforms.rotationY[i] * DEG_TO_RAD;
+		float fRadZ = transforms.rotationZ[i] * DEG_TO_RAD;
+
+		float fSinX = std::sin(fRadX), fCosX = std::cos(fRadX);
+		float fSinY = std::sin(fRadY), fCosY = std::cos(fRadY);
+		float fSinZ = std::sin(fRadZ), fCosZ = std::cos(fRadZ);
+
+		float fScaleX = transforms.scaleX[i];
+		float fScaleY = transforms.scaleY[i];
+		float fScaleZ = transforms.scaleZ[i];
+
+		float fSinXSinY = fSinX * fSinY;
+		float fCosXSinY = fCosX * fSinY;
+
+		glm::mat4& matrix = pOutMatrices[i];
+		matrix[0] = glm::vec4(
+			fCosY * fCosZ * fScaleX,
+			(fSinXSinY * fCosZ + fCosX * fSinZ) * fScaleX,
+			(fSinX * fSinZ - fCosXSinY * fCosZ) * fScaleX,
+			0.f
+		);
+		matrix[1] = glm::vec4(
+			-fCosY * fSinZ * fScaleY,
+			(fCosX * fCosZ - fSinXSinY * fSinZ) * fScaleY,
+			(fCosXSinY * fSinZ + fSinX * fCosZ) * fScaleY,
+			0.f
+		);
+		matrix[2] = glm::vec4(
+			fSinY * fScaleZ,
+			-fSinX * fCosY * fScaleZ,
+			fCosX * fCosY * fScaleZ,
+			0.f
+		);
+		matrix[3] = glm::vec4(transforms.locationX[i], transforms.locationY[i], transforms.locationZ[i], 1.f);
+	}
+}
+
+#if defined(TRANSFORM_BATCH_X86)
+
+/**
+* Sine and cosine of 4 angles
+*
+* @param x Angles in radians
+* @param pSin Output sines
+* @param pCos Output cosines
+*/
+TARGET_SSE4 static inline void
+SinCos4(__m128 x, __m128* pSin, __m128* pCos) {
+	__m128 q = _mm_round_ps(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_1)));
+	r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_2)));
+	r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(HALF_PI_3)));
+
+	__m128 r2 = _mm_mul_ps(r, r);
+
+	__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C0), r2), _mm_set1_ps(SIN_C1));
+	s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_C2));
+	s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+	__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C0), r2), _mm_set1_ps(COS_C1));
+	c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_C2));
+	c = _mm_mul_ps(_mm_mul_ps(c, r2), r2);
+	c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.f));
+
+	/* Odd quadrants swap sin and cos, quadrants 2-3 negate sin, 1-2 negate cos */
+	__m128i quadrant = _mm_cvtps_epi32(q);
+	__m128i one = _mm_set1_epi32(1);
+	__m128i two = _mm_set1_epi32(2);
+
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+	__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+
+	*pSin = _mm_xor_ps(_mm_blendv_ps(s, c, swap), sinSign);
+	*pCos = _mm_xor_ps(_mm_blendv_ps(c, s, swap), cosSign);
+}
+
+/**
+* Writes one column of 4 consecutive matrices
+*
+* @param pOutMatrices First matrix
+* @param nColumn Column index
+* @param x Row 0 of the column, one lane per matrix
+* @param y Row 1
+* @param z Row 2
+* @param w Row 3
+*/
+TARGET_SSE4 static inline void
+StoreColumn4(glm::mat4* pOutMatrices, int nColumn, __m128 x, __m128 y, __m128 z, __m128 w) {
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	_mm_storeu_ps(&pOutMatrices[0][nColumn][0], x);
+	_mm_storeu_ps(&pOutMatrices[1][nColumn][0], y);
+	_mm_storeu_ps(&pOutMatrices[2][nColumn][0], z);
+	_mm_storeu_ps(&pOutMatrices[3][nColumn][0], w);
+}
+
+/**
+* Composes matrices 4 at a time
+*
+* @param transforms Packed transforms
+* @param pOutMatrices Output matrices
+*
+* @returns Number of matrices written, the rest is left for the scalar path
+*/
+TARGET_SSE4 static size_t
+ComposeSSE4(const TransformSoA& transforms, glm::mat4* pOutMatrices) {
+	size_t nCount = transforms.GetSize() & ~static_cast<size_t>(3);
+
+	__m128 degToRad = _mm_set1_ps(DEG_TO_RAD);
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.f);
+
+	for (size_t i = 0; i < nCount; i += 4) {
+		__m128 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationX.data() + i), degToRad), &sinX, &cosX);
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationY.data() + i), degToRad), &sinY, &cosY);
+		SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationZ.data() + i), degToRad), &sinZ, &cosZ);
+
+		__m128 scaleX = _mm_loadu_ps(transforms.scaleX.data() + i);
+		__m128 scaleY = _mm_loadu_ps(transforms.scaleY.data() + i);
+		__m128 scaleZ = _mm_loadu_ps(transforms.scaleZ.data() + i);
+
+		__m128 sinXSinY = _mm_mul_ps(sinX, sinY);
+		__m128 cosXSinY = _mm_mul_ps(cosX, sinY);
+
+		__m128 m00 = _mm_mul_ps(_mm_mul_ps(cosY, cosZ), scaleX);
+		__m128 m01 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sinXSinY, cosZ), _mm_mul_ps(cosX, sinZ)), scaleX);
+		__m128 m02 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sinX, sinZ), _mm_mul_ps(cosXSinY, cosZ)), scaleX);
+
+		__m128 m10 = _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(cosY, sinZ)), scaleY);
+		__m128 m11 = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cosX, cosZ), _mm_mul_ps(sinXSinY, sinZ)), scaleY);
+		__m128 m12 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cosXSinY, sinZ), _mm_mul_ps(sinX, cosZ)), scaleY);
+
+		__m128 m20 = _mm_mul_ps(sinY, scaleZ);
+		__m128 m21 = _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(sinX, cosY)), scaleZ);
+		__m128 m22 = _mm_mul_ps(_mm_mul_ps(cosX, cosY), scaleZ);
+
+		glm::mat4* pOut = pOutMatrices + i;
+		StoreColumn4(pOut, 0, m00, m01, m02, zero);
+		StoreColumn4(pOut, 1, m10, m11, m12, zero);
+		StoreColumn4(pOut, 2, m20, m21, m22, zero);
+		StoreColumn4(
+			pOut, 3,
+			_mm_loadu_ps(transforms.locationX.data() + i),
+			_mm_loadu_ps(transforms.locationY.data() + i),
+			_mm_loadu_ps(transforms.locationZ.data() + i),
+			one
+		);
+	}
+
+	return nCount;
+}
+
+/**
+* Sine and cosine of 8 angles
+*
+* @param x Angles in radians
+* @param pSin Output sines
+* @param pCos Output cosines
+*/
+TARGET_AVX2 static inline void
+SinCos8(__m256 x, __m256* pSin, __m256* pCos) {
+	__m256 q = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+	__m256 r = _mm256_fnmadd_ps(q, _mm256_set1_ps(HALF_PI_1), x);
+	r = _mm256_fnmadd_ps(q, _mm256_set1_ps(HALF_PI_2), r);
+	r = _mm256_fnmadd_ps(q, _mm256_set1_ps(HALF_PI_3), r);
+
+	__m256 r2 = _mm256_mul_ps(r, r);
+
+	__m256 s = _mm256_fmadd_ps(_mm256_set1_ps(SIN_C0), r2, _mm256_set1_ps(SIN_C1));
+	s = _mm256_fmadd_ps(s, r2, _mm256_set1_ps(SIN_C2));
+	s = _mm256_fmadd_ps(_mm256_mul_ps(s, r2), r, r);
+
+	__m256 c = _mm256_fmadd_ps(_mm256_set1_ps(COS_C0), r2, _mm256_set1_ps(COS_C1));
+	c = _mm256_fmadd_ps(c, r2, _mm256_set1_ps(COS_C2));
+	c = _mm256_mul_ps(_mm256_mul_ps(c, r2), r2);
+	c = _mm256_add_ps(_mm256_fnmadd_ps(r2, _mm256_set1_ps(0.5f), c), _mm256_set1_ps(1.f));
+
+	/* Same quadrant fix up as SinCos4 */
+	__m256i quadrant = _mm256_cvtps_epi32(q);
+	__m256i one = _mm256_set1_epi32(1);
+	__m256i two = _mm256_set1_epi32(2);
+
+	__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+	__m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30));
+	__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30));
+
+	*pSin = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign);
+	*pCos = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign);
+}
+
+/**
+* Writes one column of 8 consecutive matrices
+*
+* @param pOutMatrices First matrix
+* @param nColumn Column index
+* @param x Row 0 of the column, one lane per matrix
+* @param y Row 1
+* @param z Row 2
+* @param w Row 3
+*/
+TARGET_AVX2 static inline void
+StoreColumn8(glm::mat4* pOutMatrices, int nColumn, __m256 x, __m256 y, __m256 z, __m256 w) {
+	__m128 x0 = _mm256_castps256_ps128(x), x1 = _mm256_extractf128_ps(x, 1);
+	__m128 y0 = _mm256_castps256_ps128(y), y1 = _mm256_extractf128_ps(y, 1);
+	__m128 z0 = _mm256_castps256_ps128(z), z1 = _mm256_extractf128_ps(z, 1);
+	__m128 w0 = _mm256_castps256_ps128(w), w1 = _mm256_extractf128_ps(w, 1);
+
+	_MM_TRANSPOSE4_PS(x0, y0, z0, w0);
+	_MM_TRANSPOSE4_PS(x1, y1, z1, w1);
+
+	_mm_storeu_ps(&pOutMatrices[0][nColumn][0], x0);
+	_mm_storeu_ps(&pOutMatrices[1][nColumn][0], y0);
+	_mm_storeu_ps(&pOutMatrices[2][nColumn][0], z0);
+	_mm_storeu_ps(&pOutMatrices[3][nColumn][0], w0);
+	_mm_storeu_ps(&pOutMatrices[4][nColumn][0], x1);
+	_mm_storeu_ps(&pOutMatrices[5][nColumn][0], y1);
+	_mm_storeu_ps(&pOutMatrices[6][nColumn][0], z1);
+	_mm_storeu_ps(&pOutMatrices[7][nColumn][0], w1);
+}
+
+/**
+* Composes matrices 8 at a time
+*
+* @param transforms Packed transforms
+* @param pOutMatrices Output matrices
+*
+* @returns Number of matrices written, the rest is left for the scalar path
+*/
+TARGET_AVX2 static size_t
+ComposeAVX2(const TransformSoA& transforms, glm::mat4* pOutMatrices) {
+	size_t nCount = transforms.GetSize() & ~static_cast<size_t>(7);
+
+	__m256 degToRad = _mm256_set1_ps(DEG_TO_RAD);
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.f);
+
+	for (size_t i = 0; i < nCount; i += 8) {
+		__m256 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationX.data() + i), degToRad), &sinX, &cosX);
+		SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationY.data() + i), degToRad), &sinY, &cosY);
+		SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationZ.data() + i), degToRad), &sinZ, &cosZ);
+
+		__m256 scaleX = _mm256_loadu_ps(transforms.scaleX.data() + i);
+		__m256 scaleY = _mm256_loadu_ps(transforms.scaleY.data() + i);
+		__m256 scaleZ = _mm256_loadu_ps(transforms.scaleZ.data() + i);
+
+		__m256 sinXSinY = _mm256_mul_ps(sinX, sinY);
+		__m256 cosXSinY = _mm256_mul_ps(cosX, sinY);
+
+		__m256 m00 = _mm256_mul_ps(_mm256_mul_ps(cosY, cosZ), scaleX);
+		__m256 m01 = _mm256_mul_ps(_mm256_fmadd_ps(sinXSinY, cosZ, _mm256_mul_ps(cosX, sinZ)), scaleX);
+		__m256 m02 = _mm256_mul_ps(_mm256_fmsub_ps(sinX, sinZ, _mm256_mul_ps(cosXSinY, cosZ)), scaleX);
+
+		__m256 m10 = _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(cosY, sinZ)), scaleY);
+		__m256 m11 = _mm256_mul_ps(_mm256_fmsub_ps(cosX, cosZ, _mm256_mul_ps(sinXSinY, sinZ)), scaleY);
+		__m256 m12 = _mm256_mul_ps(_mm256_fmadd_ps(cosXSinY, sinZ, _mm256_mul_ps(sinX, cosZ)), scaleY);
+
+		__m256 m20 = _mm256_mul_ps(sinY, scaleZ);
+		__m256 m21 = _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(sinX, cosY)), scaleZ);
+		__m256 m22 = _mm256_mul_ps(_mm256_mul_ps(cosX, cosY), scaleZ);
+
+		glm::mat4* pOut = pOutMatrices + i;
+		StoreColumn8(pOut, 0, m00, m01, m02, zero);
+		StoreColumn8(pOut, 1, m10, m11, m12, zero);
+		StoreColumn8(pOut, 2, m20, m21, m22, zero);
+		StoreColumn8(
+			pOut, 3,
+			_mm256_loadu_ps(transforms.locationX.data() + i),
+			_mm256_loadu_ps(transforms.locationY.data() + i),
+			_mm256_loadu_ps(transforms.locationZ.data() + i),
+			one
+		);
+	}
+
+	return nCount;
+}
+
+#endif // TRANSFORM_BATCH_X86
+
+/**
+* Checks the instruction sets of the running CPU
+*
+* @returns Widest usable level
+*/
+static ESIMDLevel
+DetectLevel() {
+#if defined(TRANSFORM_BATCH_X86)
+#if defined(_MSC_VER)
+	int info[4] = { };
+	__cpuid(info, 0);
+	int nMaxLeaf = info[0];
+
+	__cpuid(info, 1);
+	bool bSSE41 = (info[2] & (1 << 19)) != 0;
+	bool bFMA = (info[2] & (1 << 12)) != 0;
+	bool bOSXSave = (info[2] & (1 << 27)) != 0;
+	bool bAVX = (info[2] & (1 << 28)) != 0;
+
+	/* The OS must save the YMM registers too */
+	bool bAVX2 = false;
+	if (nMaxLeaf >= 7 && bFMA && bOSXSave && bAVX && (_xgetbv(0) & 6) == 6) {
+		__cpuidex(info, 7, 0);
+		bAVX2 = (info[1] & (1 << 5)) != 0;
+	}
+#else
+	__builtin_cpu_init();
+	bool bSSE41 = __builtin_cpu_supports("sse4.1");
+	bool bAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+
+	if (bAVX2) return ESIMDLevel::AVX2;
+	if (bSSE41) return ESIMDLevel::SSE4;
+#endif
+
+	return ESIMDLevel::SCALAR;
+}
+
+/**
+* Gets the widest kernel the CPU can run,
+* detected once
+*
+* @returns SIMD level
+*/
+ESIMDLevel
+TransformBatch::GetSupportedLevel() {
+	static const ESIMDLevel level = DetectLevel();
+	return level;
+}
+
+const char*
+TransformBatch::GetLevelName(ESIMDLevel level) {
+	switch (level) {
+		case ESIMDLevel::AVX2: return "AVX2";
+		case ESIMDLevel::SSE4: return "SSE4";
+		default: return "Scalar";
+	}
+}
+
+/**
+* Composes the local matrix of every transform
+* with the widest supported kernel
+*
+* @param transforms Packed transforms
+* @param pOutMatrices Output, at least transforms.GetSize() matrices
+*/
+void
+TransformBatch::ComposeLocalMatrices(const TransformSoA& transforms, glm::mat4* pOutMatrices) {
+	TransformBatch::ComposeLocalMatrices(transforms, pOutMatrices, TransformBatch::GetSupportedLevel());
+}
+
+/**
+* Composes the local matrix of every transform.
+* Levels above the supported one are lowered
+*
+* @param transforms Packed transforms
+* @param pOutMatrices Output, at least transforms.GetSize() matrices
+* @param level Kernel to use
+*/
+void
+TransformBatch::ComposeLocalMatrices(const TransformSoA& transforms, glm::mat4* pOutMatrices, ESIMDLevel level) {
+	ESIMDLevel supported = TransformBatch::GetSupportedLevel();
+	if (level > supported) {
+		level = supported;
+	}
+
+	size_t nDone = 0;
+
+#if defined(TRANSFORM_BATCH_X86)
+	if (level == ESIMDLevel::AVX2) {
+		nDone = ComposeAVX2(transforms, pOutMatrices);
+	}
+	else if (level == ESIMDLevel::SSE4) {
+		nDone = ComposeSSE4(transforms, pOutMatrices);
+	}
+#endif
+
+	/* Scalar fallback and the remainder of the SIMD paths */
+	ComposeScalar(transforms, nDone, transforms.GetSize(), pOutMatrices);
+}
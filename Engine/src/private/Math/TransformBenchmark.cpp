@@ -0,0 +1,140 @@
+#include "Math/TransformBenchmark.h"
+#include "Math/TransformBatch.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+
+static constexpr uint32_t BENCHMARK_RUNS = 5;
+
+/**
+* Times a function
+*
+* @param fn Function to time
+*
+* @returns Best of BENCHMARK_RUNS runs, in milliseconds
+*/
+static double
+TimeBest(const std::function<void()>& fn) {
+	double fBest = 0.0;
+
+	for (uint32_t i = 0; i < BENCHMARK_RUNS; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		fn();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (i == 0 || elapsed.count() < fBest) {
+			fBest = elapsed.count();
+		}
+	}
+
+	return fBest;
+}
+
+/**
+* Gets the largest difference between two matrix
+* arrays, relative to the magnitude of each element
+*
+* @param a First matrices
+* @param b Second matrices
+*
+* @returns Largest relative difference
+*/
+static float
+GetMaxError(const Vector<glm::mat4>& a, const Vector<glm::mat4>& b) {
+	float fMaxError = 0.f;
+
+	for (size_t i = 0; i < a.size(); i++) {
+		for (int nColumn = 0; nColumn < 4; nColumn++) {
+			for (int nRow = 0; nRow < 4; nRow++) {
+				float fExpected = a[i][nColumn][nRow];
+				float fError = std::fabs(fExpected - b[i][nColumn][nRow]) / (1.f + std::fabs(fExpected));
+				fMaxError = std::max(fMaxError, fError);
+			}
+		}
+	}
+
+	return fMaxError;
+}
+
+/**
+* Benchmarks local matrix composition at 10k, 100k
+* and 1M transforms with the glm path and every
+* kernel the CPU supports
+*
+* @returns True if every kernel matched the glm path
+*/
+bool
+TransformBenchmark::Run() {
+	const size_t counts[] = { 10000, 100000, 1000000 };
+	const ESIMDLevel levels[] = { ESIMDLevel::SCALAR, ESIMDLevel::SSE4, ESIMDLevel::AVX2 };
+
+	ESIMDLevel supported = TransformBatch::GetSupportedLevel();
+	Logger::Info("TransformBenchmark::Run: Best of {} runs, widest kernel {}", BENCHMARK_RUNS, TransformBatch::GetLevelName(supported));
+
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> locationDist(-1000.f, 1000.f);
+	std::uniform_real_distribution<float> rotationDist(-360.f, 360.f);
+	std::uniform_real_distribution<float> scaleDist(0.1f, 10.f);
+
+	bool bPassed = true;
+
+	for (size_t nCount : counts) {
+		Vector<Transform> transforms(nCount);
+		for (Transform& transform : transforms) {
+			transform.location = Vector3{ locationDist(rng), locationDist(rng), locationDist(rng) };
+			transform.rotation = Vector3{ rotationDist(rng), rotationDist(rng), rotationDist(rng) };
+			transform.scale = Vector3{ scaleDist(rng), scaleDist(rng), scaleDist(rng) };
+		}
+
+		TransformSoA packed;
+		packed.Reserve(nCount);
+
+		double fGatherMs = TimeBest([&]() {
+			packed.Clear();
+			for (const Transform& transform : transforms) {
+				packed.Push(transform);
+			}
+		});
+
+		Vector<glm::mat4> reference(nCount);
+		double fGlmMs = TimeBest([&]() {
+			for (size_t i = 0; i < nCount; i++) {
+				reference[i] = transforms[i].GetLocalMatrix();
+			}
+		});
+
+		Logger::Info(
+			"TransformBenchmark::Run: {} transforms, glm {:.3f} ms ({:.2f} ns each), SoA gather {:.3f} ms",
+			nCount, fGlmMs, fGlmMs * 1e6 / nCount, fGatherMs
+		);
+
+		Vector<glm::mat4> matrices(nCount);
+		for (ESIMDLevel level : levels) {
+			if (level > supported) continue;
+
+			double fKernelMs = TimeBest([&]() {
+				TransformBatch::ComposeLocalMatrices(packed, matrices.data(), level);
+			});
+
+			float fError = GetMaxError(reference, matrices);
+			if (fError > 1e-4f) {
+				bPassed = false;
+			}
+
+			Logger::Info(
+				"TransformBenchmark::Run:   {} {:.3f} ms ({:.2f} ns each), {:.2f}x glm, max error {:.2e}",
+				TransformBatch::GetLevelName(level), fKernelMs, fKernelMs * 1e6 / nCount, fGlmMs / fKernelMs, fError
+			);
+		}
+	}
+
+	if (!bPassed) {
+		Logger::Error("TransformBenchmark::Run: A kernel doesn't match Transform::GetLocalMatrix");
+	}
+
+	return bPassed;
+}
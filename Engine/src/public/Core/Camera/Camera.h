@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include "Math/Transform.h"
+#include "Math/AABB.h"
 #include "Core/Time.h"
 
 #include "Core/Containers.h" 
@@ -15,11 +16,14 @@ public:
 	virtual void Update();
 
 	void Resize(uint32_t nWidth, uint32_t nHeight);
+	void UpdateView();
 
 	glm::mat4 GetView() const { return this->m_view; }
 	glm::mat4 GetProjection() const { return this->m_projection; }
 	glm::mat4 GetViewProjection() const { return this->m_view * this->m_projection; }
 
+	Ray ScreenPointToRay(float fX, float fY) const;
+
 private:
 	String m_name;
 
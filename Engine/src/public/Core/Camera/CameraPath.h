@@ -0,0 +1,33 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/Logger.h"
+#include "Math/Vector3.h"
+
+class Camera;
+
+/**
+* Scripted camera path
+*
+* Plain text file, one keyframe per line:
+*   frame  locX locY locZ  rotX rotY rotZ
+* Lines starting with '#' are ignored. Keyframes
+* are linearly interpolated by frame number
+*/
+class CameraPath {
+public:
+	struct Keyframe {
+		uint32_t nFrame = 0;
+		Vector3 location;
+		Vector3 rotation;
+	};
+
+	bool LoadFromFile(const String& path);
+
+	void Apply(Camera* pCamera, uint32_t nFrame) const;
+
+	bool IsLoaded() const { return !this->m_keyframes.empty(); }
+	const Vector<Keyframe>& GetKeyframes() const { return this->m_keyframes; }
+
+private:
+	Vector<Keyframe> m_keyframes;
+};
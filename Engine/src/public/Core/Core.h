@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <spdlog/spdlog.h>
+#include <future>
 #include "Core/Input.h"
 #include "Core/Time.h"
 
@@ -17,7 +18,13 @@
 
 #include "Core/Renderer/SceneCollector.h"
 
+#include "Core/Camera/CameraPath.h"
+
+#include "Core/Utils/ThreadPool.h"
+#include "Core/Utils/FrameLimiter.h"
+
 #include "Core/Renderer/Vulkan/VulkanRenderer.h"
+#include "Core/Renderer/Null/NullRenderer.h"
 
 #include "Core/Renderer/Semaphore.h"
 #include "Core/Renderer/Fence.h"
@@ -32,6 +39,7 @@ class ResourceManager;
 
 enum class ERenderBackend {
     VULKAN,
+    NULL_RENDERER, // Records commands without a GPU (CPU profiling, tests)
 
     /* TODO */
     D3D12,
@@ -40,6 +48,35 @@ enum class ERenderBackend {
     METAL
 };
 
+/* Command line launch options */
+struct CoreLaunchOptions {
+    ERenderBackend renderBackend = ERenderBackend::VULKAN;
+    bool bHeadless = false; // No window, render into an offscreen image chain
+    String scenePath; // .aethproj project or .aeth scene to load at startup
+    String cameraPath; // Camera path file (see CameraPath)
+    uint32_t nFrameCount = 0; // Frames to render before exiting (0 = until closed)
+    uint32_t nWidth = WIDTH;
+    uint32_t nHeight = HEIGHT;
+    bool bPipelined = true; // Update and collect the next frame while the current one is recorded
+    String profilePath; // Chrome trace of the CPU zones, written at exit (empty = no capture)
+    String statsPath; // Frame time statistics, written at exit (empty = log only)
+    float fHitchThreshold = 33.3f; // Frames slower than this (ms) are reported as hitches
+    EPresentMode presentMode = EPresentMode::MAILBOX; // FIFO if not supported
+    uint32_t nSwapchainImages = 3;
+    uint32_t nFramesInFlight = 0; // Frames the CPU records ahead of the GPU (0 = 2, or 1 with bLowLatency)
+    float fTargetFPS = 0.f; // Frame limiter (0 = unlimited)
+    bool bLowLatency = false; // Sample input and collect right before recording, implies no pipelining
+    bool bBenchTransforms = false; // Run the transform composition benchmark and exit
+    float fPartitionCellSize = 0.f; // Split scenePath into world partition cells and exit (0 = off)
+    float fStreamingRadius = 0.f; // World partition load radius (0 = default)
+    uint32_t nStreamingBudgetMB = 0; // World partition memory budget (0 = default)
+    float fStaticClusterSize = 0.f; // Bake the static objects of scenePath in clusters of this size and exit (0 = off)
+    bool bKeepMeshGeometry = false; // Keep mesh vertices and indices in CPU memory after upload
+    bool bKeepMeshAssets = false; // Keep decoded mesh assets in the asset cache
+
+    static CoreLaunchOptions FromArgs(int argc, char** argv);
+};
+
 class Core {
 public:
     Core();
@@ -47,13 +84,20 @@ public:
     void Init();
     void Update();
 
+    void SetLaunchOptions(const CoreLaunchOptions& options) { this->m_options = options; }
+    const CoreLaunchOptions& GetLaunchOptions() const { return this->m_options; }
+    bool IsHeadless() const { return this->m_options.bHeadless; }
+
+    bool LoadScene(const String& scenePath);
+
     Ref<Renderer> GetRenderer() const { return this->m_renderer; }
 
     static Core* GetInstance();
 private:
     ERenderBackend m_renderBackend;
+    CoreLaunchOptions m_options;
 
-    GLFWwindow* m_pWindow;
+    GLFWwindow* m_pWindow = nullptr;
     static Core* m_instance;
 
     Input* m_input;
@@ -71,17 +115,44 @@ private:
     Ref<Swapchain> m_swapchain;
 
     ESampleCount m_sampleCount;
-    uint32_t m_nImageCount;
+    uint32_t m_nFramesInFlight;
 
     DeferredRenderer m_deferredRenderer;
 
+    /* Per frame in flight */
     Vector<Ref<Semaphore>> m_imageAvailableSemaphores;
-    Vector<Ref<Semaphore>> m_renderFinishedSemaphores;
     Vector<Ref<Fence>> m_inFlightFences;
 
+    /* Per swapchain image, presentation holds them until the image is reacquired */
+    Vector<Ref<Semaphore>> m_renderFinishedSemaphores;
+
     SceneCollector m_sceneCollector;
 
-    uint32_t m_nImageIndex = 0;
+    /* 
+        Draw data snapshots. One is rendered while the
+        simulation worker collects the other
+    */
+    CollectedDrawData m_drawData[2];
+    uint32_t m_nDrawDataIndex = 0;
+    bool m_bDrawDataValid = false;
+
+    ThreadPool::Ptr m_simulationPool;
+    std::future<void> m_simulationJob;
+
+    FrameLimiter m_frameLimiter;
+
+    uint32_t m_nFrameIndex = 0;
+    uint32_t m_nFrameNumber = 0;
+
+    CameraPath m_cameraPath;
+
+    /* GPU meshes streamed out, freed once the frames drawing them are done */
+    struct MeshRelease {
+        String name;
+        uint32_t nFrame = 0; // Frame number it can be freed at
+    };
+
+    Deque<MeshRelease> m_meshReleases;
 
     bool m_bWindowResized = false;
 
@@ -93,8 +164,15 @@ private:
         }
     }
 
+    bool ShouldClose();
+    void CollectFrame(uint32_t nFrameNumber, CollectedDrawData& drawData);
+    void SimulateFrame(uint32_t nFrameNumber, CollectedDrawData& drawData);
+    void LogNullDeviceStats();
+    void PollEvents();
+
     void CreateSwapchain();
     void CreateSyncObjects();
+    void CreatePresentSemaphores();
 
     void SetupCallbacks();
     void SetupSceneCallbacks();
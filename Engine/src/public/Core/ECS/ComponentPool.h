@@ -0,0 +1,164 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/ECS/Entity.h"
+#include "Core/GameObject/Components/Component.h"
+
+#include <type_traits>
+
+/* Type erased pool, lets the registry drop an entity from every pool */
+class IComponentPool {
+public:
+	virtual ~IComponentPool() = default;
+
+	virtual void Remove(EntityID entity) = 0;
+	virtual bool Has(EntityID entity) const = 0;
+	virtual uint32_t GetSize() const = 0;
+
+	virtual void Start() { }
+	virtual void Update() { }
+};
+
+/**
+* Sparse set of components
+*
+* Components of a type live in one dense array, packed
+* and in no particular order. The sparse array maps
+* an entity to its dense slot, so lookups are two array
+* reads and iteration never chases pointers. Removal
+* swaps the last component into the hole, pointers and
+* references to components are only valid until the
+* pool changes.
+*
+* Pools can record which entities gained, replaced or
+* lost a component, for systems that keep data derived
+* from it up to date
+*/
+template<typename T>
+class ComponentPool : public IComponentPool {
+public:
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	/**
+	* Adds a component, replacing the existing one
+	*
+	* @param entity Entity
+	* @param args Component constructor arguments
+	*
+	* @returns Added component
+	*/
+	template<typename... Args>
+	T&
+	Add(EntityID entity, Args&&... args) {
+		this->RecordChange(entity);
+
+		if (this->Has(entity)) {
+			T& component = this->m_components[this->m_sparse[entity]];
+			component = T(std::forward<Args>(args)...);
+			return component;
+		}
+
+		if (entity >= this->m_sparse.size()) {
+			this->m_sparse.resize(static_cast<size_t>(entity) + 1, INVALID_INDEX);
+		}
+
+		this->m_sparse[entity] = static_cast<uint32_t>(this->m_components.size());
+		this->m_entities.push_back(entity);
+		this->m_components.emplace_back(std::forward<Args>(args)...);
+
+		return this->m_components.back();
+	}
+
+	/**
+	* Removes an entity's component
+	*
+	* @param entity Entity
+	*/
+	void
+	Remove(EntityID entity) override {
+		if (!this->Has(entity)) return;
+
+		this->RecordChange(entity);
+
+		uint32_t nIndex = this->m_sparse[entity];
+		uint32_t nLast = static_cast<uint32_t>(this->m_components.size()) - 1;
+
+		/* Keep the dense array packed */
+		if (nIndex != nLast) {
+			this->m_components[nIndex] = std::move(this->m_components[nLast]);
+			this->m_entities[nIndex] = this->m_entities[nLast];
+			this->m_sparse[this->m_entities[nIndex]] = nIndex;
+		}
+
+		this->m_components.pop_back();
+		this->m_entities.pop_back();
+		this->m_sparse[entity] = INVALID_INDEX;
+	}
+
+	bool
+	Has(EntityID entity) const override {
+		return entity < this->m_sparse.size() && this->m_sparse[entity] != INVALID_INDEX;
+	}
+
+	/**
+	* Gets an entity's component
+	*
+	* @param entity Entity
+	*
+	* @returns Component or nullptr
+	*/
+	T*
+	Get(EntityID entity) {
+		return this->Has(entity) ? &this->m_components[this->m_sparse[entity]] : nullptr;
+	}
+
+	uint32_t GetSize() const override { return static_cast<uint32_t>(this->m_components.size()); }
+
+	/* Dense arrays, the entity at i owns the component at i */
+	Vector<T>& GetComponents() { return this->m_components; }
+	const Vector<T>& GetComponents() const { return this->m_components; }
+	const Vector<EntityID>& GetEntities() const { return this->m_entities; }
+
+	/**
+	* Starts or stops recording the entities whose
+	* component was added, replaced or removed
+	*
+	* @param bTrack True to record
+	*/
+	void
+	TrackChanges(bool bTrack) {
+		this->m_bTrackChanges = bTrack;
+		if (!bTrack) this->m_changed.clear();
+	}
+
+	/* Entities changed since the last ClearChanges(), may repeat */
+	const Vector<EntityID>& GetChanged() const { return this->m_changed; }
+	void ClearChanges() { this->m_changed.clear(); }
+
+	void
+	Start() override {
+		if constexpr (std::is_base_of_v<Component, T>) {
+			for (T& component : this->m_components) component.Start();
+		}
+	}
+
+	void
+	Update() override {
+		if constexpr (std::is_base_of_v<Component, T>) {
+			for (T& component : this->m_components) component.Update();
+		}
+	}
+private:
+	Vector<uint32_t> m_sparse; // Entity -> dense index
+	Vector<EntityID> m_entities; // Dense index -> entity
+	Vector<T> m_components;
+
+	bool m_bTrackChanges = false;
+	Vector<EntityID> m_changed;
+
+	void
+	RecordChange(EntityID entity) {
+		if (this->m_bTrackChanges) {
+			this->m_changed.push_back(entity);
+		}
+	}
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+
+/* Dense component type index, also the component's bit in a ComponentMask */
+using ComponentTypeID = uint32_t;
+using ComponentMask = uint64_t;
+
+constexpr ComponentTypeID MAX_COMPONENT_TYPES = 64;
+
+/* IDs below this are fixed at compile time, the rest are handed out on first use */
+constexpr ComponentTypeID FIRST_DYNAMIC_COMPONENT_TYPE = 16;
+
+/**
+* Compile time ID of a component type.
+* Specialized by DECLARE_COMPONENT_TYPE
+*/
+template<typename T>
+struct ComponentTypeOf {
+	static constexpr bool bStatic = false;
+};
+
+#define DECLARE_COMPONENT_TYPE(T, id) \
+	template<> \
+	struct ComponentTypeOf<T> { \
+		static_assert(id < FIRST_DYNAMIC_COMPONENT_TYPE, "Static component IDs must stay below FIRST_DYNAMIC_COMPONENT_TYPE"); \
+		static constexpr bool bStatic = true; \
+		static constexpr ComponentTypeID ID = id; \
+	};
+
+/* Engine components */
+struct Transform;
+struct WorldTransform;
+class Mesh;
+
+DECLARE_COMPONENT_TYPE(Transform, 0)
+DECLARE_COMPONENT_TYPE(WorldTransform, 1)
+DECLARE_COMPONENT_TYPE(Mesh, 2)
+
+namespace ComponentTypes {
+	ComponentTypeID NextDynamicID();
+}
+
+/**
+* Gets the ID of a component type. Engine types are
+* constants, other types get the next free ID once
+*
+* @returns Component type ID
+*/
+template<typename T>
+inline ComponentTypeID
+GetComponentTypeID() {
+	if constexpr (ComponentTypeOf<T>::bStatic) {
+		return ComponentTypeOf<T>::ID;
+	}
+	else {
+		static const ComponentTypeID id = ComponentTypes::NextDynamicID();
+		return id;
+	}
+}
+
+/**
+* Gets the mask with the bit of every given type
+*
+* @returns Component mask
+*/
+template<typename... Ts>
+inline ComponentMask
+GetComponentMask() {
+	return ((static_cast<ComponentMask>(1) << GetComponentTypeID<Ts>()) | ... | static_cast<ComponentMask>(0));
+}
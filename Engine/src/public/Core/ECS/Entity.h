@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+/* Entity identifier, an index into the component pools */
+using EntityID = uint32_t;
+
+constexpr EntityID INVALID_ENTITY = UINT32_MAX;
+
+/**
+* Generational entity handle
+*
+* The index is reused once the entity is destroyed,
+* the generation is not. A handle kept after its
+* entity died no longer matches the registry, see
+* Registry::IsAlive
+*/
+struct EntityHandle {
+	EntityID nIndex = INVALID_ENTITY;
+	uint32_t nGeneration = 0;
+
+	bool IsValid() const { return this->nIndex != INVALID_ENTITY; }
+
+	bool operator==(const EntityHandle& other) const = default;
+};
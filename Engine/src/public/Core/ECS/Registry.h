@@ -0,0 +1,117 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/ECS/Entity.h"
+#include "Core/ECS/ComponentPool.h"
+#include "Core/ECS/ComponentType.h"
+
+/**
+* Entity registry
+*
+* Hands out entity handles and owns one ComponentPool
+* per component type. Destroyed entity indices are
+* reused, so pools stay small, and their generation
+* is bumped so old handles can be told apart.
+*
+* Every entity has a mask with one bit per component
+* type it owns, kept in sync by Add and Remove. Add
+* and remove components through the registry, not
+* the pools
+*/
+class Registry {
+public:
+	Registry() = default;
+
+	Registry(const Registry&) = delete;
+	Registry& operator=(const Registry&) = delete;
+
+	EntityHandle CreateEntity();
+	void DestroyEntity(EntityHandle handle);
+
+	bool IsAlive(EntityHandle handle) const;
+	EntityHandle GetHandle(EntityID entity) const;
+	uint32_t GetEntityCount() const { return this->m_nAliveCount; }
+
+	ComponentMask GetMask(EntityID entity) const { return entity < this->m_masks.size() ? this->m_masks[entity] : 0; }
+
+	template<typename T, typename... Args>
+	T&
+	Add(EntityID entity, Args&&... args) {
+		this->m_masks[entity] |= GetComponentMask<T>();
+		return this->GetPool<T>().Add(entity, std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	void
+	Remove(EntityID entity) {
+		if (!this->Has<T>(entity)) return;
+
+		this->m_masks[entity] &= ~GetComponentMask<T>();
+		this->GetPool<T>().Remove(entity);
+	}
+
+	template<typename T>
+	T*
+	Get(EntityID entity) {
+		if (!this->Has<T>(entity)) return nullptr;
+		return this->GetPool<T>().Get(entity);
+	}
+
+	/* Mask checks only, the pools aren't touched */
+	template<typename T>
+	bool
+	Has(EntityID entity) const {
+		return (this->GetMask(entity) & GetComponentMask<T>()) != 0;
+	}
+
+	template<typename... Ts>
+	bool
+	HasAll(EntityID entity) const {
+		ComponentMask required = GetComponentMask<Ts...>();
+		return (this->GetMask(entity) & required) == required;
+	}
+
+	/**
+	* Gets every entity that has all the given
+	* component types, from the masks alone
+	*
+	* @param outEntities Output entities, in index order
+	*/
+	template<typename... Ts>
+	void
+	Query(Vector<EntityID>& outEntities) const {
+		this->QueryMask(GetComponentMask<Ts...>(), outEntities);
+	}
+
+	void QueryMask(ComponentMask required, Vector<EntityID>& outEntities) const;
+
+	/**
+	* Gets the pool of a component type,
+	* creating it on first use
+	*
+	* @returns Component pool
+	*/
+	template<typename T>
+	ComponentPool<T>&
+	GetPool() {
+		ComponentTypeID type = GetComponentTypeID<T>();
+
+		UniquePtr<IComponentPool>& pool = this->m_pools[type];
+		if (!pool) {
+			pool = std::make_unique<ComponentPool<T>>();
+		}
+
+		return *static_cast<ComponentPool<T>*>(pool.get());
+	}
+
+	void StartComponents();
+	void UpdateComponents();
+private:
+	UniquePtr<IComponentPool> m_pools[MAX_COMPONENT_TYPES]; // Indexed by component type ID
+
+	Vector<ComponentMask> m_masks; // Entity -> component types it has
+
+	Vector<bool> m_alive;
+	Vector<uint32_t> m_generations;
+	Vector<EntityID> m_freeEntities;
+	uint32_t m_nAliveCount = 0;
+};
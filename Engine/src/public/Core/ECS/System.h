@@ -0,0 +1,121 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/ECS/Registry.h"
+#include "Core/ECS/ComponentType.h"
+
+/**
+* Component types a system touches
+*
+* Two systems conflict when one writes a type the
+* other reads or writes. Exclusive systems conflict
+* with everything and always run alone
+*/
+struct SystemAccess {
+	ComponentMask reads = 0;
+	ComponentMask writes = 0;
+	bool bExclusive = false;
+
+	template<typename T>
+	SystemAccess&
+	Read() {
+		this->reads |= GetComponentMask<T>();
+		return *this;
+	}
+
+	template<typename T>
+	SystemAccess&
+	Write() {
+		this->writes |= GetComponentMask<T>();
+		return *this;
+	}
+
+	SystemAccess&
+	Exclusive() {
+		this->bExclusive = true;
+		return *this;
+	}
+
+	bool ConflictsWith(const SystemAccess& other) const;
+};
+
+/**
+* Update system
+*
+* Prepare runs on the scheduler thread and may touch
+* the registry freely (fetch pools, add components).
+* Run is called once per chunk of the range Prepare
+* returned, possibly on several threads at once. It
+* must only touch the declared component types, of
+* the entities in its chunk, and must not add or
+* remove components
+*/
+class ISystem {
+public:
+	virtual ~ISystem() = default;
+
+	virtual const char* GetName() const = 0; // String literal, used as profiler zone
+
+	virtual void DeclareAccess(SystemAccess& access) const = 0;
+
+	/**
+	* Gets the system ready for this update
+	*
+	* @param registry Scene registry
+	*
+	* @returns Number of items to split in chunks
+	*/
+	virtual uint32_t Prepare(Registry& registry) = 0;
+
+	virtual void Run(uint32_t nBegin, uint32_t nEnd, float fDeltaTime) = 0;
+};
+
+/**
+* System over the dense array of one component type.
+* Chunks are ranges of that array
+*/
+template<typename T>
+class ComponentSystem : public ISystem {
+public:
+	void
+	DeclareAccess(SystemAccess& access) const override {
+		access.Write<T>();
+	}
+
+	uint32_t
+	Prepare(Registry& registry) override {
+		this->m_pRegistry = &registry;
+		this->m_pPool = &registry.GetPool<T>();
+		return this->m_pPool->GetSize();
+	}
+protected:
+	Registry* m_pRegistry = nullptr;
+	ComponentPool<T>* m_pPool = nullptr;
+};
+
+/**
+* Calls Component::Update on every behaviour
+* component. Behaviours may reach anything, so
+* they keep running alone on one thread
+*/
+class BehaviourSystem : public ISystem {
+public:
+	const char* GetName() const override { return "BehaviourSystem"; }
+
+	void
+	DeclareAccess(SystemAccess& access) const override {
+		access.Exclusive();
+	}
+
+	uint32_t
+	Prepare(Registry& registry) override {
+		this->m_pRegistry = &registry;
+		return 1;
+	}
+
+	void
+	Run(uint32_t nBegin, uint32_t nEnd, float fDeltaTime) override {
+		this->m_pRegistry->UpdateComponents();
+	}
+private:
+	Registry* m_pRegistry = nullptr;
+};
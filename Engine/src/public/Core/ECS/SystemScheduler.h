@@ -0,0 +1,63 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/ECS/System.h"
+#include "Core/Utils/ThreadPool.h"
+
+/**
+* Runs update systems on a worker pool
+*
+* Systems are grouped into stages when they are added.
+* A system goes one stage after the last system added
+* before it that conflicts with it, so conflicting
+* systems keep their registration order and systems
+* in a stage never touch the same data. Each stage
+* splits every system's range in chunks and runs all
+* of them in parallel, the calling thread included
+*/
+class SystemScheduler {
+public:
+	static constexpr uint32_t DEFAULT_CHUNK_SIZE = 1024;
+
+	SystemScheduler() = default;
+
+	SystemScheduler(const SystemScheduler&) = delete;
+	SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+	ISystem& AddSystem(UniquePtr<ISystem> system);
+
+	template<typename T, typename... Args>
+	T&
+	AddSystem(Args&&... args) {
+		return static_cast<T&>(this->AddSystem(std::make_unique<T>(std::forward<Args>(args)...)));
+	}
+
+	void SetChunkSize(uint32_t nChunkSize) { this->m_nChunkSize = nChunkSize > 0 ? nChunkSize : 1; }
+
+	uint32_t GetStageCount() const { return static_cast<uint32_t>(this->m_stages.size()); }
+
+	void Run(Registry& registry, float fDeltaTime);
+
+	static ThreadPool* GetWorkerPool();
+private:
+	struct SystemEntry {
+		UniquePtr<ISystem> system;
+		SystemAccess access;
+		uint32_t nStage = 0;
+	};
+
+	struct Chunk {
+		ISystem* pSystem = nullptr;
+		uint32_t nBegin = 0;
+		uint32_t nEnd = 0;
+	};
+
+	Vector<SystemEntry> m_systems;
+	Vector<Vector<uint32_t>> m_stages; // Stage -> system indices
+
+	uint32_t m_nChunkSize = DEFAULT_CHUNK_SIZE;
+
+	Vector<Chunk> m_chunks;
+	Vector<std::future<void>> m_pending;
+
+	static ThreadPool::Ptr m_workerPool;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include "Core/Containers.h"
+
+#include <array>
+
+/* Percentiles of a set of frame times, in milliseconds */
+struct FrameTimeStats {
+	uint32_t nSamples = 0;
+	float fAverage = 0.f;
+	float fP50 = 0.f;
+	float fP95 = 0.f;
+	float fP99 = 0.f;
+	float fMax = 0.f;
+
+	/* FPS at the 99th percentile frame time (1% low) */
+	float GetLowFPS() const { return this->fP99 > 0.f ? 1000.f / this->fP99 : 0.f; }
+};
+
+/* Zone time inside a hitch frame */
+struct HitchZone {
+	const char* name = nullptr;
+	float fMilliseconds = 0.f;
+};
+
+struct HitchReport {
+	uint32_t nFrame = 0;
+	float fCPUMilliseconds = 0.f;
+	Vector<HitchZone> zones; // Longest profiler zones of the frame, empty without a capture
+};
+
+/**
+* Frame time statistics
+*
+* Records CPU frame times and, on frames the render graph
+* read timestamps back, GPU frame times. The last
+* WINDOW_SIZE frames are kept as is for live display,
+* the whole run only as a histogram for the exit summary,
+* so memory stays fixed however long the run is
+*/
+class FrameStats {
+public:
+	static constexpr uint32_t MAX_HITCH_REPORTS = 256;
+	static constexpr uint32_t MAX_HITCH_ZONES = 10;
+	static constexpr uint32_t WINDOW_SIZE = 1024;
+
+	FrameStats() = default;
+
+	void SetHitchThreshold(float fMilliseconds) { this->m_fHitchThreshold = fMilliseconds; }
+	float GetHitchThreshold() const { return this->m_fHitchThreshold; }
+
+	void BeginFrame(uint32_t nFrame);
+	void EndFrame(float fCPUMilliseconds, float fGPUMilliseconds);
+
+	FrameTimeStats GetCPUStats(bool bWholeRun = false) const;
+	FrameTimeStats GetGPUStats(bool bWholeRun = false) const;
+
+	const Vector<HitchReport>& GetHitches() const { return this->m_hitches; }
+	uint32_t GetHitchCount() const { return this->m_nHitchCount; }
+
+	void LogSummary() const;
+	bool WriteSummary(const String& path) const;
+
+	static FrameStats* GetInstance();
+private:
+	static FrameStats* m_instance;
+
+	float m_fHitchThreshold = 33.3f;
+
+	uint32_t m_nFrame = 0;
+	uint64_t m_nFrameStart = 0; // Profiler time
+
+	/*
+		Whole run frame times in log spaced bins, each BIN_GROWTH
+		times wider than the previous one from BIN_MIN, about 80 s
+		for the last. Percentiles are off by 1% at most
+	*/
+	struct Histogram {
+		static constexpr uint32_t BIN_COUNT = 1600;
+		static constexpr double BIN_MIN = .01; // Milliseconds, shorter frames land in the first bin
+		static constexpr double BIN_GROWTH = 1.01;
+
+		static float GetBinStart(uint32_t nBin);
+
+		std::array<uint32_t, BIN_COUNT> bins = { };
+		uint32_t nSamples = 0;
+		double fSum = 0.0;
+		float fMax = 0.f;
+
+		void Add(float fMilliseconds);
+		FrameTimeStats ComputeStats() const;
+	};
+
+	/* Rolling window, ring buffers of WINDOW_SIZE entries */
+	std::array<float, WINDOW_SIZE> m_cpuWindow = { };
+	std::array<float, WINDOW_SIZE> m_gpuWindow = { }; // 0 for frames without a GPU reading
+	uint32_t m_nWindowNext = 0;
+	uint32_t m_nWindowCount = 0;
+
+	Histogram m_cpuRun;
+	Histogram m_gpuRun;
+
+	Vector<HitchReport> m_hitches;
+	uint32_t m_nHitchCount = 0;
+
+	static FrameTimeStats ComputeStats(const std::array<float, WINDOW_SIZE>& times, uint32_t nCount);
+
+	void ReportHitch(float fCPUMilliseconds, uint64_t nFrameEnd);
+};
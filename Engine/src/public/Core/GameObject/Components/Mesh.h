@@ -10,28 +10,51 @@
 
 #include <map>
 
+/*
+	Holds a mesh registry user, or mesh data of its own,
+	until it is unloaded or destroyed. Moves inside its
+	component pool hand it over, copies aren't allowed
+*/
 class Mesh : public Component {
 public:
 	Mesh(String name);
+	~Mesh();
+
+	Mesh(const Mesh&) = delete;
+	Mesh& operator=(const Mesh&) = delete;
+
+	Mesh(Mesh&& other) noexcept;
+	Mesh& operator=(Mesh&& other);
 
 	void Start() override;
 	void Update() override;
 
-	bool LoadAsset(const AssetHandle& handle);
+	bool LoadAsset(const AssetHandle& handle, bool bQueueUpload = true);
+	bool SetMeshData(const AssetHandle& handle, const Ref<MeshData>& meshData, bool bQueueUpload = true);
+	void Unload();
+
+	static Ref<MeshData> LoadMeshData(const AssetHandle& handle);
 
-	MeshData& GetMeshData() { return this->m_meshData; }
-	const MeshData& GetMeshData() const { return this->m_meshData; }
-	bool IsLoaded() const { return this->m_meshData.bLoaded; }
+	MeshData& GetMeshData() { return *this->m_meshData; }
+	const MeshData& GetMeshData() const { return *this->m_meshData; }
+	bool IsLoaded() const { return this->m_meshData->bLoaded; }
 
-	void ClearTextureData();
+	/* Data from the MeshRegistry, shared with every other user of the asset */
+	bool IsShared() const { return this->m_bShared; }
+
+	/* Shared with the upload queue, the component itself moves inside its pool */
+	const Ref<MeshData>& GetMeshDataRef() const { return this->m_meshData; }
 
 	const AssetHandle 
 	GetAssetHandle() { return this->m_meshHandle; }
 
 private:
-	Material ProcessMaterial(const MaterialAsset& asset);
+	static Material ProcessMaterial(const MaterialAsset& asset);
+
+	void ReleaseMeshData();
 	
-	MeshData m_meshData;
+	Ref<MeshData> m_meshData; // nullptr once moved from
 
 	AssetHandle m_meshHandle;
+	bool m_bShared = false;
 };
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include <glm/glm.hpp>
+
+/**
+* Cached matrices of an object's Transform
+*
+* The Transform is relative to the parent in the
+* scene Hierarchy. Scene::UpdateTransforms recomputes
+* the local matrix of dirty objects and the world
+* matrix of every object below a change
+*/
+struct WorldTransform {
+	glm::mat4 local = glm::mat4(1.f);
+	glm::mat4 world = glm::mat4(1.f);
+	bool bDirty = true; // Transform changed since the last update
+};
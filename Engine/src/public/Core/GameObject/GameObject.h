@@ -3,28 +3,77 @@
 
 #include "Core/Containers.h"
 
+#include "Core/ECS/Registry.h"
 #include "Core/GameObject/Components/Component.h"
 #include "Core/GameObject/Components/Mesh.h"
+#include "Core/GameObject/Components/WorldTransform.h"
 #include "Math/Transform.h"
 
 #include "Core/Resources/GameObjectAsset.h"
 
+/**
+* Named entity of a scene
+*
+* The object only keeps its entity handle, the
+* transform and components live in the scene
+* registry's pools. Component pointers and
+* references are invalidated when a pool of
+* the same type changes. Objects come from
+* their scene's object pool and are dropped
+* with it without running destructors, keep
+* members free of owned memory
+*/
 class GameObject {
 public:
-	GameObject(String name);
+	GameObject(String name, Registry* pRegistry);
+	~GameObject();
+
+	GameObject(const GameObject&) = delete;
+	GameObject& operator=(const GameObject&) = delete;
 
 	String GetName();
+	EntityID GetEntity() const { return this->m_handle.nIndex; }
+	EntityHandle GetHandle() const { return this->m_handle; }
 
-	virtual void Start();
-	virtual void Update();
-	Map<String, Component*> GetComponents();
-	void AddComponent(String name, Component* component);
+	Transform& GetTransform();
+	const Transform& GetTransform() const;
 
-	void SetupFromAsset(const GameObjectAsset& asset);
+	void MarkTransformDirty();
+
+	/* Static objects never move, a bake may merge their geometry */
+	void SetStatic(bool bStatic) { this->m_bStatic = bStatic; }
+	bool IsStatic() const { return this->m_bStatic; }
+
+	template<typename T, typename... Args>
+	T&
+	AddComponent(Args&&... args) {
+		return this->m_pRegistry->Add<T>(this->m_handle.nIndex, std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	T*
+	GetComponent() {
+		return this->m_pRegistry->Get<T>(this->m_handle.nIndex);
+	}
 
-	Transform transform;
+	template<typename T>
+	bool
+	HasComponent() const {
+		return this->m_pRegistry->Has<T>(this->m_handle.nIndex);
+	}
+
+	template<typename T>
+	void
+	RemoveComponent() {
+		this->m_pRegistry->Remove<T>(this->m_handle.nIndex);
+	}
+
+	void SetupFromAsset(const GameObjectAsset& asset);
 private:
-	String m_name;
-	
-	Map<String, Component*> m_components;
-};
\ No newline at end of file
+	Name m_name;
+
+	Registry* m_pRegistry;
+	EntityHandle m_handle;
+
+	bool m_bStatic = false;
+};
@@ -26,6 +26,7 @@ public:
 	Input();
 
 	void ShowCursor(bool bShow);
+	void Poll();
 	void SetWindow(GLFWwindow* pWindow);
 	
 	/* Key setters */
@@ -66,6 +67,10 @@ private:
 
 	GLFWwindow* m_pWindow;
 
+	/* Requested by the game update, applied by Poll */
+	bool m_bCursorVisible = true;
+	bool m_bCursorShown = true;
+
 	Map<char, EInputState> m_keys;
 	Map<EMouseButton, EInputState> m_buttons;
 
@@ -9,6 +9,7 @@
 #include "Core/Renderer/Framebuffer.h"
 #include "Core/Renderer/Semaphore.h"
 #include "Core/Renderer/Fence.h"
+#include "Core/Renderer/QueryPool.h"
 #include "Core/Renderer/Pipeline.h"
 #include "Core/Renderer/ImGuiImpl.h"
 #include "Core/Renderer/TextureUploader.h"
@@ -291,6 +292,23 @@ public:
 	*/
 	virtual Ref<Fence> CreateFence(const FenceCreateInfo& createInfo) = 0;
 
+	/**
+	* Creates a query pool
+	* 
+	* @param createInfo Query pool create info
+	* 
+	* @returns Created query pool
+	*/
+	virtual Ref<QueryPool> CreateQueryPool(const QueryPoolCreateInfo& createInfo) = 0;
+
+	/**
+	* Gets the timestamp period of the graphics queue
+	* 
+	* @returns Nanoseconds per timestamp tick, 0 if
+	* the graphics queue can't write timestamps
+	*/
+	virtual float GetTimestampPeriod() = 0;
+
 	/**
 	* Creates a ImGui implementation
 	* 
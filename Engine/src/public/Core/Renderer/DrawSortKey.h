@@ -0,0 +1,68 @@
+#pragma once
+#include "Core/Containers.h"
+
+/**
+* 64 bit draw sort key, most significant first:
+*
+*	63-60	Pass
+*	59-52	Pipeline
+*	51-44	Mega-buffer block
+*	43-34	Quantized view depth, near first
+*	33-0	Material
+*
+* Sorting by it groups draws by the state they
+* bind and, inside a block, submits near draws
+* before far ones so early-Z rejects more of
+* what's behind them
+*/
+namespace DrawSortKey {
+	constexpr uint32_t PASS_SHIFT = 60;
+	constexpr uint32_t PIPELINE_SHIFT = 52;
+	constexpr uint32_t BLOCK_SHIFT = 44;
+	constexpr uint32_t DEPTH_SHIFT = 34;
+
+	constexpr uint64_t PASS_MASK = 0xF;
+	constexpr uint64_t PIPELINE_MASK = 0xFF;
+	constexpr uint64_t BLOCK_MASK = 0xFF;
+	constexpr uint64_t DEPTH_MASK = 0x3FF;
+	constexpr uint64_t MATERIAL_MASK = (1ull << DEPTH_SHIFT) - 1;
+
+	/* Passes, in submission order */
+	constexpr uint32_t PASS_OPAQUE = 0;
+
+	/**
+	* Packs the key fields, each one is masked
+	* to its width
+	*
+	* @param nPass Render pass
+	* @param nPipeline Pipeline or shader variant
+	* @param nBlock Mega-buffer block
+	* @param nDepth QuantizeDepth() bucket
+	* @param nMaterial Material ID
+	*
+	* @returns Sort key
+	*/
+	inline uint64_t
+	Make(uint32_t nPass, uint32_t nPipeline, uint32_t nBlock, uint32_t nDepth, uint64_t nMaterial) {
+		return ((nPass & PASS_MASK) << PASS_SHIFT)
+			| ((nPipeline & PIPELINE_MASK) << PIPELINE_SHIFT)
+			| ((nBlock & BLOCK_MASK) << BLOCK_SHIFT)
+			| ((nDepth & DEPTH_MASK) << DEPTH_SHIFT)
+			| (nMaterial & MATERIAL_MASK);
+	}
+
+	inline uint32_t
+	GetDepth(uint64_t nKey) {
+		return static_cast<uint32_t>((nKey >> DEPTH_SHIFT) & DEPTH_MASK);
+	}
+
+	uint32_t QuantizeDepth(float fDepth);
+}
+
+/* A sortable draw, nIndex points back at whatever is drawn */
+struct DrawSortItem {
+	uint64_t nKey;
+	uint32_t nIndex;
+};
+
+void RadixSortDraws(Vector<DrawSortItem>& items, Vector<DrawSortItem>& scratch);
@@ -12,6 +12,8 @@
 #include "Core/Renderer/Rect2D.h"
 #include "Core/Renderer/RenderPass.h"
 #include "Core/Renderer/CommandBuffer.h"
+#include "Core/Renderer/QueryPool.h"
+#include "Core/Renderer/PipelineStage.h"
 
 class GraphicsContext {
 public:
@@ -220,4 +222,24 @@ public:
 	* This is a simple but expensive synchronization method.
 	*/
 	virtual void GlobalBarrier() = 0;
+
+	/**
+	* Resets queries. Must be recorded outside
+	* of a render pass
+	* 
+	* @param queryPool Query pool
+	* @param nFirstQuery First query
+	* @param nQueryCount Query count
+	*/
+	virtual void ResetQueries(Ref<QueryPool> queryPool, uint32_t nFirstQuery, uint32_t nQueryCount) = 0;
+
+	/**
+	* Writes a timestamp once previous commands
+	* reach the given stage
+	* 
+	* @param queryPool Timestamp query pool
+	* @param nQuery Query index
+	* @param stage Pipeline stage
+	*/
+	virtual void WriteTimestamp(Ref<QueryPool> queryPool, uint32_t nQuery, EPipelineStage stage) = 0;
 };
\ No newline at end of file
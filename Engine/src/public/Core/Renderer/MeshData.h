@@ -5,6 +5,7 @@
 #include "Core/Renderer/Material.h"
 
 #include "Math/Vector3.h"
+#include "Math/AABB.h"
 
 struct TextureData {
 	String name;
@@ -17,6 +18,7 @@ struct TextureData {
 struct SubMeshData {
 	Vector<Vertex> vertices;
 	Vector<uint32_t> indices;
+	AABB bounds; // Local space, from the vertices
 
 	/**
 	* Check if SubMes material data has specified flag
@@ -50,5 +52,92 @@ struct SubMeshData {
 struct MeshData {
 	String name;
 	Map<uint32_t, SubMeshData> subMeshes;
+	AABB bounds; // Union of the sub mesh bounds
 	bool bLoaded = false;
+
+	AssetHandle assetHandle; // Asset it was decoded from, reloads read it again
+	bool bGeometryResident = true; // CPU vertices and indices, dropped once on the GPU unless kept
+	bool bTexturesResident = true; // CPU texture pixels, always dropped once on the GPU
+
+	/**
+	* CPU memory held by the geometry and textures,
+	* the same size as their GPU copy
+	* 
+	* @returns Size in bytes
+	*/
+	uint64_t
+	GetByteSize() const {
+		return this->GetGeometryByteSize() + this->GetTextureByteSize();
+	}
+
+	/**
+	* CPU memory held by the vertices and indices
+	* 
+	* @returns Size in bytes
+	*/
+	uint64_t
+	GetGeometryByteSize() const {
+		uint64_t nBytes = 0;
+
+		for (const auto& [idx, sub] : this->subMeshes) {
+			nBytes += sub.vertices.size() * sizeof(Vertex);
+			nBytes += sub.indices.size() * sizeof(uint32_t);
+		}
+
+		return nBytes;
+	}
+
+	/**
+	* CPU memory held by the texture pixels
+	* 
+	* @returns Size in bytes
+	*/
+	uint64_t
+	GetTextureByteSize() const {
+		uint64_t nBytes = 0;
+
+		for (const auto& [idx, sub] : this->subMeshes) {
+			nBytes += sub.albedo.data.size() + sub.orm.data.size();
+			nBytes += sub.emissive.data.size() + sub.normal.data.size();
+		}
+
+		return nBytes;
+	}
+
+	/**
+	* Frees the vertices and indices, once uploaded
+	* they are only needed on the GPU. Bounds stay,
+	* culling and picking only read them
+	*/
+	void
+	ClearGeometryData() {
+		for (auto& [idx, sub] : this->subMeshes) {
+			sub.vertices.clear();
+			sub.vertices.shrink_to_fit();
+			sub.indices.clear();
+			sub.indices.shrink_to_fit();
+		}
+
+		this->bGeometryResident = false;
+	}
+
+	/**
+	* Frees the texture pixels, once uploaded
+	* they are only needed on the GPU
+	*/
+	void
+	ClearTextureData() {
+		for (auto& [idx, sub] : this->subMeshes) {
+			sub.albedo.data.clear();
+			sub.albedo.data.shrink_to_fit();
+			sub.orm.data.clear();
+			sub.orm.data.shrink_to_fit();
+			sub.emissive.data.clear();
+			sub.emissive.data.shrink_to_fit();
+			sub.normal.data.clear();
+			sub.normal.data.shrink_to_fit();
+		}
+
+		this->bTexturesResident = false;
+	}
 };
@@ -0,0 +1,70 @@
+#pragma once
+#include <mutex>
+
+#include "Core/Containers.h"
+#include "Core/Resources/AssetHandle.h"
+
+struct MeshData;
+
+/* What stays in CPU memory once a mesh is on the GPU */
+struct MeshResidencyPolicy {
+	bool bKeepGeometry = false; // Vertices and indices, for CPU side collision or queries
+	bool bKeepAssets = false; // Source mesh assets in the asset cache
+};
+
+/**
+* Shared mesh resources
+*
+* One decoded MeshData per mesh asset, shared by
+* every user drawing it (Mesh components, cells
+* being streamed in) and counted per user. The
+* GPU copy follows the data, it is uploaded once.
+* When the last user lets go, the CPU copy is
+* dropped and the GPU copy queued for release,
+* the frame loop frees it once no frame in
+* flight draws it.
+*
+* Once uploaded, CPU copies are dropped as the
+* residency policy says. Bounds always stay.
+* Whatever was dropped is read back from disk by
+* Reload() if it's needed again.
+*
+* Thread safe, streaming threads acquire too
+*/
+class MeshRegistry {
+public:
+	MeshRegistry() = default;
+
+	Ref<MeshData> Acquire(const AssetHandle& handle, uint64_t* pnResidentBytes = nullptr);
+	void Release(const AssetHandle& handle);
+
+	uint32_t GetUserCount(const AssetHandle& handle);
+	uint32_t GetMeshCount();
+	uint64_t GetResidentBytes();
+
+	void SetResidencyPolicy(const MeshResidencyPolicy& policy);
+	MeshResidencyPolicy GetResidencyPolicy();
+
+	/* Frame loop thread only, the one reading and writing CPU geometry after upload */
+	void OnUploaded(MeshData& meshData);
+	bool Reload(MeshData& meshData);
+
+	static MeshRegistry* GetInstance();
+private:
+	struct Entry {
+		Ref<MeshData> meshData;
+		uint32_t nUsers = 0;
+		uint64_t nResidentBytes = 0; // Kept once uploaded, measured on decode
+	};
+
+	static MeshRegistry* m_instance;
+
+	std::mutex m_mutex;
+	HashMap<uint64_t, Entry> m_meshes; // Mesh asset UUID -> shared data
+	HashMap<uint64_t, uint32_t> m_decoding; // Mesh asset UUID -> decodes in flight
+	uint64_t m_nResidentBytes = 0; // Sum over m_meshes
+
+	MeshResidencyPolicy m_policy;
+
+	Ref<MeshData> Decode(const AssetHandle& handle);
+};
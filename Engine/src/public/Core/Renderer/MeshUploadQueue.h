@@ -0,0 +1,45 @@
+#pragma once
+#include <mutex>
+#include <unordered_set>
+
+#include "Core/Containers.h"
+
+struct MeshData;
+
+/**
+* Meshes waiting for their GPU upload
+*
+* Mesh components push their data once the
+* asset is loaded, the frame loop drains the
+* queue. Per frame cost only depends on the
+* number of new meshes, not on scene size.
+* 
+* Meshes whose last user went away (streamed
+* out cells) are queued for release the same
+* way, the GPU side is owned by the frame loop
+*/
+class MeshUploadQueue {
+public:
+	MeshUploadQueue() = default;
+
+	void Push(const Ref<MeshData>& meshData);
+	void Remove(const MeshData* pMeshData);
+
+	Vector<Ref<MeshData>> Drain();
+
+	void Release(const String& name);
+	Vector<String> DrainReleases();
+
+	bool IsEmpty();
+
+	static MeshUploadQueue* GetInstance();
+private:
+	static MeshUploadQueue* m_instance;
+
+	std::mutex m_mutex;
+
+	Vector<Ref<MeshData>> m_pending;
+	std::unordered_set<const MeshData*> m_queued;
+
+	Vector<String> m_releases; // GPU mesh names
+};
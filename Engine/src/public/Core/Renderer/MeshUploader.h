@@ -31,6 +31,7 @@ struct UploadedSubMesh {
 
 struct UploadedMesh {
 	Map<uint32_t, UploadedSubMesh> subMeshes;
+	uint32_t nUploadId = 0; // Changes when the mesh is uploaded again
 };
 
 struct PendingTextureUpload {
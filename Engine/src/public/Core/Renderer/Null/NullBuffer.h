@@ -0,0 +1,39 @@
+#pragma once
+#include "Core/Renderer/GPUBuffer.h"
+
+class NullDevice;
+
+/**
+* Null buffer
+*
+* Host memory is only allocated the first time
+* the buffer is mapped, so large device-local
+* buffers cost nothing
+*/
+class NullBuffer : public GPUBuffer {
+public:
+	using Ptr = Ref<NullBuffer>;
+
+	explicit NullBuffer(Ref<NullDevice> device);
+	~NullBuffer() override = default;
+
+	void Create(const BufferCreateInfo& createInfo, const String& debugName = "GPUBuffer") override;
+
+	void* Map() override;
+	void Unmap() override;
+
+	void CopyBuffer(Ref<GPUBuffer> srcBuff, uint32_t nSize, uint32_t nOffset = 0) override;
+
+	uint32_t GetSize() const { return this->m_nSize; }
+
+	static Ptr
+	CreateShared(Ref<NullDevice> device) {
+		return CreateRef<NullBuffer>(device);
+	}
+
+private:
+	Ref<NullDevice> m_device;
+
+	Vector<uint8_t> m_data;
+	uint32_t m_nSize = 0;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+#include "Core/Renderer/CommandBuffer.h"
+
+/**
+* Commands recorded into a null command buffer
+*/
+struct NullCommandStats {
+	uint64_t nDraws = 0;
+	uint64_t nIndexedDraws = 0;
+	uint64_t nIndirectDraws = 0; // DrawIndexedIndirect calls
+	uint64_t nMaxIndirectDrawCount = 0; // Sum of their max draw counts
+	uint64_t nVertices = 0; // Vertices/indices of direct draws, times instances
+
+	uint64_t nDispatches = 0;
+	uint64_t nDispatchGroups = 0;
+
+	uint64_t nBufferBarriers = 0;
+	uint64_t nImageBarriers = 0;
+	uint64_t nGlobalBarriers = 0;
+
+	uint64_t nRenderPasses = 0;
+	uint64_t nSubpasses = 0;
+
+	uint64_t nPipelineBinds = 0;
+	uint64_t nDescriptorSetBinds = 0;
+	uint64_t nVertexBufferBinds = 0;
+	uint64_t nIndexBufferBinds = 0;
+
+	uint64_t nPushConstantBytes = 0;
+	uint64_t nFilledBytes = 0;
+
+	uint64_t GetDrawCount() const { return this->nDraws + this->nIndexedDraws + this->nIndirectDraws; }
+	uint64_t GetBarrierCount() const { return this->nBufferBarriers + this->nImageBarriers + this->nGlobalBarriers; }
+
+	void Accumulate(const NullCommandStats& other);
+};
+
+class NullCommandBuffer : public CommandBuffer {
+public:
+	using Ptr = Ref<NullCommandBuffer>;
+
+	void Begin(bool bSingleTime = false) override;
+	void End() override;
+	void Reset() override;
+
+	bool IsRecording() const { return this->m_bRecording; }
+
+	NullCommandStats& GetStats() { return this->m_stats; }
+	const NullCommandStats& GetStats() const { return this->m_stats; }
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullCommandBuffer>();
+	}
+
+private:
+	NullCommandStats m_stats;
+	bool m_bRecording = false;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "Core/Renderer/CommandPool.h"
+
+#include "Core/Renderer/Null/NullCommandBuffer.h"
+
+class NullCommandPool : public CommandPool {
+public:
+	using Ptr = Ref<NullCommandPool>;
+
+	void Create(const CommandPoolCreateInfo& createInfo) override;
+
+	Ref<CommandBuffer> AllocateCommandBuffer() override;
+	Vector<Ref<CommandBuffer>> AllocateCommandBuffers(uint32_t nCount) override;
+
+	void FreeCommandBuffer(Ref<CommandBuffer> commandBuffer) override;
+	void FreeCommandBuffers(const Vector<Ref<CommandBuffer>>& commandBuffers) override;
+
+	void Reset(bool bReleaseResources = false) override;
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullCommandPool>();
+	}
+
+private:
+	Vector<Ref<NullCommandBuffer>> m_commandBuffers;
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <mutex>
+
+#include "Utils.h"
+#include "Core/Logger.h"
+
+#include "Core/Renderer/Device.h"
+
+#include "Core/Renderer/Null/NullObjects.h"
+#include "Core/Renderer/Null/NullCommandBuffer.h"
+#include "Core/Renderer/Null/NullCommandPool.h"
+#include "Core/Renderer/Null/NullGraphicsContext.h"
+#include "Core/Renderer/Null/NullBuffer.h"
+#include "Core/Renderer/Null/NullRingBuffer.h"
+#include "Core/Renderer/Null/NullTexture.h"
+#include "Core/Renderer/Null/NullSwapchain.h"
+
+/**
+* Totals recorded by a null device
+*/
+struct NullDeviceStats {
+	NullCommandStats commands; // Every submitted command buffer
+
+	uint64_t nSubmits = 0;
+	uint64_t nCommandBuffersSubmitted = 0;
+
+	/* Buffer initial data, buffer copies, texture staging and ring buffer allocations */
+	uint64_t nBytesUploaded = 0;
+
+	uint64_t nBuffersCreated = 0;
+	uint64_t nBufferBytes = 0;
+	uint64_t nTexturesCreated = 0;
+	uint64_t nPipelinesCreated = 0;
+	uint64_t nDescriptorSetsCreated = 0;
+};
+
+/**
+* Null device
+*
+* Implements the whole Device interface without a
+* GPU. Resources are plain host objects, commands
+* are only counted, and waits return immediately.
+* Used to measure the CPU side of a frame and to
+* get deterministic command stream counts
+*/
+class NullDevice : public Device {
+public:
+	using Ptr = Ref<NullDevice>;
+
+	static constexpr uint32_t MIN_BUFFER_OFFSET_ALIGNMENT = 256;
+
+	NullDevice() = default;
+	~NullDevice() override = default;
+
+	void Create(const DeviceCreateInfo& createInfo) override;
+	void WaitIdle() override {}
+	void WaitForFence(Ref<Fence> fence) override {}
+
+	Ref<CommandPool> CreateCommandPool(
+		const CommandPoolCreateInfo& createInfo,
+		EQueueType queueType = EQueueType::GRAPHICS
+	) override;
+
+	Ref<GraphicsContext> CreateContext(Ref<CommandPool>& commandPool) override;
+
+	Ref<PipelineLayout> CreatePipelineLayout(const PipelineLayoutCreateInfo& createInfo) override;
+
+	Ref<Pipeline> CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override;
+	Ref<Pipeline> CreateComputePipeline(const ComputePipelineCreateInfo& createInfo) override;
+
+	Ref<CommandBuffer> BeginSingleTimeCommandBuffer() override;
+	void EndSingleTimeCommandBuffer(Ref<CommandBuffer> commandBuffer) override;
+
+	void GetLimits(
+		uint32_t& nMaxUniformBufferRange,
+		uint32_t& nMaxStorageBufferRange,
+		uint32_t& nMaxPushConstantSize,
+		uint32_t& nMaxBoundDescriptorSets
+	) const override;
+
+	const char* GetDeviceName() const override { return "Null device"; }
+
+	bool HasStencilComponent(GPUFormat format) override;
+	void TransitionLayout(
+		Ref<GPUTexture> image,
+		GPUFormat format,
+		EImageLayout oldLayout,
+		EImageLayout newLayout,
+		uint32_t nLayerCount = 1,
+		uint32_t nBaseMipLevel = 0,
+		uint32_t nBaseArrayLayer = 0
+	) override {}
+
+	Ref<Swapchain> CreateSwapchain(const SwapchainCreateInfo& createInfo) override;
+
+	Ref<RenderPass> CreateRenderPass(const RenderPassCreateInfo& createInfo) override;
+
+	Ref<GPUBuffer> CreateBuffer(const BufferCreateInfo& createInfo) override;
+
+	Ref<GPURingBuffer> CreateRingBuffer(const RingBufferCreateInfo& createInfo) override;
+
+	Ref<GPUTexture> CreateTexture(const TextureCreateInfo& createInfo) override;
+
+	Ref<ImageView> CreateImageView(const ImageViewCreateInfo& createInfo) override;
+
+	Ref<Framebuffer> CreateFramebuffer(const FramebufferCreateInfo& createInfo) override;
+
+	Ref<Sampler> CreateSampler(const SamplerCreateInfo& createInfo) override;
+
+	Ref<DescriptorPool> CreateDescriptorPool(const DescriptorPoolCreateInfo& createInfo) override;
+
+	Ref<DescriptorSetLayout> CreateDescriptorSetLayout(const DescriptorSetLayoutCreateInfo& createInfo) override;
+
+	Ref<DescriptorSet> CreateDescriptorSet(Ref<DescriptorPool> pool, Ref<DescriptorSetLayout> layout) override;
+
+	Ref<Semaphore> CreateSemaphore() override;
+	Ref<Fence> CreateFence(const FenceCreateInfo& createInfo) override;
+	Ref<QueryPool> CreateQueryPool(const QueryPoolCreateInfo& createInfo) override;
+	float GetTimestampPeriod() override { return 0.f; } // No timestamps to time against
+	Ref<ImGuiImpl> CreateImGui(const ImGuiImplCreateInfo& createInfo) override;
+
+	Ref<TextureUploader> GetTextureUploader() override;
+
+	void Submit(const SubmitInfo& submitInfo, Ref<Fence> fence) override;
+
+	/* Recording hooks for null resources */
+	void RecordUpload(uint64_t nBytes);
+	void RecordBufferCreated(uint64_t nBytes);
+	void RecordTextureCreated();
+
+	NullDeviceStats GetStats();
+	void ResetStats();
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullDevice>();
+	}
+
+private:
+	Ref<TextureUploader> m_textureUploader;
+
+	std::mutex m_statsMutex;
+
+	NullDeviceStats m_stats;
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include "Core/Renderer/GraphicsContext.h"
+
+#include "Core/Renderer/Null/NullCommandBuffer.h"
+
+/**
+* Null graphics context
+*
+* Every command is counted into the stats of
+* its command buffer and otherwise dropped
+*/
+class NullGraphicsContext : public GraphicsContext {
+public:
+	using Ptr = Ref<NullGraphicsContext>;
+
+	explicit NullGraphicsContext(Ref<NullCommandBuffer> commandBuffer);
+	~NullGraphicsContext() override = default;
+
+	void BindPipeline(Ref<Pipeline> pipeline) override;
+	void BindDescriptorSets(
+		uint32_t nFirstSet,
+		const Vector<Ref<DescriptorSet>>& sets, const Vector<uint32_t>& dynamicOffsets = {}) override;
+
+	void BindVertexBuffers(const Vector<Ref<GPUBuffer>>& buffers, const Vector<size_t>& offsets = {}) override;
+	void BindIndexBuffer(Ref<GPUBuffer> buffer, EIndexType indexType = EIndexType::UINT16) override;
+
+	void Draw(
+		uint32_t nVertexCount,
+		uint32_t nInstanceCount = 1,
+		uint32_t nFirstVertex = 0,
+		uint32_t nFirstInstance = 0
+	) override;
+
+	void DrawIndexed(
+		uint32_t nIndexCount,
+		uint32_t nInstanceCount = 1,
+		uint32_t nFirstIndex = 0,
+		uint32_t nVertexOffset = 0,
+		uint32_t nFirstInstance = 0
+	) override;
+
+	void DrawIndexedIndirect(
+		Ref<GPUBuffer> buffer,
+		uint32_t nOffset,
+		Ref<GPUBuffer> countBuffer,
+		uint32_t nCountBufferOffset,
+		uint32_t nMaxDrawCount,
+		uint32_t nStride = 0
+	) override;
+
+	void PushConstants(
+		Ref<PipelineLayout> layout,
+		EShaderStage stages,
+		uint32_t nOffset,
+		uint32_t nSize,
+		const void* pcData
+	) override;
+
+	void SetViewport(const Viewport& viewport) override {}
+	void SetScissor(const Rect2D& scissor) override {}
+
+	void BeginRenderPass(const RenderPassBeginInfo& beginInfo) override;
+	void EndRenderPass() override;
+	void NextSubpass() override;
+
+	void FillBuffer(Ref<GPUBuffer> buffer, uint32_t nOffset, uint32_t nSize, uint32_t nData) override;
+
+	void Dispatch(uint32_t x, uint32_t y, uint32_t z) override;
+
+	void BufferMemoryBarrier(Ref<GPUBuffer> buffer, EAccess srcAccess, EAccess dstAccess) override;
+
+	void ImageBarrier(
+		Ref<GPUTexture> image,
+		EImageLayout oldLayout,
+		EImageLayout newLayout
+	) override;
+
+	void ImageBarrier(
+		Ref<GPUTexture> image,
+		EImageLayout oldLayout,
+		EImageLayout newLayout,
+		uint32_t nLayerCount,
+		uint32_t nBaseMipLevel,
+		uint32_t nBaseArrayLayer = 0
+	) override;
+
+	Ref<CommandBuffer> GetCommandBuffer() const override { return this->m_commandBuffer.As<CommandBuffer>(); }
+
+	void GlobalBarrier() override;
+
+	void ResetQueries(Ref<QueryPool> queryPool, uint32_t nFirstQuery, uint32_t nQueryCount) override {}
+	void WriteTimestamp(Ref<QueryPool> queryPool, uint32_t nQuery, EPipelineStage stage) override {}
+
+	static Ptr
+	CreateShared(Ref<NullCommandBuffer> commandBuffer) {
+		return CreateRef<NullGraphicsContext>(commandBuffer);
+	}
+
+private:
+	Ref<NullCommandBuffer> m_commandBuffer;
+
+	bool m_bInsideRenderPass = false;
+};
@@ -0,0 +1,257 @@
+#pragma once
+#include "Core/Containers.h"
+
+#include "Core/Renderer/Fence.h"
+#include "Core/Renderer/Semaphore.h"
+#include "Core/Renderer/QueryPool.h"
+#include "Core/Renderer/ImageView.h"
+#include "Core/Renderer/Framebuffer.h"
+#include "Core/Renderer/Sampler.h"
+#include "Core/Renderer/RenderPass.h"
+#include "Core/Renderer/Pipeline.h"
+#include "Core/Renderer/PipelineLayout.h"
+#include "Core/Renderer/DescriptorPool.h"
+#include "Core/Renderer/DescriptorSet.h"
+#include "Core/Renderer/DescriptorSetLayout.h"
+#include "Core/Renderer/ImGuiImpl.h"
+
+/*
+* Handle-only objects of the null backend.
+* They keep whatever the engine may read back
+* and nothing else
+*/
+
+class NullFence : public Fence {
+public:
+	using Ptr = Ref<NullFence>;
+
+	void Create(const FenceCreateInfo& createInfo) override {}
+	void Reset() override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullFence>();
+	}
+};
+
+class NullSemaphore : public Semaphore {
+public:
+	using Ptr = Ref<NullSemaphore>;
+
+	void Create() override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullSemaphore>();
+	}
+};
+
+/* No GPU, queries never become available */
+class NullQueryPool : public QueryPool {
+public:
+	using Ptr = Ref<NullQueryPool>;
+
+	void Create(const QueryPoolCreateInfo& createInfo) override { this->m_nQueryCount = createInfo.nQueryCount; }
+
+	bool GetResults(uint32_t nFirstQuery, uint32_t nQueryCount, Vector<uint64_t>& results) override { return false; }
+
+	uint32_t GetQueryCount() const override { return this->m_nQueryCount; }
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullQueryPool>();
+	}
+private:
+	uint32_t m_nQueryCount = 0;
+};
+
+class NullImageView : public ImageView {
+public:
+	using Ptr = Ref<NullImageView>;
+
+	void
+	Create(const ImageViewCreateInfo& createInfo) override {
+		this->m_image = createInfo.image;
+		this->m_viewType = createInfo.viewType;
+		this->m_format = createInfo.format;
+	}
+
+	Ref<GPUTexture> GetImage() const override { return this->m_image; }
+	EImageViewType GetViewType() const override { return this->m_viewType; }
+	GPUFormat GetFormat() const override { return this->m_format; }
+
+	void Reset() override { this->m_image = nullptr; }
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullImageView>();
+	}
+
+private:
+	Ref<GPUTexture> m_image;
+	EImageViewType m_viewType = EImageViewType::TYPE_2D;
+	GPUFormat m_format = GPUFormat::UNDEFINED;
+};
+
+class NullFramebuffer : public Framebuffer {
+public:
+	using Ptr = Ref<NullFramebuffer>;
+
+	void Create(const FramebufferCreateInfo& createInfo) override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullFramebuffer>();
+	}
+};
+
+class NullSampler : public Sampler {
+public:
+	using Ptr = Ref<NullSampler>;
+
+	void Create(const SamplerCreateInfo& createInfo) override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullSampler>();
+	}
+};
+
+class NullRenderPass : public RenderPass {
+public:
+	using Ptr = Ref<NullRenderPass>;
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullRenderPass>();
+	}
+};
+
+class NullPipelineLayout : public PipelineLayout {
+public:
+	using Ptr = Ref<NullPipelineLayout>;
+
+	void Create(const PipelineLayoutCreateInfo& createInfo) override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullPipelineLayout>();
+	}
+};
+
+class NullPipeline : public Pipeline {
+public:
+	using Ptr = Ref<NullPipeline>;
+
+	void
+	CreateGraphics(const GraphicsPipelineCreateInfo& createInfo) override {
+		this->m_type = EPipelineType::GRAPHICS;
+		this->m_layout = createInfo.pipelineLayout;
+	}
+
+	void
+	CreateCompute(const ComputePipelineCreateInfo& createInfo) override {
+		this->m_type = EPipelineType::COMPUTE;
+
+		/* Compute pipelines own their layout, same as in Vulkan */
+		PipelineLayoutCreateInfo layoutInfo = { };
+		layoutInfo.setLayouts = createInfo.descriptorSetLayouts;
+		layoutInfo.pushConstantRanges = createInfo.pushConstantRanges;
+
+		Ref<NullPipelineLayout> layout = NullPipelineLayout::CreateShared();
+		layout->Create(layoutInfo);
+
+		this->m_layout = layout.As<PipelineLayout>();
+	}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullPipeline>();
+	}
+};
+
+class NullDescriptorPool : public DescriptorPool {
+public:
+	using Ptr = Ref<NullDescriptorPool>;
+
+	void Create(const DescriptorPoolCreateInfo& createInfo) override {}
+	void Reset() override {}
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullDescriptorPool>();
+	}
+};
+
+class NullDescriptorSetLayout : public DescriptorSetLayout {
+public:
+	using Ptr = Ref<NullDescriptorSetLayout>;
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullDescriptorSetLayout>();
+	}
+};
+
+class NullDescriptorSet : public DescriptorSet {
+public:
+	using Ptr = Ref<NullDescriptorSet>;
+
+	void
+	Allocate(Ref<DescriptorPool> pool, Ref<DescriptorSetLayout> layout) override {
+		this->m_layout = layout;
+	}
+
+	void WriteBuffer(uint32_t nBinding, uint32_t nArrayElement, const DescriptorBufferInfo& bufferInfo) override {}
+	void WriteTexture(uint32_t nBinding, uint32_t nArrayElement, const DescriptorImageInfo& imageInfo) override {}
+
+	void WriteBuffers(
+		uint32_t nBinding,
+		uint32_t nFirstArrayElement,
+		const Vector<DescriptorBufferInfo>& bufferInfos,
+		EBufferType bufferType = EBufferType::UNIFORM_BUFFER
+	) override {}
+
+	void WriteTextures(
+		uint32_t nBinding,
+		uint32_t nFirstArrayElement,
+		const Vector<DescriptorImageInfo>& imageInfos
+	) override {}
+
+	void UpdateWrites() override {}
+
+	Ref<DescriptorSetLayout> GetLayout() const override { return this->m_layout; }
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullDescriptorSet>();
+	}
+
+private:
+	Ref<DescriptorSetLayout> m_layout;
+};
+
+class NullImGuiImpl : public ImGuiImpl {
+public:
+	using Ptr = Ref<NullImGuiImpl>;
+
+	void Create(const ImGuiImplCreateInfo& createInfo) override {}
+
+	void NewFrame() override {}
+	void Render(Ref<GraphicsContext> context) override {}
+
+	Ref<DescriptorSet>
+	AddTexture(Ref<Sampler> sampler, Ref<ImageView> imageView, EImageLayout imageLayout) override {
+		return NullDescriptorSet::CreateShared().As<DescriptorSet>();
+	}
+
+	void RemoveTexture(Ref<DescriptorSet> set) override {}
+
+	void Image(Ref<DescriptorSet> descriptorSet, ImVec2 imageSize) override {}
+	bool ImageButton(Ref<DescriptorSet> descriptorSet, const String& label, ImVec2 size) override { return false; }
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullImGuiImpl>();
+	}
+};
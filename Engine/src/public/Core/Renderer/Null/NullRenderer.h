@@ -0,0 +1,27 @@
+#pragma once
+#include "Core/Renderer/Renderer.h"
+
+class NullDevice;
+
+/**
+* Renderer for the null backend. Creates
+* devices that record instead of render
+*/
+class NullRenderer : public Renderer {
+public:
+	using Ptr = Ref<NullRenderer>;
+
+	static constexpr const char* CLASS_NAME = "NullRenderer";
+
+	NullRenderer() = default;
+	~NullRenderer() override = default;
+
+	void Create(GLFWwindow* pWindow) override;
+
+	Ref<Device> CreateDevice() override;
+
+	static Ptr
+	CreateShared() {
+		return CreateRef<NullRenderer>();
+	}
+};
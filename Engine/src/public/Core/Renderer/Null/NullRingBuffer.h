@@ -0,0 +1,36 @@
+#pragma once
+#include "Core/Renderer/GPURingBuffer.h"
+#include "Core/Containers.h"
+
+#include <algorithm>
+
+class NullDevice;
+
+class NullRingBuffer : public GPURingBuffer {
+public:
+	using Ptr = Ref<NullRingBuffer>;
+
+	explicit NullRingBuffer(Ref<NullDevice> device);
+	~NullRingBuffer() override = default;
+
+	void Create(const RingBufferCreateInfo& createInfo) override;
+	void* Allocate(uint32_t nDataSize, uint32_t& outOffset) override;
+	uint32_t Align(uint32_t nValue, uint32_t nAlignment) override;
+	void Reset(uint32_t nImageIndex) override;
+
+	uint32_t GetOffset() const { return this->m_nOffset; }
+
+	uint64_t GetSize() const override { return this->m_nBufferSize; }
+
+	static Ptr
+	CreateShared(Ref<NullDevice> device) {
+		return CreateRef<NullRingBuffer>(device);
+	}
+
+private:
+	Ref<NullDevice> m_device;
+
+	uint32_t m_nOffset = 0;
+
+	void* m_pMap = nullptr;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "Core/Renderer/Swapchain.h"
+
+class NullDevice;
+
+/**
+* Null swap chain
+*
+* Hands out null images round-robin.
+* Acquire and present never block
+*/
+class NullSwapchain : public Swapchain {
+public:
+	using Ptr = Ref<NullSwapchain>;
+
+	static constexpr GPUFormat COLOR_FORMAT = GPUFormat::BGRA8_UNORM;
+	static constexpr GPUFormat DEPTH_FORMAT = GPUFormat::D32_FLOAT;
+
+	explicit NullSwapchain(Ref<NullDevice> device);
+	~NullSwapchain() override = default;
+
+	void Create(const SwapchainCreateInfo& createInfo) override;
+
+	uint32_t AcquireNextImage(
+		uint64_t nTimeout,
+		Ref<Semaphore> signalSemaphore,
+		Ref<Fence> signalFence
+	) override;
+
+	bool Present(
+		uint32_t nImageIndex,
+		const Vector<Ref<Semaphore>>& pWaitSemaphores = {}
+	) override;
+
+	void Rebuild(uint32_t nNewWidth, uint32_t nNewHeight) override;
+
+	uint32_t GetImageCount() const override { return this->m_nImageCount; }
+
+	Ref<GPUTexture> GetImage(uint32_t nIndex) const override { return this->m_images[nIndex]; }
+	Ref<ImageView> GetImageView(uint32_t nIndex) const override { return this->m_imageViews[nIndex]; }
+
+	Ref<GPUTexture> GetDepthImage() const override { return this->m_depthImage; }
+	Ref<ImageView> GetDepthImageView() const override { return this->m_depthImageView; }
+	GPUFormat GetDepthFormat() const override { return DEPTH_FORMAT; }
+
+	Extent2D GetExtent() const override { return this->m_extent; }
+
+	bool NeedsRebuild() const override { return false; }
+
+	uint64_t GetPresentCount() const { return this->m_nPresentCount; }
+
+	static Ptr
+	CreateShared(Ref<NullDevice> device) {
+		return CreateRef<NullSwapchain>(device);
+	}
+
+private:
+	Ref<NullDevice> m_device;
+
+	Vector<Ref<GPUTexture>> m_images;
+	Vector<Ref<ImageView>> m_imageViews;
+
+	Ref<GPUTexture> m_depthImage;
+	Ref<ImageView> m_depthImageView;
+
+	Extent2D m_extent = { };
+	uint32_t m_nImageCount = 0;
+	uint32_t m_nNextImage = 0;
+	uint64_t m_nPresentCount = 0;
+
+	void CreateImages();
+	Ref<ImageView> CreateView(Ref<GPUTexture> image, GPUFormat format, EImageAspect aspect);
+};
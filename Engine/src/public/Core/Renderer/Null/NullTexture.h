@@ -0,0 +1,33 @@
+#pragma once
+#include "Core/Renderer/GPUTexture.h"
+
+class NullDevice;
+
+class NullTexture : public GPUTexture {
+public:
+	using Ptr = Ref<NullTexture>;
+
+	explicit NullTexture(Ref<NullDevice> device);
+	~NullTexture() override = default;
+
+	void Create(const TextureCreateInfo& createInfo, const String& debugName = "GPUTexture") override;
+
+	uint32_t GetSize() const override { return this->m_nSize; }
+
+	void Reset() override;
+
+	const Extent3D& GetExtent() const { return this->m_extent; }
+	GPUFormat GetFormat() const { return this->m_format; }
+
+	static Ptr
+	CreateShared(Ref<NullDevice> device) {
+		return CreateRef<NullTexture>(device);
+	}
+
+private:
+	Ref<NullDevice> m_device;
+
+	Extent3D m_extent = { };
+	GPUFormat m_format = GPUFormat::UNDEFINED;
+	uint32_t m_nSize = 0;
+};
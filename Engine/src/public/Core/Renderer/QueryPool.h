@@ -0,0 +1,45 @@
+#pragma once
+#include "Core/Containers.h"
+
+enum class EQueryType {
+	TIMESTAMP
+};
+
+struct QueryPoolCreateInfo {
+	EQueryType type = EQueryType::TIMESTAMP;
+	uint32_t nQueryCount = 0;
+};
+
+class QueryPool {
+public:
+	static constexpr const char* CLASS_NAME = "QueryPool";
+
+	using Ptr = Ref<QueryPool>;
+
+	virtual ~QueryPool() = default;
+
+	/**
+	* Creates a query pool
+	* 
+	* @param createInfo Query pool create info
+	*/
+	virtual void Create(const QueryPoolCreateInfo& createInfo) = 0;
+
+	/**
+	* Reads query results without waiting for the GPU
+	* 
+	* @param nFirstQuery First query
+	* @param nQueryCount Query count
+	* @param results Output results, one per query
+	* 
+	* @returns True if every query in the range was available
+	*/
+	virtual bool GetResults(uint32_t nFirstQuery, uint32_t nQueryCount, Vector<uint64_t>& results) = 0;
+
+	/**
+	* Gets the query count
+	* 
+	* @returns Query count
+	*/
+	virtual uint32_t GetQueryCount() const = 0;
+};
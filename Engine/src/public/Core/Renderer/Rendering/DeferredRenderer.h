@@ -32,11 +32,14 @@ public:
     void Resize(uint32_t nWidth, uint32_t nHeight, bool bImGuiCall = false);
     void Invalidate();
 
+    bool IsHeadless() const { return this->m_bHeadless; }
+
     void Render(
         Ref<GraphicsContext> context,
         Ref<Swapchain> swapchain,
         const CollectedDrawData& drawData,
-        uint32_t nImgIdx
+        uint32_t nFrameIndex,
+        uint32_t nImageIndex
     );
 
     CullingPass& GetCullingPass() { return this->m_cullingPass; }
@@ -45,12 +48,17 @@ public:
     SkyboxPass& GetSkyboxPass() { return this->m_skyboxPass; }
 
     const Map<String, UploadedMesh>& GetUploadedMeshes() const { return this->m_uploadedMeshes; }
+    uint32_t GetMeshCacheGeneration() const { return this->m_nMeshCacheGeneration; }
 
     void UploadMesh(const MeshData& meshData);
     void UnloadMesh(const String& name);
     void FinalizeMeshUploads() { this->m_meshUploader.FinalizeUploads(); }
     MegaBuffer& GetMegaBuffer() { return this->m_megaBuffer; }
 
+    const Vector<GPUNodeTiming>& GetGPUTimings() const { return this->m_graph.GetGPUTimings(); }
+    float GetGPUFrameTime() const { return this->m_graph.GetGPUFrameTime(); }
+    bool HasNewGPUTimings() const { return this->m_graph.HasNewGPUTimings(); }
+
     void 
     SetOnSceneSaveCallback(ImGuiPass::OnSceneSaveCallback callback) {
         this->m_imguiPass.SetOnSceneSaveCallback(callback);
@@ -93,6 +101,9 @@ private:
     MegaBuffer m_megaBuffer;
     MeshUploader m_meshUploader;
     Map<String, UploadedMesh> m_uploadedMeshes;
+    uint32_t m_nMeshCacheGeneration = 0; // Bumped on every upload and unload
+
+    uint64_t m_nAppliedSceneSequence = 0; // Last CollectedDrawData::nSequence sent to the GPU
 
     Ref<DescriptorPool> m_scenePool;
     Ref<DescriptorSetLayout> m_sceneSetLayout;
@@ -112,6 +123,7 @@ private:
     glm::vec3 m_sunDirection = glm::vec3(1.f);
 
     GLFWwindow* m_pWindow = nullptr;
+    bool m_bHeadless = false;
 
     bool m_bIBLGenerated = false;
 
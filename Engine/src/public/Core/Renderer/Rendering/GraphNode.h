@@ -9,6 +9,12 @@
 
 class RenderGraphContext;
 
+/* GPU time of a graph node, read back a few frames late */
+struct GPUNodeTiming {
+	const char* name = nullptr;
+	float fMilliseconds = 0.f;
+};
+
 struct GraphNode {
 	const char* name = nullptr;
 
@@ -1,8 +1,24 @@
 #pragma once
 #include "Core/Renderer/Rendering/Passes/BasePass.h"
 
+/* One culled view (camera or shadow cascade) */
+struct CullViewInfo {
+	uint32_t nViewIdx = 0; // < CullingPass::MAX_CULL_VIEWS
+	uint32_t nBatchCount = 0; // Visible list length, or slots to walk
+	bool bUseVisibleList = false;
+
+	uint32_t nFrustumOffset = 0;
+	uint32_t nFrustumAlignment = 0;
+
+	/* Outputs bound to the set, barriered for the indirect draw */
+	Ref<GPUBuffer> indirectBuffer;
+	Ref<GPUBuffer> countBuffer;
+};
+
 class CullingPass : public BasePass {
 public:
+	static constexpr uint32_t MAX_CULL_VIEWS = 8;
+
 	void Init(Ref<Device> device) override;
 	void Init(Ref<Device> device, uint32_t nFramesInFlight);
 	void SetupNode(RenderGraphBuilder& builder) override;
@@ -12,49 +28,99 @@ public:
 		uint32_t nFrameIndex = 0
 	) override;
 
-	Ref<GPURingBuffer> GetInstanceBuffer() { return this->m_instanceBuffer; }
-	Ref<GPURingBuffer> GetMaterialBuffer() { return this->m_materialBuffer; }
+	/* Persistent scene tables, indexed by the collector's slots */
+	Ref<GPUBuffer> GetInstanceTable() { return this->m_instanceTable; }
+	Ref<GPUBuffer> GetMaterialTable() { return this->m_materialTable; }
+	Ref<GPUBuffer> GetBatchTable() { return this->m_batchTable; }
+	Ref<GPUBuffer> GetWorldTable() { return this->m_worldTable; }
+	Ref<GPUBuffer> GetGroupTable() { return this->m_groupTable; }
+
+	/* Per view draw group outputs */
+	Ref<GPUBuffer> GetGroupCountBuffer() { return this->m_groupCountBuffer; }
+	Ref<GPURingBuffer> GetGroupInstanceBuffer() { return this->m_groupInstanceBuffer; }
+
+	Ref<GPURingBuffer> GetTransformUpdateBuffer() { return this->m_transformUpdateBuffer; }
+	Ref<GPURingBuffer> GetInstanceUpdateBuffer() { return this->m_instanceUpdateBuffer; }
+	Ref<GPURingBuffer> GetGroupUpdateBuffer() { return this->m_groupUpdateBuffer; }
+	Ref<GPURingBuffer> GetVisibleBuffer() { return this->m_visibleBuffer; }
 	Ref<GPURingBuffer> GetIndirectBuffer() { return this->m_indirectBuffer; }
-	Ref<GPURingBuffer> GetBatchBuffer() { return this->m_batchBuffer; }
-	Ref<GPURingBuffer> GetWVPBuffer() { return this->m_wvpBuffer; }
 	Ref<GPUBuffer> GetCountBuffer() { return this->m_countBuffer; }
 
+	void 
+	SetUpdateCounts(uint32_t nTransformUpdates, uint32_t nInstanceUpdates, uint32_t nGroupUpdates) {
+		this->m_nTransformUpdates = nTransformUpdates;
+		this->m_nInstanceUpdates = nInstanceUpdates;
+		this->m_nGroupUpdates = nGroupUpdates;
+	}
+
 	void SetTotalBatches(uint32_t nBatchCount) { this->m_nTotalBatches = nBatchCount; }
 	uint32_t GetTotalBatches() const { return this->m_nTotalBatches; }
 
+	void SetBatchSlotCount(uint32_t nSlotCount) { this->m_nBatchSlotCount = nSlotCount; }
+	uint32_t GetBatchSlotCount() const { return this->m_nBatchSlotCount; }
+
 	void SetTotalBlocks(uint32_t nBlockCount) { this->m_nBlockCount = nBlockCount; }
 	uint32_t GetBlockCount() const { return this->m_nBlockCount; }
 
-	void SetBatchesPerBlock(uint32_t nBatchesPerBlock) { this->m_nMaxBatchesPerBlock = nBatchesPerBlock; }
-	uint32_t GetMaxBatchesPerBlock() const { return this->m_nMaxBatchesPerBlock; }
+	void SetGroupSlotCount(uint32_t nSlotCount) { this->m_nGroupSlotCount = nSlotCount; }
+	uint32_t GetGroupSlotCount() const { return this->m_nGroupSlotCount; }
 
-	Ref<Pipeline> GetPipeline() const { return this->m_computePipeline; }
-	Ref<PipelineLayout> GetPipelineLayout() const { return this->m_pipelineLayout; }
+	void SetDrawsPerBlock(uint32_t nDrawsPerBlock) { this->m_nMaxDrawsPerBlock = nDrawsPerBlock; }
+	uint32_t GetMaxDrawsPerBlock() const { return this->m_nMaxDrawsPerBlock; }
 
 	Ref<DescriptorSetLayout> GetSetLayout() const { return this->m_setLayout; }
 
+	void CullView(Ref<GraphicsContext> context, Ref<DescriptorSet> set, const CullViewInfo& info);
+
 	void SetViewProj(const glm::mat4& viewProj) { this->m_viewProj = viewProj; }
 private:
 	Ref<Device> m_device;
 
+	/* Persistent tables */
+	Ref<GPUBuffer> m_instanceTable;
+	Ref<GPUBuffer> m_materialTable;
+	Ref<GPUBuffer> m_batchTable;
+	Ref<GPUBuffer> m_worldTable;
+	Ref<GPUBuffer> m_groupTable;
+
 	/* Ring buffers */
-	Ref<GPURingBuffer> m_instanceBuffer;
-	Ref<GPURingBuffer> m_materialBuffer;
+	Ref<GPURingBuffer> m_transformUpdateBuffer;
+	Ref<GPURingBuffer> m_instanceUpdateBuffer;
+	Ref<GPURingBuffer> m_groupUpdateBuffer;
+	Ref<GPURingBuffer> m_visibleBuffer;
 	Ref<GPURingBuffer> m_indirectBuffer;
-	Ref<GPURingBuffer> m_batchBuffer;
-	Ref<GPURingBuffer> m_wvpBuffer;
 
 	Ref<GPURingBuffer> m_frustumBuffer;
 
 	/* Count buffer */
 	Ref<GPUBuffer> m_countBuffer;
 
+	/* Visible instances per draw group and view */
+	Ref<GPUBuffer> m_groupCountBuffer;
+	Ref<GPURingBuffer> m_groupInstanceBuffer;
+
 	Vector<Ref<DescriptorSet>> m_cullingSets;
 	Ref<Pipeline> m_computePipeline;
 
+	/* Turns each view's group counts into instanced draws */
+	Ref<Pipeline> m_drawGroupsPipeline;
+	Ref<PipelineLayout> m_drawGroupsPipelineLayout;
+
+	/* Scatters the frame's updates into the persistent tables */
+	Ref<DescriptorSetLayout> m_updateSetLayout;
+	Vector<Ref<DescriptorSet>> m_updateSets;
+	Ref<Pipeline> m_updatePipeline;
+	Ref<PipelineLayout> m_updatePipelineLayout;
+
+	uint32_t m_nTransformUpdates = 0;
+	uint32_t m_nInstanceUpdates = 0;
+	uint32_t m_nGroupUpdates = 0;
+
 	uint32_t m_nTotalBatches = 0;
+	uint32_t m_nBatchSlotCount = 0;
+	uint32_t m_nGroupSlotCount = 0;
 	uint32_t m_nBlockCount = 0;
-	uint32_t m_nMaxBatchesPerBlock = 0;
+	uint32_t m_nMaxDrawsPerBlock = 0;
 
 	Ref<DescriptorSetLayout> m_setLayout;
 
@@ -70,5 +136,7 @@ private:
 	void CreateResources();
 	void CreateDescriptors();
 
+	void ApplySceneUpdates(Ref<GraphicsContext> context, uint32_t nFrameIndex);
+
 	void ExtractFrustumPlanes(const glm::mat4& viewProj, glm::vec4 planes[6]);
 };
\ No newline at end of file
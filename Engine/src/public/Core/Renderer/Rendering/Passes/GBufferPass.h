@@ -38,9 +38,8 @@ public:
 		Ref<GPURingBuffer> indirectBuffer,
 		uint32_t nIndirectOffset,
 		uint32_t nTotalBatches,
-		uint32_t nMaxBatchesPerBlock,
-		uint32_t nWvpAlignment,
-		uint32_t nMaterialAlignment
+		uint32_t nMaxDrawsPerBlock,
+		const glm::mat4& viewProj
 	);
 
 	Ref<DescriptorSet> GetReadDescriptorSet() const { return this->m_gbuffer.GetReadDescriptorSet(); }
@@ -65,9 +64,8 @@ private:
 
 	uint32_t m_nIndirectOffset = 0;
 	uint32_t m_nTotalBatches = 0;
-	uint32_t m_nMaxBatchesPerBlock = 0;
-	uint32_t m_nWvpAlignment = 0;
-	uint32_t m_nMaterialAlignment = 0;
+	uint32_t m_nMaxDrawsPerBlock = 0;
+	glm::mat4 m_viewProj = glm::mat4(1.f);
 
 	void CreatePipeline();
 };
\ No newline at end of file
@@ -40,6 +40,18 @@ public:
 	void SetOutput(TextureHandle output);
 	void SetWindow(GLFWwindow* pWindow);
 
+	/**
+	* Sets the GPU timings shown by the overlay
+	* 
+	* @param timings Node timings
+	* @param fFrameTime GPU frame time in milliseconds
+	*/
+	void 
+	SetGPUTimings(const Vector<GPUNodeTiming>& timings, float fFrameTime) {
+		this->m_gpuTimings = timings;
+		this->m_fGPUFrameTime = fFrameTime;
+	}
+
 	void 
 	SetOnSceneSaveCallback(OnSceneSaveCallback callback) {
 		this->m_sceneSaveCallback = callback;
@@ -52,7 +64,7 @@ public:
 
 private:
 	void ShowAssetBrowser();
-	void DrawHierarchyNode(Hierarchy& hierarchy, const Ref<Hierarchy::HierarchyNode>& node);
+	void DrawHierarchyNode(const Hierarchy& hierarchy, uint32_t nNode, uint32_t& nDeleteNode);
 
 	void CreateResources();
 	void SetupTheme();
@@ -77,6 +89,9 @@ private:
 
 	GLFWwindow* m_pWindow = nullptr;
 
+	Vector<GPUNodeTiming> m_gpuTimings;
+	float m_fGPUFrameTime = 0.f;
+
 	OnSceneSaveCallback m_sceneSaveCallback;
 	OnDropToViewport m_dropCallback;
 };
\ No newline at end of file
@@ -9,6 +9,8 @@
 static constexpr uint32_t CSM_CASCADE_COUNT = 4;
 static constexpr uint32_t CSM_SHADOW_MAP_SIZE = 2048;
 
+static_assert(1 + CSM_CASCADE_COUNT <= CullingPass::MAX_CULL_VIEWS, "The camera and every cascade need a culling view");
+
 class ShadowPass : public BasePass {
 public:
 	struct CascadeData {
@@ -35,7 +37,7 @@ public:
 
 	/**
 	* Sets the reference to the main CullingPass
-	* for reusing its batch/instance/WVP buffers
+	* for reusing its batch/instance/world tables
 	* and the culling compute pipeline
 	* 
 	* @param pCullingPass Pointer to culling pass
@@ -26,6 +26,15 @@ public:
 	*/
 	void SetInput(TextureHandle input);
 
+	/**
+	* Renders straight into an existing texture
+	* instead of a transient one (headless back buffer)
+	* 
+	* @param output Output texture handle
+	* @param finalLayout Layout after the pass
+	*/
+	void SetOutput(TextureHandle output, EImageLayout finalLayout = EImageLayout::TRANSFER_SRC);
+
 	/**
 	* Get tonemap pass output
 	* 
@@ -50,6 +59,9 @@ private:
 	TextureHandle m_input;
 	TextureHandle m_output;
 
+	TextureHandle m_externalOutput;
+	EImageLayout m_externalFinalLayout = EImageLayout::TRANSFER_SRC;
+
 	Ref<DescriptorSetLayout> m_setLayout;
 	Ref<DescriptorPool> m_pool;
 	Vector<Ref<DescriptorSet>> m_sets;
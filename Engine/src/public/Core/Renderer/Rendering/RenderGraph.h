@@ -11,6 +11,8 @@
 
 class RenderGraph {
 public:
+	static constexpr uint32_t MAX_TIMED_NODES = 32;
+
 	void Setup(Ref<Device> device, uint32_t nFramesInFlight);
 
 	TextureHandle ImportBackbuffer(Ref<GPUTexture> img, Ref<ImageView> view);
@@ -56,10 +58,46 @@ public:
 	void Invalidate();
 
 	TransientResourcePool& GetPool() { return this->m_pool; }
+
+	/**
+	* Gets the GPU time of every node of the last
+	* frame whose timestamps were available
+	* 
+	* @returns Node timings in execution order
+	*/
+	const Vector<GPUNodeTiming>& GetGPUTimings() const { return this->m_gpuTimings; }
+
+	/**
+	* Gets the GPU time from the first node start
+	* to the last node end of that same frame
+	* 
+	* @returns GPU frame time in milliseconds
+	*/
+	float GetGPUFrameTime() const { return this->m_fGPUFrameTime; }
+
+	/**
+	* Checks if the last Execute() read new
+	* timestamps back, the GPU timings are
+	* from an older frame otherwise
+	* 
+	* @returns True if the timings are new
+	*/
+	bool HasNewGPUTimings() const { return this->m_bNewGPUTimings; }
+
+	bool HasGPUTimings() const { return this->m_fTimestampPeriod > 0.f; }
 private:
 	void CreateRenderPasses();
 	void CreateFramebuffers();
 
+	/* Timestamps written by one frame in flight */
+	struct TimestampFrame {
+		Ref<QueryPool> queryPool;
+		Vector<const char*> nodeNames; // Nodes timed when recorded, empty until then
+	};
+
+	void CreateTimestampQueries();
+	void ReadTimestamps(TimestampFrame& frame);
+
 	Ref<Device> m_device;
 	TransientResourcePool m_pool;
 	Vector<GraphNode> m_nodes;
@@ -70,4 +108,10 @@ private:
 
 	Map<String, Ref<RenderPass>> m_cachedRenderPasses;
 	Map<String, Vector<Ref<Framebuffer>>> m_cachedFramebuffers;
+
+	float m_fTimestampPeriod = 0.f; // ns per tick, 0 disables GPU timings
+	Vector<TimestampFrame> m_timestampFrames;
+	Vector<GPUNodeTiming> m_gpuTimings;
+	float m_fGPUFrameTime = 0.f;
+	bool m_bNewGPUTimings = false;
 };
\ No newline at end of file
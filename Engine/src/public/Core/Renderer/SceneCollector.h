@@ -1,19 +1,162 @@
 #pragma once
+#include <atomic>
+
 #include "Core/Scene/Scene.h"
 #include "Core/Renderer/MeshUploader.h"
+#include "Core/Renderer/DrawSortKey.h"
 
 #include "Utils.h"
 
+/**
+* Collects the draw data of a scene
+*
+* Every mesh object owns a transform slot and one
+* instance slot per submesh in the renderer's
+* persistent tables. The slots stay put while the
+* object lives, so a frame only carries the slots
+* that changed since the renderer last applied an
+* update, plus the list of visible instances.
+* Instances of the same uploaded submesh share a
+* draw group, drawn with one instanced command.
+* Groups are ranked inside their block by a sort
+* key, the commands are submitted in that order
+*/
 class SceneCollector {
 public:
-	void 
-	SetUploadedMeshes(const Map<String, UploadedMesh>* cache) {
+	void
+	SetUploadedMeshes(const Map<String, UploadedMesh>* cache, uint32_t nGeneration) {
 		this->m_uploadedMeshes = cache;
+		this->m_nUploadGeneration = nGeneration;
 	}
 
-	CollectedDrawData Collect(Scene* scene);
+	void Collect(Scene* scene, CollectedDrawData& outData);
+
+	/**
+	* Marks the updates of a recorded frame as applied.
+	* Safe to call while collecting
+	*
+	* @param nSequence CollectedDrawData::nSequence
+	*/
+	void
+	Acknowledge(uint64_t nSequence) {
+		if (nSequence > this->m_nAppliedSequence.load(std::memory_order_relaxed)) {
+			this->m_nAppliedSequence.store(nSequence, std::memory_order_release);
+		}
+	}
 private:
+	static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+	struct InstanceSlot {
+		uint32_t nSlot = INVALID_SLOT;
+		uint32_t nSubMeshIdx = 0;
+	};
+
+	struct ObjectRecord {
+		bool bTracked = false;
+		uint32_t nGeneration = 0;
+		uint32_t nUploadGeneration = 0;
+		uint64_t nSweep = 0;
+
+		const UploadedMesh* pUpload = nullptr; // Null while the mesh isn't uploaded
+		uint32_t nUploadId = 0;
+		uint32_t nTransformSlot = INVALID_SLOT;
+		Vector<InstanceSlot> instances;
+	};
+
+	struct DrawGroupRecord {
+		uint64_t nKey = 0;
+		uint32_t nLiveCount = 0; // 0 = free slot
+		DrawGroup group = { };
+
+		uint64_t nSortKey = 0; // Last one ranked
+		uint64_t nMaterialId = 0;
+		uint32_t nPipeline = 0;
+	};
+
+	/* Slots changed per sequence, oldest first. Dropped once applied */
+	struct ChangeLog {
+		struct SlotChange {
+			uint64_t nSequence;
+			uint32_t nSlot;
+		};
+
+		Vector<SlotChange> changes;
+		Vector<uint64_t> emitted; // Slot -> sequence it was last emitted in
+
+		void Mark(uint64_t nSequence, uint32_t nSlot);
+		void DropApplied(uint64_t nApplied);
+		void Clear();
+
+		/**
+		* Calls fn once per pending slot
+		*
+		* @param nSequence Sequence being emitted
+		* @param fn Callback taking the slot
+		*/
+		template <typename Fn>
+		void
+		ForEachPending(uint64_t nSequence, Fn&& fn) {
+			for (const SlotChange& change : this->changes) {
+				if (this->emitted[change.nSlot] == nSequence) continue;
+				this->emitted[change.nSlot] = nSequence;
+
+				fn(change.nSlot);
+			}
+		}
+	};
+
 	const Map<String, UploadedMesh>* m_uploadedMeshes = nullptr;
+	uint32_t m_nUploadGeneration = 0;
+
+	Scene* m_pScene = nullptr;
+
+	Vector<ObjectRecord> m_records; // Entity index -> record
+	uint64_t m_nSweep = 0;
+
+	/* CPU mirrors of the GPU tables */
+	Vector<glm::mat4> m_worlds;
+	Vector<InstanceUpdate> m_instances;
+	Vector<DrawGroupRecord> m_groups;
+
+	Vector<uint32_t> m_freeTransformSlots;
+	Vector<uint32_t> m_freeInstanceSlots;
+	Vector<uint32_t> m_freeGroupSlots;
+	uint32_t m_nTransformSlotCount = 0;
+	uint32_t m_nInstanceSlotCount = 0;
+
+	HashMap<uint64_t, uint32_t> m_groupSlots; // Upload ID and submesh -> group slot
+	bool m_bGroupLayoutDirty = false; // Live counts changed, instance bases are stale
+	bool m_bGroupOrderDirty = false; // Groups came or went, draw orders are stale
+
+	Vector<float> m_groupDepths; // Nearest visible instance per group, this frame
+	Vector<DrawSortItem> m_sortItems;
+	Vector<DrawSortItem> m_sortScratch;
+
+	Vector<uint32_t> m_blockGroupCounts; // Live draw groups per mega-buffer block
+
+	uint64_t m_nSequence = 0;
+	std::atomic<uint64_t> m_nAppliedSequence = 0;
+
+	ChangeLog m_transformLog;
+	ChangeLog m_instanceLog;
+	ChangeLog m_groupLog;
+
+	Vector<EntityID> m_visibleEntities; // BVH frustum query, reused every frame
+
+	void Reset(Scene* scene);
+	void SyncObjects(Scene* scene);
+	void SyncTransforms(Scene* scene);
+	void LayoutGroups();
+	void CollectVisible(Scene* scene, const Frustum& frustum, const glm::mat4& view, CollectedDrawData& outData);
+	void SortGroups();
+	void EmitUpdates(CollectedDrawData& outData);
+
+	void TrackObject(ObjectRecord& record, const UploadedMesh* pUpload, const glm::mat4& world);
+	void ReleaseObject(ObjectRecord& record);
+
+	uint32_t AcquireGroup(uint32_t nUploadId, uint32_t nSubMeshIdx, const UploadedSubMesh& subMesh);
+	void ReleaseGroup(uint32_t nGroup);
 
-	void CollectGameObjects(Ref<Hierarchy::HierarchyNode> node, Map<String, GameObject*>& outObjects);
+	uint32_t AllocateTransformSlot();
+	uint32_t AllocateInstanceSlot();
 };
\ No newline at end of file
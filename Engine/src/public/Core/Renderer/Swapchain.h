@@ -22,12 +22,16 @@ struct SwapchainCreateInfo {
 	uint32_t width = 0;
 	uint32_t height = 0;
 	uint32_t nImageCount = 3; // Default triple buffering
+	EPresentMode presentMode = EPresentMode::MAILBOX; // FIFO if not supported
 	bool bEnableDepthStencil = true;
 
 	/* Swapchain reconstruct (resize) */
 	void* pOldSwapchain = nullptr;
 
 	GLFWwindow* pWindow = nullptr;
+
+	/* Render into an offscreen image chain instead of a window surface */
+	bool bOffscreen = false;
 };
 
 class Swapchain {
@@ -14,12 +14,14 @@
 #include "Core/Renderer/Vulkan/VulkanGraphicsContext.h"
 #include "Core/Renderer/Vulkan/VulkanPipelineLayout.h"
 #include "Core/Renderer/Vulkan/VulkanSwapchain.h"
+#include "Core/Renderer/Vulkan/VulkanOffscreenSwapchain.h"
 #include "Core/Renderer/Vulkan/VulkanFramebuffer.h"
 #include "Core/Renderer/Vulkan/VulkanDescriptorSet.h"
 #include "Core/Renderer/Vulkan/VulkanDescriptorSetLayout.h"
 #include "Core/Renderer/Vulkan/VulkanSampler.h"
 #include "Core/Renderer/Vulkan/VulkanSemaphore.h"
 #include "Core/Renderer/Vulkan/VulkanFence.h"
+#include "Core/Renderer/Vulkan/VulkanQueryPool.h"
 #include "Core/Renderer/Vulkan/VulkanRingBuffer.h"
 #include "Core/Renderer/Vulkan/VulkanImGuiImpl.h"
 
@@ -99,6 +101,8 @@ public:
 
 	Ref<Semaphore> CreateSemaphore() override;
 	Ref<Fence> CreateFence(const FenceCreateInfo& createInfo) override;
+	Ref<QueryPool> CreateQueryPool(const QueryPoolCreateInfo& createInfo) override;
+	float GetTimestampPeriod() override;
 	Ref<ImGuiImpl> CreateImGui(const ImGuiImplCreateInfo& createInfo) override;
 
 	Ref<TextureUploader> GetTextureUploader() override;
@@ -88,6 +88,9 @@ public:
 
 	void GlobalBarrier() override;
 
+	void ResetQueries(Ref<QueryPool> queryPool, uint32_t nFirstQuery, uint32_t nQueryCount) override;
+	void WriteTimestamp(Ref<QueryPool> queryPool, uint32_t nQuery, EPipelineStage stage) override;
+
 	static Ptr
 	CreateShared(Ref<VulkanCommandBuffer> commandBuffer) {
 		return CreateRef<VulkanGraphicsContext>(commandBuffer);
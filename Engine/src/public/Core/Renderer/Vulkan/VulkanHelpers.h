@@ -9,6 +9,7 @@
 #include "Core/Renderer/GPUBuffer.h"
 #include "Core/Renderer/ImageView.h"
 #include "Core/Renderer/Device.h"
+#include "Core/Renderer/Swapchain.h"
 
 namespace VulkanHelpers {
 	/** 
@@ -567,4 +568,15 @@ namespace VulkanHelpers {
 			default: return VK_INDEX_TYPE_UINT16;
 		}
 	}
+
+	inline VkPresentModeKHR
+	ConvertPresentMode(EPresentMode presentMode) {
+		switch (presentMode) {
+			case EPresentMode::IMMEDIATE: return VK_PRESENT_MODE_IMMEDIATE_KHR;
+			case EPresentMode::FIFO: return VK_PRESENT_MODE_FIFO_KHR;
+			case EPresentMode::FIFO_RELAXED: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+			case EPresentMode::MAILBOX: return VK_PRESENT_MODE_MAILBOX_KHR;
+			default: return VK_PRESENT_MODE_FIFO_KHR;
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "Core/Renderer/Swapchain.h"
+
+#include "Core/Renderer/Vulkan/VulkanImageView.h"
+#include "Core/Renderer/Vulkan/VulkanHelpers.h"
+#include "Core/Renderer/Vulkan/VulkanSemaphore.h"
+#include "Core/Renderer/Vulkan/VulkanFence.h"
+
+class VulkanDevice;
+
+/**
+* Offscreen image chain
+*
+* Stands in for a swap chain when there is no
+* window. Images are regular device-local textures
+* handed out round-robin, present is a no-op that
+* only consumes the render finished semaphores
+*/
+class VulkanOffscreenSwapchain : public Swapchain {
+public:
+	using Ptr = Ref<VulkanOffscreenSwapchain>;
+
+	static constexpr GPUFormat COLOR_FORMAT = GPUFormat::BGRA8_UNORM;
+
+	explicit VulkanOffscreenSwapchain(Ref<VulkanDevice> device);
+	~VulkanOffscreenSwapchain() override = default;
+
+	void Create(const SwapchainCreateInfo& createInfo) override;
+
+	uint32_t AcquireNextImage(
+		uint64_t nTimeout,
+		Ref<Semaphore> signalSemaphore,
+		Ref<Fence> signalFence
+	) override;
+
+	bool Present(
+		uint32_t nImageIndex,
+		const Vector<Ref<Semaphore>>& pWaitSemaphores = {}
+	) override;
+
+	void Rebuild(uint32_t nNewWidth, uint32_t nNewHeight) override;
+
+	uint32_t GetImageCount() const override { return this->m_nImageCount; }
+
+	Ref<GPUTexture> GetImage(uint32_t nIndex) const override { return this->m_images[nIndex]; }
+	Ref<ImageView> GetImageView(uint32_t nIndex) const override { return this->m_imageViews[nIndex]; }
+
+	Ref<GPUTexture> GetDepthImage() const override { return this->m_depthImage; }
+	Ref<ImageView> GetDepthImageView() const override { return this->m_depthImageView; }
+	GPUFormat GetDepthFormat() const override { return this->m_depthFormat; }
+
+	Extent2D GetExtent() const override { return this->m_extent; }
+
+	bool NeedsRebuild() const override { return false; }
+
+	static Ptr
+	CreateShared(Ref<VulkanDevice> device) {
+		return CreateRef<VulkanOffscreenSwapchain>(device);
+	}
+
+private:
+	Ref<VulkanDevice> m_device;
+
+	Vector<Ref<GPUTexture>> m_images;
+	Vector<Ref<ImageView>> m_imageViews;
+
+	Ref<GPUTexture> m_depthImage;
+	Ref<ImageView> m_depthImageView;
+	GPUFormat m_depthFormat = GPUFormat::UNDEFINED;
+
+	Extent2D m_extent = { };
+	uint32_t m_nImageCount = 0;
+	uint32_t m_nNextImage = 0;
+
+	void CreateImages();
+	void CreateDepthResources();
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "Core/Renderer/QueryPool.h"
+
+#include "Core/Renderer/Vulkan/VulkanDevice.h"
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+class VulkanQueryPool : public QueryPool {
+public:
+	using Ptr = Ref<VulkanQueryPool>;
+
+	explicit VulkanQueryPool(Ref<VulkanDevice> device);
+	~VulkanQueryPool() override;
+
+	void Create(const QueryPoolCreateInfo& createInfo) override;
+
+	bool GetResults(uint32_t nFirstQuery, uint32_t nQueryCount, Vector<uint64_t>& results) override;
+
+	uint32_t GetQueryCount() const override { return this->m_nQueryCount; }
+
+	VkQueryPool GetVkQueryPool() const { return this->m_queryPool; }
+
+	static Ptr
+	CreateShared(Ref<VulkanDevice> device) {
+		return CreateRef<VulkanQueryPool>(device);
+	}
+
+private:
+	Ref<VulkanDevice> m_device;
+
+	VkQueryPool m_queryPool;
+	uint32_t m_nQueryCount;
+};
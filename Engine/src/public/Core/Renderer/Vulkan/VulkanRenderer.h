@@ -65,6 +65,7 @@ private:
 
 	bool CheckValidationLayersSupport();
 	Vector<const char*> GetRequiredExtensions();
+	Vector<const char*> GetDeviceExtensions() const;
 
 	void PopulateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& messengerInfo);
 
@@ -82,7 +82,7 @@ static constexpr AssetVersion MESH_VERSION(1, 0, 0);
 static constexpr AssetVersion TEXTURE_VERSION(1, 0, 0);
 static constexpr AssetVersion MATERIAL_VERSION(1, 0, 0);
 static constexpr AssetVersion GAMEOBJECT_VERSION(1, 0, 0);
-static constexpr AssetVersion SCENE_VERSION(1, 0, 0);
+static constexpr AssetVersion SCENE_VERSION(1, 2, 0); // 1.1: World partition cell table, 1.2: Static objects and batches
 
 inline static HashMap<EAssetType, AssetVersion> s_assetVersions = {
 	{ EAssetType::MESH, MESH_VERSION },
@@ -115,6 +115,7 @@ public:
 	AssetHandle RegisterAsset(const String& path, EAssetType type);
 
 	const AssetVariant& GetAsset(const AssetHandle& handle);
+	void UnloadAsset(const AssetHandle& handle);
 
 	bool ImportAsset(const String& path, const String& projectAssets);
 
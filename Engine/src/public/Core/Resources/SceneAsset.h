@@ -1,13 +1,52 @@
 #pragma once
 #include "Core/Containers.h"
 #include "Core/Resources/GameObjectAsset.h"
+#include "Math/AABB.h"
 
 struct SceneAssetHeader {
 	uint32_t nObjectCount = 0;
 	Name displayName;
 };
 
+/* 
+	World partition cell, written after the 
+	scene objects. Its objects live in a 
+	separate scene asset streamed at runtime
+*/
+struct SceneCellAsset {
+	int32_t nX = 0; // Grid coordinates
+	int32_t nZ = 0;
+	AABB bounds; // Cell square, object heights on Y
+	uint32_t nObjectCount = 0;
+	uint64_t nByteSize = 0; // Geometry payload estimate, for the streaming budget
+	Path path; // Cell asset file, relative to the scene file
+
+	AssetHandle handle; // Resolved when the scene is read
+};
+
+/*
+	Baked static geometry, written after the cells.
+	The scene object at nObjectIndex draws a mesh
+	asset holding the pre-transformed submeshes of
+	the static objects it replaced, merged by material
+*/
+struct SceneStaticBatchAsset {
+	AABB bounds; // World space
+	uint32_t nSourceCount = 0; // Static objects merged into it
+	uint32_t nObjectIndex = 0; // Into SceneAsset::objects
+	Path path; // Batch mesh file, relative to the scene file
+
+	AssetHandle handle; // Resolved when the scene is read
+};
+
 struct SceneAsset {
 	SceneAssetHeader header;
-	Vector<GameObjectAsset> objects;
-};
\ No newline at end of file
+	Vector<GameObjectAsset> objects; // Always loaded
+	Vector<SceneCellAsset> cells; // Empty unless the scene is partitioned
+
+	Vector<uint32_t> staticObjects; // Indices of the objects flagged static
+	Vector<SceneStaticBatchAsset> staticBatches; // Empty unless the scene is baked
+
+	bool IsPartitioned() const { return !this->cells.empty(); }
+	bool IsBaked() const { return !this->staticBatches.empty(); }
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <functional>
+
+#include "Core/Containers.h"
+
+class GameObject;
+
+/**
+* Scene hierarchy
+*
+* Nodes live in one flat array kept in depth first
+* order, root first. A node's subtree is the range
+* [index, index + nSubtreeSize), so walking the tree
+* is a linear scan where parents always come before
+* their children. Node indices change when the tree
+* changes, IDs don't
+*/
+struct Hierarchy {
+	using OnNodeDeleted = std::function<void(GameObject*)>;
+
+	static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+	static constexpr uint32_t ROOT = 0;
+
+	/* One reparent of a bulk move */
+	struct NodeMove {
+		uint32_t nNode;
+		uint32_t nNewParent;
+	};
+
+	struct HierarchyNode {
+		uint32_t id = INVALID_NODE; // Stable across tree changes
+
+		Name name;
+		GameObject* pObj = nullptr;
+
+		uint32_t nParent = INVALID_NODE;
+		uint32_t nFirstChild = INVALID_NODE;
+		uint32_t nLastChild = INVALID_NODE;
+		uint32_t nNextSibling = INVALID_NODE;
+		uint32_t nSubtreeSize = 1; // Node and all its descendants
+		uint32_t nDepth = 0;
+
+		/**
+		* Check if hierarchy node is valid
+		*
+		* @returns True if is valid
+		*/
+		bool
+		IsValid() const {
+			return this->id != INVALID_NODE;
+		}
+
+		/**
+		* Check if hierarchy node
+		* has any children
+		*
+		* @returns True if it has childrens
+		*/
+		bool HasChildren() const { return this->nFirstChild != INVALID_NODE; }
+	};
+
+	Vector<HierarchyNode> nodes; /* Depth first order */
+	HashMap<uint32_t, uint32_t> nodeIndices; /* ID -> Node index */
+	HashMap<String, Vector<uint32_t>> nameIndices; /* Name -> Node IDs (Name has no ordering of its own) */
+	OnNodeDeleted nodeDeletedCb = nullptr;
+
+	uint32_t nCurrentId = 0;
+
+	void
+	SetOnNodeDeleted(OnNodeDeleted callback) {
+		this->nodeDeletedCb = callback;
+	}
+
+	/**
+	* Generates a unique ID
+	* inside of the tree
+	*
+	* @returns Generated ID
+	*/
+	uint32_t
+	GenerateID() {
+		return this->nCurrentId++;
+	}
+
+	static Hierarchy Create(const Name& rootName);
+
+	uint32_t GetSize() const { return static_cast<uint32_t>(this->nodes.size()); }
+	uint32_t FindNode(uint32_t nId) const;
+
+	uint32_t CreateNode(const Name& name, uint32_t nParent = INVALID_NODE, GameObject* pObj = nullptr);
+	void MoveNode(uint32_t nNode, uint32_t nNewParent);
+	void DeleteNode(uint32_t nNode);
+
+	/* Bulk changes, one rebuild for the whole set */
+	uint32_t CreateNodes(const Name& name, uint32_t nParent, const Vector<GameObject*>& objects);
+	void MoveNodes(const Vector<NodeMove>& moves);
+	void DeleteNodes(const Vector<uint32_t>& nodesToDelete);
+
+private:
+	void ReleaseNode(HierarchyNode& node);
+	void Reorder(const Vector<uint32_t>& order);
+	void RebuildLinks();
+};
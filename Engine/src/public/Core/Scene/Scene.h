@@ -6,194 +6,54 @@
 
 #include "Core/Containers.h"
 
+#include "Core/ECS/Registry.h"
+#include "Core/ECS/SystemScheduler.h"
 #include "Core/GameObject/GameObject.h"
 #include "Core/GameObject/Components/Mesh.h"
 #include "Core/Camera/Camera.h"
 #include "Core/Camera/EditorCamera.h"
+#include "Core/Scene/Hierarchy.h"
+#include "Core/Scene/SceneCommandBuffer.h"
+#include "Core/Scene/SceneBVH.h"
+#include "Core/Scene/WorldPartition.h"
+#include "Core/Resources/SceneAsset.h"
+#include "Core/Utils/LinearArena.h"
+#include "Core/Utils/ObjectPool.h"
+#include "Math/TransformBatch.h"
 #include "Utils.h"
 
-struct SceneAsset;
-
-struct Hierarchy {
-	using OnNodeDeleted = std::function<void(GameObject*)>;
-
-	struct HierarchyNode {
-		uint32_t id = -1;
-
-		Name name;
-		WeakRef<HierarchyNode> parent;
-		Vector<Ref<HierarchyNode>> children;
-		GameObject* pObj = nullptr;
-
-		/**
-		* Check if hierarchy node is valid
-		* 
-		* @returns True if is valid
-		*/
-		bool
-		IsValid() const {
-			return this->id != -1;
-		}
-
-		/**
-		* Check if hierarchy node
-		* has any children
-		* 
-		* @returns True if it has childrens
-		*/
-		bool HasChildren() const { return !this->children.empty(); }
-	};
-
-	Ref<HierarchyNode> root;
-	Map<uint32_t, Ref<HierarchyNode>> nodeIndices; /* ID -> Node */
-	Map<Name, Vector<uint32_t>> nameIndices; /* Name -> Node IDs */
-	OnNodeDeleted nodeDeletedCb = nullptr;
-
-	uint32_t nCurrentId = 0;
-
-	void
-	SetOnNodeDeleted(OnNodeDeleted callback) { 
-		this->nodeDeletedCb = callback;
-	}
-
-	/**
-	* Generates a unique ID
-	* inside of the tree
-	* 
-	* @returns Generated ID
-	*/
-	uint32_t 
-	GenerateID() {
-		return this->nCurrentId++;
-	}
-
-	static Hierarchy
-	Create(const Name& rootName) {
-		Hierarchy hierarchy = { };
-		hierarchy.root = hierarchy.CreateNode(rootName);
-		return hierarchy;
-	}
-
-	/**
-	* Creates a node
-	* inside the tree
-	* 
-	* @param name Node name
-	* @param parent Node parent
-	* @param pObj Node GameObject
-	* 
-	* @returns Created node
-	*/
-	Ref<Hierarchy::HierarchyNode>
-	CreateNode(const Name& name, Ref<HierarchyNode> parent = nullptr, GameObject* pObj = nullptr) {
-		Ref<HierarchyNode> node = CreateRef<HierarchyNode>();
-		node->name = name;
-		node->id = this->GenerateID();
-		node->parent = parent.Get();
-		node->pObj = pObj;
-
-		Vector<uint32_t>& indices = this->nameIndices[name];
-		indices.push_back(node->id);
-
-		if (parent) {
-			parent->children.push_back(node);
-		}
-
-		return node;
-	}
-
-	/**
-	* Changes node parent (move node)
-	* 
-	* @param node Hierarchy ndoe
-	* @param newParent New parent
-	*/
-	void 
-	MoveNode(Ref<HierarchyNode> node, Ref<HierarchyNode> newParent) {
-		if (!node || !newParent) return;
-
-		Ref<HierarchyNode> oldParent = node->parent.lock();
-		if (oldParent) {
-			Vector<Ref<HierarchyNode>>& children = oldParent->children;
-
-			auto it = std::find_if(
-				children.begin(),
-				children.end(),
-				[&](const Ref<HierarchyNode>& child)
-				{
-					return child.Get() == node.Get();
-				});
-
-			if (it != children.end())
-				children.erase(it);
-		}
-
-		node->parent = newParent.Get();
-		newParent->children.push_back(node);
-
-		node->parent = newParent.Get();
-		return;
-	}
-
-	/**
-	* Delete a node from the hierarchy
-	* 
-	* @param node Hierarchy node
-	*/
-	void 
-	DeleteNode(Ref<HierarchyNode> node) {
-		if (!node) return;
-		
-		/* Get node parent and children */
-		WeakRef<HierarchyNode> weakParent = node->parent;
-		Vector<Ref<HierarchyNode>>& children = node->children;
-
-		/* Delete each children node */
-		for (Ref<HierarchyNode>& child : children) {
-			this->DeleteNode(child);
-		}
-
-		children.clear();
-
-		if (node->pObj != nullptr && this->nodeDeletedCb) {
-			this->nodeDeletedCb(node->pObj);
-			node->pObj = nullptr;
-		}
-
-		Ref<HierarchyNode> parent = weakParent.lock();
-
-		if (!parent) return;
-
-		/* Remove node from parent */
-		Vector<Ref<HierarchyNode>>& parentChildren = parent->children;
-		parentChildren.erase(
-			std::remove_if(
-				parentChildren.begin(),
-				parentChildren.end(),
-				[node](const Ref<HierarchyNode>& parentChild) {
-					return parentChild.Get() == node.Get();
-				}
-			),
-			parentChildren.end()
-		);
-	}
-};
-
 class Scene {
 	friend class SceneManager;
+	friend class SceneCommandBuffer;
 public:
 	Scene(const String& name);
+	~Scene();
+
+	Scene(const Scene&) = delete;
+	Scene& operator=(const Scene&) = delete;
 
-	void AddObject(GameObject* object);
-	Map<String, GameObject*> GetObjects();
+	GameObject* CreateObject(const String& name, uint32_t nParentNode = Hierarchy::ROOT);
+
+	GameObject* GetGameObject(EntityHandle handle);
+	GameObject* FindObject(const String& name);
+	const Vector<GameObject*>& GetObjects() const { return this->m_objects; }
 
 	void DeleteObject(GameObject* pObj);
 
+	GameObject* PickObject(const Ray& ray, float fMaxDistance = FLT_MAX);
+
 	void Start();
 	void Update();
+	void UpdateTransforms();
 
 	Camera* GetCurrentCamera() { return this->m_currentCamera; }
 	Hierarchy& GetHierarchy() { return this->m_hierarchy; }
+	const SceneBVH& GetBVH() const { return this->m_bvh; }
+	const Vector<EntityID>& GetChangedEntities() const { return this->m_changedEntities; }
+	Registry& GetRegistry() { return this->m_registry; }
+	SystemScheduler& GetSystems() { return this->m_systems; }
+	WorldPartition& GetPartition() { return this->m_partition; }
+	SceneCommandBuffer& GetCommands() { return this->m_commands; }
 
 	const String 
 	GetName() { 
@@ -206,13 +66,49 @@ public:
 private:
 	String m_name;
 
-	Map<String, GameObject*> m_gameObjects;
+	Registry m_registry;
+	SystemScheduler m_systems;
+
+	/* Scene lifetime memory, dropped at once with the scene */
+	LinearArena m_arena;
+	ObjectPool<GameObject> m_objectPool;
+
+	/* Slot map over the registry's entity indices, objects stay packed */
+	Vector<GameObject*> m_objects;
+	Vector<uint32_t> m_objectSlots; // Entity index -> m_objects index
+	HashMap<String, Vector<EntityHandle>> m_nameIndex; // Names don't have to be unique
 
 	Camera* m_currentCamera;
 	Map<String, Camera*> m_cameras;
 
 	Hierarchy m_hierarchy;
 
-	void StartHierarchy(Ref<Hierarchy::HierarchyNode> node);
-	void UpdateHierarchy(Ref<Hierarchy::HierarchyNode> node);
+	/* Dirty transform batch, reused every update */
+	Vector<uint32_t> m_dirtyIndices; // Dense WorldTransform indices
+	TransformSoA m_dirtyTransforms;
+	Vector<glm::mat4> m_dirtyMatrices;
+
+	/* Per hierarchy node scratch of the world matrix pass */
+	Vector<const glm::mat4*> m_nodeWorlds;
+	Vector<uint8_t> m_nodeChanged;
+	Vector<EntityID> m_changedEntities; // World matrix changed this update
+
+	SceneBVH m_bvh; // World bounds of every loaded mesh
+
+	WorldPartition m_partition; // Streamed cells, partitioned scenes only
+
+	/* Objects drawing a baked static batch, written back with the scene */
+	struct StaticBatch {
+		EntityHandle handle;
+		SceneStaticBatchAsset asset;
+	};
+
+	HashMap<EntityID, StaticBatch> m_staticBatches;
+
+	SceneCommandBuffer m_commands; // Structural changes, applied once per update
+
+	GameObject* AllocateObject(const String& name);
+	void ComposeDirtyLocals(ComponentPool<Transform>& transforms, ComponentPool<WorldTransform>& worldTransforms);
+	void PropagateWorlds(ComponentPool<WorldTransform>& worldTransforms);
+	void UpdateBounds(ComponentPool<WorldTransform>& worldTransforms);
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/ECS/Entity.h"
+
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+
+struct RayHit {
+	EntityID entity = INVALID_ENTITY;
+	float fDistance = 0.f;
+
+	bool IsValid() const { return this->entity != INVALID_ENTITY; }
+};
+
+/**
+* Dynamic AABB tree over scene objects
+*
+* Binary tree with one object per leaf. Build()
+* splits with a binned surface area heuristic,
+* between builds objects are inserted next to their
+* cheapest sibling and moved objects refit their
+* ancestors. Optimize() rebuilds once refits made
+* the tree noticeably worse than the last build
+*/
+class SceneBVH {
+public:
+	static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+	struct BVHNode {
+		AABB bounds;
+		uint32_t nParent = INVALID_NODE;
+		uint32_t nLeft = INVALID_NODE; // INVALID_NODE on leaves
+		uint32_t nRight = INVALID_NODE;
+		EntityID entity = INVALID_ENTITY; // Leaves only
+
+		bool IsLeaf() const { return this->nLeft == INVALID_NODE; }
+	};
+
+	void Insert(EntityID entity, const AABB& bounds);
+	void Remove(EntityID entity);
+	void Update(EntityID entity, const AABB& bounds);
+	bool Contains(EntityID entity) const;
+
+	void Build();
+	void Optimize();
+	void Clear();
+
+	void QueryFrustum(const Frustum& frustum, Vector<EntityID>& outEntities) const;
+	void QueryOverlap(const AABB& bounds, Vector<EntityID>& outEntities) const;
+	RayHit RayCast(const Ray& ray, float fMaxDistance = FLT_MAX) const;
+
+	float GetCost() const;
+	uint32_t GetLeafCount() const { return this->m_nLeafCount; }
+	uint32_t GetRoot() const { return this->m_nRoot; }
+	const Vector<BVHNode>& GetNodes() const { return this->m_nodes; }
+
+private:
+	Vector<BVHNode> m_nodes;
+	Vector<uint32_t> m_freeNodes;
+	Vector<uint32_t> m_leaves; // Entity index -> leaf node
+
+	uint32_t m_nRoot = INVALID_NODE;
+	uint32_t m_nLeafCount = 0;
+
+	float m_fBuildCost = 0.f; // GetCost() right after the last Build()
+	uint32_t m_nChangesSinceBuild = 0;
+
+	uint32_t AllocateNode();
+	void FreeNode(uint32_t nNode);
+
+	void InsertLeaf(uint32_t nLeaf);
+	void RemoveLeaf(uint32_t nLeaf);
+	void Refit(uint32_t nNode);
+	void CollectSubtree(uint32_t nNode, Vector<EntityID>& outEntities) const;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <mutex>
+#include <functional>
+
+#include "Core/Containers.h"
+#include "Core/ECS/Entity.h"
+#include "Math/Transform.h"
+
+class Scene;
+class GameObject;
+
+/**
+* Deferred structural scene changes
+*
+* Spawns, despawns and reparents are recorded from
+* any thread and applied by the scene once per
+* update, right after its systems ran. The whole
+* set costs one hierarchy rebuild per kind of
+* change, one upload per shared mesh and one
+* batch of GPU mesh releases, instead of a
+* rebuild and an upload or unload per object.
+*
+* Applied in order: despawns, reparents, spawns.
+* Despawning an object despawns its subtree
+*/
+class SceneCommandBuffer {
+public:
+	/* Called on the simulation thread with the spawned objects */
+	using OnSpawned = std::function<void(const Vector<EntityHandle>&)>;
+
+	SceneCommandBuffer() = default;
+
+	SceneCommandBuffer(const SceneCommandBuffer&) = delete;
+	SceneCommandBuffer& operator=(const SceneCommandBuffer&) = delete;
+
+	void Spawn(EntityHandle prototype, uint32_t nCount, EntityHandle parent = { }, OnSpawned onSpawned = nullptr);
+	void Spawn(EntityHandle prototype, const Vector<Transform>& transforms, EntityHandle parent = { }, OnSpawned onSpawned = nullptr);
+	void Despawn(EntityHandle handle);
+	void Reparent(EntityHandle handle, EntityHandle newParent = { });
+
+	bool IsEmpty();
+
+	void Apply(Scene& scene);
+private:
+	struct SpawnCommand {
+		EntityHandle prototype;
+		EntityHandle parent; // Root if invalid
+		uint32_t nCount = 0;
+		uint32_t nFirstTransform = UINT32_MAX; // Into m_transforms, prototype transform if invalid
+		OnSpawned onSpawned;
+	};
+
+	struct ReparentCommand {
+		EntityHandle handle;
+		EntityHandle parent; // Root if invalid
+	};
+
+	/* Recorded commands, swapped out when applied */
+	struct Commands {
+		Vector<SpawnCommand> spawns;
+		Vector<Transform> transforms;
+		Vector<EntityHandle> despawns;
+		Vector<ReparentCommand> reparents;
+
+		bool
+		IsEmpty() const {
+			return this->spawns.empty() && this->despawns.empty() && this->reparents.empty();
+		}
+
+		void
+		Clear() {
+			this->spawns.clear();
+			this->transforms.clear();
+			this->despawns.clear();
+			this->reparents.clear();
+		}
+	};
+
+	std::mutex m_mutex;
+	Commands m_recording;
+	Commands m_applying; // Keeps its capacity between updates
+
+	HashMap<EntityID, uint32_t> m_nodeIds; // Entity -> hierarchy node ID, rebuilt per apply
+
+	void ApplyDespawns(Scene& scene);
+	void ApplyReparents(Scene& scene);
+	void ApplySpawns(Scene& scene);
+
+	void MapNodes(Scene& scene);
+	uint32_t FindNode(Scene& scene, EntityHandle handle);
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <spdlog/spdlog.h>
 
 #include "Core/Scene/Scene.h"
@@ -22,10 +23,22 @@ public:
 
 	void SetDimensions(uint32_t nWidth, uint32_t nHeight);
 
+	/**
+	* Guards the scenes while the game update and
+	* draw collection run on the simulation worker.
+	* Main thread code touching the scene during
+	* rendering (editor UI) must hold it
+	* 
+	* @returns Scene mutex
+	*/
+	std::mutex& GetSceneMutex() { return this->m_sceneMutex; }
+
 	static SceneManager* GetInstance();
 private:
 	Scene* m_currentScene;
 	Map<String, Scene*> m_scenes;
 
+	std::mutex m_sceneMutex;
+
 	static SceneManager* m_instance;
 };
\ No newline at end of file
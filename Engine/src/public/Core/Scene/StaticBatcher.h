@@ -0,0 +1,56 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/Resources/SceneAsset.h"
+#include "Core/Resources/MeshAsset.h"
+#include "Utils.h"
+
+/* Bake clustering and chunk limits */
+struct StaticBatchSettings {
+	float fClusterSize = 64.f; // Side of the XZ squares static objects are grouped in
+	uint32_t nMaxChunkVertices = 256 * 1024; // Per merged submesh, a fraction of a mega-buffer block
+	uint32_t nMaxChunkIndices = 1024 * 1024;
+};
+
+/**
+* Static geometry baking
+*
+* Static mesh objects are grouped in XZ clusters.
+* Inside a cluster, their submeshes sharing a
+* material are transformed into the cluster's
+* space and merged into one submesh, split in
+* chunks when it grows past the limits. Each
+* cluster becomes one mesh asset drawn by one
+* static object, so a cluster costs a transform
+* slot and a draw group per material instead of
+* an instance per source submesh. The clusters
+* are still small enough to be culled apart
+*/
+class StaticBatcher {
+public:
+	static bool Bake(
+		const SceneAsset& sceneAsset,
+		const StaticBatchSettings& settings,
+		const String& batchPrefix,
+		SceneAsset& outScene,
+		Vector<MeshAsset>& outMeshes
+	);
+	static bool BakeFile(const String& scenePath, const StaticBatchSettings& settings);
+
+private:
+	struct Chunk {
+		Vector<Vertex> vertices;
+		Vector<uint32_t> indices;
+	};
+
+	struct Cluster {
+		int32_t nX = 0;
+		int32_t nZ = 0;
+		glm::vec3 origin = glm::vec3(0.f);
+		AABB bounds;
+		uint32_t nSourceCount = 0;
+		Map<AssetHandle, Vector<Chunk>> materials; // Ordered, the bake comes out the same for the same scene
+	};
+
+	static bool MergeMesh(const MeshAsset& meshAsset, const glm::mat4& world, const StaticBatchSettings& settings, Cluster& cluster);
+	static MeshAsset BuildMesh(const Cluster& cluster, const String& name);
+};
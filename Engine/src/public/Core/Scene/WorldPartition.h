@@ -0,0 +1,118 @@
+#pragma once
+#include <future>
+
+#include "Core/Containers.h"
+#include "Core/ECS/Entity.h"
+#include "Core/Renderer/MeshData.h"
+#include "Core/Resources/SceneAsset.h"
+#include "Core/Utils/ThreadPool.h"
+
+class Scene;
+
+/* Streaming distances and limits */
+struct WorldPartitionSettings {
+	float fLoadRadius = 200.f; // Cells closer than this to the camera are loaded (XZ)
+	float fUnloadMargin = 50.f; // Loaded cells stay until this much farther than the load radius
+	uint64_t nMemoryBudget = 512ull << 20; // Mesh registry resident bytes (GPU copies, kept CPU geometry), farther cells are evicted to make room
+	uint32_t nMaxConcurrentLoads = 2;
+	uint32_t nMaxCellsPerUpdate = 1; // Loaded cells instantiated per update
+	uint32_t nStreamingThreads = 2;
+};
+
+/**
+* World partition streaming
+*
+* A partitioned scene keeps its always loaded
+* objects in the scene asset and the rest in
+* one asset per grid cell. Cells around the
+* camera are read and their meshes decoded on
+* streaming threads, then instantiated on the
+* thread owning the scene. Cells unload once
+* they are past the load radius plus a margin,
+* or to make room for nearer ones when the
+* memory budget is exceeded
+*/
+class WorldPartition {
+public:
+	WorldPartition() = default;
+	~WorldPartition();
+
+	WorldPartition(const WorldPartition&) = delete;
+	WorldPartition& operator=(const WorldPartition&) = delete;
+
+	void Init(const SceneAsset& sceneAsset);
+	void SetSettings(const WorldPartitionSettings& settings) { this->m_settings = settings; }
+	const WorldPartitionSettings& GetSettings() const { return this->m_settings; }
+
+	void Update(Scene& scene, const glm::vec3& viewPosition);
+
+	bool IsEnabled() const { return !this->m_cells.empty(); }
+	bool IsStreamed(EntityHandle handle) const;
+
+	Vector<SceneCellAsset> GetCellAssets() const;
+	uint32_t GetLoadedCellCount() const { return this->m_nLoadedCells; }
+
+	static bool Partition(const SceneAsset& sceneAsset, float fCellSize, const String& cellPrefix, SceneAsset& outRoot, Vector<SceneAsset>& outCells);
+	static bool PartitionFile(const String& scenePath, float fCellSize);
+
+private:
+	enum class ECellState : uint8_t {
+		UNLOADED,
+		LOADING, // Streaming thread reading it
+		LOADED,
+		FAILED // Not retried
+	};
+
+	/* Streaming thread output */
+	struct CellPayload {
+		CellPayload() = default;
+		~CellPayload();
+
+		CellPayload(const CellPayload&) = delete;
+		CellPayload& operator=(const CellPayload&) = delete;
+
+		Vector<GameObjectAsset> objects;
+		Vector<uint32_t> staticObjects; // Ascending indices into objects
+		HashMap<uint64_t, Ref<MeshData>> meshes; // Mesh asset UUID -> registry data, one user each
+		uint64_t nByteSize = 0;
+	};
+
+	struct Cell {
+		SceneCellAsset asset;
+		ECellState state = ECellState::UNLOADED;
+		std::future<Ref<CellPayload>> load;
+
+		uint64_t nByteSize = 0; // Resident bytes of its meshes, shared ones included. Measured on load, asset estimate before
+		float fDistance = 0.f;
+
+		uint32_t nNodeId = UINT32_MAX; // Hierarchy group node of its objects
+		Vector<EntityHandle> objects;
+	};
+
+	struct StreamedObject {
+		EntityHandle handle;
+		uint32_t nCell = 0;
+	};
+
+	WorldPartitionSettings m_settings;
+
+	Vector<Cell> m_cells;
+	ThreadPool::Ptr m_streamingPool;
+
+	HashMap<EntityID, StreamedObject> m_streamedObjects;
+
+	uint32_t m_nLoadedCells = 0;
+	uint32_t m_nLoadingCells = 0;
+	uint64_t m_nPendingBytes = 0; // Sizes of the loading cells
+	bool m_bOverBudget = false;
+
+	void PollLoads(Scene& scene);
+	void StartLoads(Scene& scene);
+	bool MakeRoom(Scene& scene, uint64_t nBytes, float fDistance);
+
+	void InstantiateCell(Scene& scene, uint32_t nCell, const CellPayload& payload);
+	void UnloadCell(Scene& scene, uint32_t nCell);
+
+	static Ref<CellPayload> LoadCell(AssetHandle handle);
+	static float DistanceXZ(const AABB& bounds, const glm::vec3& point);
+};
@@ -12,6 +12,7 @@ public:
 	void PostUpdate();
 
 	float deltaTime;
+	float frameTime; // Seconds from PreUpdate to PostUpdate of the last frame
 
 	static Time* GetInstance();
 private:
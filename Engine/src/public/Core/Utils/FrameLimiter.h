@@ -0,0 +1,39 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+/**
+* Caps the frame rate
+*
+* Sleeps in 1 ms steps while the remaining time is above
+* the expected oversleep of a step, then spins to the
+* deadline. The oversleep estimate is learned at runtime
+* (mean + standard deviation), so coarse OS timers cost
+* a little spinning instead of a missed deadline
+*/
+class FrameLimiter {
+public:
+	FrameLimiter() = default;
+
+	void SetTargetFPS(float fFPS);
+	float GetTargetFPS() const { return this->m_fTargetFPS; }
+
+	bool IsEnabled() const { return this->m_fTargetFPS > 0.f; }
+
+	void Wait();
+private:
+	using Clock = std::chrono::steady_clock;
+
+	float m_fTargetFPS = 0.f;
+	Clock::duration m_period = Clock::duration::zero();
+	Clock::time_point m_nextFrame;
+	bool m_bStarted = false;
+
+	/* Oversleep statistics of a 1 ms sleep, in seconds */
+	double m_fSleepEstimate = 0.005;
+	double m_fSleepMean = 0.005;
+	double m_fSleepM2 = 0.0;
+	uint64_t m_nSleepCount = 1;
+
+	void UpdateSleepEstimate(double fObserved);
+};
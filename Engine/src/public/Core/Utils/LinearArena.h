@@ -0,0 +1,45 @@
+#pragma once
+#include "Core/Containers.h"
+
+#include <cstddef>
+
+/**
+* Bump allocator for data sharing one lifetime
+*
+* Allocations are carved out of large blocks and never
+* freed one by one, Reset() drops all of them at once.
+* Destructors are not run, only put objects in here
+* whose destructor has nothing to release, or that
+* are abandoned together with what they refer to
+*/
+class LinearArena {
+public:
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	explicit LinearArena(size_t nBlockSize = DEFAULT_BLOCK_SIZE);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	void* Allocate(size_t nSize, size_t nAlignment = alignof(std::max_align_t));
+	void Reset();
+
+	size_t GetUsedBytes() const { return this->m_nUsedBytes; }
+	size_t GetReservedBytes() const { return this->m_nReservedBytes; }
+
+private:
+	struct Block {
+		Byte* pData = nullptr;
+		size_t nSize = 0;
+	};
+
+	Vector<Block> m_blocks;
+	size_t m_nBlockSize;
+	size_t m_nOffset = 0; // Into the last block
+
+	size_t m_nUsedBytes = 0;
+	size_t m_nReservedBytes = 0;
+
+	void AddBlock(size_t nMinSize);
+};
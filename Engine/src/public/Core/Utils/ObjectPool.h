@@ -0,0 +1,132 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Core/Utils/LinearArena.h"
+
+#include <new>
+#include <utility>
+
+/**
+* Fixed size block pool for one type
+*
+* Objects live in chunks of nChunkSize slots that are
+* never moved, so pointers stay valid until the object
+* is destroyed. Free slots form an intrusive list,
+* creating and destroying an object is a few pointer
+* writes. Chunks come from an arena when one is given
+* (dropped with it), from the heap otherwise
+*
+* @tparam T Object type
+* @tparam nChunkSize Slots per chunk
+*/
+template<typename T, uint32_t nChunkSize = 256>
+class ObjectPool {
+public:
+	explicit ObjectPool(LinearArena* pArena = nullptr) : m_pArena(pArena) { }
+
+	/* Live objects are not destroyed, see Abandon */
+	~ObjectPool() {
+		this->ReleaseChunks();
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/**
+	* Constructs an object in a free slot
+	*
+	* @param args Constructor arguments
+	*
+	* @returns Created object
+	*/
+	template<typename... Args>
+	T*
+	Create(Args&&... args) {
+		if (this->m_pFreeList == nullptr) {
+			this->AddChunk();
+		}
+
+		Slot* pSlot = this->m_pFreeList;
+		this->m_pFreeList = pSlot->pNext;
+		this->m_nLiveCount++;
+
+		return new (pSlot->storage) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	* Destroys an object and returns its slot
+	*
+	* @param pObj Object created by this pool
+	*/
+	void
+	Destroy(T* pObj) {
+		if (pObj == nullptr) return;
+
+		pObj->~T();
+
+		Slot* pSlot = reinterpret_cast<Slot*>(pObj);
+		pSlot->pNext = this->m_pFreeList;
+		this->m_pFreeList = pSlot;
+		this->m_nLiveCount--;
+	}
+
+	/**
+	* Forgets every object without running
+	* destructors. Only valid when whatever they
+	* would release goes away with them
+	*/
+	void
+	Abandon() {
+		this->ReleaseChunks();
+
+		this->m_pFreeList = nullptr;
+		this->m_nLiveCount = 0;
+	}
+
+	uint32_t GetLiveCount() const { return this->m_nLiveCount; }
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(this->m_chunks.size()) * nChunkSize; }
+
+private:
+	union Slot {
+		Slot* pNext;
+		alignas(T) Byte storage[sizeof(T)];
+	};
+
+	LinearArena* m_pArena = nullptr;
+
+	Vector<Slot*> m_chunks;
+	Slot* m_pFreeList = nullptr;
+	uint32_t m_nLiveCount = 0;
+
+	void
+	AddChunk() {
+		Slot* pChunk = nullptr;
+
+		if (this->m_pArena != nullptr) {
+			pChunk = static_cast<Slot*>(this->m_pArena->Allocate(sizeof(Slot) * nChunkSize, alignof(Slot)));
+		}
+		else {
+			pChunk = static_cast<Slot*>(::operator new(sizeof(Slot) * nChunkSize, std::align_val_t(alignof(Slot))));
+		}
+
+		/* Linked in address order, the first slot is handed out first */
+		for (uint32_t i = 0; i < nChunkSize - 1; i++) {
+			pChunk[i].pNext = &pChunk[i + 1];
+		}
+		pChunk[nChunkSize - 1].pNext = this->m_pFreeList;
+
+		this->m_pFreeList = pChunk;
+		this->m_chunks.push_back(pChunk);
+	}
+
+	void
+	ReleaseChunks() {
+		/* Arena chunks go with the arena */
+		if (this->m_pArena == nullptr) {
+			for (Slot* pChunk : this->m_chunks) {
+				::operator delete(pChunk, std::align_val_t(alignof(Slot)));
+			}
+		}
+
+		this->m_chunks.clear();
+	}
+};
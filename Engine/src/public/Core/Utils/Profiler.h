@@ -0,0 +1,128 @@
+#pragma once
+#include "Core/Containers.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/*
+	Scoped CPU zones are compiled in for debug builds.
+	Release builds need USE_PROFILER, otherwise the
+	macros expand to nothing
+*/
+#if !defined(NDEBUG) || defined(USE_PROFILER)
+	#define PROFILER_ENABLED
+#endif
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(PROFILER_ENABLED)
+	#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+	#define PROFILE_THREAD(name) Profiler::GetInstance()->SetThreadName(name)
+#else
+	#define PROFILE_SCOPE(name) do { } while (0)
+	#define PROFILE_THREAD(name) do { } while (0)
+#endif
+
+struct ProfileZone {
+	const char* name = nullptr; // Must outlive the capture (string literals)
+	uint64_t nStart = 0; // Nanoseconds since the capture began
+	uint64_t nEnd = 0;
+};
+
+/**
+* Zones recorded by one thread
+*
+* Only the owning thread writes. Zones are stored in
+* chunks that are never moved, so the trace can be
+* written while other threads keep recording
+*/
+class ProfilerThreadBuffer {
+public:
+	static constexpr uint32_t CHUNK_SIZE = 4096;
+
+	struct Chunk {
+		ProfileZone zones[CHUNK_SIZE];
+		std::atomic<uint32_t> nCount{ 0 };
+		std::atomic<Chunk*> pNext{ nullptr };
+	};
+
+	explicit ProfilerThreadBuffer(uint32_t nThreadId);
+	~ProfilerThreadBuffer();
+
+	void Push(const ProfileZone& zone);
+
+	const Chunk* GetHead() const { return this->m_pHead; }
+	uint32_t GetThreadId() const { return this->m_nThreadId; }
+
+	String name;
+private:
+	uint32_t m_nThreadId;
+
+	Chunk* m_pHead;
+	Chunk* m_pTail;
+};
+
+class Profiler {
+public:
+	Profiler() = default;
+
+	void BeginCapture();
+	void EndCapture();
+
+	bool IsCapturing() const { return this->m_bCapturing.load(std::memory_order_acquire); }
+
+	void SetThreadName(const char* name);
+
+	void Record(const char* name, uint64_t nStart, uint64_t nEnd);
+	uint64_t Now() const;
+
+	bool WriteChromeTrace(const String& path);
+	static void WriteEscaped(std::ostream& out, const char* str);
+
+	void GetZones(uint64_t nStart, uint64_t nEnd, Vector<ProfileZone>& outZones);
+
+	static Profiler* GetInstance();
+private:
+	static Profiler* m_instance;
+
+	std::atomic<bool> m_bCapturing{ false };
+	std::chrono::steady_clock::time_point m_epoch;
+
+	std::mutex m_buffersMutex;
+	Vector<Ref<ProfilerThreadBuffer>> m_buffers;
+
+	ProfilerThreadBuffer* GetThreadBuffer();
+};
+
+/**
+* Records a zone from construction to destruction.
+* Use through PROFILE_SCOPE
+*/
+class ProfileScope {
+public:
+	explicit
+	ProfileScope(const char* name) : m_name(name) {
+		Profiler* pProfiler = Profiler::GetInstance();
+
+		this->m_bActive = pProfiler->IsCapturing();
+		if (this->m_bActive) {
+			this->m_nStart = pProfiler->Now();
+		}
+	}
+
+	~ProfileScope() {
+		if (!this->m_bActive) return;
+
+		Profiler* pProfiler = Profiler::GetInstance();
+		pProfiler->Record(this->m_name, this->m_nStart, pProfiler->Now());
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	const char* m_name;
+	uint64_t m_nStart = 0;
+	bool m_bActive = false;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <cfloat>
+
+#include <glm/glm.hpp>
+
+/**
+* Axis aligned bounding box
+*
+* Default constructed boxes are empty (min above
+* max), expanding them by anything makes them valid
+*/
+struct AABB {
+	glm::vec3 min = glm::vec3(FLT_MAX);
+	glm::vec3 max = glm::vec3(-FLT_MAX);
+
+	AABB() = default;
+	AABB(const glm::vec3& minPoint, const glm::vec3& maxPoint) : min(minPoint), max(maxPoint) {}
+
+	bool IsValid() const { return this->min.x <= this->max.x && this->min.y <= this->max.y && this->min.z <= this->max.z; }
+
+	glm::vec3 GetCenter() const { return (this->min + this->max) * .5f; }
+	glm::vec3 GetExtent() const { return (this->max - this->min) * .5f; }
+
+	/**
+	* Surface area, the SAH cost of a node
+	*
+	* @returns Area or 0 if empty
+	*/
+	float
+	GetSurfaceArea() const {
+		if (!this->IsValid()) return 0.f;
+
+		glm::vec3 size = this->max - this->min;
+		return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	void
+	Expand(const glm::vec3& point) {
+		this->min = glm::min(this->min, point);
+		this->max = glm::max(this->max, point);
+	}
+
+	void
+	Expand(const AABB& other) {
+		this->min = glm::min(this->min, other.min);
+		this->max = glm::max(this->max, other.max);
+	}
+
+	bool
+	Overlaps(const AABB& other) const {
+		return this->min.x <= other.max.x && this->max.x >= other.min.x
+			&& this->min.y <= other.max.y && this->max.y >= other.min.y
+			&& this->min.z <= other.max.z && this->max.z >= other.min.z;
+	}
+
+	bool
+	Contains(const AABB& other) const {
+		return this->min.x <= other.min.x && this->max.x >= other.max.x
+			&& this->min.y <= other.min.y && this->max.y >= other.max.y
+			&& this->min.z <= other.min.z && this->max.z >= other.max.z;
+	}
+
+	static AABB
+	Union(const AABB& a, const AABB& b) {
+		return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+	}
+
+	AABB Transform(const glm::mat4& matrix) const;
+};
+
+struct Ray {
+	glm::vec3 origin = glm::vec3(0.f);
+	glm::vec3 direction = glm::vec3(0.f, 0.f, -1.f); // Normalized
+
+	Ray() = default;
+	Ray(const glm::vec3& o, const glm::vec3& d) : origin(o), direction(d) {}
+
+	bool Intersects(const AABB& box, float fMaxDistance, float& fOutDistance) const;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Math/AABB.h"
+
+enum class EFrustumTest {
+	OUTSIDE,
+	INTERSECTS,
+	INSIDE
+};
+
+/**
+* View frustum as 6 normalized planes (xyz normal,
+* w distance), normals pointing inside
+*/
+struct Frustum {
+	static constexpr uint32_t PLANE_COUNT = 6;
+	static constexpr uint32_t ALL_PLANES = (1u << PLANE_COUNT) - 1;
+
+	glm::vec4 planes[PLANE_COUNT];
+
+	static Frustum FromMatrix(const glm::mat4& viewProj);
+
+	EFrustumTest Test(const AABB& box, uint32_t& nPlaneMask) const;
+	bool Intersects(const AABB& box) const;
+};
@@ -26,5 +26,5 @@ struct Transform {
 
 	Vector3 RotatePoint(Vector3& point);
 
-	glm::mat4 GetWorldMatrix() const;
+	glm::mat4 GetLocalMatrix() const; // Parent relative, see WorldTransform
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include "Core/Containers.h"
+#include "Math/Transform.h"
+
+enum class ESIMDLevel {
+	SCALAR,
+	SSE4, // 4 matrices per iteration
+	AVX2 // 8 matrices per iteration
+};
+
+/**
+* Packed (SoA) copy of Transform values
+*
+* Each component lives in its own array so the
+* batch kernel can load 4 or 8 objects per register
+*/
+struct TransformSoA {
+	Vector<float> locationX;
+	Vector<float> locationY;
+	Vector<float> locationZ;
+	Vector<float> rotationX; // Degrees, same as Transform
+	Vector<float> rotationY;
+	Vector<float> rotationZ;
+	Vector<float> scaleX;
+	Vector<float> scaleY;
+	Vector<float> scaleZ;
+
+	void Clear();
+	void Reserve(size_t nCount);
+	void Push(const Transform& transform);
+
+	size_t GetSize() const { return this->locationX.size(); }
+};
+
+namespace TransformBatch {
+	ESIMDLevel GetSupportedLevel();
+	const char* GetLevelName(ESIMDLevel level);
+
+	/* Same result as Transform::GetLocalMatrix for every element */
+	void ComposeLocalMatrices(const TransformSoA& transforms, glm::mat4* pOutMatrices);
+	void ComposeLocalMatrices(const TransformSoA& transforms, glm::mat4* pOutMatrices, ESIMDLevel level);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+* Compares Transform::GetLocalMatrix with the
+* TransformBatch kernels. Run with --bench-transforms
+*/
+namespace TransformBenchmark {
+	bool Run();
+}
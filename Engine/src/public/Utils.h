@@ -108,15 +108,16 @@ struct ScreenQuadVertex {
     glm::vec2 texCoord;
 };
 
-struct WVP {
-	glm::mat4 World;
-	glm::mat4 View;
-	glm::mat4 Projection;
-};
+/* Slots of the persistent scene tables, shared by the collector and the culling pass */
+constexpr uint32_t MAX_SCENE_INSTANCES = 65536;
+constexpr uint32_t MAX_SCENE_TRANSFORMS = 65536;
+constexpr uint32_t MAX_DRAW_GROUPS = 16384;
+
+constexpr uint32_t INVALID_DRAW_GROUP = UINT32_MAX;
 
 struct ObjectInstanceData {
-    uint32_t wvpOffset;
-    uint32_t materialOffset;
+    uint32_t transformIndex;
+    uint32_t materialIndex;
 };
 
 struct MaterialInstanceData {
@@ -142,12 +143,25 @@ struct DrawIndexedIndirectCommand {
     uint32_t firstInstance;
 };
 
+/* One instance of a draw group */
 struct DrawBatch {
+    uint32_t groupIndex; // INVALID_DRAW_GROUP on dead slots
+    uint32_t instanceDataIndex;
+};
+
+/*
+    Instances sharing a mesh allocation and material, drawn
+    with one instanced indirect command. Visible instances
+    are compacted at instanceBase of the view's instance list,
+    the command goes at drawOrder of its block's range
+*/
+struct DrawGroup {
     uint32_t indexCount;
     uint32_t firstIndex;
     int vertexOffset;
-    uint32_t instanceDataIndex;
     uint32_t nBlockIdx;
+    uint32_t instanceBase;
+    uint32_t drawOrder; // Rank in the block by sort key
 };
 
 struct FrameIndirectData {
@@ -158,12 +172,48 @@ struct FrameIndirectData {
     uint32_t objectCount;
 };
 
+/* New world matrix of a transform slot */
+struct TransformUpdate {
+    uint32_t nSlot;
+    uint32_t padding[3];
+    glm::mat4 world;
+};
+
+/* New contents of an instance slot */
+struct InstanceUpdate {
+    MaterialInstanceData material;
+    DrawBatch batch;
+    ObjectInstanceData instance;
+    uint32_t nSlot;
+    uint32_t padding[3];
+};
+
+/* New contents of a draw group slot. A dead group has indexCount = 0 */
+struct GroupUpdate {
+    DrawGroup group;
+    uint32_t nSlot;
+};
+
+static_assert(sizeof(TransformUpdate) == 80, "TransformUpdate must match the std430 layout in SceneUpdate.comp");
+static_assert(sizeof(InstanceUpdate) == 96, "InstanceUpdate must match the std430 layout in SceneUpdate.comp");
+static_assert(sizeof(GroupUpdate) == 28, "GroupUpdate must match the std430 layout in SceneUpdate.comp");
+
+/*
+    Draw data of a frame. Instances live in persistent GPU
+    tables, only the slots changed since the renderer last
+    applied an update are sent
+*/
 struct CollectedDrawData {
-    Vector<ObjectInstanceData> instances;
-    Vector<MaterialInstanceData> materials;
-    Vector<DrawBatch> batches;
-    Vector<WVP> wvps;
-    uint32_t nTotalBatches = 0;
+    Vector<TransformUpdate> transformUpdates;
+    Vector<InstanceUpdate> instanceUpdates;
+    Vector<GroupUpdate> groupUpdates;
+    Vector<uint32_t> visibleBatches; // Instance slots inside the camera frustum
+    uint64_t nSequence = 0;
+
+    uint32_t nTotalBatches = 0; // visibleBatches.size()
+    uint32_t nBatchSlotCount = 0; // Instance slots in use, live or dead
+    uint32_t nGroupSlotCount = 0; // Draw group slots in use, live or dead
+    uint32_t nMaxDrawsPerBlock = 1; // Live draw groups in the fullest mega-buffer block
 
     glm::mat4 viewProj = glm::mat4(1.f);
     glm::mat4 view = glm::mat4(1.f);
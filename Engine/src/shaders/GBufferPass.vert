@@ -5,15 +5,9 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormals;
 layout(location = 2) in vec2 inUVs;
 
-struct WVP {
-    mat4 World;
-    mat4 View;
-    mat4 Projection;
-};
-
 struct ObjectInstanceData {
-    uint wvpOffset; // WVP Ring buffer dynamic offset
-    uint materialOffset;
+    uint transformIndex;
+    uint materialIndex;
 };
 
 struct MaterialInstanceData {
@@ -40,13 +34,17 @@ layout(set = 0, binding = 1) readonly buffer MaterialInstances {
     MaterialInstanceData materials[];
 };
 
-layout(set = 0, binding = 5) readonly buffer WVPBuffer {
-    WVP wvpData[];
+layout(set = 0, binding = 5) readonly buffer WorldBuffer {
+    mat4 worlds[];
+};
+
+/* Instance slots compacted per draw group by the culling pass */
+layout(set = 0, binding = 6) readonly buffer GroupInstances {
+    uint groupInstances[];
 };
 
 layout(push_constant) uniform PushConstants {
-    uint wvpAlignment;
-    uint materialAlignment;
+    mat4 viewProj;
 } pc;
 
 /* Output locations */
@@ -57,24 +55,21 @@ layout(location = 3) out flat uint outMaterialIndex;
 
 void main() {
     /* Use gl_InstanceIndex that comes from the indirect draw */ 
-    ObjectInstanceData instance = instances[gl_InstanceIndex];
-
-    uint wvpIndex = instance.wvpOffset / pc.wvpAlignment;
-    WVP wvp = wvpData[wvpIndex];
+    ObjectInstanceData instance = instances[groupInstances[gl_InstanceIndex]];
 
-    uint materialIndex = instance.materialOffset / pc.materialAlignment;
+    mat4 world = worlds[instance.transformIndex];
 
     /* Multiply our vertex position by our wold matrix */ 
-    vec4 worldPos = wvp.World * vec4(inPosition, 1.0);
+    vec4 worldPos = world * vec4(inPosition, 1.0);
 
     /* Multiply our Porjection * View * Vertex World position */ 
-    gl_Position = wvp.Projection * wvp.View * worldPos;
+    gl_Position = pc.viewProj * worldPos;
 
     /* Fragment position = Vertex world position */ 
     fragPos = worldPos.xyz;
 
     /* Invert our world matrix and transpose it */ 
-    mat3 normalMatrix = transpose(inverse(mat3(wvp.World)));
+    mat3 normalMatrix = transpose(inverse(mat3(world)));
     outNormals = normalize(normalMatrix * inNormals); // Normal matrix * input normals. Then normalize normals
     
     outUVs = inUVs;
@@ -83,5 +78,5 @@ void main() {
     // outTextureIndex = instance.textureIndex;
     // outOrmTextureIndex = instance.ormTextureIndex;
     // outEmissiveTextureIndex = instance.emissiveTextureIndex;
-    outMaterialIndex = materialIndex;
+    outMaterialIndex = instance.materialIndex;
 }
\ No newline at end of file
@@ -4,15 +4,9 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormals; // Unused but vertex layout needs it
 layout(location = 2) in vec2 inUVs; // Unused
 
-struct WVP {
-    mat4 World;
-    mat4 View;
-    mat4 Projection;
-};
-
 struct ObjectInstanceData {
-    uint wvpOffset;
-    uint materialOffset;
+    uint transformIndex;
+    uint materialIndex;
 };
 
 struct MaterialInstanceData {
@@ -36,23 +30,24 @@ layout(set = 0, binding = 0) readonly buffer InputInstances {
     ObjectInstanceData instances[];
 };
 
-layout(set = 0, binding = 5) readonly buffer WVPBuffer {
-    WVP wvpData[];
+layout(set = 0, binding = 5) readonly buffer WorldBuffer {
+    mat4 worlds[];
+};
+
+/* Instance slots compacted per draw group by the culling pass */
+layout(set = 0, binding = 6) readonly buffer GroupInstances {
+    uint groupInstances[];
 };
 
 /* Push constants with actual cascade lightViewProj */
 layout(push_constant) uniform PushConstants {
     mat4 lightViewProj;
-    uint wvpAlignment;
 } pc;
 
 void main() {
-    ObjectInstanceData instance = instances[gl_InstanceIndex];
-
-    uint wvpIndex = instance.wvpOffset / pc.wvpAlignment;
-    WVP wvp = wvpData[wvpIndex];
+    ObjectInstanceData instance = instances[groupInstances[gl_InstanceIndex]];
 
-    vec4 worldPos = wvp.World * vec4(inPosition, 1.0);
+    vec4 worldPos = worlds[instance.transformIndex] * vec4(inPosition, 1.0);
 
     gl_Position = pc.lightViewProj * worldPos;
 }